@@ -39,11 +39,21 @@ namespace Magnum { namespace Ui {
 
 template<class VertexData> BasicGLLayer<VertexData>::BasicGLLayer(): _buffer{GL::Buffer::TargetHint::Array} {}
 
-template<class VertexData> BasicGLLayer<VertexData>::~BasicGLLayer() = default;
+template<class VertexData> BasicGLLayer<VertexData>::BasicGLLayer(GLBufferArena& arena): _arena{&arena}, _buffer{NoCreate} {}
+
+template<class VertexData> BasicGLLayer<VertexData>::~BasicGLLayer() {
+    if(_arena && _allocation.size) _arena->free(_allocation);
+}
 
 template<class VertexData> void BasicGLLayer<VertexData>::reset(const std::size_t elementCapacity, const std::size_t dataCapacity, const GL::BufferUsage usage) {
-    /* Reallocate the buffer, if needed */
-    if(dataCapacity > this->capacity())
+    /* Reallocate the buffer, if needed. The arena allocation is done even
+       for zero capacity so the mesh has a buffer to refer to. */
+    if(_arena) {
+        if(!_allocation.size || dataCapacity > this->capacity()) {
+            if(_allocation.size) _arena->free(_allocation);
+            _allocation = _arena->allocate(sizeof(VertexData)*dataCapacity);
+        }
+    } else if(dataCapacity > this->capacity())
         _buffer.setData({nullptr, sizeof(VertexData)*dataCapacity}, usage);
 
     /* Reset state */
@@ -59,15 +69,23 @@ template<class VertexData> void BasicGLLayer<VertexData>::update() {
 
     /* Upload modified vertex data */
     const Math::Range1D<std::size_t> modifiedBytes = this->modified().scaled(sizeof(VertexData));
-    #ifndef MAGNUM_TARGET_WEBGL
-    const auto bufferData = Containers::arrayCast<VertexData>(_buffer.map(modifiedBytes.min(), modifiedBytes.size(), GL::Buffer::MapFlag::Write|GL::Buffer::MapFlag::InvalidateRange));
-    std::uninitialized_copy(this->data() + std::size_t{this->modified().min()},
-                            this->data() + std::size_t{this->modified().max()}, bufferData.begin());
-    _buffer.unmap();
-    #else
-    _buffer.setSubData(modifiedBytes.min(), this->data().slice(this->modified().min(),
-                                                               this->modified().max()));
-    #endif
+    if(_arena) {
+        /* The data stay in place until the arena uploads them, as the CPU
+           storage is reallocated only together with the allocation, which
+           discards the queued upload */
+        _arena->queueUpload(_allocation, modifiedBytes.min(),
+            this->data().slice(this->modified().min(), this->modified().max()));
+    } else {
+        #ifndef MAGNUM_TARGET_WEBGL
+        const auto bufferData = Containers::arrayCast<VertexData>(_buffer.map(modifiedBytes.min(), modifiedBytes.size(), GL::Buffer::MapFlag::Write|GL::Buffer::MapFlag::InvalidateRange));
+        std::uninitialized_copy(this->data() + std::size_t{this->modified().min()},
+                                this->data() + std::size_t{this->modified().max()}, bufferData.begin());
+        _buffer.unmap();
+        #else
+        _buffer.setSubData(modifiedBytes.min(), this->data().slice(this->modified().min(),
+                                                                   this->modified().max()));
+        #endif
+    }
 
     /* Reset modified range */
     this->resetModified();
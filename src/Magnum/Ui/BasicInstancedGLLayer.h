@@ -33,6 +33,7 @@
 #include <Magnum/GL/Mesh.h>
 
 #include "Magnum/Ui/BasicInstancedLayer.h"
+#include "Magnum/Ui/GLBufferArena.h"
 
 namespace Magnum { namespace Ui {
 
@@ -44,12 +45,43 @@ Adds OpenGL mesh and buffer management on top of @ref BasicInstancedLayer.
 */
 template<class InstanceData> class BasicInstancedGLLayer: public BasicInstancedLayer<InstanceData> {
     public:
+        /**
+         * @brief Constructor
+         *
+         * The layer data are stored in a buffer owned by the layer.
+         */
         explicit BasicInstancedGLLayer();
 
+        /**
+         * @brief Construct with data stored in a buffer arena
+         *
+         * The layer data are suballocated from @p arena, which is expected
+         * to outlive the layer. Data modified in @ref update() are only
+         * queued and uploaded in @ref GLBufferArena::upload().
+         */
+        explicit BasicInstancedGLLayer(GLBufferArena& arena);
+
         ~BasicInstancedGLLayer();
 
-        /** @brief Instance data buffer */
-        GL::Buffer& buffer() { return _buffer; }
+        /**
+         * @brief Instance data buffer
+         *
+         * If the layer is constructed with a @ref GLBufferArena, returns the
+         * arena buffer the data are currently allocated in. Use
+         * @ref bufferOffset() to get the offset of the data in it.
+         */
+        GL::Buffer& buffer() {
+            return _arena ? _arena->buffer(_allocation.buffer) : _buffer;
+        }
+
+        /**
+         * @brief Offset of the instance data in the buffer
+         *
+         * Always zero if the layer isn't constructed with a
+         * @ref GLBufferArena. Can change on every @ref reset() call, so the
+         * mesh has to be set up again after.
+         */
+        std::size_t bufferOffset() const { return _allocation.offset; }
 
         /** @brief Layer mesh */
         GL::Mesh& mesh() { return _mesh; }
@@ -61,6 +93,9 @@ template<class InstanceData> class BasicInstancedGLLayer: public BasicInstancedL
          * instances, clearing everything that has been set before. If current
          * memory capacity is larger or equal to @p capacity, no reallocation
          * is done.
+         *
+         * The @p usage is ignored if the layer is constructed with a
+         * @ref GLBufferArena.
          */
         void reset(std::size_t capacity, GL::BufferUsage usage);
 
@@ -71,6 +106,9 @@ template<class InstanceData> class BasicInstancedGLLayer: public BasicInstancedL
          * Called automatically at the beginning of @ref BasicUserInterface::draw(),
          * but scheduling it explicitly in a different place might reduce the
          * need for CPU/GPU synchronization.
+         *
+         * If the layer is constructed with a @ref GLBufferArena, the data
+         * are only queued for upload in @ref GLBufferArena::upload().
          */
         void update();
 
@@ -78,6 +116,8 @@ template<class InstanceData> class BasicInstancedGLLayer: public BasicInstancedL
         void draw(AbstractUiShader& shader);
 
     private:
+        GLBufferArena* _arena{};
+        GLBufferArena::Allocation _allocation{};
         GL::Buffer _buffer;
         GL::Mesh _mesh;
 };
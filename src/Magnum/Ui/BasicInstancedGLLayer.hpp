@@ -39,11 +39,21 @@ namespace Magnum { namespace Ui {
 
 template<class InstanceData> BasicInstancedGLLayer<InstanceData>::BasicInstancedGLLayer(): _buffer{GL::Buffer::TargetHint::Array} {}
 
-template<class InstanceData> BasicInstancedGLLayer<InstanceData>::~BasicInstancedGLLayer() = default;
+template<class InstanceData> BasicInstancedGLLayer<InstanceData>::BasicInstancedGLLayer(GLBufferArena& arena): _arena{&arena}, _buffer{NoCreate} {}
+
+template<class InstanceData> BasicInstancedGLLayer<InstanceData>::~BasicInstancedGLLayer() {
+    if(_arena && _allocation.size) _arena->free(_allocation);
+}
 
 template<class InstanceData> void BasicInstancedGLLayer<InstanceData>::reset(const std::size_t capacity, const GL::BufferUsage usage) {
-    /* Reallocate */
-    if(capacity > this->capacity())
+    /* Reallocate. The arena allocation is done even for zero capacity so
+       the mesh has a buffer to refer to. */
+    if(_arena) {
+        if(!_allocation.size || capacity > this->capacity()) {
+            if(_allocation.size) _arena->free(_allocation);
+            _allocation = _arena->allocate(sizeof(InstanceData)*capacity);
+        }
+    } else if(capacity > this->capacity())
         _buffer.setData({nullptr, sizeof(InstanceData)*capacity}, usage);
 
     /* Reset state */
@@ -59,15 +69,23 @@ template<class InstanceData> void BasicInstancedGLLayer<InstanceData>::update()
 
     /* Update modified instance data */
     const Math::Range1D<std::size_t> modifiedBytes = this->modified().scaled(sizeof(InstanceData));
-    #ifndef MAGNUM_TARGET_WEBGL
-    const auto bufferData = Containers::arrayCast<InstanceData>(_buffer.map(modifiedBytes.min(), modifiedBytes.size(), GL::Buffer::MapFlag::Write|GL::Buffer::MapFlag::InvalidateRange));
-    std::uninitialized_copy(this->data() + std::size_t{this->modified().min()},
-                            this->data() + std::size_t{this->modified().max()}, bufferData.begin());
-    _buffer.unmap();
-    #else
-    _buffer.setSubData(modifiedBytes.min(), this->data().slice(this->modified().min(),
-                                                               this->modified().max()));
-    #endif
+    if(_arena) {
+        /* The data stay in place until the arena uploads them, as the CPU
+           storage is reallocated only together with the allocation, which
+           discards the queued upload */
+        _arena->queueUpload(_allocation, modifiedBytes.min(),
+            this->data().slice(this->modified().min(), this->modified().max()));
+    } else {
+        #ifndef MAGNUM_TARGET_WEBGL
+        const auto bufferData = Containers::arrayCast<InstanceData>(_buffer.map(modifiedBytes.min(), modifiedBytes.size(), GL::Buffer::MapFlag::Write|GL::Buffer::MapFlag::InvalidateRange));
+        std::uninitialized_copy(this->data() + std::size_t{this->modified().min()},
+                                this->data() + std::size_t{this->modified().max()}, bufferData.begin());
+        _buffer.unmap();
+        #else
+        _buffer.setSubData(modifiedBytes.min(), this->data().slice(this->modified().min(),
+                                                                   this->modified().max()));
+        #endif
+    }
 
     /* Reset modified range */
     this->resetModified();
@@ -148,6 +148,19 @@ template<class VertexData> class BasicLayer {
          */
         Containers::ArrayView<VertexData> modifyElement(std::size_t id);
 
+        /**
+         * @brief Modify part of an element
+         * @param id            Element ID
+         * @param offset        Offset into the element data
+         * @param size          Size of the modified part
+         *
+         * Like @ref modifyElement(std::size_t), but marks only the returned
+         * subrange as modified, reducing the amount of data uploaded in the
+         * next update. Expects that @p offset and @p size fit into the
+         * element.
+         */
+        Containers::ArrayView<VertexData> modifyElement(std::size_t id, std::size_t offset, std::size_t size);
+
         /**
          * @brief Element size
          * @param id            Element ID
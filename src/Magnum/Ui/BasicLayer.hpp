@@ -77,6 +77,14 @@ template<class VertexData> Containers::ArrayView<VertexData> BasicLayer<VertexDa
     return {_data + _elementOffset[id], elementSize(id)};
 }
 
+template<class VertexData> Containers::ArrayView<VertexData> BasicLayer<VertexData>::modifyElement(const std::size_t id, const std::size_t offset, const std::size_t size) {
+    CORRADE_ASSERT(id < _size, "Ui::BasicLayer::modifyElement(): ID out of range", {});
+    CORRADE_ASSERT(offset + size <= elementSize(id), "Ui::BasicLayer::modifyElement(): range" << offset << "+" << size << "out of bounds for an element of size" << elementSize(id), {});
+
+    _modified = Math::join(_modified, Math::Range1D<std::size_t>::fromSize(_elementOffset[id] + offset, size));
+    return {_data + _elementOffset[id] + offset, size};
+}
+
 template<class VertexData> std::size_t BasicLayer<VertexData>::elementSize(const std::size_t id) const {
     CORRADE_ASSERT(id < _size, "Ui::BasicLayer::elementSize(): ID out of range", {});
 
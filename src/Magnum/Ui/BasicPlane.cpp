@@ -26,9 +26,20 @@
 #include "BasicPlane.h"
 
 #include <Corrade/Containers/EnumSet.hpp>
+#include <Magnum/GL/AbstractFramebuffer.h>
+#ifdef MAGNUM_TARGET_GLES2
+#include <Magnum/GL/OpenGL.h>
+#include <Magnum/GL/Renderer.h>
+#endif
+#include <Magnum/GL/Sampler.h>
+#include <Magnum/GL/TextureFormat.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Matrix3.h>
 
 #include "Magnum/Ui/Widget.h"
 #include "Magnum/Ui/BasicUserInterface.h"
+#include "Magnum/Ui/Implementation/PlaneCache.h"
 #include "Anchor.h"
 
 namespace Magnum { namespace Ui {
@@ -59,6 +70,87 @@ AbstractPlane::AbstractPlane(AbstractUserInterface& ui, const Anchor& anchor, co
 
 AbstractPlane::~AbstractPlane() = default;
 
+void AbstractPlane::setTransformation(const Matrix3& transformation) {
+    CORRADE_ASSERT(transformation.determinant() != 0.0f,
+        "Ui::AbstractPlane::setTransformation(): the matrix is not invertible:" << Debug::newline << transformation, );
+
+    _transformation = transformation;
+    _inverseTransformation = transformation.inverted();
+
+    /* The cache has the transformation baked in */
+    invalidateCache();
+}
+
+void AbstractPlane::setCached(const bool cached) {
+    if(cached == isCached()) return;
+
+    if(cached) {
+        _cache.reset(new Implementation::PlaneCache);
+        _cacheDirty = true;
+    } else _cache = nullptr;
+}
+
+bool AbstractPlane::beginCacheUpdate(Matrix3& transformationProjectionMatrix) {
+    /* Match the pixel density of the framebuffer the UI is drawn into */
+    const Vector2i viewportSize = ui().framebuffer().viewport().size();
+    const Vector2i size = Math::max(Vector2i{Math::ceil(_rect.size()*Vector2{viewportSize}/ui().size())}, Vector2i{1});
+
+    /* (Re)create the render target if the plane got resized or it's the
+       first draw */
+    if(size != _cache->size) {
+        _cache->size = size;
+        _cache->texture = GL::Texture2D{};
+        _cache->texture
+            .setMinificationFilter(GL::SamplerFilter::Linear)
+            .setMagnificationFilter(GL::SamplerFilter::Linear)
+            .setWrapping(GL::SamplerWrapping::ClampToEdge)
+            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+            .setStorage(1, GL::TextureFormat::RGBA8, size);
+            #else
+            .setStorage(1, GL::TextureFormat::RGBA, size);
+            #endif
+        _cache->framebuffer = GL::Framebuffer{Range2Di{{}, size}};
+        _cache->framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, _cache->texture, 0);
+        _cacheDirty = true;
+    }
+
+    if(!_cacheDirty) return false;
+
+    #ifndef MAGNUM_TARGET_GLES2
+    _cache->framebuffer
+        .clearColor(0, Color4{})
+        .bind();
+    #else
+    /* Per-attachment clear isn't available on ES2 and WebGL 1, go through
+       the global clear color instead and restore it after so the
+       application clear isn't affected */
+    Float clearColor[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+    GL::Renderer::setClearColor(Color4{});
+    _cache->framebuffer
+        .clear(GL::FramebufferClear::Color)
+        .bind();
+    GL::Renderer::setClearColor(Color4::from(clearColor));
+    #endif
+
+    /* Layers are positioned relative to the plane origin, so the cache
+       covers just the plane rect */
+    transformationProjectionMatrix = Matrix3::scaling(2.0f/_rect.size())*Matrix3::translation(-_rect.size()/2);
+    _cacheDirty = false;
+    return true;
+}
+
+void AbstractPlane::drawCache(const Matrix3& projectionMatrix, const bool updated) {
+    /* Binding through the framebuffer object keeps the GL state tracker in
+       sync and restores the viewport as well */
+    if(updated) ui().framebuffer().bind();
+
+    Implementation::PlaneCompositor& compositor = ui().planeCompositor();
+    compositor.shader.bindTexture(_cache->texture)
+        .setTransformationProjectionMatrix(projectionMatrix*Matrix3::translation(_rect.min())*Matrix3::scaling(_rect.size()))
+        .draw(compositor.quad);
+}
+
 AbstractPlane* AbstractPlane::previousActivePlane() {
     return const_cast<AbstractPlane*>(const_cast<const AbstractPlane&>(*this).previousActivePlane());
 }
@@ -106,9 +198,12 @@ void AbstractPlane::removeWidget(const std::size_t index) {
     _widgets[index].widget = nullptr;
 }
 
-Widget* AbstractPlane::handleEvent(const Vector2& position) {
+Widget* AbstractPlane::handleEvent(const Vector2& planePosition) {
     Widget* currentHoveredWidget = nullptr;
 
+    /* Widget rects are in untransformed coordinates */
+    const Vector2 position = _inverseTransformation.transformPoint(planePosition);
+
     /* Cursor stayed on the same widget */
     if(_lastHoveredWidget && _lastHoveredWidget->_rect.contains(position) && !(_lastHoveredWidget->_flags & WidgetFlag::Hidden))
         currentHoveredWidget = _lastHoveredWidget;
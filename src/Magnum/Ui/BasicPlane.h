@@ -32,7 +32,9 @@
 #include <tuple>
 #include <vector>
 #include <Corrade/Containers/LinkedList.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Magnum/Magnum.h>
+#include <Magnum/Math/Matrix3.h>
 #include <Magnum/Math/Range.h>
 
 #include "Magnum/Ui/Ui.h"
@@ -40,6 +42,10 @@
 
 namespace Magnum { namespace Ui {
 
+namespace Implementation {
+    struct PlaneCache;
+}
+
 /**
 @brief Plane flag
 
@@ -110,6 +116,30 @@ class MAGNUM_UI_EXPORT AbstractPlane: private Containers::LinkedListItem<Abstrac
          */
         Vector2 margin() const { return _margin; }
 
+        /**
+         * @brief Transformation
+         *
+         * @see @ref setTransformation()
+         */
+        Matrix3 transformation() const { return _transformation; }
+
+        /**
+         * @brief Set transformation
+         *
+         * Applied to the plane contents relative to the bottom left corner of
+         * @ref rect() when drawing, for example
+         * @cpp Matrix3::translation(offset)*Matrix3::scaling(Vector2{zoom}) @ce
+         * for zooming. Cheaper than regenerating the layer data with
+         * different sizes, as only the matrix used for drawing changes.
+         * Event positions are transformed with the inverse, so events reach
+         * the widgets where they're drawn. Contents outside of @ref rect()
+         * are drawn but don't receive events, contents of a cached plane
+         * are clipped by @ref rect(). Expects that the matrix is invertible,
+         * identity by default.
+         * @see @ref setCached()
+         */
+        void setTransformation(const Matrix3& transformation);
+
         /**
          * @brief Flags
          *
@@ -156,6 +186,45 @@ class MAGNUM_UI_EXPORT AbstractPlane: private Containers::LinkedListItem<Abstrac
          */
         void hide();
 
+        /**
+         * @brief Whether the plane contents are cached
+         *
+         * @see @ref setCached()
+         */
+        bool isCached() const { return _cache != nullptr; }
+
+        /**
+         * @brief Enable or disable caching of the plane contents
+         *
+         * If enabled, the plane layers are drawn into an offscreen texture
+         * only when they change and otherwise the texture is drawn with a
+         * single quad, which saves a lot of work for complex planes that are
+         * mostly static. The texture matches the pixel density of
+         * @ref AbstractUserInterface::framebuffer(), which gets bound again
+         * after the texture is updated, and contents outside of
+         * @ref rect() are clipped. The layers are expected to be drawn with
+         * premultiplied alpha blending, same as without the cache. Disabled
+         * by default.
+         *
+         * Changes to the layers are detected from
+         * @ref BasicLayer::modified() "Basic*Layer::modified()" during
+         * @ref BasicPlane::update(), for other changes call
+         * @ref invalidateCache().
+         */
+        void setCached(bool cached);
+
+        /**
+         * @brief Invalidate the cached contents
+         *
+         * Makes the plane draw its layers into the cache again the next time
+         * it's drawn. Needed only if the plane appearance changes in a way
+         * that isn't reflected in the layer data, for example when shader
+         * uniforms change. No-op if caching is not enabled.
+         * @see @ref setCached(),
+         *      @ref AbstractUserInterface::invalidatePlaneCaches()
+         */
+        void invalidateCache() { _cacheDirty = true; }
+
     protected:
         ~AbstractPlane();
 
@@ -165,6 +234,7 @@ class MAGNUM_UI_EXPORT AbstractPlane: private Containers::LinkedListItem<Abstrac
         friend Containers::LinkedListItem<AbstractPlane, AbstractUserInterface>;
         friend AbstractUserInterface;
         friend Widget;
+        template<class ...> friend class BasicPlane;
         #endif
 
         /* MSVC 2015 doesn't like std::vector of undefined type so I have to
@@ -184,6 +254,15 @@ class MAGNUM_UI_EXPORT AbstractPlane: private Containers::LinkedListItem<Abstrac
         bool handlePressEvent(const Vector2& position);
         bool handleReleaseEvent(const Vector2& position);
 
+        /* Used by BasicPlane::draw(). If the cache is invalid, binds the
+           cache framebuffer, replaces the matrix with one for drawing into it
+           and returns true. Otherwise returns false and the layers don't need
+           to be drawn. */
+        bool beginCacheUpdate(Matrix3& transformationProjectionMatrix);
+        /* Switches back to the original framebuffer if the cache got updated
+           and draws the cached contents */
+        void drawCache(const Matrix3& projectionMatrix, bool updated);
+
         Range2D _rect, _padding;
         Vector2 _margin;
         std::vector<WidgetReference> _widgets;
@@ -191,6 +270,9 @@ class MAGNUM_UI_EXPORT AbstractPlane: private Containers::LinkedListItem<Abstrac
         Widget *_lastHoveredWidget = nullptr,
             *_lastActiveWidget = nullptr;
         PlaneFlags _flags;
+        Matrix3 _transformation, _inverseTransformation;
+        Containers::Pointer<Implementation::PlaneCache> _cache;
+        bool _cacheDirty = false;
 };
 
 /**
@@ -57,12 +57,24 @@ template<class ...Layers> void BasicPlane<Layers...>::update() {
 }
 
 template<class ...Layers> template<std::size_t i> void BasicPlane<Layers...>::updateInternal(std::integral_constant<std::size_t, i>) {
+    /* Has to be checked before the update resets the modified range */
+    if(std::get<i>(_layers).modified().size()) invalidateCache();
     std::get<i>(_layers).update();
     updateInternal(std::integral_constant<std::size_t, i + 1>{});
 }
 
 template<class ...Layers> void BasicPlane<Layers...>::draw(const Matrix3& projectionMatrix, const Containers::StaticArray<sizeof...(Layers), Containers::Reference<AbstractUiShader>>& shaders) {
-    drawInternal(projectionMatrix*Matrix3::translation(rect().min()), shaders, std::integral_constant<std::size_t, 0>{});
+    Matrix3 transformationProjectionMatrix = projectionMatrix*Matrix3::translation(rect().min());
+    if(!isCached()) {
+        drawInternal(transformationProjectionMatrix*transformation(), shaders, std::integral_constant<std::size_t, 0>{});
+        return;
+    }
+
+    /* Draw the layers only if the cache got invalidated, otherwise just
+       composite the cached texture */
+    const bool updated = beginCacheUpdate(transformationProjectionMatrix);
+    if(updated) drawInternal(transformationProjectionMatrix*transformation(), shaders, std::integral_constant<std::size_t, 0>{});
+    drawCache(projectionMatrix, updated);
 }
 
 template<class ...Layers> template<std::size_t i> void BasicPlane<Layers...>::drawInternal(const Matrix3& transformationProjectionMatrix, const Containers::StaticArray<sizeof...(Layers), Containers::Reference<AbstractUiShader>>& shaders, std::integral_constant<std::size_t, i>) {
@@ -25,16 +25,46 @@
 
 #include "BasicUserInterface.hpp"
 
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/Math/Range.h>
 
 #include "Magnum/Ui/BasicPlane.h"
+#include "Magnum/Ui/Implementation/PlaneCache.h"
 
 namespace Magnum { namespace Ui {
 
-AbstractUserInterface::AbstractUserInterface(const Vector2& size, const Vector2i& windowSize): _size{size}, _coordinateScaling{size/Vector2{windowSize}} {}
+namespace Implementation {
+
+PlaneCompositor::PlaneCompositor() {
+    /* Unit square, scaled to the plane rect in AbstractPlane::drawCache() */
+    const Vector2 positions[]{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {0.0f, 1.0f},
+        {1.0f, 1.0f}
+    };
+    quad.setPrimitive(GL::MeshPrimitive::TriangleStrip)
+        .setCount(4)
+        .addVertexBuffer(GL::Buffer{positions}, 0, CompositeShader::Position{});
+}
+
+}
+
+AbstractUserInterface::AbstractUserInterface(const Vector2& size, const Vector2i& windowSize): _size{size}, _coordinateScaling{size/Vector2{windowSize}}, _framebuffer{&GL::defaultFramebuffer} {}
 
 AbstractUserInterface::~AbstractUserInterface() = default;
 
+void AbstractUserInterface::invalidatePlaneCaches() {
+    for(AbstractPlane& plane: *this) plane.invalidateCache();
+}
+
+Implementation::PlaneCompositor& AbstractUserInterface::planeCompositor() {
+    if(!_planeCompositor)
+        _planeCompositor.reset(new Implementation::PlaneCompositor);
+    return *_planeCompositor;
+}
+
 AbstractPlane* AbstractUserInterface::activePlane() {
     return const_cast<AbstractPlane*>(const_cast<const AbstractUserInterface&>(*this).activePlane());
 }
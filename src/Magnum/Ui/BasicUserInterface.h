@@ -30,14 +30,21 @@
  */
 
 #include <Corrade/Containers/LinkedList.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Magnum/Magnum.h>
+#include <Magnum/GL/GL.h>
 #include <Magnum/Math/Vector2.h>
 
 #include "Magnum/Ui/Ui.h"
+#include "Magnum/Ui/UpdateQueue.h"
 #include "Magnum/Ui/visibility.h"
 
 namespace Magnum { namespace Ui {
 
+namespace Implementation {
+    struct PlaneCompositor;
+}
+
 /**
 @brief Non-templated base for user interfaces
 
@@ -70,6 +77,45 @@ class MAGNUM_UI_EXPORT AbstractUserInterface: private Containers::LinkedList<Abs
         AbstractPlane* activePlane();
         const AbstractPlane* activePlane() const; /**< @overload */
 
+        /**
+         * @brief Cross-thread widget update queue
+         *
+         * Widget updates queued from any thread get applied at the
+         * beginning of @ref BasicUserInterface::update().
+         */
+        UpdateQueue& updateQueue() { return _updateQueue; }
+
+        /**
+         * @brief Invalidate cached contents of all planes
+         *
+         * Calls @ref AbstractPlane::invalidateCache() on all planes in the
+         * interface. Meant to be called when something that affects the
+         * appearance of all planes changes, such as shader uniforms.
+         */
+        void invalidatePlaneCaches();
+
+        /**
+         * @brief Framebuffer the interface is drawn into
+         *
+         * @see @ref setFramebuffer()
+         */
+        GL::AbstractFramebuffer& framebuffer() { return *_framebuffer; }
+
+        /**
+         * @brief Set the framebuffer the interface is drawn into
+         *
+         * Cached planes take the pixel density of their offscreen textures
+         * from viewport of this framebuffer and bind it again after updating
+         * their contents, see @ref AbstractPlane::setCached(). The
+         * framebuffer is expected to be bound and have its viewport set when
+         * the interface is drawn and to stay alive for the lifetime of the
+         * interface or until another framebuffer is set. Default is
+         * @ref GL::defaultFramebuffer.
+         */
+        void setFramebuffer(GL::AbstractFramebuffer& framebuffer) {
+            _framebuffer = &framebuffer;
+        }
+
         /** @brief Handle application mouse move event */
         bool handleMoveEvent(const Vector2i& screenPosition);
 
@@ -99,14 +145,21 @@ class MAGNUM_UI_EXPORT AbstractUserInterface: private Containers::LinkedList<Abs
         friend Containers::LinkedListItem<AbstractPlane, AbstractUserInterface>;
         friend AbstractPlane;
         template<class ...> friend class BasicUserInterface;
+        /* To delete planes before the buffer arena they use */
+        friend UserInterface;
         #endif
 
         ~AbstractUserInterface();
 
         std::pair<Vector2, AbstractPlane*> handleEvent(const Vector2i& screenPosition);
 
+        Implementation::PlaneCompositor& planeCompositor();
+
         Vector2 _size;
         Vector2 _coordinateScaling;
+        UpdateQueue _updateQueue;
+        GL::AbstractFramebuffer* _framebuffer;
+        Containers::Pointer<Implementation::PlaneCompositor> _planeCompositor;
 };
 
 /**
@@ -133,9 +186,10 @@ template<class ...Layers> class BasicUserInterface: public AbstractUserInterface
         /**
          * @brief Update the interface
          *
-         * Calls @ref BasicPlane::update() on all planes in the interface.
-         * Called automatically at the beginning of @ref draw(), but scheduling
-         * it explicitly in a different place might reduce the need for CPU/GPU
+         * Applies widget updates queued in @ref updateQueue() and then calls
+         * @ref BasicPlane::update() on all planes in the interface. Called
+         * automatically at the beginning of @ref draw(), but scheduling it
+         * explicitly in a different place might reduce the need for CPU/GPU
          * synchronization.
          */
         void update();
@@ -36,6 +36,10 @@ namespace Magnum { namespace Ui {
 template<class ...Layers> BasicUserInterface<Layers...>::~BasicUserInterface() {}
 
 template<class ...Layers> void BasicUserInterface<Layers...>::update() {
+    /* Apply updates from other threads first so they get uploaded in the
+       same frame */
+    _updateQueue.apply();
+
     /** @todo Update only non-hidden to save cycles? */
     for(AbstractPlane& plane: *this) static_cast<BasicPlane<Layers...>&>(plane).update();
 }
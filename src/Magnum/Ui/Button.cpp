@@ -32,6 +32,7 @@
 #include "Magnum/Ui/Plane.h"
 #include "Magnum/Ui/UserInterface.h"
 #include "Magnum/Ui/Implementation/TextUtility.h"
+#include "Magnum/Ui/Implementation/WidgetState.h"
 
 namespace Magnum { namespace Ui {
 
@@ -75,14 +76,17 @@ auto Button::tapped() -> Signal {
 }
 
 void Button::update() {
-    auto& plane = static_cast<Plane&>(this->plane());
-
-    plane._foregroundLayer.modifyElement(_foregroundElementId).colorIndex =
-        Implementation::foregroundColorIndex(Type::Button, _style,
-        _style == Style::Flat ? WidgetFlag::Hidden : flags() & ~WidgetFlag::Active);
+    Implementation::WidgetStateUpdates updates;
+    updateState(updates);
+    Implementation::applyWidgetStateUpdates(static_cast<Plane&>(plane()), updates);
+}
 
-    for(Implementation::TextVertex& v: plane._textLayer.modifyElement(_textElementId))
-        v.colorIndex = Implementation::textColorIndex(Type::Button, _style, flags() & ~WidgetFlag::Active);
+void Button::updateState(Implementation::WidgetStateUpdates& updates) {
+    updates.add(Implementation::StateLayer::Foreground, Type::Button, _style,
+        _style == Style::Flat ? WidgetFlag::Hidden : flags() & ~WidgetFlag::Active,
+        _foregroundElementId);
+    updates.add(Implementation::StateLayer::Text, Type::Button, _style,
+        flags() & ~WidgetFlag::Active, _textElementId);
 }
 
 bool Button::hoverEvent() {
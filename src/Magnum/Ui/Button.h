@@ -105,6 +105,7 @@ class MAGNUM_UI_EXPORT Button: public Widget, public Interconnect::Emitter {
 
     private:
         void MAGNUM_UI_LOCAL update() override;
+        void MAGNUM_UI_LOCAL updateState(Implementation::WidgetStateUpdates& updates) override;
 
         bool MAGNUM_UI_LOCAL hoverEvent() override;
         bool MAGNUM_UI_LOCAL pressEvent() override;
@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FontStack.h"
+
+#include <tuple>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Unicode.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Text/AbstractGlyphCache.h>
+
+namespace Magnum { namespace Ui {
+
+namespace {
+
+/* Glyphs of the primary font keep their IDs, fallback glyphs have the font
+   index in the upper bits */
+UnsignedInt cacheGlyphId(const std::size_t font, const UnsignedInt glyph) {
+    return font ? UnsignedInt(font << 16)|glyph : glyph;
+}
+
+}
+
+/* Makes a font see just a part of the glyph cache, so it can be filled
+   multiple times and by multiple fonts. Fonts insert glyphs with their own
+   IDs here, which get copied to the real cache after. */
+class FontStack::GlyphCacheRegion: public Text::AbstractGlyphCache {
+    public:
+        explicit GlyphCacheRegion(Text::AbstractGlyphCache& cache, const Range2Di& region): Text::AbstractGlyphCache{region.size(), cache.padding()}, _cache(cache), _offset{region.min()} {}
+
+    private:
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+
+        void doSetImage(const Vector2i& offset, const ImageView2D& image) override {
+            _cache.setImage(_offset + offset, image);
+        }
+
+        Text::AbstractGlyphCache& _cache;
+        Vector2i _offset;
+};
+
+class FontStack::Layouter: public Text::AbstractLayouter {
+    public:
+        explicit Layouter(const Text::AbstractGlyphCache& cache, const Float scale, std::vector<Glyph>&& glyphs): Text::AbstractLayouter{UnsignedInt(glyphs.size())}, _cache(cache), _scale{scale}, _glyphs{std::move(glyphs)} {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(const UnsignedInt i) override {
+            /* Position of the texture in the resulting glyph, texture
+               coordinates */
+            Vector2i position;
+            Range2Di rectangle;
+            std::tie(position, rectangle) = _cache[_glyphs[i].id];
+
+            /* Normalized texture coordinates */
+            const Range2D textureCoordinates = Range2D{rectangle}.scaled(1.0f/Vector2{_cache.textureSize()});
+
+            /* Quad rectangle, computed from texture rectangle, denormalized
+               to requested text size */
+            const Range2D quadRectangle = Range2D{Range2Di::fromSize(position, rectangle.size())}.scaled(Vector2{_scale});
+
+            return std::make_tuple(quadRectangle, textureCoordinates, Vector2::xAxis(_glyphs[i].advance*_scale));
+        }
+
+        const Text::AbstractGlyphCache& _cache;
+        Float _scale;
+        std::vector<Glyph> _glyphs;
+};
+
+FontStack::FontStack(Containers::Pointer<Text::AbstractFont>&& primary, Text::AbstractGlyphCache& cache): _cache(cache) {
+    _fonts.push_back(Font{std::move(primary), {}, false});
+}
+
+FontStack::~FontStack() = default;
+
+bool FontStack::isFallbackOpened(const std::size_t id) const {
+    CORRADE_ASSERT(id < fallbackCount(),
+        "Ui::FontStack::isFallbackOpened(): index" << id << "out of range for" << fallbackCount() << "fallbacks", {});
+    return _fonts[id + 1].font->isOpened();
+}
+
+FontStack& FontStack::addFallbackFont(Containers::Pointer<Text::AbstractFont>&& font, const std::string& filename) {
+    _fonts.push_back(Font{std::move(font), filename, false});
+    return *this;
+}
+
+Text::FontFeatures FontStack::doFeatures() const { return Text::FontFeature::OpenData; }
+
+bool FontStack::doIsOpened() const { return _fonts.front().font->isOpened(); }
+
+auto FontStack::doOpenData(const Containers::ArrayView<const char> data, const Float size) -> Properties {
+    Text::AbstractFont& font = primary();
+    if(!font.openData(data, size)) return {};
+
+    return {font.size(), font.ascent(), font.descent(), font.lineHeight()};
+}
+
+void FontStack::doClose() {
+    for(Font& font: _fonts) {
+        font.font->close();
+        font.failed = false;
+    }
+    _glyphs.clear();
+}
+
+UnsignedInt FontStack::doGlyphId(const char32_t character) {
+    return primary().glyphId(character);
+}
+
+Vector2 FontStack::doGlyphAdvance(const UnsignedInt glyph) {
+    return primary().glyphAdvance(glyph);
+}
+
+void FontStack::doFillGlyphCache(Text::AbstractGlyphCache& cache, const std::u32string& characters) {
+    CORRADE_ASSERT(&cache == &_cache,
+        "Ui::FontStack::fillGlyphCache(): can fill only the cache passed in the constructor", );
+    addGlyphs(characters);
+}
+
+Containers::Pointer<Text::AbstractLayouter> FontStack::doLayout(const Text::AbstractGlyphCache& cache, const Float size, const std::string& text) {
+    CORRADE_ASSERT(&cache == &_cache,
+        "Ui::FontStack::layout(): can use only the cache passed in the constructor", {});
+
+    const std::u32string characters = Utility::Unicode::utf32(text);
+    addGlyphs(characters);
+
+    std::vector<Glyph> glyphs;
+    glyphs.reserve(characters.size());
+    for(const char32_t character: characters)
+        glyphs.push_back(_glyphs.at(character));
+
+    return Containers::Pointer<Text::AbstractLayouter>{new Layouter{_cache, size/this->size(), std::move(glyphs)}};
+}
+
+void FontStack::addGlyphs(const std::u32string& characters) {
+    /* Pick a font for each character not encountered yet. Characters not in
+       any font stay with the primary font and its invalid glyph. */
+    std::vector<std::string> missing(_fonts.size());
+    for(const char32_t character: characters) {
+        if(_glyphs.find(character) != _glyphs.end()) continue;
+
+        std::size_t fontId = 0;
+        UnsignedInt glyphId = 0;
+        for(std::size_t i = 0; i != _fonts.size(); ++i) {
+            Font& font = _fonts[i];
+
+            /* Open the fallback on first use, at the same size as the
+               primary font so the glyphs have the same scale */
+            if(!font.font->isOpened()) {
+                if(!i || font.failed) continue;
+                if(!font.font->openFile(font.filename, size())) {
+                    Warning{} << "Ui::FontStack: can't open fallback font" << font.filename;
+                    font.failed = true;
+                    continue;
+                }
+            }
+
+            if((glyphId = font.font->glyphId(character))) {
+                fontId = i;
+                break;
+            }
+        }
+
+        _glyphs.emplace(character, Glyph{cacheGlyphId(fontId, glyphId), _fonts[fontId].font->glyphAdvance(glyphId).x()});
+
+        if(!glyphId) continue;
+        char utf8[4];
+        missing[fontId].append(utf8, Utility::Unicode::utf8(character, utf8));
+    }
+
+    /* Fill each font to a new strip of the cache */
+    for(std::size_t i = 0; i != _fonts.size(); ++i) {
+        if(missing[i].empty()) continue;
+
+        const Vector2i size = _cache.textureSize();
+        if(_cacheFilled >= size.y()) {
+            Warning{} << "Ui::FontStack: glyph cache is full, can't add glyphs for" << missing[i];
+            continue;
+        }
+
+        GlyphCacheRegion region{_cache, {{0, _cacheFilled}, size}};
+        _fonts[i].font->fillGlyphCache(region, missing[i]);
+
+        Int filled = 0;
+        for(const auto& glyph: region) {
+            /* The invalid glyph is taken only from the primary font and only
+               if the font rendered it */
+            if(!glyph.first && (i || glyph.second.second.size().isZero()))
+                continue;
+
+            const Range2Di rectangle = glyph.second.second.translated({0, _cacheFilled});
+            _cache.insert(cacheGlyphId(i, glyph.first), glyph.second.first, rectangle);
+            filled = Math::max(filled, glyph.second.second.max().y());
+        }
+        _cacheFilled += filled + _cache.padding().y();
+    }
+}
+
+}}
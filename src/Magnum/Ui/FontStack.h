@@ -0,0 +1,140 @@
+#ifndef Magnum_Ui_FontStack_h
+#define Magnum_Ui_FontStack_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Ui::FontStack
+ */
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/Text/AbstractFont.h>
+
+#include "Magnum/Ui/Ui.h"
+#include "Magnum/Ui/visibility.h"
+
+namespace Magnum { namespace Ui {
+
+/**
+@brief Font with fallbacks
+
+Wraps a primary font and a list of fallback fonts. Text layout picks the first
+font that contains given character, with characters not present in any font
+taken from the primary font. Glyphs of all fonts are put into the same glyph
+cache, so text using multiple fonts can still be drawn in a single call.
+
+Opening the stack opens the primary font. Fallback fonts are opened only when
+a character not present in the fonts before them is encountered for the first
+time. Glyphs, including glyphs of the primary font, are added to the glyph
+cache on demand as well, so @ref fillGlyphCache() is not required to be
+called upfront. The glyph cache is filled in horizontal strips, each fill
+taking a new strip. If there's no space left, the glyphs render as the
+invalid glyph.
+
+The glyph cache is passed in the constructor and only layouting with the same
+glyph cache is allowed. Glyphs of the primary font keep their IDs in the
+cache, glyphs of fallback fonts have the fallback index plus one in the upper
+16 bits.
+@experimental
+*/
+class MAGNUM_UI_EXPORT FontStack: public Text::AbstractFont {
+    public:
+        /**
+         * @brief Constructor
+         * @param primary   Primary font, not opened yet
+         * @param cache     Glyph cache to put glyphs of all fonts to. Expected
+         *      to be empty and to outlive the instance.
+         */
+        explicit FontStack(Containers::Pointer<Text::AbstractFont>&& primary, Text::AbstractGlyphCache& cache);
+
+        ~FontStack();
+
+        /** @brief Primary font */
+        Text::AbstractFont& primary() { return *_fonts.front().font; }
+
+        /** @brief Fallback font count */
+        std::size_t fallbackCount() const { return _fonts.size() - 1; }
+
+        /**
+         * @brief Whether given fallback font is opened
+         *
+         * Expects that @p id is less than @ref fallbackCount().
+         */
+        bool isFallbackOpened(std::size_t id) const;
+
+        /**
+         * @brief Add a fallback font
+         * @param font      Font, not opened yet
+         * @param filename  File to open the font from
+         * @return Reference to self (for method chaining)
+         *
+         * The font is opened from @p filename at the size of the primary
+         * font only once a character not present in the fonts before it is
+         * encountered. If the opening fails, the font is skipped.
+         */
+        FontStack& addFallbackFont(Containers::Pointer<Text::AbstractFont>&& font, const std::string& filename);
+
+    private:
+        struct Font {
+            Containers::Pointer<Text::AbstractFont> font;
+            std::string filename;
+            bool failed;
+        };
+
+        /* Glyph in the cache used for a character */
+        struct Glyph {
+            UnsignedInt id;
+            Float advance;
+        };
+
+        class Layouter;
+        class GlyphCacheRegion;
+
+        Text::FontFeatures MAGNUM_UI_LOCAL doFeatures() const override;
+        bool MAGNUM_UI_LOCAL doIsOpened() const override;
+        Properties MAGNUM_UI_LOCAL doOpenData(Containers::ArrayView<const char> data, Float size) override;
+        void MAGNUM_UI_LOCAL doClose() override;
+        UnsignedInt MAGNUM_UI_LOCAL doGlyphId(char32_t character) override;
+        Vector2 MAGNUM_UI_LOCAL doGlyphAdvance(UnsignedInt glyph) override;
+        void MAGNUM_UI_LOCAL doFillGlyphCache(Text::AbstractGlyphCache& cache, const std::u32string& characters) override;
+        Containers::Pointer<Text::AbstractLayouter> MAGNUM_UI_LOCAL doLayout(const Text::AbstractGlyphCache& cache, Float size, const std::string& text) override;
+
+        /* Finds a font for all characters that weren't encountered yet and
+           adds their glyphs to the cache */
+        void MAGNUM_UI_LOCAL addGlyphs(const std::u32string& characters);
+
+        Text::AbstractGlyphCache& _cache;
+        std::vector<Font> _fonts;
+        std::unordered_map<char32_t, Glyph> _glyphs;
+        /* Top of the cache area not used by any glyph yet */
+        Int _cacheFilled{};
+};
+
+}}
+
+#endif
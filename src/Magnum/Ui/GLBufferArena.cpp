@@ -0,0 +1,173 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GLBufferArena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Range.h>
+
+namespace Magnum { namespace Ui {
+
+struct GLBufferArena::Block {
+    explicit Block(const std::size_t size, const GL::BufferUsage usage): buffer{GL::Buffer::TargetHint::Array}, size{size} {
+        buffer.setData({nullptr, size}, usage);
+        free.push_back({0, size});
+    }
+
+    GL::Buffer buffer;
+    std::size_t size;
+    /* Sorted and non-overlapping, neighbors are merged on free */
+    std::vector<Math::Range1D<std::size_t>> free;
+};
+
+struct GLBufferArena::Upload {
+    UnsignedInt buffer;
+    std::size_t offset;
+    Containers::ArrayView<const char> data;
+};
+
+GLBufferArena::GLBufferArena(const std::size_t bufferSize, const GL::BufferUsage usage): _bufferSize{bufferSize}, _usage{usage} {}
+
+GLBufferArena::~GLBufferArena() = default;
+
+std::size_t GLBufferArena::capacity() const {
+    std::size_t size = 0;
+    for(const Containers::Pointer<Block>& block: _buffers) size += block->size;
+    return size;
+}
+
+GL::Buffer& GLBufferArena::buffer(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _buffers.size(),
+        "Ui::GLBufferArena::buffer(): index" << id << "out of range for" << _buffers.size() << "buffers", _buffers[0]->buffer);
+    return _buffers[id]->buffer;
+}
+
+auto GLBufferArena::allocate(std::size_t size) -> Allocation {
+    /* Zero-sized allocations get the smallest possible size so they have a
+       buffer and an offset as well */
+    size = Math::max(std::size_t(Alignment), (size + Alignment - 1)/Alignment*Alignment);
+
+    /* First fit */
+    for(std::size_t i = 0; i != _buffers.size(); ++i) {
+        for(auto it = _buffers[i]->free.begin(); it != _buffers[i]->free.end(); ++it) {
+            if(it->size() < size) continue;
+
+            const Allocation allocation{UnsignedInt(i), it->min(), size};
+            if(it->size() == size) _buffers[i]->free.erase(it);
+            else it->min() += size;
+            return allocation;
+        }
+    }
+
+    /* No space left, add a new buffer */
+    _buffers.emplace_back(new Block{Math::max(_bufferSize, size), _usage});
+    Block& block = *_buffers.back();
+    if(block.size == size) block.free.clear();
+    else block.free.front().min() = size;
+    return {UnsignedInt(_buffers.size() - 1), 0, size};
+}
+
+void GLBufferArena::free(const Allocation& allocation) {
+    CORRADE_ASSERT(allocation.buffer < _buffers.size() && allocation.size,
+        "Ui::GLBufferArena::free(): invalid allocation", );
+
+    /* Discard queued uploads that would go to the freed range */
+    const Math::Range1D<std::size_t> range = Math::Range1D<std::size_t>::fromSize(allocation.offset, allocation.size);
+    _uploads.erase(std::remove_if(_uploads.begin(), _uploads.end(), [&](const Upload& upload) {
+        return upload.buffer == allocation.buffer && upload.offset >= range.min() && upload.offset < range.max();
+    }), _uploads.end());
+
+    /* Insert the range back, merging with neighbors */
+    std::vector<Math::Range1D<std::size_t>>& free = _buffers[allocation.buffer]->free;
+    auto next = std::lower_bound(free.begin(), free.end(), range, [](const Math::Range1D<std::size_t>& a, const Math::Range1D<std::size_t>& b) {
+        return a.min() < b.min();
+    });
+    CORRADE_ASSERT((next == free.end() || next->min() >= range.max()) &&
+                   (next == free.begin() || (next - 1)->max() <= range.min()),
+        "Ui::GLBufferArena::free(): allocation already freed", );
+    const bool mergePrevious = next != free.begin() && (next - 1)->max() == range.min();
+    const bool mergeNext = next != free.end() && next->min() == range.max();
+    if(mergePrevious && mergeNext) {
+        (next - 1)->max() = next->max();
+        free.erase(next);
+    } else if(mergePrevious) {
+        (next - 1)->max() = range.max();
+    } else if(mergeNext) {
+        next->min() = range.min();
+    } else free.insert(next, range);
+}
+
+void GLBufferArena::queueUpload(const Allocation& allocation, const std::size_t offset, const Containers::ArrayView<const void> data) {
+    CORRADE_ASSERT(offset + data.size() <= allocation.size,
+        "Ui::GLBufferArena::queueUpload(): expected at most" << allocation.size << "bytes but got" << data.size() << "at offset" << offset, );
+    if(data.empty()) return;
+
+    _uploads.push_back({allocation.buffer, allocation.offset + offset,
+        {static_cast<const char*>(data.data()), data.size()}});
+}
+
+void GLBufferArena::upload() {
+    if(_uploads.empty()) return;
+
+    /* Group by buffer, keeping the order for ranges queued repeatedly */
+    std::stable_sort(_uploads.begin(), _uploads.end(), [](const Upload& a, const Upload& b) {
+        return a.buffer < b.buffer;
+    });
+
+    for(auto first = _uploads.begin(); first != _uploads.end(); ) {
+        auto last = first;
+        Math::Range1D<std::size_t> range{first->offset, first->offset};
+        for(; last != _uploads.end() && last->buffer == first->buffer; ++last)
+            range = Math::join(range, Math::Range1D<std::size_t>::fromSize(last->offset, last->data.size()));
+
+        GL::Buffer& buffer = _buffers[first->buffer]->buffer;
+        #ifndef MAGNUM_TARGET_WEBGL
+        /* Not invalidating as the range can contain data that weren't
+           modified. Flushing explicitly only what was written. */
+        const Containers::ArrayView<char> data = buffer.map(range.min(), range.size(), GL::Buffer::MapFlag::Write|GL::Buffer::MapFlag::FlushExplicit);
+        CORRADE_INTERNAL_ASSERT(data);
+        for(auto it = first; it != last; ++it) {
+            std::memcpy(data + (it->offset - range.min()), it->data.data(), it->data.size());
+            buffer.flushMappedRange(it->offset - range.min(), it->data.size());
+        }
+        buffer.unmap();
+        #else
+        for(auto it = first; it != last; ++it)
+            buffer.setSubData(it->offset, it->data);
+        #endif
+
+        for(auto it = first; it != last; ++it)
+            _uploadedSize += it->data.size();
+
+        first = last;
+    }
+
+    _uploads.clear();
+}
+
+}}
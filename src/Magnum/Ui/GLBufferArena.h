@@ -0,0 +1,186 @@
+#ifndef Magnum_Ui_GLBufferArena_h
+#define Magnum_Ui_GLBufferArena_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Ui::GLBufferArena
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/GL/GL.h>
+#include <Magnum/GL/Buffer.h>
+
+#include "Magnum/Ui/Ui.h"
+#include "Magnum/Ui/visibility.h"
+
+namespace Magnum { namespace Ui {
+
+/**
+@brief Buffer arena for layer data
+
+Suballocates GPU memory for many layers from a few large buffers, so
+@ref BasicGLLayer and @ref BasicInstancedGLLayer instances constructed with an
+arena don't need a buffer each. Modified data of all layers get queued in
+their @ref BasicGLLayer::update() "update()" and then uploaded together in
+@ref upload(), mapping each buffer just once.
+
+@ref UserInterface has an arena for all its planes, available through
+@ref UserInterface::bufferArena().
+@experimental
+*/
+class MAGNUM_UI_EXPORT GLBufferArena {
+    public:
+        /**
+         * @brief Allocation
+         *
+         * @see @ref allocate()
+         */
+        struct Allocation {
+            /** @brief Index of the buffer the allocation is in */
+            UnsignedInt buffer;
+
+            /** @brief Offset in the buffer, in bytes */
+            std::size_t offset;
+
+            /**
+             * @brief Size in bytes
+             *
+             * Zero for an empty allocation.
+             */
+            std::size_t size;
+        };
+
+        /** @brief Alignment of all allocations, in bytes */
+        enum: std::size_t { Alignment = 16 };
+
+        /**
+         * @brief Constructor
+         * @param bufferSize    Size of each buffer, in bytes. Allocations
+         *      larger than this get a buffer of their own.
+         * @param usage         Buffer usage
+         *
+         * No buffer is created until the first @ref allocate() call.
+         */
+        explicit GLBufferArena(std::size_t bufferSize = 1024*1024, GL::BufferUsage usage = GL::BufferUsage::StaticDraw);
+
+        /** @brief Copying is not allowed */
+        GLBufferArena(const GLBufferArena&) = delete;
+
+        /** @brief Moving is not allowed */
+        GLBufferArena(GLBufferArena&&) = delete;
+
+        ~GLBufferArena();
+
+        /** @brief Copying is not allowed */
+        GLBufferArena& operator=(const GLBufferArena&) = delete;
+
+        /** @brief Moving is not allowed */
+        GLBufferArena& operator=(GLBufferArena&&) = delete;
+
+        /** @brief Size of each buffer */
+        std::size_t bufferSize() const { return _bufferSize; }
+
+        /** @brief Count of buffers created so far */
+        std::size_t bufferCount() const { return _buffers.size(); }
+
+        /**
+         * @brief Total size of all buffers, in bytes
+         *
+         * Includes both allocated and free ranges.
+         */
+        std::size_t capacity() const;
+
+        /**
+         * @brief Total size of uploaded data, in bytes
+         *
+         * Sum of sizes of all data uploaded in @ref upload() since the arena
+         * was constructed. Uploads discarded by @ref free() are not counted.
+         * Meant for profiling.
+         */
+        std::size_t uploadedSize() const { return _uploadedSize; }
+
+        /**
+         * @brief Buffer
+         *
+         * Expects that @p id is less than @ref bufferCount().
+         */
+        GL::Buffer& buffer(UnsignedInt id);
+
+        /**
+         * @brief Allocate memory
+         *
+         * The @p size is rounded up to a multiple of @ref Alignment. Returns
+         * the first free range that is large enough, creating a new buffer
+         * if there's none.
+         */
+        Allocation allocate(std::size_t size);
+
+        /**
+         * @brief Free memory
+         *
+         * Makes the range available for other allocations and discards all
+         * uploads queued for it. Expects that @p allocation was returned
+         * from @ref allocate() and wasn't freed yet.
+         */
+        void free(const Allocation& allocation);
+
+        /**
+         * @brief Queue an upload
+         * @param allocation    Allocation to upload to
+         * @param offset        Offset in the allocation, in bytes
+         * @param data          Data to upload
+         *
+         * The data are not copied, so they're expected to stay in scope
+         * until @ref upload() or until the allocation is freed. Expects that
+         * the data fit into the allocation.
+         */
+        void queueUpload(const Allocation& allocation, std::size_t offset, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Upload all queued data
+         *
+         * Maps each buffer that has queued uploads once, covering all its
+         * queued ranges, and copies the data there. On WebGL, where buffer
+         * mapping is not available, the ranges are uploaded one by one.
+         */
+        void upload();
+
+    private:
+        struct Block;
+        struct Upload;
+
+        std::size_t _bufferSize;
+        GL::BufferUsage _usage;
+        std::vector<Containers::Pointer<Block>> _buffers;
+        std::vector<Upload> _uploads;
+        std::size_t _uploadedSize{};
+};
+
+}}
+
+#endif
@@ -0,0 +1,296 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImmediatePlane.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Text/Alignment.h>
+
+#include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/Button.h"
+#include "Magnum/Ui/Label.h"
+#include "Magnum/Ui/NumericLabel.h"
+
+namespace Magnum { namespace Ui {
+
+namespace {
+
+enum class Kind: UnsignedByte {
+    Label,
+    NumericLabel,
+    Button
+};
+
+/* Button remembering whether it was tapped, reported from
+   ImmediatePlane::button() */
+struct TrackedButton: Button {
+    explicit TrackedButton(Plane& plane, const Anchor& anchor, const std::string& text, std::size_t capacity, Style style): Button{plane, anchor, text, capacity, style} {
+        Interconnect::connect(*this, &Button::tapped, [this]() {
+            wasTapped = true;
+        });
+    }
+
+    bool wasTapped = false;
+};
+
+/* Widget together with the properties it was declared with. Widget
+   destructors are protected, so each type has its own pointer, only one of
+   them is set. */
+struct Entry {
+    Widget& widget() {
+        if(label) return *label;
+        if(numericLabel) return *numericLabel;
+        return *button;
+    }
+
+    Kind kind;
+    Anchor anchor;
+    Range2D rect;
+    Text::Alignment alignment;
+    /* Text capacity or numeric label width */
+    std::size_t capacity;
+    Int precision;
+    Style style;
+    std::string text;
+    Double value;
+    UnsignedInt frame;
+
+    Containers::Pointer<Label> label;
+    Containers::Pointer<NumericLabel> numericLabel;
+    Containers::Pointer<TrackedButton> button;
+};
+
+/* Hidden widgets are looked up by type and rectangle, the rest is checked
+   with isCompatible() */
+struct PoolKey {
+    Kind kind;
+    Range2D rect;
+};
+
+bool operator==(const PoolKey& a, const PoolKey& b) {
+    return a.kind == b.kind && a.rect == b.rect;
+}
+
+struct PoolKeyHash {
+    std::size_t operator()(const PoolKey& key) const {
+        std::size_t hash = std::size_t(key.kind);
+        for(const Float f: {key.rect.min().x(), key.rect.min().y(), key.rect.max().x(), key.rect.max().y()})
+            hash = hash*31 + std::hash<Float>{}(f);
+        return hash;
+    }
+};
+
+/* Whether an existing widget can show a declaration with given properties.
+   Numeric labels have the layout given by the width, so it has to match
+   exactly, text capacity can be larger. */
+bool isCompatible(const Entry& entry, const Kind kind, const Range2D& rect, const Text::Alignment alignment, const std::size_t capacity, const Int precision) {
+    return entry.kind == kind && entry.rect == rect &&
+        entry.alignment == alignment && entry.precision == precision &&
+        (entry.capacity == capacity || (kind != Kind::NumericLabel && entry.capacity > capacity));
+}
+
+bool isSameText(const std::string& a, const Containers::ArrayView<const char> b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), b.size()) == 0;
+}
+
+}
+
+struct ImmediatePlane::State {
+    Entry& declare(ImmediatePlane& plane, UnsignedLong id, const Anchor& anchor, Kind kind, Text::Alignment alignment, std::size_t capacity, Int precision);
+    void retire(Entry&& entry);
+
+    std::unordered_map<UnsignedLong, Entry> entries;
+    std::unordered_multimap<PoolKey, Entry, PoolKeyHash> pool;
+    /* IDs declared for the first time in this frame, get a widget in
+       endFrame() */
+    std::vector<UnsignedLong> pending;
+    UnsignedInt frame = 1;
+};
+
+Entry& ImmediatePlane::State::declare(ImmediatePlane& plane, const UnsignedLong id, const Anchor& anchor, const Kind kind, const Text::Alignment alignment, const std::size_t capacity, const Int precision) {
+    const Range2D rect = anchor.rect(plane);
+
+    auto found = entries.find(id);
+    if(found != entries.end()) {
+        Entry& entry = found->second;
+        CORRADE_ASSERT(entry.frame != frame,
+            "Ui::ImmediatePlane: widget" << id << "declared twice in the same frame", entry);
+        entry.frame = frame;
+
+        /* The widget can stay, only its contents will get updated */
+        if(isCompatible(entry, kind, rect, alignment, capacity, precision))
+            return entry;
+
+        /* Otherwise give the widget away and make the ID pending as if it
+           was declared for the first time */
+        retire(std::move(entry));
+        entries.erase(found);
+    }
+
+    Entry& entry = entries[id];
+    entry.kind = kind;
+    entry.anchor = anchor;
+    entry.rect = rect;
+    entry.alignment = alignment;
+    entry.capacity = capacity;
+    entry.precision = precision;
+    entry.style = Style::Default;
+    entry.value = 0.0;
+    entry.frame = frame;
+    pending.push_back(id);
+    return entry;
+}
+
+void ImmediatePlane::State::retire(Entry&& entry) {
+    entry.widget().hide();
+    const PoolKey key{entry.kind, entry.rect};
+    pool.emplace(key, std::move(entry));
+}
+
+ImmediatePlane::ImmediatePlane(UserInterface& ui, const Anchor& anchor, const std::size_t backgroundCapacity, const std::size_t foregroundCapacity, const std::size_t textCapacity): Plane{ui, anchor, backgroundCapacity, foregroundCapacity, textCapacity}, _state{new State} {}
+
+ImmediatePlane::~ImmediatePlane() = default;
+
+std::size_t ImmediatePlane::widgetCount() const {
+    return _state->entries.size();
+}
+
+std::size_t ImmediatePlane::pooledWidgetCount() const {
+    return _state->pool.size();
+}
+
+void ImmediatePlane::label(const UnsignedLong id, const Anchor& anchor, const Containers::ArrayView<const char> text, const Text::Alignment alignment, const std::size_t capacity, const Style style) {
+    Entry& entry = _state->declare(*this, id, anchor, Kind::Label, alignment, Math::max(capacity, text.size()), 0);
+
+    /* For pending entries only the properties are recorded, the widget gets
+       created in endFrame() */
+    if(!isSameText(entry.text, text)) {
+        entry.text.assign(text.data(), text.size());
+        if(entry.label) entry.label->setText(text);
+    }
+    if(entry.style != style) {
+        entry.style = style;
+        if(entry.label) entry.label->setStyle(style);
+    }
+}
+
+void ImmediatePlane::numericLabel(const UnsignedLong id, const Anchor& anchor, const Double value, const std::size_t width, const Int precision, const Text::Alignment alignment, const Style style) {
+    Entry& entry = _state->declare(*this, id, anchor, Kind::NumericLabel, alignment, width, precision);
+
+    if(entry.value != value) {
+        entry.value = value;
+        if(entry.numericLabel) entry.numericLabel->setValue(value);
+    }
+    if(entry.style != style) {
+        entry.style = style;
+        if(entry.numericLabel) entry.numericLabel->setStyle(style);
+    }
+}
+
+bool ImmediatePlane::button(const UnsignedLong id, const Anchor& anchor, const Containers::ArrayView<const char> text, const std::size_t capacity, const Style style) {
+    /* Alignment is not used for buttons */
+    Entry& entry = _state->declare(*this, id, anchor, Kind::Button, Text::Alignment::LineCenterIntegral, Math::max(capacity, text.size()), 0);
+
+    if(!isSameText(entry.text, text)) {
+        entry.text.assign(text.data(), text.size());
+        if(entry.button) entry.button->setText(text);
+    }
+    if(entry.style != style) {
+        entry.style = style;
+        if(entry.button) entry.button->setStyle(style);
+    }
+
+    if(!entry.button || !entry.button->wasTapped) return false;
+    entry.button->wasTapped = false;
+    return true;
+}
+
+void ImmediatePlane::endFrame() {
+    State& state = *_state;
+
+    /* Hide widgets that weren't declared in this frame and keep them for
+       reuse. Done first so the pending IDs below can pick them up already. */
+    for(auto it = state.entries.begin(); it != state.entries.end(); ) {
+        if(it->second.frame == state.frame) {
+            ++it;
+            continue;
+        }
+
+        state.retire(std::move(it->second));
+        it = state.entries.erase(it);
+    }
+
+    /* Give widgets to IDs declared for the first time, reusing hidden ones
+       with the same layout if possible */
+    for(const UnsignedLong id: state.pending) {
+        Entry& entry = state.entries.find(id)->second;
+
+        const auto range = state.pool.equal_range(PoolKey{entry.kind, entry.rect});
+        const auto found = std::find_if(range.first, range.second, [&entry](const std::pair<const PoolKey, Entry>& pooled) {
+            return isCompatible(pooled.second, entry.kind, entry.rect, entry.alignment, entry.capacity, entry.precision);
+        });
+
+        /* Nothing to reuse, create a new widget */
+        if(found == range.second) {
+            if(entry.kind == Kind::Label)
+                entry.label.reset(new Label{*this, entry.anchor, entry.text, entry.alignment, entry.capacity, entry.style});
+            else if(entry.kind == Kind::NumericLabel)
+                entry.numericLabel.reset(new NumericLabel{*this, entry.anchor, entry.value, entry.capacity, entry.precision, entry.alignment, entry.style});
+            else entry.button.reset(new TrackedButton{*this, entry.anchor, entry.text, entry.capacity, entry.style});
+            continue;
+        }
+
+        /* Update only what differs from the widget's previous use */
+        Entry& pooled = found->second;
+        if(entry.kind == Kind::Label) {
+            if(pooled.text != entry.text) pooled.label->setText(entry.text);
+            if(pooled.style != entry.style) pooled.label->setStyle(entry.style);
+        } else if(entry.kind == Kind::NumericLabel) {
+            if(pooled.value != entry.value) pooled.numericLabel->setValue(entry.value);
+            if(pooled.style != entry.style) pooled.numericLabel->setStyle(entry.style);
+        } else {
+            if(pooled.text != entry.text) pooled.button->setText(entry.text);
+            if(pooled.style != entry.style) pooled.button->setStyle(entry.style);
+            pooled.button->wasTapped = false;
+        }
+        pooled.widget().show();
+
+        entry.capacity = pooled.capacity;
+        entry.label = std::move(pooled.label);
+        entry.numericLabel = std::move(pooled.numericLabel);
+        entry.button = std::move(pooled.button);
+        state.pool.erase(found);
+    }
+
+    state.pending.clear();
+    ++state.frame;
+}
+
+}}
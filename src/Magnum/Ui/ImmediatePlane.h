@@ -0,0 +1,174 @@
+#ifndef Magnum_Ui_ImmediatePlane_h
+#define Magnum_Ui_ImmediatePlane_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Ui::ImmediatePlane
+ */
+
+#include <string>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Ui/Plane.h"
+
+namespace Magnum { namespace Ui {
+
+/**
+@brief Plane with an immediate-mode interface
+
+Instead of creating widgets upfront and updating them when the data they show
+change, the application declares all widgets each frame, identified by an ID
+that stays the same across frames, and then calls @ref endFrame(). The plane
+compares the declarations with the previous frame and only calls
+@ref Label::setText(), @ref Label::setStyle() etc. for properties that
+actually changed, so the layer data get uploaded only for those.
+
+Widgets that are not declared in a frame get hidden in @ref endFrame() and
+kept for reuse. A widget declared for the first time gets created in
+@ref endFrame() as well, reusing a hidden widget of the same type, rectangle
+and text alignment if there's any, so the plane layers don't grow when the
+same layout gets filled with different IDs. The plane layers have to have
+enough capacity for all widgets that exist at the same time, including the
+hidden ones. Changing the type, rectangle or alignment of an existing ID, or
+exceeding its text capacity, hides the widget and makes the ID use a
+different one.
+
+The @ref reset() function is not meant to be called on this plane, as the
+widgets would be left without their layer data.
+@experimental
+*/
+class MAGNUM_UI_EXPORT ImmediatePlane: public Plane {
+    public:
+        /**
+         * @brief Constructor
+         * @param ui                    User interface this plane is part of
+         * @param anchor                Positioning anchor
+         * @param backgroundCapacity    Number of background elements to reserve
+         * @param foregroundCapacity    Number of foreground elements to reserve
+         * @param textCapacity          Number of text glyphs to reserve
+         */
+        explicit ImmediatePlane(UserInterface& ui, const Anchor& anchor, std::size_t backgroundCapacity, std::size_t foregroundCapacity, std::size_t textCapacity);
+
+        ~ImmediatePlane();
+
+        /**
+         * @brief Widget count
+         *
+         * Count of widgets declared in the previous frame, plus widgets
+         * declared in the current frame so far for the first time.
+         */
+        std::size_t widgetCount() const;
+
+        /**
+         * @brief Count of hidden widgets kept for reuse
+         *
+         * @see @ref endFrame()
+         */
+        std::size_t pooledWidgetCount() const;
+
+        /**
+         * @brief Declare a label
+         * @param id            Widget ID, unique in the plane
+         * @param anchor        Positioning anchor
+         * @param text          Label text
+         * @param alignment     Label text alignment
+         * @param capacity      Label text capacity. If smaller than size of
+         *      @p text, size of @p text is used.
+         * @param style         Widget style
+         *
+         * See @ref Label for more information.
+         */
+        void label(UnsignedLong id, const Anchor& anchor, Containers::ArrayView<const char> text, Text::Alignment alignment, std::size_t capacity = 0, Style style = Style::Default);
+
+        /** @overload */
+        void label(UnsignedLong id, const Anchor& anchor, const std::string& text, Text::Alignment alignment, std::size_t capacity = 0, Style style = Style::Default) {
+            label(id, anchor, Containers::ArrayView<const char>{text.data(), text.size()}, alignment, capacity, style);
+        }
+
+        /** @overload */
+        template<std::size_t size> void label(UnsignedLong id, const Anchor& anchor, const char(&text)[size], Text::Alignment alignment, std::size_t capacity = 0, Style style = Style::Default) {
+            label(id, anchor, Containers::ArrayView<const char>{text, size - 1}, alignment, capacity, style);
+        }
+
+        /**
+         * @brief Declare a numeric label
+         * @param id            Widget ID, unique in the plane
+         * @param anchor        Positioning anchor
+         * @param value         Value
+         * @param width         Character count
+         * @param precision     Count of digits after the decimal point
+         * @param alignment     Alignment of the fixed-width layout
+         * @param style         Widget style
+         *
+         * See @ref NumericLabel for more information.
+         */
+        void numericLabel(UnsignedLong id, const Anchor& anchor, Double value, std::size_t width, Int precision, Text::Alignment alignment, Style style = Style::Default);
+
+        /**
+         * @brief Declare a button
+         * @param id            Widget ID, unique in the plane
+         * @param anchor        Positioning anchor
+         * @param text          Button text
+         * @param capacity      Button text capacity. If smaller than size of
+         *      @p text, size of @p text is used.
+         * @param style         Widget style
+         * @return Whether the button was tapped since it was declared the
+         *      last time
+         *
+         * See @ref Button for more information.
+         */
+        bool button(UnsignedLong id, const Anchor& anchor, Containers::ArrayView<const char> text, std::size_t capacity = 0, Style style = Style::Default);
+
+        /** @overload */
+        bool button(UnsignedLong id, const Anchor& anchor, const std::string& text, std::size_t capacity = 0, Style style = Style::Default) {
+            return button(id, anchor, Containers::ArrayView<const char>{text.data(), text.size()}, capacity, style);
+        }
+
+        /** @overload */
+        template<std::size_t size> bool button(UnsignedLong id, const Anchor& anchor, const char(&text)[size], std::size_t capacity = 0, Style style = Style::Default) {
+            return button(id, anchor, Containers::ArrayView<const char>{text, size - 1}, capacity, style);
+        }
+
+        /**
+         * @brief End the frame
+         *
+         * Hides widgets that weren't declared since the last call and creates
+         * widgets that were declared for the first time. Call after all
+         * widgets for the frame are declared and before
+         * @ref UserInterface::draw().
+         */
+        void endFrame();
+
+    private:
+        struct State;
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
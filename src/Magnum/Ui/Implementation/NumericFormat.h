@@ -0,0 +1,73 @@
+#ifndef Magnum_Ui_Implementation_NumericFormat_h
+#define Magnum_Ui_Implementation_NumericFormat_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/Magnum.h>
+
+namespace Magnum { namespace Ui { namespace Implementation {
+
+/* Formats the value right-aligned into the whole view, padded with spaces
+   from the left. Returns false if it doesn't fit, the view contents are
+   unspecified in that case. Used by NumericLabel. */
+inline bool formatNumericValue(const Containers::ArrayView<char> out, const Double value, const Int precision) {
+    for(char& c: out) c = ' ';
+
+    /* Catches also NaN and infinity */
+    const Double scaled = std::abs(value)*std::pow(10.0, precision);
+    if(!(scaled < 1.0e18)) return false;
+
+    unsigned long long n = std::llround(scaled);
+    /* Don't show a sign for values that round to zero */
+    const bool negative = value < 0.0 && n;
+
+    std::size_t i = out.size();
+    for(Int digit = 0; digit != precision; ++digit) {
+        if(!i) return false;
+        out[--i] = '0' + n%10;
+        n /= 10;
+    }
+    if(precision) {
+        if(!i) return false;
+        out[--i] = '.';
+    }
+    do {
+        if(!i) return false;
+        out[--i] = '0' + n%10;
+        n /= 10;
+    } while(n);
+    if(negative) {
+        if(!i) return false;
+        out[--i] = '-';
+    }
+
+    return true;
+}
+
+}}}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef Magnum_Ui_Implementation_PlaneCache_h
+#define Magnum_Ui_Implementation_PlaneCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/Math/Range.h>
+
+#include "Magnum/Ui/Style.h"
+
+namespace Magnum { namespace Ui { namespace Implementation {
+
+/* Offscreen render target of a cached plane, see AbstractPlane::setCached().
+   The GL objects are created lazily on the first draw so enabling the cache
+   doesn't need a GL context. */
+struct PlaneCache {
+    Vector2i size;
+    GL::Texture2D texture{NoCreate};
+    GL::Framebuffer framebuffer{NoCreate};
+};
+
+/* Shared among all cached planes in an user interface, created on first
+   use */
+struct PlaneCompositor {
+    explicit PlaneCompositor();
+
+    CompositeShader shader;
+    GL::Mesh quad;
+};
+
+}}}
+
+#endif
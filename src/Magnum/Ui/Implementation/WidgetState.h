@@ -0,0 +1,68 @@
+#ifndef Magnum_Ui_Implementation_WidgetState_h
+#define Magnum_Ui_Implementation_WidgetState_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+
+#include "Magnum/Ui/Style.h"
+#include "Magnum/Ui/Widget.h"
+
+namespace Magnum { namespace Ui { namespace Implementation {
+
+enum class StateLayer: UnsignedByte {
+    Background,
+    Foreground,
+    Text
+};
+
+struct WidgetStateUpdate {
+    StateLayer layer;
+    Type type;
+    Style style;
+    WidgetFlags flags;
+    std::size_t element;
+    UnsignedByte colorIndex;
+};
+
+/* Filled by Widget::updateState() overrides, color indices are then
+   calculated and written to the plane layers in WidgetStateChange::commit() */
+struct WidgetStateUpdates {
+    void add(StateLayer layer, Type type, Style style, WidgetFlags flags, std::size_t element) {
+        updates.push_back({layer, type, style, flags, element, 0});
+    }
+
+    std::vector<WidgetStateUpdate> updates;
+};
+
+/* Declared in Plane.h already, as it's a friend of it. Calculates the color
+   indices, writes them to the plane layers and clears the updates. Used by
+   WidgetStateChange::commit() and also by update() of the builtin widgets,
+   which describe their elements only in updateState(). */
+void MAGNUM_UI_LOCAL applyWidgetStateUpdates(Plane& plane, WidgetStateUpdates& updates);
+
+}}}
+
+#endif
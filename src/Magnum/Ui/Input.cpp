@@ -32,6 +32,7 @@
 #include "Magnum/Ui/Plane.h"
 #include "Magnum/Ui/UserInterface.h"
 #include "Magnum/Ui/Implementation/TextUtility.h"
+#include "Magnum/Ui/Implementation/WidgetState.h"
 
 namespace Magnum { namespace Ui {
 
@@ -96,14 +97,17 @@ auto Input::valueChanged(const std::string& value) -> Signal {
 }
 
 void Input::update() {
-    auto& plane = static_cast<Plane&>(this->plane());
-
-    plane._foregroundLayer.modifyElement(_foregroundElementId).colorIndex =
-        Implementation::foregroundColorIndex(Type::Input, _style,
-        _style == Style::Flat ? WidgetFlag::Hidden : flags());
+    Implementation::WidgetStateUpdates updates;
+    updateState(updates);
+    Implementation::applyWidgetStateUpdates(static_cast<Plane&>(plane()), updates);
+}
 
-    for(Implementation::TextVertex& v: plane._textLayer.modifyElement(_textElementId))
-        v.colorIndex = Implementation::textColorIndex(Type::Input, _style, flags());
+void Input::updateState(Implementation::WidgetStateUpdates& updates) {
+    updates.add(Implementation::StateLayer::Foreground, Type::Input, _style,
+        _style == Style::Flat ? WidgetFlag::Hidden : flags(),
+        _foregroundElementId);
+    updates.add(Implementation::StateLayer::Text, Type::Input, _style,
+        flags(), _textElementId);
 }
 
 void Input::updateValue() {
@@ -140,6 +140,7 @@ class MAGNUM_UI_EXPORT Input: public Widget, public Interconnect::Emitter {
 
     private:
         void MAGNUM_UI_LOCAL update() override;
+        void MAGNUM_UI_LOCAL updateState(Implementation::WidgetStateUpdates& updates) override;
         void updateValue();
 
         bool MAGNUM_UI_LOCAL hoverEvent() override;
@@ -25,13 +25,16 @@
 
 #include "Label.h"
 
+#include <Magnum/Math/Functions.h>
 #include <Magnum/Text/AbstractFont.h>
 #include <Magnum/Text/Alignment.h>
+#include <Magnum/Text/GlyphCache.h>
 
 #include "Magnum/Ui/Anchor.h"
 #include "Magnum/Ui/Plane.h"
 #include "Magnum/Ui/UserInterface.h"
 #include "Magnum/Ui/Implementation/TextUtility.h"
+#include "Magnum/Ui/Implementation/WidgetState.h"
 
 namespace Magnum { namespace Ui {
 
@@ -56,6 +59,37 @@ Label::Label(Plane& plane, const Anchor& anchor, const Containers::ArrayView<con
         _cursor, alignment, capacity);
 }
 
+Label::Label(Plane& plane, const Anchor& anchor, const Containers::ArrayView<const char> text, Text::Alignment alignment, const TextLayoutFlags layoutFlags, const std::size_t capacity, const Style style): Widget{plane, anchor}, _style{style}, _layout{Containers::pointer<TextLayout>()}, _layoutFlags{layoutFlags}, _textWidth{rect().sizeX()} {
+    /* The whole block is centered for Line alignment */
+    /** @todo don't use implementation details */
+    if((UnsignedByte(alignment) & Text::Implementation::AlignmentVertical) == Text::Implementation::AlignmentLine)
+        alignment = Text::Alignment((UnsignedByte(alignment) & ~Text::Implementation::AlignmentVertical)|Text::Implementation::AlignmentMiddle);
+    _alignment = alignment;
+
+    if((UnsignedByte(alignment) & Text::Implementation::AlignmentHorizontal) == Text::Implementation::AlignmentLeft)
+        _cursor.x() = rect().left();
+    else if((UnsignedByte(alignment) & Text::Implementation::AlignmentHorizontal) == Text::Implementation::AlignmentRight)
+        _cursor.x() = rect().right();
+    else _cursor.x() = rect().centerX();
+
+    if((UnsignedByte(alignment) & Text::Implementation::AlignmentVertical) == Text::Implementation::AlignmentTop)
+        _cursor.y() = rect().top();
+    else _cursor.y() = rect().centerY();
+
+    UserInterface& ui = plane.ui();
+    _layout->setText(ui.font(), ui.glyphCache(), ui.styleConfiguration().fontSize(), text);
+
+    /* Clip to the widget height, but always show at least one line */
+    _maxLines = Math::max(std::size_t(rect().sizeY()/_layout->lineHeight()), std::size_t{1});
+    _layout->layout(_textWidth, _maxLines, _layoutFlags);
+
+    /* The initial layout may be clipped, reserve space for all glyphs so
+       setTextWidth() can make it wider later */
+    _textElementId = plane.addText(
+        Implementation::textColorIndex(Type::Label, style, flags() & ~(WidgetFlag::Active|WidgetFlag::Hovered|WidgetFlag::Pressed)),
+        *_layout, _cursor, alignment, capacity ? capacity : _layout->maxGlyphCount(_maxLines));
+}
+
 Label::~Label() = default;
 
 Label& Label::setStyle(const Style style) {
@@ -67,6 +101,13 @@ Label& Label::setStyle(const Style style) {
 Label& Label::setText(const Containers::ArrayView<const char> text) {
     auto& plane = static_cast<Plane&>(this->plane());
 
+    if(_layout) {
+        _layout->setText(plane.ui().font(), plane.ui().glyphCache(), plane.ui().styleConfiguration().fontSize(), text);
+        _layout->layout(_textWidth, _maxLines, _layoutFlags);
+        layoutText();
+        return *this;
+    }
+
     plane.setText(_textElementId,
         Implementation::textColorIndex(Type::Label, _style, flags() & ~(WidgetFlag::Active|WidgetFlag::Hovered|WidgetFlag::Pressed)),
         plane.ui().styleConfiguration().fontSize(),
@@ -75,9 +116,31 @@ Label& Label::setText(const Containers::ArrayView<const char> text) {
     return *this;
 }
 
+Label& Label::setTextWidth(const Float width) {
+    CORRADE_ASSERT(_layout,
+        "Ui::Label::setTextWidth(): the label is not multi-line", *this);
+
+    _textWidth = width;
+    if(_layout->layout(_textWidth, _maxLines, _layoutFlags)) layoutText();
+    return *this;
+}
+
+void Label::layoutText() {
+    static_cast<Plane&>(plane()).setText(_textElementId,
+        Implementation::textColorIndex(Type::Label, _style, flags() & ~(WidgetFlag::Active|WidgetFlag::Hovered|WidgetFlag::Pressed)),
+        *_layout, _cursor, _alignment);
+}
+
 void Label::update() {
-    for(Implementation::TextVertex& v: static_cast<Plane&>(plane())._textLayer.modifyElement(_textElementId))
-        v.colorIndex = Implementation::textColorIndex(Type::Label, _style, flags() & ~(WidgetFlag::Active|WidgetFlag::Hovered|WidgetFlag::Pressed));
+    Implementation::WidgetStateUpdates updates;
+    updateState(updates);
+    Implementation::applyWidgetStateUpdates(static_cast<Plane&>(plane()), updates);
+}
+
+void Label::updateState(Implementation::WidgetStateUpdates& updates) {
+    updates.add(Implementation::StateLayer::Text, Type::Label, _style,
+        flags() & ~(WidgetFlag::Active|WidgetFlag::Hovered|WidgetFlag::Pressed),
+        _textElementId);
 }
 
 }}
@@ -29,17 +29,36 @@
  * @brief Class @ref Magnum::Ui::Label
  */
 
+#include <Corrade/Containers/Pointer.h>
 #include <Magnum/Text/Text.h>
 
 #include "Magnum/Ui/Widget.h"
 #include "Magnum/Ui/Style.h"
+#include "Magnum/Ui/TextLayout.h"
 
 namespace Magnum { namespace Ui {
 
 /**
 @brief Label widget
 
-Just a text with no interactivity.
+Just a text with no interactivity. By default the text is a single line
+rendered as-is. Labels constructed with @ref TextLayoutFlags lay out the text
+into multiple lines using @ref TextLayout instead, see
+@ref Ui-Label-multiline below.
+
+@section Ui-Label-multiline Multi-line labels
+
+The text is broken into lines at newline characters and, with
+@ref TextLayoutFlag::Wrap, also to fit the text width, which is the widget
+width by default. Lines that don't fit into the widget height are clipped,
+lines exceeding the text width as well. With @ref TextLayoutFlag::Ellipsis
+the clipped lines end with an ellipsis. The text is shaped only when it
+changes, changing the width using @ref setTextWidth() only breaks the lines
+again.
+
+Vertical alignment applies to the whole block of text, with
+@ref Text::Alignment::LineLeft and other `Line*` values centering it the same
+as @ref Text::Alignment::MiddleLeft and others.
 
 @section Ui-Label-styling Styling
 
@@ -75,6 +94,30 @@ class MAGNUM_UI_EXPORT Label: public Widget {
         /** @overload */
         explicit Label(Plane& plane, const Anchor& anchor, Containers::ArrayView<const char> text, Text::Alignment alignment, Style style = Style::Default): Label{plane, anchor, text, alignment, 0, style} {}
 
+        /**
+         * @brief Multi-line label
+         * @param plane         Plane this widget is a part of
+         * @param anchor        Positioning anchor
+         * @param text          Label text
+         * @param alignment     Label text alignment
+         * @param flags         Text layout flags
+         * @param capacity      Label text capacity (see @ref setText())
+         * @param style         Widget style
+         *
+         * See @ref Ui-Label-multiline for more information. The capacity is
+         * in glyphs and has to include also the ellipses, if any. If zero,
+         * space for all glyphs of @p text and an ellipsis on each line is
+         * reserved, so the text fits for any @ref setTextWidth(), but
+         * @ref setText() can't set a longer text than @p text.
+         */
+        explicit Label(Plane& plane, const Anchor& anchor, const std::string& text, Text::Alignment alignment, TextLayoutFlags flags, std::size_t capacity = 0, Style style = Style::Default): Label{plane, anchor, Containers::ArrayView<const char>{text.data(), text.size()}, alignment, flags, capacity, style} {}
+
+        /** @overload */
+        template<std::size_t size> explicit Label(Plane& plane, const Anchor& anchor, const char(&text)[size], Text::Alignment alignment, TextLayoutFlags flags, std::size_t capacity = 0, Style style = Style::Default): Label{plane, anchor, Containers::ArrayView<const char>{text, size - 1}, alignment, flags, capacity, style} {}
+
+        /** @overload */
+        explicit Label(Plane& plane, const Anchor& anchor, Containers::ArrayView<const char> text, Text::Alignment alignment, TextLayoutFlags flags, std::size_t capacity = 0, Style style = Style::Default);
+
         ~Label();
 
         /**
@@ -88,7 +131,10 @@ class MAGNUM_UI_EXPORT Label: public Widget {
          * @return Reference to self (for method chaining)
          *
          * The text is expected to not exceed the capacity defined in the
-         * constructor.
+         * constructor. For a multi-line label it's the laid out glyph count
+         * including ellipses that's checked against the capacity, which by
+         * default is the glyph count of the initial text with an ellipsis on
+         * each line.
          */
         Label& setText(const std::string& text) {
             return setText(Containers::ArrayView<const char>{text.data(), text.size()});
@@ -102,13 +148,41 @@ class MAGNUM_UI_EXPORT Label: public Widget {
             return setText(Containers::ArrayView<const char>{text, size - 1});
         }
 
+        /**
+         * @brief Text width
+         *
+         * Width the text of a multi-line label is laid out to. Defaults to
+         * the widget width. Always @cpp 0.0f @ce for single-line labels.
+         */
+        Float textWidth() const { return _textWidth; }
+
+        /**
+         * @brief Set text width
+         * @return Reference to self (for method chaining)
+         *
+         * Breaks the lines again without shaping the text. Expects that the
+         * label was constructed with @ref TextLayoutFlags and the laid out
+         * text doesn't exceed the capacity defined in the constructor. That's
+         * always the case if the capacity was zero in the constructor and
+         * the text didn't get longer since, otherwise the capacity has to
+         * account for the widest layout.
+         */
+        Label& setTextWidth(Float width);
+
     private:
         void MAGNUM_UI_LOCAL update() override;
+        void MAGNUM_UI_LOCAL updateState(Implementation::WidgetStateUpdates& updates) override;
+
+        void MAGNUM_UI_LOCAL layoutText();
 
         Text::Alignment _alignment;
         Style _style;
         Vector2 _cursor;
         std::size_t _textElementId;
+        Containers::Pointer<TextLayout> _layout;
+        TextLayoutFlags _layoutFlags;
+        std::size_t _maxLines{};
+        Float _textWidth{};
 };
 
 }}
@@ -27,6 +27,7 @@
 
 #include "Magnum/Ui/Plane.h"
 #include "Magnum/Ui/UserInterface.h"
+#include "Magnum/Ui/Implementation/WidgetState.h"
 
 namespace Magnum { namespace Ui {
 
@@ -47,12 +48,15 @@ Modal& Modal::setStyle(Style style) {
 }
 
 void Modal::update() {
-    auto& plane = static_cast<Plane&>(this->plane());
+    Implementation::WidgetStateUpdates updates;
+    updateState(updates);
+    Implementation::applyWidgetStateUpdates(static_cast<Plane&>(plane()), updates);
+}
 
-    plane._backgroundLayer.modifyElement(_dimElementId).colorIndex =
-        Implementation::backgroundColorIndex(Type::Modal, Style::Dim, flags() & ~(WidgetFlag::Active|WidgetFlag::Hovered|WidgetFlag::Pressed));
-    plane._backgroundLayer.modifyElement(_backgroundElementId).colorIndex =
-        Implementation::backgroundColorIndex(Type::Modal, _style, flags() & ~(WidgetFlag::Active|WidgetFlag::Hovered|WidgetFlag::Pressed));
+void Modal::updateState(Implementation::WidgetStateUpdates& updates) {
+    const WidgetFlags state = flags() & ~(WidgetFlag::Active|WidgetFlag::Hovered|WidgetFlag::Pressed);
+    updates.add(Implementation::StateLayer::Background, Type::Modal, Style::Dim, state, _dimElementId);
+    updates.add(Implementation::StateLayer::Background, Type::Modal, _style, state, _backgroundElementId);
 }
 
 }}
@@ -68,6 +68,7 @@ class MAGNUM_UI_EXPORT Modal: public Widget {
 
     private:
         void MAGNUM_UI_LOCAL update() override;
+        void MAGNUM_UI_LOCAL updateState(Implementation::WidgetStateUpdates& updates) override;
 
         std::size_t _dimElementId, _backgroundElementId;
         Style _style;
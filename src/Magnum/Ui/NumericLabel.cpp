@@ -0,0 +1,196 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "NumericLabel.h"
+
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/Alignment.h>
+#include <Magnum/Text/GlyphCache.h>
+
+#include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/Plane.h"
+#include "Magnum/Ui/UserInterface.h"
+#include "Magnum/Ui/Implementation/NumericFormat.h"
+#include "Magnum/Ui/Implementation/TextUtility.h"
+#include "Magnum/Ui/Implementation/WidgetState.h"
+
+namespace Magnum { namespace Ui {
+
+namespace {
+
+/* Characters in the same order as NumericLabel::_glyphs */
+constexpr const char GlyphCharacters[]{"0123456789-.#"};
+constexpr std::size_t GlyphCount = sizeof(GlyphCharacters) - 1;
+
+/* Index into NumericLabel::_glyphs, -1 for a space */
+Int glyphIndex(const char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c == '-') return 10;
+    if(c == '.') return 11;
+    if(c == '#') return 12;
+    return -1;
+}
+
+}
+
+NumericLabel::NumericLabel(Plane& plane, const Anchor& anchor, const Double value, const std::size_t width, const Int precision, const Text::Alignment alignment, const Style style): Widget{plane, anchor}, _style{style}, _precision{precision}, _width{width}, _value{} {
+    CORRADE_ASSERT(width && width <= MaxWidth,
+        "Ui::NumericLabel: expected width to be between 1 and" << MaxWidth << "but got" << width, );
+    CORRADE_ASSERT(precision >= 0,
+        "Ui::NumericLabel: expected non-negative precision but got" << precision, );
+
+    UserInterface& ui = plane.ui();
+    const Float size = ui.styleConfiguration().fontSize();
+
+    /* Lay out all characters just once. The cell is as wide as the widest
+       digit and each glyph gets centered in it. */
+    Containers::Pointer<Text::AbstractLayouter> layouter = ui.font().layout(ui.glyphCache(), size, GlyphCharacters);
+    CORRADE_INTERNAL_ASSERT(layouter->glyphCount() == GlyphCount);
+    Float advances[GlyphCount];
+    _cellWidth = 0.0f;
+    for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
+        Vector2 cursor;
+        Range2D rectangle;
+        std::tie(_glyphs[i].position, _glyphs[i].textureCoordinates) = layouter->renderGlyph(i, cursor, rectangle);
+        advances[i] = cursor.x();
+        if(i < 10) _cellWidth = Math::max(_cellWidth, cursor.x());
+    }
+    for(std::size_t i = 0; i != GlyphCount; ++i)
+        _glyphs[i].position = _glyphs[i].position.translated(Vector2::xAxis((_cellWidth - advances[i])*0.5f));
+
+    /* Position the layout origin (left end of the baseline). The layout
+       width is known upfront, so there's no need to measure the text. */
+    /** @todo don't use implementation details */
+    const Float layoutWidth = _cellWidth*width;
+    if((UnsignedByte(alignment) & Text::Implementation::AlignmentHorizontal) == Text::Implementation::AlignmentLeft)
+        _origin.x() = rect().left();
+    else if((UnsignedByte(alignment) & Text::Implementation::AlignmentHorizontal) == Text::Implementation::AlignmentRight)
+        _origin.x() = rect().right() - layoutWidth;
+    else _origin.x() = rect().centerX() - layoutWidth*0.5f;
+
+    /* Vertically it's the same as a single-line Label, which aligns the
+       rendered glyph rectangle to the widget top for Top, to the widget
+       center for Middle and puts the baseline to the center for Line. The
+       rectangle is of all characters the label can show so the text doesn't
+       move when the value changes. */
+    Range1D glyphBounds{_glyphs[0].position.y()};
+    for(std::size_t i = 1; i != GlyphCount; ++i)
+        glyphBounds = Math::join(glyphBounds, _glyphs[i].position.y());
+    if((UnsignedByte(alignment) & Text::Implementation::AlignmentVertical) == Text::Implementation::AlignmentTop)
+        _origin.y() = rect().top() - glyphBounds.max();
+    else if((UnsignedByte(alignment) & Text::Implementation::AlignmentVertical) == Text::Implementation::AlignmentLine)
+        _origin.y() = rect().centerY() + Int(Implementation::lineAlignmentAdjustment(ui));
+    else _origin.y() = rect().centerY() - glyphBounds.center();
+
+    /* Add an element with all cells empty, setValue() then fills in the
+       glyphs */
+    for(char& c: _text) c = ' ';
+    Containers::Array<Implementation::TextVertex> vertices{Containers::ValueInit, width*4};
+    _textElementId = plane._textLayer.addElement(vertices, width*6);
+
+    setValue(value);
+}
+
+NumericLabel::~NumericLabel() = default;
+
+NumericLabel& NumericLabel::setStyle(const Style style) {
+    _style = style;
+    update();
+    return *this;
+}
+
+NumericLabel& NumericLabel::setValue(const Double value) {
+    _value = value;
+
+    char text[MaxWidth];
+    const Containers::ArrayView<char> textView{text, _width};
+    if(!Implementation::formatNumericValue(textView, value, _precision))
+        for(char& c: textView) c = '#';
+
+    /* Find the range of characters that differ from what's shown */
+    std::size_t first = _width, last = 0;
+    for(std::size_t i = 0; i != _width; ++i) {
+        if(text[i] == _text[i]) continue;
+        if(first == _width) first = i;
+        last = i + 1;
+    }
+    if(first >= last) return *this;
+
+    /* Modify just that range, replacing only glyphs that changed */
+    auto& plane = static_cast<Plane&>(this->plane());
+    const Containers::ArrayView<Implementation::TextVertex> vertices = plane._textLayer.modifyElement(_textElementId, first*4, (last - first)*4);
+    const UnsignedByte colorIndex = Implementation::textColorIndex(Type::Label, _style, flags() & ~(WidgetFlag::Active|WidgetFlag::Hovered|WidgetFlag::Pressed));
+    for(std::size_t i = first; i != last; ++i) {
+        if(text[i] == _text[i]) continue;
+        _text[i] = text[i];
+
+        Implementation::TextVertex* const quad = &vertices[(i - first)*4];
+        const Int index = glyphIndex(text[i]);
+        if(index == -1) {
+            for(std::size_t j = 0; j != 4; ++j) quad[j] = {};
+            continue;
+        }
+
+        /* Same vertex order as Text::AbstractRenderer produces */
+        const Glyph& glyph = _glyphs[index];
+        const Vector2 offset = _origin + Vector2::xAxis(Float(i)*_cellWidth);
+        quad[0] = Implementation::TextVertex{
+            glyph.position.topLeft() + offset,
+            glyph.textureCoordinates.topLeft(),
+            colorIndex};
+        quad[1] = Implementation::TextVertex{
+            glyph.position.bottomLeft() + offset,
+            glyph.textureCoordinates.bottomLeft(),
+            colorIndex};
+        quad[2] = Implementation::TextVertex{
+            glyph.position.topRight() + offset,
+            glyph.textureCoordinates.topRight(),
+            colorIndex};
+        quad[3] = Implementation::TextVertex{
+            glyph.position.bottomRight() + offset,
+            glyph.textureCoordinates.bottomRight(),
+            colorIndex};
+    }
+
+    return *this;
+}
+
+void NumericLabel::update() {
+    Implementation::WidgetStateUpdates updates;
+    updateState(updates);
+    Implementation::applyWidgetStateUpdates(static_cast<Plane&>(plane()), updates);
+}
+
+void NumericLabel::updateState(Implementation::WidgetStateUpdates& updates) {
+    updates.add(Implementation::StateLayer::Text, Type::Label, _style,
+        flags() & ~(WidgetFlag::Active|WidgetFlag::Hovered|WidgetFlag::Pressed),
+        _textElementId);
+}
+
+}}
@@ -0,0 +1,139 @@
+#ifndef Magnum_Ui_NumericLabel_h
+#define Magnum_Ui_NumericLabel_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Ui::NumericLabel
+ */
+
+#include <Magnum/Math/Range.h>
+#include <Magnum/Text/Text.h>
+
+#include "Magnum/Ui/Widget.h"
+#include "Magnum/Ui/Style.h"
+
+namespace Magnum { namespace Ui {
+
+/**
+@brief Numeric label widget
+
+A label showing a number in a fixed-width layout. Each character occupies a
+cell of the same width, so instead of laying out the whole text again,
+@ref setValue() only replaces glyphs of characters that differ from the
+previously shown value and marks just the range between the first and last
+changed character as modified. That makes it suitable for counters and other
+values changing every frame.
+
+The number is right-aligned in the layout and padded with spaces from the
+left. A value that doesn't fit into @ref width() characters is shown as
+`#` in all cells.
+
+Vertical alignment is handled the same as in a single-line @ref Label, with
+@ref Text::Alignment::MiddleLeft and other `Middle*` values centering the
+glyphs and `Line*` values putting the baseline to the widget center. The
+glyph extents are calculated from all characters the label can show, so the
+text doesn't move vertically when the value changes.
+
+@section Ui-NumericLabel-styling Styling
+
+Styled the same as a @ref Label. Ignores @ref WidgetFlag::Hovered,
+@ref WidgetFlag::Pressed and @ref WidgetFlag::Active, @ref Style::Flat.
+@experimental
+*/
+class MAGNUM_UI_EXPORT NumericLabel: public Widget {
+    public:
+        enum: std::size_t {
+            MaxWidth = 32   /**< Max character count */
+        };
+
+        /**
+         * @brief Constructor
+         * @param plane         Plane this widget is a part of
+         * @param anchor        Positioning anchor
+         * @param value         Initial value
+         * @param width         Character count, including the sign and
+         *      decimal point. Expected to be non-zero and not larger than
+         *      @ref MaxWidth.
+         * @param precision     Count of digits after the decimal point
+         * @param alignment     Alignment of the fixed-width layout in the
+         *      widget rectangle
+         * @param style         Widget style
+         */
+        explicit NumericLabel(Plane& plane, const Anchor& anchor, Double value, std::size_t width, Int precision, Text::Alignment alignment, Style style = Style::Default);
+
+        /** @overload */
+        explicit NumericLabel(Plane& plane, const Anchor& anchor, Double value, std::size_t width, Text::Alignment alignment, Style style = Style::Default): NumericLabel{plane, anchor, value, width, 0, alignment, style} {}
+
+        ~NumericLabel();
+
+        /** @brief Character count */
+        std::size_t width() const { return _width; }
+
+        /** @brief Count of digits after the decimal point */
+        Int precision() const { return _precision; }
+
+        /** @brief Value */
+        Double value() const { return _value; }
+
+        /**
+         * @brief Set widget style
+         * @return Reference to self (for method chaining)
+         */
+        NumericLabel& setStyle(Style style);
+
+        /**
+         * @brief Set value
+         * @return Reference to self (for method chaining)
+         *
+         * Updates only glyphs of characters that changed. If the displayed
+         * text is the same as before, nothing is modified.
+         */
+        NumericLabel& setValue(Double value);
+
+    private:
+        struct Glyph {
+            Range2D position;
+            Range2D textureCoordinates;
+        };
+
+        void MAGNUM_UI_LOCAL update() override;
+        void MAGNUM_UI_LOCAL updateState(Implementation::WidgetStateUpdates& updates) override;
+
+        Style _style;
+        Int _precision;
+        std::size_t _width, _textElementId;
+        Double _value;
+        /* Glyph quads for 0-9, '-', '.' and '#', already centered in the
+           cell and positioned relative to the layout origin */
+        Glyph _glyphs[13];
+        Float _cellWidth;
+        Vector2 _origin;
+        char _text[MaxWidth];
+};
+
+}}
+
+#endif
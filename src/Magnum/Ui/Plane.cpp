@@ -28,6 +28,7 @@
 #include <Magnum/Text/Renderer.h>
 
 #include "Magnum/Ui/BasicPlane.hpp"
+#include "Magnum/Ui/TextLayout.h"
 #include "Magnum/Ui/UserInterface.h"
 
 namespace Magnum { namespace Ui {
@@ -39,46 +40,56 @@ Plane::Plane(UserInterface& ui, const Anchor& anchor): BasicPlane<Implementation
     ui.styleConfiguration().margin(),
     _backgroundLayer,
     _foregroundLayer,
-    _textLayer}
-{
+    _textLayer},
+    _backgroundLayer{ui._bufferArena},
+    _foregroundLayer{ui._bufferArena},
+    _textLayer{ui._bufferArena} {}
+
+Plane::~Plane() = default;
+
+UserInterface& Plane::ui() {
+    return static_cast<UserInterface&>(BasicPlane::ui());
+}
+
+const UserInterface& Plane::ui() const {
+    return static_cast<const UserInterface&>(BasicPlane::ui());
+}
+
+void Plane::reset(const std::size_t backgroundCapacity, const std::size_t foregroundCapacity, const std::size_t textCapacity) {
+    _backgroundLayer.reset(4*backgroundCapacity, GL::BufferUsage::StaticDraw);
+    _foregroundLayer.reset(4*foregroundCapacity, GL::BufferUsage::StaticDraw);
+    _textLayer.reset(foregroundCapacity, 4*textCapacity, GL::BufferUsage::StaticDraw);
+
+    /* The layer data can end up at a different place in the arena after a
+       reset, so the meshes have to be set up from scratch */
     /** @todo ugh Containers::reference()? How about creference()? */
     for(Implementation::QuadLayer& quadLayer: {Containers::Reference<Implementation::QuadLayer>{_backgroundLayer},
                                                Containers::Reference<Implementation::QuadLayer>{_foregroundLayer}}) {
+        quadLayer.mesh() = GL::Mesh{};
         quadLayer.mesh()
             .setPrimitive(GL::MeshPrimitive::TriangleStrip)
             .setCount(4)
-            .addVertexBuffer(ui._quadVertices, 0,
+            .setInstanceCount(0)
+            .addVertexBuffer(ui()._quadVertices, 0,
                 Implementation::AbstractQuadShader::Position{},
                 Implementation::AbstractQuadShader::EdgeDistance{})
-            .addVertexBufferInstanced(quadLayer.buffer(), 1, 0,
+            .addVertexBufferInstanced(quadLayer.buffer(), 1, quadLayer.bufferOffset(),
                 Implementation::AbstractQuadShader::Rect{},
                 Implementation::AbstractQuadShader::ColorIndex{Implementation::AbstractQuadShader::ColorIndex::DataType::Short},
                 2);
     }
 
+    _textLayer.mesh() = GL::Mesh{};
     _textLayer.mesh()
-        .setIndexBuffer(ui._quadIndices, 0, GL::MeshIndexType::UnsignedShort)
-        .addVertexBuffer(_textLayer.buffer(), 0,
+        .setIndexBuffer(ui()._quadIndices, 0, GL::MeshIndexType::UnsignedShort)
+        .addVertexBuffer(_textLayer.buffer(), _textLayer.bufferOffset(),
             Implementation::TextShader::Position{},
             Implementation::TextShader::TextureCoordinates{},
             Implementation::TextShader::ColorIndex{Implementation::TextShader::ColorIndex::DataType::Short},
             2);
-}
-
-Plane::~Plane() = default;
-
-UserInterface& Plane::ui() {
-    return static_cast<UserInterface&>(BasicPlane::ui());
-}
 
-const UserInterface& Plane::ui() const {
-    return static_cast<const UserInterface&>(BasicPlane::ui());
-}
-
-void Plane::reset(const std::size_t backgroundCapacity, const std::size_t foregroundCapacity, const std::size_t textCapacity) {
-    _backgroundLayer.reset(4*backgroundCapacity, GL::BufferUsage::StaticDraw);
-    _foregroundLayer.reset(4*foregroundCapacity, GL::BufferUsage::StaticDraw);
-    _textLayer.reset(foregroundCapacity, 4*textCapacity, GL::BufferUsage::StaticDraw);
+    /* The reset doesn't mark the layers as modified */
+    invalidateCache();
 }
 
 std::size_t Plane::addText(const UnsignedByte colorIndex, const Float size, const Containers::ArrayView<const char> text, const Vector2& cursor, const Text::Alignment alignment, const std::size_t capacity) {
@@ -128,4 +139,45 @@ void Plane::setText(const std::size_t id, const UnsignedByte colorIndex, const F
     for(std::size_t i = positions.size(); i != vertices.size(); ++i) vertices[i] = {};
 }
 
+std::size_t Plane::addText(const UnsignedByte colorIndex, const TextLayout& layout, const Vector2& cursor, const Text::Alignment alignment, const std::size_t capacity) {
+    const std::size_t glyphCount = layout.glyphCount();
+    CORRADE_ASSERT(!capacity || capacity >= glyphCount,
+        "Ui::Plane::addText(): capacity too small for provided layout, got" << glyphCount << "but expected at most" << capacity, 0);
+
+    /* Render the layout */
+    Containers::Array<Vector2> positions{glyphCount*4};
+    Containers::Array<Vector2> textureCoordinates{glyphCount*4};
+    layout.render(cursor, alignment, positions, textureCoordinates);
+
+    /* Add the element vertex data */
+    Containers::Array<Implementation::TextVertex> vertices{Math::max(capacity, glyphCount)*4};
+    for(std::size_t i = 0; i != positions.size(); ++i) vertices[i] = Implementation::TextVertex{
+        positions[i],
+        textureCoordinates[i],
+        colorIndex};
+    return _textLayer.addElement(vertices, vertices.size()*6/4);
+}
+
+void Plane::setText(const std::size_t id, const UnsignedByte colorIndex, const TextLayout& layout, const Vector2& cursor, const Text::Alignment alignment) {
+    Containers::ArrayView<Implementation::TextVertex> vertices = _textLayer.modifyElement(id);
+
+    const std::size_t glyphCount = layout.glyphCount();
+    CORRADE_ASSERT(vertices.size() >= glyphCount*4,
+        "Ui::Plane::setText(): capacity too small for provided layout, got" << glyphCount << "but expected at most" << vertices.size()/4, );
+
+    /* Render the layout */
+    Containers::Array<Vector2> positions{glyphCount*4};
+    Containers::Array<Vector2> textureCoordinates{glyphCount*4};
+    layout.render(cursor, alignment, positions, textureCoordinates);
+
+    /* Update vertex data */
+    for(std::size_t i = 0; i != positions.size(); ++i) vertices[i] = Implementation::TextVertex{
+        positions[i],
+        textureCoordinates[i],
+        colorIndex};
+
+    /* Clear the rest */
+    for(std::size_t i = positions.size(); i != vertices.size(); ++i) vertices[i] = {};
+}
+
 }}
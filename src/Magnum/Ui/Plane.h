@@ -38,6 +38,11 @@
 
 namespace Magnum { namespace Ui {
 
+namespace Implementation {
+    struct WidgetStateUpdates;
+    void MAGNUM_UI_LOCAL applyWidgetStateUpdates(Plane& plane, WidgetStateUpdates& updates);
+}
+
 /**
 @brief Default UI plane
 
@@ -47,7 +52,9 @@ class MAGNUM_UI_EXPORT Plane: public BasicPlane<Implementation::QuadLayer, Imple
     friend Button;
     friend Input;
     friend Label;
+    friend NumericLabel;
     friend Modal;
+    friend void Implementation::applyWidgetStateUpdates(Plane&, Implementation::WidgetStateUpdates&);
 
     public:
         /**
@@ -96,7 +103,10 @@ class MAGNUM_UI_EXPORT Plane: public BasicPlane<Implementation::QuadLayer, Imple
          * @param textCapacity          Number of text glyphs to reserve
          *
          * Clears contents of the plane and reserves memory. If the memory
-         * capacity is enough, no reallocation is done.
+         * capacity is enough, no reallocation is done. The
+         * @p foregroundCapacity is also used as the count of text elements
+         * to reserve, so it has to be at least the count of widgets showing
+         * a text, such as @ref Label, even if they have no foreground.
          */
         void reset(std::size_t backgroundCapacity, std::size_t foregroundCapacity, std::size_t textCapacity);
 
@@ -105,6 +115,10 @@ class MAGNUM_UI_EXPORT Plane: public BasicPlane<Implementation::QuadLayer, Imple
 
         void setText(std::size_t id, UnsignedByte colorIndex, Float size, Containers::ArrayView<const char> text, const Vector2& cursor, Text::Alignment alignment);
 
+        std::size_t addText(UnsignedByte colorIndex, const TextLayout& layout, const Vector2& cursor, Text::Alignment alignment, std::size_t capacity = 0);
+
+        void setText(std::size_t id, UnsignedByte colorIndex, const TextLayout& layout, const Vector2& cursor, Text::Alignment alignment);
+
         Implementation::QuadLayer _backgroundLayer;
         Implementation::QuadLayer _foregroundLayer;
         Implementation::TextLayer _textLayer;
@@ -1081,4 +1081,44 @@ TextShader& TextShader::bindStyleBuffer(GL::Buffer& buffer) {
     return *this;
 }
 
+CompositeShader::CompositeShader() {
+    #ifdef MAGNUM_BUILD_STATIC
+    if(!Utility::Resource::hasGroup("MagnumUi"))
+        importShaderResources();
+    #endif
+
+    Utility::Resource rs{"MagnumUi"};
+
+    GL::Shader vert{
+        #ifndef MAGNUM_TARGET_GLES
+        GL::Version::GL330,
+        #else
+        GL::Version::GLES300,
+        #endif
+        GL::Shader::Type::Vertex};
+    GL::Shader frag{
+        #ifndef MAGNUM_TARGET_GLES
+        GL::Version::GL330,
+        #else
+        GL::Version::GLES300,
+        #endif
+        GL::Shader::Type::Fragment};
+    vert.addSource(rs.get("CompositeShader.vert"));
+    frag.addSource(rs.get("CompositeShader.frag"));
+
+    CORRADE_INTERNAL_ASSERT(GL::Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+
+    CORRADE_INTERNAL_ASSERT(link());
+
+    _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+    /* Units 0 and 1 are used by the corner and glyph cache textures */
+    setUniform(uniformLocation("textureData"), 2);
+}
+
+CompositeShader& CompositeShader::bindTexture(GL::Texture2D& texture) {
+    texture.bind(2);
+    return *this;
+}
+
 }}}
@@ -475,6 +475,17 @@ class MAGNUM_UI_EXPORT TextShader: public AbstractUiShader {
         TextShader& bindStyleBuffer(GL::Buffer& buffer);
 };
 
+/* Draws a cached plane texture with a single quad, see
+   AbstractPlane::setCached() */
+class MAGNUM_UI_EXPORT CompositeShader: public AbstractUiShader {
+    public:
+        typedef GL::Attribute<0, Vector2> Position;
+
+        explicit CompositeShader();
+
+        CompositeShader& bindTexture(GL::Texture2D& texture);
+};
+
 }
 
 }}
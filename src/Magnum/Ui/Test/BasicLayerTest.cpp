@@ -23,8 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Ui/BasicLayer.hpp"
 
@@ -41,6 +43,10 @@ struct BasicLayerTest: TestSuite::Tester {
     void resetNoReallocData();
     void resetNoReallocElementData();
     void modifyElement();
+    void modifyElementRange();
+    void modifyElementRangeMultiple();
+    void modifyElementRangeEmpty();
+    void modifyElementRangeOutOfBounds();
 };
 
 BasicLayerTest::BasicLayerTest() {
@@ -51,7 +57,11 @@ BasicLayerTest::BasicLayerTest() {
               &BasicLayerTest::reset,
               &BasicLayerTest::resetNoReallocData,
               &BasicLayerTest::resetNoReallocElementData,
-              &BasicLayerTest::modifyElement});
+              &BasicLayerTest::modifyElement,
+              &BasicLayerTest::modifyElementRange,
+              &BasicLayerTest::modifyElementRangeMultiple,
+              &BasicLayerTest::modifyElementRangeEmpty,
+              &BasicLayerTest::modifyElementRangeOutOfBounds});
 }
 
 struct Layer: BasicLayer<Int> {
@@ -221,6 +231,88 @@ void BasicLayerTest::modifyElement() {
     CORRADE_COMPARE(layer.modified(), (Math::Range1D<std::size_t>{3, 8}));
 }
 
+void BasicLayerTest::modifyElementRange() {
+    Layer layer;
+    layer.reset(17, 42);
+
+    CORRADE_COMPARE(layer.addElement(
+        Containers::Array<Int>{Containers::InPlaceInit, {13, -5, 27}}, 3), 0);
+    CORRADE_COMPARE(layer.addElement(
+        Containers::Array<Int>{Containers::InPlaceInit, {23, 17, 57, 0}}, 6), 1);
+    layer.resetModified();
+
+    Containers::ArrayView<Int> data = layer.modifyElement(1, 1, 2);
+    CORRADE_COMPARE(data.size(), 2);
+    data[0] = 2555;
+    data[1] = 5704;
+
+    CORRADE_COMPARE_AS(layer.data(),
+        (Containers::Array<Int>{Containers::InPlaceInit, {
+            13, -5, 27, 23, 2555, 5704, 0}}),
+        TestSuite::Compare::Container);
+    /* Only the modified part of the element is marked */
+    CORRADE_COMPARE(layer.modified(), (Math::Range1D<std::size_t>{4, 6}));
+}
+
+void BasicLayerTest::modifyElementRangeMultiple() {
+    Layer layer;
+    layer.reset(17, 42);
+
+    CORRADE_COMPARE(layer.addElement(
+        Containers::Array<Int>{Containers::InPlaceInit, {13, -5, 27}}, 3), 0);
+    CORRADE_COMPARE(layer.addElement(
+        Containers::Array<Int>{Containers::InPlaceInit, {23, 17, 57, 0}}, 6), 1);
+    layer.resetModified();
+
+    /* The last item of the first element and the first item of the second,
+       the modified range is the union */
+    layer.modifyElement(0, 2, 1)[0] = 2555;
+    layer.modifyElement(1, 0, 1)[0] = 5704;
+
+    CORRADE_COMPARE_AS(layer.data(),
+        (Containers::Array<Int>{Containers::InPlaceInit, {
+            13, -5, 2555, 5704, 17, 57, 0}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(layer.modified(), (Math::Range1D<std::size_t>{2, 4}));
+
+    /* Modifying the whole element extends it further */
+    layer.modifyElement(1, 0, 4);
+    CORRADE_COMPARE(layer.modified(), (Math::Range1D<std::size_t>{2, 7}));
+}
+
+void BasicLayerTest::modifyElementRangeEmpty() {
+    Layer layer;
+    layer.reset(17, 42);
+
+    CORRADE_COMPARE(layer.addElement(
+        Containers::Array<Int>{Containers::InPlaceInit, {13, -5, 27}}, 3), 0);
+    layer.resetModified();
+
+    CORRADE_VERIFY(layer.modifyElement(0, 3, 0).empty());
+    CORRADE_VERIFY(!layer.modified().size());
+}
+
+void BasicLayerTest::modifyElementRangeOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Layer layer;
+    layer.reset(17, 42);
+
+    CORRADE_COMPARE(layer.addElement(
+        Containers::Array<Int>{Containers::InPlaceInit, {13, -5, 27}}, 3), 0);
+    CORRADE_COMPARE(layer.addElement(
+        Containers::Array<Int>{Containers::InPlaceInit, {23, 17, 57, 0}}, 6), 1);
+    layer.resetModified();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    layer.modifyElement(0, 2, 2);
+    CORRADE_COMPARE(out.str(), "Ui::BasicLayer::modifyElement(): range 2 + 2 out of bounds for an element of size 3\n");
+    CORRADE_VERIFY(!layer.modified().size());
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Ui::Test::BasicLayerTest)
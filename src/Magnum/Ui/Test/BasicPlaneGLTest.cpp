@@ -0,0 +1,129 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Magnum/Image.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/Alignment.h>
+
+#include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/Button.h"
+#include "Magnum/Ui/Label.h"
+#include "Magnum/Ui/Plane.h"
+#include "Magnum/Ui/UserInterface.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct BasicPlaneGLTest: GL::OpenGLTester {
+    explicit BasicPlaneGLTest();
+
+    void drawCached();
+
+    private:
+        PluginManager::Manager<Text::AbstractFont> _manager;
+};
+
+BasicPlaneGLTest::BasicPlaneGLTest() {
+    addTests({&BasicPlaneGLTest::drawCached});
+}
+
+constexpr Vector2i Size{128, 64};
+
+Image2D drawPlane(UserInterface& ui, GL::Framebuffer& framebuffer) {
+    /* Clearing a particular attachment isn't available on ES2 */
+    GL::Renderer::setClearColor(Color4{});
+    framebuffer
+        .clear(GL::FramebufferClear::Color)
+        .bind();
+    ui.draw();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    return framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+}
+
+UnsignedInt maxDifference(const Image2D& a, const Image2D& b) {
+    UnsignedInt difference = 0;
+    const Containers::StridedArrayView2D<const Color4ub> pixelsA = a.pixels<Color4ub>();
+    const Containers::StridedArrayView2D<const Color4ub> pixelsB = b.pixels<Color4ub>();
+    for(std::size_t y = 0; y != pixelsA.size()[0]; ++y)
+        for(std::size_t x = 0; x != pixelsA.size()[1]; ++x)
+            for(std::size_t i = 0; i != 4; ++i)
+                difference = Math::max(difference, UnsignedInt(Math::abs(Int(pixelsA[y][x][i]) - Int(pixelsB[y][x][i]))));
+    return difference;
+}
+
+void BasicPlaneGLTest::drawCached() {
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test");
+
+    /* Drawing into a custom framebuffer so the cache has to switch back to
+       something else than the default one */
+    GL::Renderbuffer color;
+    color.setStorage(GL::RenderbufferFormat::RGBA8, Size);
+    GL::Framebuffer framebuffer{{{}, Size}};
+    framebuffer.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color);
+
+    UserInterface ui{_manager, Vector2{Size}, Size, Size};
+    ui.setFramebuffer(framebuffer);
+    CORRADE_COMPARE(&ui.framebuffer(), &framebuffer);
+
+    Plane plane{ui, {{}, ui.size()}, 8, 8, 64};
+    Button button{plane, {Snap::Top|Snap::Left, {64.0f, 24.0f}}, "Button"};
+    Label label{plane, {Snap::Bottom|Snap::Left, {64.0f, 24.0f}}, "Label", Text::Alignment::LineLeft};
+
+    GL::Renderer::enable(GL::Renderer::Feature::Blending);
+    GL::Renderer::setBlendFunction(GL::Renderer::BlendFunction::One, GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+
+    const Image2D uncached = drawPlane(ui, framebuffer);
+
+    /* The first cached draw updates the cache and composites it, the second
+       only composites. If the cache framebuffer stayed bound after the
+       update, the composited quad would end up there and the output would
+       be empty. */
+    plane.setCached(true);
+    const Image2D updated = drawPlane(ui, framebuffer);
+    const Image2D composited = drawPlane(ui, framebuffer);
+
+    CORRADE_COMPARE_AS(maxDifference(updated, uncached), 1, TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(maxDifference(composited, uncached), 1, TestSuite::Compare::LessOrEqual);
+
+    /* Something got actually drawn */
+    CORRADE_VERIFY(maxDifference(uncached, Image2D{PixelFormat::RGBA8Unorm, Size, Containers::Array<char>{Containers::ValueInit, std::size_t(Size.product()*4)}}) > 0);
+
+    GL::Renderer::disable(GL::Renderer::Feature::Blending);
+}
+
+}}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Ui::Test::BasicPlaneGLTest)
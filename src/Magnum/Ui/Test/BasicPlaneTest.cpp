@@ -30,6 +30,7 @@
 #include "Magnum/Ui/Anchor.h"
 #include "Magnum/Ui/BasicPlane.hpp"
 #include "Magnum/Ui/BasicUserInterface.hpp"
+#include "Magnum/Ui/Widget.h"
 
 namespace Magnum { namespace Ui { namespace Test { namespace {
 
@@ -47,6 +48,9 @@ struct BasicPlaneTest: TestSuite::Tester {
     void hierarchyHideHidden();
     void hierarchyHideInactive();
 
+    void cached();
+    void transformation();
+
     void debugFlag();
     void debugFlags();
 };
@@ -61,6 +65,9 @@ BasicPlaneTest::BasicPlaneTest() {
               &BasicPlaneTest::hierarchyHideHidden,
               &BasicPlaneTest::hierarchyHideInactive,
 
+              &BasicPlaneTest::cached,
+              &BasicPlaneTest::transformation,
+
               &BasicPlaneTest::debugFlag,
               &BasicPlaneTest::debugFlags});
 }
@@ -73,6 +80,10 @@ struct Plane: BasicPlane<> {
     using BasicPlane::BasicPlane;
 };
 
+struct Widget: Ui::Widget {
+    using Ui::Widget::Widget;
+};
+
 void BasicPlaneTest::construct() {
     UserInterface ui{{800, 600}, {1600, 900}};
     Plane plane{ui, {Snap::Left|Snap::Top, {400.0f, 300.0f}}, {{10.0f, 25.0f}, {-15.0f, -5.0f}}, {7.0f, 3.0f}};
@@ -267,6 +278,52 @@ void BasicPlaneTest::hierarchyHideInactive() {
     CORRADE_COMPARE(b.nextActivePlane(), nullptr);
 }
 
+void BasicPlaneTest::cached() {
+    UserInterface ui{{800, 600}, {800, 600}};
+    Plane a{ui, {{}, {800.0f, 600.0f}}, {}, {}};
+    Plane b{ui, {{}, {800.0f, 600.0f}}, {}, {}};
+    CORRADE_VERIFY(!a.isCached());
+    CORRADE_VERIFY(!b.isCached());
+
+    /* Enabling the cache doesn't need a GL context, the render target gets
+       created on first draw */
+    a.setCached(true);
+    CORRADE_VERIFY(a.isCached());
+    CORRADE_VERIFY(!b.isCached());
+
+    /* Invalidating is allowed for non-cached planes as well */
+    ui.invalidatePlaneCaches();
+    b.invalidateCache();
+
+    a.setCached(false);
+    CORRADE_VERIFY(!a.isCached());
+}
+
+void BasicPlaneTest::transformation() {
+    UserInterface ui{{800, 600}, {800, 600}};
+    Plane plane{ui, {{}, {800.0f, 600.0f}}, {}, {}};
+    Widget widget{plane, {Snap::Bottom|Snap::Left, {100.0f, 100.0f}}};
+    CORRADE_COMPARE(plane.transformation(), Matrix3{});
+    CORRADE_COMPARE(widget.rect(), Range2D::fromSize({}, {100.0f, 100.0f}));
+
+    /* Outside of the widget without a transformation */
+    ui.handlePressEvent({150, 450});
+    CORRADE_VERIFY(!(widget.flags() & WidgetFlag::Pressed));
+    ui.handleReleaseEvent({150, 450});
+
+    /* Scaled 2x, the same position is inside */
+    plane.setTransformation(Matrix3::scaling(Vector2{2.0f}));
+    CORRADE_COMPARE(plane.transformation(), Matrix3::scaling(Vector2{2.0f}));
+    ui.handlePressEvent({150, 450});
+    CORRADE_VERIFY(widget.flags() & WidgetFlag::Pressed);
+    ui.handleReleaseEvent({150, 450});
+
+    /* Moved away, outside again */
+    plane.setTransformation(Matrix3::translation({300.0f, 0.0f})*Matrix3::scaling(Vector2{2.0f}));
+    ui.handlePressEvent({150, 450});
+    CORRADE_VERIFY(!(widget.flags() & WidgetFlag::Pressed));
+}
+
 void BasicPlaneTest::debugFlag() {
     std::ostringstream out;
 
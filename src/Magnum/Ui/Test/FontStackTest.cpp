@@ -0,0 +1,238 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Text/AbstractGlyphCache.h>
+
+#include "Magnum/Ui/FontStack.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct FontStackTest: TestSuite::Tester {
+    explicit FontStackTest();
+
+    void open();
+    void layoutPrimary();
+    void layoutFallback();
+    void layoutFallbackFailed();
+    void fillGlyphCache();
+    void cacheFull();
+};
+
+FontStackTest::FontStackTest() {
+    addTests({&FontStackTest::open,
+              &FontStackTest::layoutPrimary,
+              &FontStackTest::layoutFallback,
+              &FontStackTest::layoutFallbackFailed,
+              &FontStackTest::fillGlyphCache,
+              &FontStackTest::cacheFull});
+}
+
+/* Font containing characters from given range, with glyph IDs being the
+   character codes and each glyph 4x4 pixels large */
+struct Font: Text::AbstractFont {
+    explicit Font(char32_t first, char32_t last, bool openable = true): first{first}, last{last}, openable{openable} {}
+
+    Text::FontFeatures doFeatures() const override { return Text::FontFeature::OpenData; }
+    bool doIsOpened() const override { return opened; }
+    void doClose() override { opened = false; }
+
+    Properties doOpenData(Containers::ArrayView<const char>, Float size) override {
+        opened = true;
+        return {size, 0.8f*size, -0.2f*size, 1.2f*size};
+    }
+
+    Properties doOpenFile(const std::string&, Float size) override {
+        if(!openable) return {};
+        ++openCount;
+        opened = true;
+        return {size, 0.8f*size, -0.2f*size, 1.2f*size};
+    }
+
+    UnsignedInt doGlyphId(char32_t character) override {
+        return character >= first && character <= last ? UnsignedInt(character) : 0;
+    }
+
+    Vector2 doGlyphAdvance(UnsignedInt glyph) override {
+        return Vector2::xAxis(glyph ? 5.0f : 1.0f);
+    }
+
+    void doFillGlyphCache(Text::AbstractGlyphCache& cache, const std::u32string& characters) override {
+        const std::vector<Range2Di> rectangles = cache.reserve(std::vector<Vector2i>(characters.size(), Vector2i{4}));
+        for(std::size_t i = 0; i != characters.size(); ++i)
+            cache.insert(doGlyphId(characters[i]), {}, rectangles[i]);
+        ++fillCount;
+    }
+
+    Containers::Pointer<Text::AbstractLayouter> doLayout(const Text::AbstractGlyphCache&, Float, const std::string&) override {
+        return nullptr;
+    }
+
+    char32_t first, last;
+    bool openable;
+    bool opened = false;
+    Int openCount = 0, fillCount = 0;
+};
+
+struct GlyphCache: Text::AbstractGlyphCache {
+    using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+    Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+struct Fixture {
+    explicit Fixture(bool fallbackOpenable = true, const Vector2i& cacheSize = Vector2i{64}): cache{cacheSize} {
+        Containers::Pointer<Font> primary{new Font{U'a', U'z'}};
+        Containers::Pointer<Font> fallback{new Font{U'α', U'ω', fallbackOpenable}};
+        this->primary = primary.get();
+        this->fallback = fallback.get();
+        stack.reset(new FontStack{std::move(primary), cache});
+        stack->addFallbackFont(std::move(fallback), "greek.ttf");
+
+        const char data[1]{};
+        stack->openData(data, 10.0f);
+    }
+
+    GlyphCache cache;
+    Font* primary;
+    Font* fallback;
+    Containers::Pointer<FontStack> stack;
+};
+
+void FontStackTest::open() {
+    Fixture f;
+    CORRADE_VERIFY(f.stack->isOpened());
+    CORRADE_VERIFY(f.primary->isOpened());
+    CORRADE_COMPARE(f.stack->size(), 10.0f);
+    CORRADE_COMPARE(f.stack->lineHeight(), 12.0f);
+    CORRADE_COMPARE(f.stack->fallbackCount(), 1);
+
+    /* The fallback isn't opened upfront and nothing is in the cache yet */
+    CORRADE_VERIFY(!f.stack->isFallbackOpened(0));
+    CORRADE_COMPARE(f.cache.glyphCount(), 1);
+}
+
+void FontStackTest::layoutPrimary() {
+    Fixture f;
+    Containers::Pointer<Text::AbstractLayouter> layouter = f.stack->layout(f.cache, 20.0f, "abba");
+    CORRADE_COMPARE(layouter->glyphCount(), 4);
+
+    /* Only the primary font is used and filled just once */
+    CORRADE_VERIFY(!f.stack->isFallbackOpened(0));
+    CORRADE_COMPARE(f.primary->fillCount, 1);
+    CORRADE_COMPARE(f.cache.glyphCount(), 3);
+    CORRADE_COMPARE(f.cache[U'b'].second, Range2Di::fromSize({4, 0}, Vector2i{4}));
+
+    /* Advance is scaled to the layout size */
+    Vector2 cursor;
+    Range2D rectangle;
+    Range2D position;
+    std::tie(position, std::ignore) = layouter->renderGlyph(1, cursor, rectangle);
+    CORRADE_COMPARE(position, Range2D::fromSize({}, Vector2{8.0f}));
+    CORRADE_COMPARE(cursor, Vector2::xAxis(10.0f));
+
+    /* Laying out the same characters again doesn't fill anything */
+    f.stack->layout(f.cache, 20.0f, "ab");
+    CORRADE_COMPARE(f.primary->fillCount, 1);
+}
+
+void FontStackTest::layoutFallback() {
+    Fixture f;
+    Containers::Pointer<Text::AbstractLayouter> layouter = f.stack->layout(f.cache, 10.0f, "aβ");
+    CORRADE_COMPARE(layouter->glyphCount(), 2);
+
+    /* The fallback is opened and its glyph put into a strip above the
+       primary font glyphs */
+    CORRADE_VERIFY(f.stack->isFallbackOpened(0));
+    CORRADE_COMPARE(f.fallback->size(), 10.0f);
+    CORRADE_COMPARE(f.primary->fillCount, 1);
+    CORRADE_COMPARE(f.fallback->fillCount, 1);
+    CORRADE_COMPARE(f.cache.glyphCount(), 3);
+    CORRADE_COMPARE(f.cache[(1 << 16)|U'β'].second, Range2Di::fromSize({0, 4}, Vector2i{4}));
+
+    /* Characters not in any font don't open anything again */
+    f.stack->layout(f.cache, 10.0f, "?");
+    CORRADE_COMPARE(f.fallback->openCount, 1);
+    CORRADE_COMPARE(f.cache.glyphCount(), 3);
+}
+
+void FontStackTest::layoutFallbackFailed() {
+    Fixture f{false};
+
+    std::ostringstream out;
+    Containers::Pointer<Text::AbstractLayouter> layouter;
+    {
+        Warning redirectWarning{&out};
+        layouter = f.stack->layout(f.cache, 10.0f, "aβ");
+    }
+    CORRADE_COMPARE(layouter->glyphCount(), 2);
+    CORRADE_VERIFY(!f.stack->isFallbackOpened(0));
+    CORRADE_COMPARE(f.cache.glyphCount(), 2);
+    CORRADE_COMPARE(out.str(), "Ui::FontStack: can't open fallback font greek.ttf\n");
+
+    /* Not attempted again */
+    out.str({});
+    {
+        Warning redirectWarning{&out};
+        f.stack->layout(f.cache, 10.0f, "γ");
+    }
+    CORRADE_COMPARE(out.str(), "");
+}
+
+void FontStackTest::fillGlyphCache() {
+    Fixture f;
+    f.stack->fillGlyphCache(f.cache, "abγ");
+    CORRADE_COMPARE(f.cache.glyphCount(), 4);
+    CORRADE_VERIFY(f.stack->isFallbackOpened(0));
+
+    /* Laying out doesn't add anything */
+    f.stack->layout(f.cache, 10.0f, "baγ");
+    CORRADE_COMPARE(f.primary->fillCount, 1);
+    CORRADE_COMPARE(f.fallback->fillCount, 1);
+}
+
+void FontStackTest::cacheFull() {
+    Fixture f{true, {8, 4}};
+    f.stack->layout(f.cache, 10.0f, "ab");
+    CORRADE_COMPARE(f.cache.glyphCount(), 3);
+
+    std::ostringstream out;
+    {
+        Warning redirectWarning{&out};
+        f.stack->layout(f.cache, 10.0f, "c");
+    }
+    CORRADE_COMPARE(f.cache.glyphCount(), 3);
+    CORRADE_COMPARE(out.str(), "Ui::FontStack: glyph cache is full, can't add glyphs for c\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::FontStackTest)
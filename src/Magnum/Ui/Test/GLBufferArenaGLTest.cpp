@@ -0,0 +1,185 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Magnum/GL/OpenGLTester.h>
+
+#include "Magnum/Ui/GLBufferArena.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct GLBufferArenaGLTest: GL::OpenGLTester {
+    explicit GLBufferArenaGLTest();
+
+    void allocate();
+    void allocateLarge();
+    void free();
+    void upload();
+    void uploadFreed();
+};
+
+GLBufferArenaGLTest::GLBufferArenaGLTest() {
+    addTests({&GLBufferArenaGLTest::allocate,
+              &GLBufferArenaGLTest::allocateLarge,
+              &GLBufferArenaGLTest::free,
+              &GLBufferArenaGLTest::upload,
+              &GLBufferArenaGLTest::uploadFreed});
+}
+
+void GLBufferArenaGLTest::allocate() {
+    GLBufferArena arena{256};
+    CORRADE_COMPARE(arena.bufferCount(), 0);
+    CORRADE_COMPARE(arena.capacity(), 0);
+
+    GLBufferArena::Allocation a = arena.allocate(100);
+    CORRADE_COMPARE(a.buffer, 0);
+    CORRADE_COMPARE(a.offset, 0);
+    CORRADE_COMPARE(a.size, 112);
+
+    /* Zero-sized allocation still gets some space */
+    GLBufferArena::Allocation b = arena.allocate(0);
+    CORRADE_COMPARE(b.buffer, 0);
+    CORRADE_COMPARE(b.offset, 112);
+    CORRADE_COMPARE(b.size, 16);
+
+    /* Doesn't fit into the rest, a new buffer is created */
+    GLBufferArena::Allocation c = arena.allocate(200);
+    CORRADE_COMPARE(c.buffer, 1);
+    CORRADE_COMPARE(c.offset, 0);
+    CORRADE_COMPARE(c.size, 208);
+    CORRADE_COMPARE(arena.bufferCount(), 2);
+    CORRADE_COMPARE(arena.capacity(), 512);
+
+    /* Fits into the first one again */
+    GLBufferArena::Allocation d = arena.allocate(128);
+    CORRADE_COMPARE(d.buffer, 0);
+    CORRADE_COMPARE(d.offset, 128);
+    CORRADE_COMPARE(d.size, 128);
+    CORRADE_COMPARE(arena.bufferCount(), 2);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void GLBufferArenaGLTest::allocateLarge() {
+    GLBufferArena arena{256};
+
+    /* Larger than the buffer size, gets a buffer of its own */
+    GLBufferArena::Allocation a = arena.allocate(1000);
+    CORRADE_COMPARE(a.buffer, 0);
+    CORRADE_COMPARE(a.offset, 0);
+    CORRADE_COMPARE(a.size, 1008);
+
+    GLBufferArena::Allocation b = arena.allocate(16);
+    CORRADE_COMPARE(b.buffer, 1);
+    CORRADE_COMPARE(b.offset, 0);
+    CORRADE_COMPARE(arena.bufferCount(), 2);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void GLBufferArenaGLTest::free() {
+    GLBufferArena arena{256};
+    GLBufferArena::Allocation a = arena.allocate(64);
+    GLBufferArena::Allocation b = arena.allocate(64);
+    GLBufferArena::Allocation c = arena.allocate(64);
+    CORRADE_COMPARE(c.offset, 128);
+
+    /* Freeing the two neighbors makes a range large enough for 128 bytes */
+    arena.free(a);
+    arena.free(b);
+    GLBufferArena::Allocation d = arena.allocate(128);
+    CORRADE_COMPARE(d.buffer, 0);
+    CORRADE_COMPARE(d.offset, 0);
+
+    /* Freeing everything merges the ranges back into one */
+    arena.free(c);
+    arena.free(d);
+    GLBufferArena::Allocation e = arena.allocate(256);
+    CORRADE_COMPARE(e.buffer, 0);
+    CORRADE_COMPARE(e.offset, 0);
+    CORRADE_COMPARE(arena.bufferCount(), 1);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void GLBufferArenaGLTest::upload() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available on OpenGL ES.");
+    #else
+    GLBufferArena arena{64};
+    GLBufferArena::Allocation a = arena.allocate(16);
+    GLBufferArena::Allocation b = arena.allocate(32);
+
+    const Int zerosA[4]{};
+    const Int zerosB[8]{};
+    arena.queueUpload(a, 0, zerosA);
+    arena.queueUpload(b, 0, zerosB);
+    arena.upload();
+
+    const Int dataA[]{1, 2};
+    const Int dataB[]{3, 4, 5};
+    arena.queueUpload(b, 12, dataB);
+    arena.queueUpload(a, 4, dataA);
+    arena.upload();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::Array<char> out = arena.buffer(0).subData(0, 48);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Int>(out),
+        Containers::arrayView<Int>({0, 1, 2, 0, 0, 0, 0, 3, 4, 5, 0, 0}),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void GLBufferArenaGLTest::uploadFreed() {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_SKIP("Buffer data queries are not available on OpenGL ES.");
+    #else
+    GLBufferArena arena{64};
+    GLBufferArena::Allocation a = arena.allocate(16);
+
+    const Int zeros[4]{};
+    arena.queueUpload(a, 0, zeros);
+    arena.upload();
+    CORRADE_COMPARE(arena.uploadedSize(), 16);
+
+    /* The upload is discarded together with the allocation */
+    const Int data[]{1, 2, 3, 4};
+    arena.queueUpload(a, 0, data);
+    arena.free(a);
+    arena.upload();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(arena.uploadedSize(), 16);
+
+    Containers::Array<char> out = arena.buffer(0).subData(0, 16);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Int>(out),
+        Containers::arrayView<Int>({0, 0, 0, 0}),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::GLBufferArenaGLTest)
@@ -0,0 +1,214 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/Alignment.h>
+
+#include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/ImmediatePlane.h"
+#include "Magnum/Ui/UserInterface.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct ImmediatePlaneGLTest: GL::OpenGLTester {
+    explicit ImmediatePlaneGLTest();
+
+    void declare();
+    void reuse();
+    void changeLayout();
+    void capacity();
+
+    void benchmarkChurn();
+
+    private:
+        PluginManager::Manager<Text::AbstractFont> _manager;
+};
+
+enum: std::size_t {
+    BenchmarkWidgetCount = 10000,
+    /* 1% of the widgets get replaced with different IDs each frame */
+    BenchmarkChurnCount = BenchmarkWidgetCount/100
+};
+
+ImmediatePlaneGLTest::ImmediatePlaneGLTest() {
+    addTests({&ImmediatePlaneGLTest::declare,
+              &ImmediatePlaneGLTest::reuse,
+              &ImmediatePlaneGLTest::changeLayout,
+              &ImmediatePlaneGLTest::capacity});
+
+    addBenchmarks({&ImmediatePlaneGLTest::benchmarkChurn}, 10);
+}
+
+Anchor cellAnchor(const std::size_t i) {
+    return {{}, Range2D::fromSize(Vector2{Float(i%100), Float(i/100)}*10.0f, Vector2{10.0f})};
+}
+
+void ImmediatePlaneGLTest::declare() {
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test");
+
+    UserInterface ui{_manager, {1000.0f, 1000.0f}, {1000, 1000}, {1000, 1000}};
+    ImmediatePlane plane{ui, {{}, ui.size()}, 0, 16, 64};
+
+    for(std::size_t i = 0; i != 10; ++i)
+        plane.label(i, cellAnchor(i), "label", Text::Alignment::LineLeft);
+    CORRADE_VERIFY(!plane.button(10, cellAnchor(10), "button"));
+    plane.numericLabel(11, cellAnchor(11), 3.5, 5, 1, Text::Alignment::LineRight);
+
+    /* All declared widgets are counted right away, but created only at the
+       end of the frame */
+    CORRADE_COMPARE(plane.widgetCount(), 12);
+    plane.endFrame();
+    CORRADE_COMPARE(plane.widgetCount(), 12);
+    CORRADE_COMPARE(plane.pooledWidgetCount(), 0);
+
+    /* Not declaring a widget hides it */
+    for(std::size_t i = 0; i != 10; ++i)
+        plane.label(i, cellAnchor(i), "label", Text::Alignment::LineLeft);
+    plane.numericLabel(11, cellAnchor(11), 4.5, 5, 1, Text::Alignment::LineRight);
+    plane.endFrame();
+    CORRADE_COMPARE(plane.widgetCount(), 11);
+    CORRADE_COMPARE(plane.pooledWidgetCount(), 1);
+}
+
+void ImmediatePlaneGLTest::reuse() {
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test");
+
+    UserInterface ui{_manager, {1000.0f, 1000.0f}, {1000, 1000}, {1000, 1000}};
+    ImmediatePlane plane{ui, {{}, ui.size()}, 0, 16, 64};
+
+    plane.label(0, cellAnchor(0), "a", Text::Alignment::LineLeft);
+    plane.label(1, cellAnchor(1), "b", Text::Alignment::LineLeft);
+    plane.endFrame();
+
+    /* ID 2 takes the place of ID 1 in the same frame, so it gets the hidden
+       widget instead of a new one */
+    plane.label(0, cellAnchor(0), "a", Text::Alignment::LineLeft);
+    plane.label(2, cellAnchor(1), "c", Text::Alignment::LineLeft);
+    plane.endFrame();
+    CORRADE_COMPARE(plane.widgetCount(), 2);
+    CORRADE_COMPARE(plane.pooledWidgetCount(), 0);
+
+    /* A different alignment can't reuse it */
+    plane.label(0, cellAnchor(0), "a", Text::Alignment::LineLeft);
+    plane.label(3, cellAnchor(1), "d", Text::Alignment::LineRight);
+    plane.endFrame();
+    CORRADE_COMPARE(plane.widgetCount(), 2);
+    CORRADE_COMPARE(plane.pooledWidgetCount(), 1);
+}
+
+void ImmediatePlaneGLTest::changeLayout() {
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test");
+
+    UserInterface ui{_manager, {1000.0f, 1000.0f}, {1000, 1000}, {1000, 1000}};
+    ImmediatePlane plane{ui, {{}, ui.size()}, 0, 16, 64};
+
+    plane.numericLabel(0, cellAnchor(0), 1.0, 5, 0, Text::Alignment::LineLeft);
+    plane.endFrame();
+
+    /* Same ID with a different position gets a new widget, the original one
+       is kept for reuse */
+    plane.numericLabel(0, cellAnchor(1), 1.0, 5, 0, Text::Alignment::LineLeft);
+    plane.endFrame();
+    CORRADE_COMPARE(plane.widgetCount(), 1);
+    CORRADE_COMPARE(plane.pooledWidgetCount(), 1);
+
+    /* Moving it back picks the original widget again */
+    plane.numericLabel(0, cellAnchor(0), 1.0, 5, 0, Text::Alignment::LineLeft);
+    plane.endFrame();
+    CORRADE_COMPARE(plane.widgetCount(), 1);
+    CORRADE_COMPARE(plane.pooledWidgetCount(), 1);
+
+    /* Numeric labels need the width to match exactly */
+    plane.numericLabel(0, cellAnchor(0), 1.0, 4, 0, Text::Alignment::LineLeft);
+    plane.endFrame();
+    CORRADE_COMPARE(plane.widgetCount(), 1);
+    CORRADE_COMPARE(plane.pooledWidgetCount(), 2);
+}
+
+void ImmediatePlaneGLTest::capacity() {
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test");
+
+    UserInterface ui{_manager, {1000.0f, 1000.0f}, {1000, 1000}, {1000, 1000}};
+    ImmediatePlane plane{ui, {{}, ui.size()}, 0, 16, 64};
+
+    plane.label(0, cellAnchor(0), "abc", Text::Alignment::LineLeft, 8);
+    plane.endFrame();
+
+    /* Text fitting into the capacity keeps the widget */
+    plane.label(0, cellAnchor(0), "abcdefgh", Text::Alignment::LineLeft);
+    plane.endFrame();
+    CORRADE_COMPARE(plane.pooledWidgetCount(), 0);
+
+    /* Exceeding it needs a new widget */
+    plane.label(0, cellAnchor(0), "abcdefghi", Text::Alignment::LineLeft);
+    plane.endFrame();
+    CORRADE_COMPARE(plane.widgetCount(), 1);
+    CORRADE_COMPARE(plane.pooledWidgetCount(), 1);
+}
+
+void ImmediatePlaneGLTest::benchmarkChurn() {
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot benchmark");
+
+    UserInterface ui{_manager, {1000.0f, 1000.0f}, {1000, 1000}, {1000, 1000}};
+    ImmediatePlane plane{ui, {{}, ui.size()}, 0, BenchmarkWidgetCount, BenchmarkWidgetCount};
+
+    /* Each cell shows one digit, the ID changes every time the cell gets
+       churned */
+    Containers::Array<UnsignedLong> generations{Containers::ValueInit, BenchmarkWidgetCount};
+    const char digits[] = "0123456789";
+    std::size_t frame = 0;
+    auto declare = [&]() {
+        for(std::size_t i = 0; i != BenchmarkChurnCount; ++i)
+            ++generations[(frame*BenchmarkChurnCount + i)%BenchmarkWidgetCount];
+        for(std::size_t i = 0; i != BenchmarkWidgetCount; ++i)
+            plane.label(i + generations[i]*BenchmarkWidgetCount, cellAnchor(i), Containers::ArrayView<const char>{digits + (i + generations[i])%10, 1}, Text::Alignment::LineLeft);
+        plane.endFrame();
+        plane.update();
+        ++frame;
+    };
+
+    /* Create all widgets first */
+    declare();
+    CORRADE_COMPARE(plane.widgetCount(), BenchmarkWidgetCount);
+
+    CORRADE_BENCHMARK(1) declare();
+
+    /* The churned IDs reuse the hidden widgets instead of creating new
+       ones */
+    CORRADE_COMPARE(plane.widgetCount(), BenchmarkWidgetCount);
+    CORRADE_COMPARE(plane.pooledWidgetCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::ImmediatePlaneGLTest)
@@ -0,0 +1,179 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Magnum/Image.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/Alignment.h>
+
+#include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/NumericLabel.h"
+#include "Magnum/Ui/Plane.h"
+#include "Magnum/Ui/UserInterface.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct NumericLabelGLTest: GL::OpenGLTester {
+    explicit NumericLabelGLTest();
+
+    void setValue();
+    void verticalAlignment();
+
+    private:
+        PluginManager::Manager<Text::AbstractFont> _manager;
+        GL::Renderbuffer _color{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+};
+
+constexpr Vector2i Size{128, 64};
+
+const struct {
+    const char* name;
+    Text::Alignment alignment;
+    bool middle;
+} VerticalAlignmentData[]{
+    {"top", Text::Alignment::TopRight, false},
+    {"middle", Text::Alignment::MiddleRight, true}
+};
+
+NumericLabelGLTest::NumericLabelGLTest() {
+    addTests({&NumericLabelGLTest::setValue});
+
+    addInstancedTests({&NumericLabelGLTest::verticalAlignment},
+        Containers::arraySize(VerticalAlignmentData));
+
+    _color = GL::Renderbuffer{};
+    _color.setStorage(GL::RenderbufferFormat::RGBA8, Size);
+    _framebuffer = GL::Framebuffer{{{}, Size}};
+    _framebuffer.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color);
+}
+
+/* Draws a label showing given value, optionally set to each of
+   valueSequence in turn after, and saves its rectangle to rect, if not
+   null. The UI size matches the framebuffer size, so the rectangle is in
+   pixels. */
+Image2D drawLabel(PluginManager::Manager<Text::AbstractFont>& manager, GL::Framebuffer& framebuffer, const Double value, const Text::Alignment alignment, const Containers::ArrayView<const Double> valueSequence = {}, Range2D* const rect = nullptr) {
+    UserInterface ui{manager, Vector2{Size}, Size, Size};
+    ui.setFramebuffer(framebuffer);
+    Plane plane{ui, {{}, ui.size()}, 8, 8, 64};
+    NumericLabel label{plane, {{}, {96.0f, 32.0f}}, value, 8, 2, alignment};
+    if(rect) *rect = label.rect();
+
+    /* Draw in between the changes so the plane uploads only the modified
+       parts of the layer each time */
+    framebuffer.bind();
+    for(const Double next: valueSequence) {
+        ui.draw();
+        label.setValue(next);
+    }
+
+    GL::Renderer::enable(GL::Renderer::Feature::Blending);
+    GL::Renderer::setBlendFunction(GL::Renderer::BlendFunction::One, GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+    /* Clearing a particular attachment isn't available on ES2 */
+    GL::Renderer::setClearColor(Color4{});
+    framebuffer
+        .clear(GL::FramebufferClear::Color)
+        .bind();
+    ui.draw();
+    GL::Renderer::disable(GL::Renderer::Feature::Blending);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    return framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+}
+
+UnsignedInt maxDifference(const Image2D& a, const Image2D& b) {
+    UnsignedInt difference = 0;
+    const Containers::StridedArrayView2D<const Color4ub> pixelsA = a.pixels<Color4ub>();
+    const Containers::StridedArrayView2D<const Color4ub> pixelsB = b.pixels<Color4ub>();
+    for(std::size_t y = 0; y != pixelsA.size()[0]; ++y)
+        for(std::size_t x = 0; x != pixelsA.size()[1]; ++x)
+            for(std::size_t i = 0; i != 4; ++i)
+                difference = Math::max(difference, UnsignedInt(Math::abs(Int(pixelsA[y][x][i]) - Int(pixelsB[y][x][i]))));
+    return difference;
+}
+
+void NumericLabelGLTest::setValue() {
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test");
+
+    /* Going through a shorter value, a value that doesn't fit into the
+       capacity and back, each time patching only the changed glyphs, should
+       end up the same as showing the final value right away */
+    const Double values[]{-7.5, 1234567.0, 12.25, -7.5};
+    const Image2D patched = drawLabel(_manager, _framebuffer, 123.45, Text::Alignment::LineRight, values);
+    const Image2D expected = drawLabel(_manager, _framebuffer, -7.5, Text::Alignment::LineRight);
+    CORRADE_COMPARE_AS(maxDifference(patched, expected), 1, TestSuite::Compare::LessOrEqual);
+
+    /* Something got actually drawn and the overflow is shown differently */
+    const Image2D empty{PixelFormat::RGBA8Unorm, Size, Containers::Array<char>{Containers::ValueInit, std::size_t(Size.product()*4)}};
+    CORRADE_VERIFY(maxDifference(expected, empty) > 0);
+    const Image2D overflow = drawLabel(_manager, _framebuffer, 1234567.0, Text::Alignment::LineRight);
+    CORRADE_VERIFY(maxDifference(overflow, expected) > 0);
+}
+
+void NumericLabelGLTest::verticalAlignment() {
+    auto&& data = VerticalAlignmentData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test");
+
+    /* Same as a Label, the glyphs should touch the top of the widget or be
+       centered in it */
+    Range2D rect;
+    const Image2D image = drawLabel(_manager, _framebuffer, 88.0, data.alignment, {}, &rect);
+    const Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    Int first = -1, last = -1;
+    for(std::size_t y = 0; y != pixels.size()[0]; ++y) {
+        for(std::size_t x = 0; x != pixels.size()[1]; ++x) {
+            if(pixels[y][x].a() < 128) continue;
+            if(first == -1) first = Int(y);
+            last = Int(y) + 1;
+            break;
+        }
+    }
+    CORRADE_VERIFY(first != -1);
+
+    if(data.middle)
+        CORRADE_COMPARE_WITH((first + last)*0.5f, rect.centerY(), TestSuite::Compare::around(2.0f));
+    else
+        CORRADE_COMPARE_WITH(Float(last), rect.top(), TestSuite::Compare::around(2.0f));
+}
+
+}}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Ui::Test::NumericLabelGLTest)
@@ -0,0 +1,105 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <limits>
+#include <string>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Ui/Implementation/NumericFormat.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct NumericLabelTest: TestSuite::Tester {
+    explicit NumericLabelTest();
+
+    void format();
+    void formatDoesNotFit();
+};
+
+const struct {
+    const char* name;
+    Double value;
+    std::size_t width;
+    Int precision;
+    const char* expected;
+} FormatData[]{
+    {"zero", 0.0, 4, 0, "   0"},
+    {"integer", 1337.0, 6, 0, "  1337"},
+    {"exactly fitting", 1337.0, 4, 0, "1337"},
+    {"negative", -42.0, 4, 0, " -42"},
+    {"rounded", 2.5, 3, 0, "  3"},
+    {"precision", 3.14159, 6, 2, "  3.14"},
+    {"precision, rounded up", 0.996, 5, 2, " 1.00"},
+    {"precision, leading zero", 0.05, 5, 2, " 0.05"},
+    {"precision, negative", -12.5, 6, 1, " -12.5"},
+    {"negative rounding to zero", -0.001, 5, 2, " 0.00"},
+};
+
+const struct {
+    const char* name;
+    Double value;
+    std::size_t width;
+    Int precision;
+} FormatDoesNotFitData[]{
+    {"too many digits", 12345.0, 4, 0},
+    {"no space for the sign", -1234.0, 4, 0},
+    {"no space for the decimal point", 1.5, 2, 1},
+    {"no space for the integer part", 0.5, 2, 1},
+    {"too large", 1.0e30, 32, 0},
+    {"infinity", std::numeric_limits<Double>::infinity(), 8, 0},
+    {"NaN", std::numeric_limits<Double>::quiet_NaN(), 8, 0},
+};
+
+NumericLabelTest::NumericLabelTest() {
+    addInstancedTests({&NumericLabelTest::format},
+        Containers::arraySize(FormatData));
+
+    addInstancedTests({&NumericLabelTest::formatDoesNotFit},
+        Containers::arraySize(FormatDoesNotFitData));
+}
+
+void NumericLabelTest::format() {
+    auto&& data = FormatData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    char out[32];
+    CORRADE_VERIFY(Implementation::formatNumericValue({out, data.width}, data.value, data.precision));
+    CORRADE_COMPARE((std::string{out, data.width}), data.expected);
+}
+
+void NumericLabelTest::formatDoesNotFit() {
+    auto&& data = FormatDoesNotFitData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    char out[32];
+    CORRADE_VERIFY(!Implementation::formatNumericValue({out, data.width}, data.value, data.precision));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::NumericLabelTest)
@@ -0,0 +1,371 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/AbstractGlyphCache.h>
+#include <Magnum/Text/Alignment.h>
+
+#include "Magnum/Ui/TextLayout.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct TextLayoutTest: TestSuite::Tester {
+    explicit TextLayoutTest();
+
+    void setText();
+    void layout();
+    void layoutCached();
+    void wrap();
+    void wrapLongWord();
+    void clipLines();
+    void clipLinesEllipsis();
+    void clipWidth();
+    void clipWidthEllipsis();
+    void maxGlyphCount();
+    void render();
+    void renderAligned();
+
+    void debugFlag();
+    void debugFlags();
+};
+
+TextLayoutTest::TextLayoutTest() {
+    addTests({&TextLayoutTest::setText,
+              &TextLayoutTest::layout,
+              &TextLayoutTest::layoutCached,
+              &TextLayoutTest::wrap,
+              &TextLayoutTest::wrapLongWord,
+              &TextLayoutTest::clipLines,
+              &TextLayoutTest::clipLinesEllipsis,
+              &TextLayoutTest::clipWidth,
+              &TextLayoutTest::clipWidthEllipsis,
+              &TextLayoutTest::maxGlyphCount,
+              &TextLayoutTest::render,
+              &TextLayoutTest::renderAligned,
+
+              &TextLayoutTest::debugFlag,
+              &TextLayoutTest::debugFlags});
+}
+
+/* Monospace font with each glyph having an advance of its size, ascent of
+   0.8 and descent of 0.2 of the size */
+struct Layouter: Text::AbstractLayouter {
+    explicit Layouter(Float size, UnsignedInt glyphCount): Text::AbstractLayouter{glyphCount}, size{size} {}
+
+    std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt) override {
+        return std::make_tuple(Range2D{{0.0f, -0.2f*size}, {size, 0.8f*size}}, Range2D{{}, Vector2{1.0f}}, Vector2::xAxis(size));
+    }
+
+    Float size;
+};
+
+struct Font: Text::AbstractFont {
+    Text::FontFeatures doFeatures() const override { return Text::FontFeature::OpenData; }
+    bool doIsOpened() const override { return opened; }
+    void doClose() override { opened = false; }
+
+    Properties doOpenData(Containers::ArrayView<const char>, Float size) override {
+        opened = true;
+        return {size, 0.8f*size, -0.2f*size, 1.2f*size};
+    }
+
+    UnsignedInt doGlyphId(char32_t) override { return 0; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+    Containers::Pointer<Text::AbstractLayouter> doLayout(const Text::AbstractGlyphCache&, Float size, const std::string& text) override {
+        /* All test strings are ASCII */
+        return Containers::pointer<Layouter>(size, UnsignedInt(text.size()));
+    }
+
+    bool opened = false;
+};
+
+struct GlyphCache: Text::AbstractGlyphCache {
+    using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+    Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+struct Fixture {
+    explicit Fixture() {
+        const char data[1]{};
+        font.openData(data, 10.0f);
+    }
+
+    Font font;
+    GlyphCache cache{Vector2i{16}};
+};
+
+void TextLayoutTest::setText() {
+    Fixture f;
+    TextLayout layout;
+    CORRADE_COMPARE(layout.shapedGlyphCount(), 0);
+
+    layout.setText(f.font, f.cache, 10.0f, "ab cd\n\nef");
+    /* The newlines don't get shaped */
+    CORRADE_COMPARE(layout.shapedGlyphCount(), 7);
+    CORRADE_COMPARE(layout.lineHeight(), 12.0f);
+    CORRADE_VERIFY(layout.lines().empty());
+}
+
+void TextLayoutTest::layout() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "ab cd \n\nef");
+    CORRADE_VERIFY(layout.layout(0.0f));
+
+    CORRADE_COMPARE(layout.lines().size(), 3);
+    /* The trailing space is not counted */
+    CORRADE_COMPARE(layout.lines()[0].glyphOffset, 0);
+    CORRADE_COMPARE(layout.lines()[0].glyphCount, 5);
+    CORRADE_COMPARE(layout.lines()[0].width, 50.0f);
+    CORRADE_COMPARE(layout.lines()[1].glyphCount, 0);
+    CORRADE_COMPARE(layout.lines()[2].glyphOffset, 6);
+    CORRADE_COMPARE(layout.lines()[2].glyphCount, 2);
+    CORRADE_COMPARE(layout.lines()[2].width, 20.0f);
+    CORRADE_COMPARE(layout.glyphCount(), 7);
+    CORRADE_COMPARE(layout.size(), (Vector2{50.0f, 34.0f}));
+}
+
+void TextLayoutTest::layoutCached() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "aaa bbb");
+    CORRADE_VERIFY(layout.layout(35.0f, 0, TextLayoutFlag::Wrap));
+    CORRADE_VERIFY(!layout.layout(35.0f, 0, TextLayoutFlag::Wrap));
+    CORRADE_COMPARE(layout.lines().size(), 2);
+
+    /* Different width lays out again without shaping */
+    CORRADE_VERIFY(layout.layout(100.0f, 0, TextLayoutFlag::Wrap));
+    CORRADE_COMPARE(layout.lines().size(), 1);
+
+    /* Setting text discards the layout */
+    layout.setText(f.font, f.cache, 10.0f, "aaa bbb");
+    CORRADE_VERIFY(layout.lines().empty());
+    CORRADE_VERIFY(layout.layout(100.0f, 0, TextLayoutFlag::Wrap));
+}
+
+void TextLayoutTest::wrap() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "aaa bbb  ccc");
+
+    layout.layout(75.0f, 0, TextLayoutFlag::Wrap);
+    CORRADE_COMPARE(layout.lines().size(), 2);
+    CORRADE_COMPARE(layout.lines()[0].glyphOffset, 0);
+    CORRADE_COMPARE(layout.lines()[0].glyphCount, 7);
+    /* Both spaces are skipped */
+    CORRADE_COMPARE(layout.lines()[1].glyphOffset, 9);
+    CORRADE_COMPARE(layout.lines()[1].glyphCount, 3);
+
+    layout.layout(65.0f, 0, TextLayoutFlag::Wrap);
+    CORRADE_COMPARE(layout.lines().size(), 3);
+    CORRADE_COMPARE(layout.lines()[0].glyphCount, 3);
+    CORRADE_COMPARE(layout.lines()[1].glyphOffset, 4);
+    CORRADE_COMPARE(layout.lines()[1].glyphCount, 3);
+    CORRADE_COMPARE(layout.lines()[1].width, 30.0f);
+    CORRADE_COMPARE(layout.lines()[2].glyphOffset, 9);
+}
+
+void TextLayoutTest::wrapLongWord() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "abcdefgh");
+
+    layout.layout(35.0f, 0, TextLayoutFlag::Wrap);
+    CORRADE_COMPARE(layout.lines().size(), 3);
+    CORRADE_COMPARE(layout.lines()[0].glyphCount, 3);
+    CORRADE_COMPARE(layout.lines()[1].glyphOffset, 3);
+    CORRADE_COMPARE(layout.lines()[1].glyphCount, 3);
+    CORRADE_COMPARE(layout.lines()[2].glyphOffset, 6);
+    CORRADE_COMPARE(layout.lines()[2].glyphCount, 2);
+
+    /* Narrower than a glyph, there's still one glyph on each line */
+    layout.layout(5.0f, 0, TextLayoutFlag::Wrap);
+    CORRADE_COMPARE(layout.lines().size(), 8);
+}
+
+void TextLayoutTest::clipLines() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "aaa bbb ccc");
+
+    layout.layout(35.0f, 2, TextLayoutFlag::Wrap);
+    CORRADE_COMPARE(layout.lines().size(), 2);
+    CORRADE_COMPARE(layout.lines()[1].glyphCount, 3);
+    CORRADE_VERIFY(!layout.lines()[1].ellipsis);
+    CORRADE_COMPARE(layout.glyphCount(), 6);
+}
+
+void TextLayoutTest::clipLinesEllipsis() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "aaa bbb ccc");
+
+    /* The ellipsis fits after the last line */
+    layout.layout(65.0f, 2, TextLayoutFlag::Wrap|TextLayoutFlag::Ellipsis);
+    CORRADE_COMPARE(layout.lines().size(), 2);
+    CORRADE_COMPARE(layout.lines()[1].glyphCount, 3);
+    CORRADE_VERIFY(layout.lines()[1].ellipsis);
+    CORRADE_COMPARE(layout.lines()[1].width, 60.0f);
+    CORRADE_COMPARE(layout.glyphCount(), 9);
+
+    /* Glyphs get removed to make space for the ellipsis */
+    layout.layout(45.0f, 1, TextLayoutFlag::Wrap|TextLayoutFlag::Ellipsis);
+    CORRADE_COMPARE(layout.lines().size(), 1);
+    CORRADE_COMPARE(layout.lines()[0].glyphCount, 1);
+    CORRADE_VERIFY(layout.lines()[0].ellipsis);
+    CORRADE_COMPARE(layout.lines()[0].width, 40.0f);
+
+    /* Everything fits, no ellipsis */
+    layout.layout(200.0f, 1, TextLayoutFlag::Wrap|TextLayoutFlag::Ellipsis);
+    CORRADE_COMPARE(layout.lines().size(), 1);
+    CORRADE_VERIFY(!layout.lines()[0].ellipsis);
+}
+
+void TextLayoutTest::clipWidth() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "abcdefgh\nab");
+
+    layout.layout(55.0f);
+    CORRADE_COMPARE(layout.lines().size(), 2);
+    CORRADE_COMPARE(layout.lines()[0].glyphCount, 5);
+    CORRADE_COMPARE(layout.lines()[0].width, 50.0f);
+    CORRADE_VERIFY(!layout.lines()[0].ellipsis);
+    CORRADE_COMPARE(layout.lines()[1].glyphOffset, 8);
+    CORRADE_COMPARE(layout.lines()[1].glyphCount, 2);
+}
+
+void TextLayoutTest::clipWidthEllipsis() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "abcdefgh\nab");
+
+    layout.layout(55.0f, 0, TextLayoutFlag::Ellipsis);
+    CORRADE_COMPARE(layout.lines().size(), 2);
+    CORRADE_COMPARE(layout.lines()[0].glyphCount, 2);
+    CORRADE_COMPARE(layout.lines()[0].width, 50.0f);
+    CORRADE_VERIFY(layout.lines()[0].ellipsis);
+    CORRADE_VERIFY(!layout.lines()[1].ellipsis);
+    CORRADE_COMPARE(layout.glyphCount(), 7);
+}
+
+void TextLayoutTest::maxGlyphCount() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "aaa bbb ccc");
+    CORRADE_COMPARE(layout.maxGlyphCount(1), 14);
+    CORRADE_COMPARE(layout.maxGlyphCount(2), 17);
+    /* A line for each glyph and paragraph */
+    CORRADE_COMPARE(layout.maxGlyphCount(0), 11 + 12*3);
+
+    /* Truncated to a single glyph and an ellipsis */
+    layout.layout(45.0f, 1, TextLayoutFlag::Wrap|TextLayoutFlag::Ellipsis);
+    CORRADE_COMPARE(layout.glyphCount(), 4);
+
+    /* Widening it makes more glyphs visible, but still within the bound --
+       this is what Label::setTextWidth() relies on */
+    layout.layout(65.0f, 1, TextLayoutFlag::Wrap|TextLayoutFlag::Ellipsis);
+    CORRADE_COMPARE(layout.glyphCount(), 6);
+    CORRADE_VERIFY(layout.glyphCount() <= layout.maxGlyphCount(1));
+
+    layout.layout(200.0f, 1, TextLayoutFlag::Wrap|TextLayoutFlag::Ellipsis);
+    CORRADE_COMPARE(layout.glyphCount(), 11);
+    CORRADE_VERIFY(layout.glyphCount() <= layout.maxGlyphCount(1));
+
+    /* Same without wrapping, where each line can get clipped */
+    layout.layout(45.0f, 0, TextLayoutFlag::Ellipsis);
+    CORRADE_VERIFY(layout.glyphCount() <= layout.maxGlyphCount(0));
+}
+
+void TextLayoutTest::render() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "ab\nc");
+    layout.layout(0.0f);
+
+    Containers::Array<Vector2> positions{12};
+    Containers::Array<Vector2> textureCoordinates{12};
+    layout.render({100.0f, 200.0f}, Text::Alignment::LineLeft, positions, textureCoordinates);
+    CORRADE_COMPARE_AS(positions, Containers::arrayView<Vector2>({
+        {100.0f, 208.0f}, {100.0f, 198.0f}, {110.0f, 208.0f}, {110.0f, 198.0f},
+        {110.0f, 208.0f}, {110.0f, 198.0f}, {120.0f, 208.0f}, {120.0f, 198.0f},
+        {100.0f, 196.0f}, {100.0f, 186.0f}, {110.0f, 196.0f}, {110.0f, 186.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(textureCoordinates.prefix(4), Containers::arrayView<Vector2>({
+        {0.0f, 1.0f}, {0.0f, 0.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void TextLayoutTest::renderAligned() {
+    Fixture f;
+    TextLayout layout;
+    layout.setText(f.font, f.cache, 10.0f, "ab\nc");
+    layout.layout(0.0f);
+    CORRADE_COMPARE(layout.size(), (Vector2{20.0f, 22.0f}));
+
+    Containers::Array<Vector2> positions{12};
+    Containers::Array<Vector2> textureCoordinates{12};
+
+    /* Top left corner of the first line at the cursor, each line aligned
+       separately */
+    layout.render({100.0f, 200.0f}, Text::Alignment::TopRight, positions, textureCoordinates);
+    CORRADE_COMPARE(positions[0], (Vector2{80.0f, 200.0f}));
+    CORRADE_COMPARE(positions[8], (Vector2{90.0f, 188.0f}));
+
+    /* The whole block centered around the cursor */
+    layout.render({100.0f, 200.0f}, Text::Alignment::MiddleCenter, positions, textureCoordinates);
+    CORRADE_COMPARE(positions[0], (Vector2{90.0f, 211.0f}));
+    CORRADE_COMPARE(positions[8], (Vector2{95.0f, 199.0f}));
+    CORRADE_COMPARE(positions[11], (Vector2{105.0f, 189.0f}));
+}
+
+void TextLayoutTest::debugFlag() {
+    std::ostringstream out;
+
+    Debug{&out} << TextLayoutFlag::Ellipsis << TextLayoutFlag(0xde);
+    CORRADE_COMPARE(out.str(), "Ui::TextLayoutFlag::Ellipsis Ui::TextLayoutFlag(0xde)\n");
+}
+
+void TextLayoutTest::debugFlags() {
+    std::ostringstream out;
+
+    Debug{&out} << TextLayoutFlags{} << (TextLayoutFlag::Wrap|TextLayoutFlag::Ellipsis) << (TextLayoutFlag(0xd0)|TextLayoutFlag::Wrap);
+    CORRADE_COMPARE(out.str(), "Ui::TextLayoutFlags{} Ui::TextLayoutFlag::Wrap|Ui::TextLayoutFlag::Ellipsis Ui::TextLayoutFlag::Wrap|Ui::TextLayoutFlag(0xd0)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::TextLayoutTest)
@@ -0,0 +1,163 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#include <vector>
+#endif
+
+#include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/BasicUserInterface.hpp"
+#include "Magnum/Ui/BasicPlane.hpp"
+#include "Magnum/Ui/UpdateQueue.h"
+#include "Magnum/Ui/Widget.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct UpdateQueueTest: TestSuite::Tester {
+    explicit UpdateQueueTest();
+
+    void empty();
+    void visible();
+    void collapse();
+    void userInterfaceUpdate();
+    void multipleThreads();
+};
+
+UpdateQueueTest::UpdateQueueTest() {
+    addTests({&UpdateQueueTest::empty,
+              &UpdateQueueTest::visible,
+              &UpdateQueueTest::collapse,
+              &UpdateQueueTest::userInterfaceUpdate,
+              &UpdateQueueTest::multipleThreads});
+}
+
+struct UserInterface: BasicUserInterface<> {
+    using BasicUserInterface::BasicUserInterface;
+};
+
+struct Plane: BasicPlane<> {
+    using BasicPlane::BasicPlane;
+};
+
+struct Widget: Ui::Widget {
+    using Ui::Widget::Widget;
+};
+
+void UpdateQueueTest::empty() {
+    UpdateQueue queue;
+    CORRADE_VERIFY(queue.isEmpty());
+    CORRADE_COMPARE(queue.apply(), 0);
+}
+
+void UpdateQueueTest::visible() {
+    UserInterface ui{{800.0f, 600.0f}, {800, 600}};
+    Plane plane{ui, {Snap::Left|Snap::Top, {400.0f, 300.0f}}, {}, {}};
+    Widget a{plane, {Snap::Bottom|Snap::Right, {100.0f, 100.0f}}};
+
+    UpdateQueue queue;
+    queue.setVisible(a, false);
+    CORRADE_VERIFY(!queue.isEmpty());
+
+    /* Nothing is applied until apply() is called */
+    CORRADE_COMPARE(a.flags(), WidgetFlags{});
+
+    CORRADE_COMPARE(queue.apply(), 1);
+    CORRADE_VERIFY(queue.isEmpty());
+    CORRADE_COMPARE(a.flags(), WidgetFlag::Hidden);
+
+    /* Second apply does nothing */
+    CORRADE_COMPARE(queue.apply(), 0);
+    CORRADE_COMPARE(a.flags(), WidgetFlag::Hidden);
+}
+
+void UpdateQueueTest::collapse() {
+    UserInterface ui{{800.0f, 600.0f}, {800, 600}};
+    Plane plane{ui, {Snap::Left|Snap::Top, {400.0f, 300.0f}}, {}, {}};
+    Widget a{plane, {Snap::Bottom|Snap::Right, {100.0f, 100.0f}}};
+    Widget b{plane, {Snap::Left, a, {100.0f, 100.0f}}};
+    b.hide();
+
+    UpdateQueue queue;
+    queue.setVisible(a, false)
+         .setVisible(b, true)
+         .setVisible(a, true)
+         .setVisible(a, false);
+
+    /* Only the latest update for each widget gets applied */
+    CORRADE_COMPARE(queue.apply(), 2);
+    CORRADE_COMPARE(a.flags(), WidgetFlag::Hidden);
+    CORRADE_COMPARE(b.flags(), WidgetFlags{});
+}
+
+void UpdateQueueTest::userInterfaceUpdate() {
+    UserInterface ui{{800.0f, 600.0f}, {800, 600}};
+    Plane plane{ui, {Snap::Left|Snap::Top, {400.0f, 300.0f}}, {}, {}};
+    Widget a{plane, {Snap::Bottom|Snap::Right, {100.0f, 100.0f}}};
+
+    ui.updateQueue().setVisible(a, false);
+    CORRADE_COMPARE(a.flags(), WidgetFlags{});
+
+    ui.update();
+    CORRADE_VERIFY(ui.updateQueue().isEmpty());
+    CORRADE_COMPARE(a.flags(), WidgetFlag::Hidden);
+}
+
+void UpdateQueueTest::multipleThreads() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not available on Emscripten.");
+    #else
+    UserInterface ui{{800.0f, 600.0f}, {800, 600}};
+    Plane plane{ui, {Snap::Left|Snap::Top, {400.0f, 300.0f}}, {}, {}};
+    Widget a{plane, {Snap::Bottom|Snap::Right, {100.0f, 100.0f}}};
+    Widget b{plane, {Snap::Left, a, {100.0f, 100.0f}}};
+    Widget c{plane, {Snap::Left, b, {100.0f, 100.0f}}};
+    Widget d{plane, {Snap::Left, c, {100.0f, 100.0f}}};
+    Widget* const widgets[]{&a, &b, &c, &d};
+
+    /* Each thread toggles its own widget many times, ending with it hidden
+       for even threads and visible for odd */
+    UpdateQueue queue;
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != 4; ++i) threads.emplace_back([&queue, &widgets, i] {
+        for(std::size_t j = 0; j != 1000; ++j)
+            queue.setVisible(*widgets[i], j % 2 == i % 2);
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(queue.apply(), 4);
+    CORRADE_COMPARE(a.flags(), WidgetFlag::Hidden);
+    CORRADE_COMPARE(b.flags(), WidgetFlags{});
+    CORRADE_COMPARE(c.flags(), WidgetFlag::Hidden);
+    CORRADE_COMPARE(d.flags(), WidgetFlags{});
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::UpdateQueueTest)
@@ -0,0 +1,196 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Magnum/Image.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/Alignment.h>
+
+#include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/Button.h"
+#include "Magnum/Ui/Input.h"
+#include "Magnum/Ui/Label.h"
+#include "Magnum/Ui/Plane.h"
+#include "Magnum/Ui/UserInterface.h"
+#include "Magnum/Ui/WidgetStateChange.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct WidgetStateChangeGLTest: GL::OpenGLTester {
+    explicit WidgetStateChangeGLTest();
+
+    void commit();
+
+    private:
+        PluginManager::Manager<Text::AbstractFont> _manager;
+        GL::Renderbuffer _color{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+};
+
+constexpr Vector2i Size{256, 128};
+
+/* Builtin widgets on two planes, so the changes have to be grouped by plane.
+   The UI size matches the framebuffer size. */
+struct Scene {
+    explicit Scene(PluginManager::Manager<Text::AbstractFont>& manager, GL::Framebuffer& framebuffer): ui{manager, Vector2{Size}, Size, Size} {
+        ui.setFramebuffer(framebuffer);
+        right.activate();
+    }
+
+    UserInterface ui;
+    Plane left{ui, {Snap::Left, {128.0f, 128.0f}}, 8, 8, 64};
+    Plane right{ui, {Snap::Right, {128.0f, 128.0f}}, 8, 8, 64};
+    Button button{left, {Snap::Top, {96.0f, 32.0f}}, "Left", Style::Primary};
+    Input input{left, {Snap::Bottom, {96.0f, 32.0f}}, "input", 8};
+    Label label{right, {Snap::Top, {96.0f, 32.0f}}, "Right", Text::Alignment::LineCenter};
+    Button another{right, {Snap::Bottom, {96.0f, 32.0f}}, "Right"};
+};
+
+const struct {
+    const char* name;
+    std::size_t changed;
+    std::size_t(*batched)(Scene&);
+    void(*individual)(Scene&);
+} CommitData[]{
+    {"across planes", 4,
+        [](Scene& s) {
+            return WidgetStateChange{}
+                .hide({s.button, s.label})
+                .disable({s.input, s.another})
+                .commit();
+        },
+        [](Scene& s) {
+            s.button.hide();
+            s.label.hide();
+            s.input.disable();
+            s.another.disable();
+        }},
+    {"multiple changes of one widget", 2,
+        [](Scene& s) {
+            return WidgetStateChange{}
+                .hide(s.button)
+                .disable(s.input)
+                .disable(s.button)
+                .hide(s.label)
+                .show(s.button)
+                .enable(s.input)
+                .commit();
+        },
+        [](Scene& s) {
+            s.button.disable();
+            s.label.hide();
+        }},
+    {"unchanged", 0,
+        [](Scene& s) {
+            return WidgetStateChange{}
+                .hide({s.button, s.another})
+                .show({s.another, s.button})
+                .commit();
+        },
+        [](Scene&) {}}
+};
+
+WidgetStateChangeGLTest::WidgetStateChangeGLTest() {
+    addInstancedTests({&WidgetStateChangeGLTest::commit},
+        Containers::arraySize(CommitData));
+
+    _color = GL::Renderbuffer{};
+    _color.setStorage(GL::RenderbufferFormat::RGBA8, Size);
+    _framebuffer = GL::Framebuffer{{{}, Size}};
+    _framebuffer.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color);
+}
+
+Image2D draw(GL::Framebuffer& framebuffer, UserInterface& ui) {
+    GL::Renderer::enable(GL::Renderer::Feature::Blending);
+    GL::Renderer::setBlendFunction(GL::Renderer::BlendFunction::One, GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+    /* Clearing a particular attachment isn't available on ES2 */
+    GL::Renderer::setClearColor(Color4{});
+    framebuffer
+        .clear(GL::FramebufferClear::Color)
+        .bind();
+    ui.draw();
+    GL::Renderer::disable(GL::Renderer::Feature::Blending);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    return framebuffer.read(framebuffer.viewport(), {PixelFormat::RGBA8Unorm});
+}
+
+UnsignedInt maxDifference(const Image2D& a, const Image2D& b) {
+    UnsignedInt difference = 0;
+    const Containers::StridedArrayView2D<const Color4ub> pixelsA = a.pixels<Color4ub>();
+    const Containers::StridedArrayView2D<const Color4ub> pixelsB = b.pixels<Color4ub>();
+    for(std::size_t y = 0; y != pixelsA.size()[0]; ++y)
+        for(std::size_t x = 0; x != pixelsA.size()[1]; ++x)
+            for(std::size_t i = 0; i != 4; ++i)
+                difference = Math::max(difference, UnsignedInt(Math::abs(Int(pixelsA[y][x][i]) - Int(pixelsB[y][x][i]))));
+    return difference;
+}
+
+void WidgetStateChangeGLTest::commit() {
+    auto&& data = CommitData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_manager.load("TrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TrueTypeFont plugin not found, cannot test");
+
+    /* The layer elements written by the batched commit should be the same as
+       when updating each widget separately with its final state, which is
+       verified through what gets drawn. Draw both before the change as well,
+       so the planes upload only the modified elements afterwards. */
+    Scene initial{_manager, _framebuffer};
+    const Image2D before = draw(_framebuffer, initial.ui);
+
+    Scene batched{_manager, _framebuffer};
+    draw(_framebuffer, batched.ui);
+    CORRADE_COMPARE(data.batched(batched), data.changed);
+    const Image2D actual = draw(_framebuffer, batched.ui);
+
+    Scene individual{_manager, _framebuffer};
+    draw(_framebuffer, individual.ui);
+    data.individual(individual);
+    const Image2D expected = draw(_framebuffer, individual.ui);
+
+    CORRADE_COMPARE(maxDifference(actual, expected), 0);
+
+    /* Verify the change actually did something, if anything */
+    if(data.changed)
+        CORRADE_VERIFY(maxDifference(actual, before) > 0);
+    else
+        CORRADE_COMPARE(maxDifference(actual, before), 0);
+}
+
+}}}}
+
+MAGNUM_GL_TEST_MAIN(Magnum::Ui::Test::WidgetStateChangeGLTest)
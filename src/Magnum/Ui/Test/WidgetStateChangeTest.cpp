@@ -0,0 +1,188 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/BasicUserInterface.hpp"
+#include "Magnum/Ui/BasicPlane.hpp"
+#include "Magnum/Ui/WidgetStateChange.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct WidgetStateChangeTest: TestSuite::Tester {
+    explicit WidgetStateChangeTest();
+
+    void empty();
+    void commit();
+    void commitOrder();
+    void commitUnchanged();
+    void commitReuse();
+    void move();
+};
+
+WidgetStateChangeTest::WidgetStateChangeTest() {
+    addTests({&WidgetStateChangeTest::empty,
+              &WidgetStateChangeTest::commit,
+              &WidgetStateChangeTest::commitOrder,
+              &WidgetStateChangeTest::commitUnchanged,
+              &WidgetStateChangeTest::commitReuse,
+              &WidgetStateChangeTest::move});
+}
+
+struct UserInterface: BasicUserInterface<> {
+    using BasicUserInterface::BasicUserInterface;
+};
+
+struct Plane: BasicPlane<> {
+    using BasicPlane::BasicPlane;
+};
+
+/* Doesn't override updateState(), so update() gets called as a fallback */
+struct Widget: Ui::Widget {
+    using Ui::Widget::Widget;
+
+    void update() override { ++updateCount; }
+
+    Int updateCount = 0;
+};
+
+void WidgetStateChangeTest::empty() {
+    WidgetStateChange change;
+    CORRADE_COMPARE(change.size(), 0);
+    CORRADE_COMPARE(change.commit(), 0);
+}
+
+void WidgetStateChangeTest::commit() {
+    UserInterface ui{{800.0f, 600.0f}, {800, 600}};
+    Plane plane{ui, {Snap::Left|Snap::Top, {400.0f, 300.0f}}, {}, {}};
+    Plane another{ui, {Snap::Right|Snap::Top, {400.0f, 300.0f}}, {}, {}};
+    Widget a{plane, {Snap::Bottom|Snap::Right, {100.0f, 100.0f}}};
+    Widget b{another, {Snap::Bottom|Snap::Right, {100.0f, 100.0f}}};
+    Widget c{plane, {Snap::Left, a, {100.0f, 100.0f}}};
+
+    WidgetStateChange change;
+    change.hide({a, b})
+        .disable(c)
+        .setEnabled(false, {b});
+    CORRADE_COMPARE(change.size(), 4);
+
+    /* Nothing is applied until commit */
+    CORRADE_COMPARE(a.flags(), WidgetFlags{});
+    CORRADE_COMPARE(b.flags(), WidgetFlags{});
+    CORRADE_COMPARE(c.flags(), WidgetFlags{});
+    CORRADE_COMPARE(a.updateCount, 0);
+
+    CORRADE_COMPARE(change.commit(), 3);
+    CORRADE_COMPARE(change.size(), 0);
+    CORRADE_COMPARE(a.flags(), WidgetFlag::Hidden);
+    CORRADE_COMPARE(b.flags(), WidgetFlag::Hidden|WidgetFlag::Disabled);
+    CORRADE_COMPARE(c.flags(), WidgetFlag::Disabled);
+
+    /* Each widget is updated just once, even with multiple changes */
+    CORRADE_COMPARE(a.updateCount, 1);
+    CORRADE_COMPARE(b.updateCount, 1);
+    CORRADE_COMPARE(c.updateCount, 1);
+}
+
+void WidgetStateChangeTest::commitOrder() {
+    UserInterface ui{{800.0f, 600.0f}, {800, 600}};
+    Plane plane{ui, {Snap::Left|Snap::Top, {400.0f, 300.0f}}, {}, {}};
+    Widget a{plane, {Snap::Bottom|Snap::Right, {100.0f, 100.0f}}};
+    Widget b{plane, {Snap::Left, a, {100.0f, 100.0f}}};
+
+    /* The last change of given flag wins */
+    WidgetStateChange change;
+    change.disable(a)
+        .hide(b)
+        .enable(a)
+        .hide(a)
+        .show(b)
+        .setVisible(false, b);
+    CORRADE_COMPARE(change.commit(), 2);
+    CORRADE_COMPARE(a.flags(), WidgetFlag::Hidden);
+    CORRADE_COMPARE(b.flags(), WidgetFlag::Hidden);
+    CORRADE_COMPARE(a.updateCount, 1);
+    CORRADE_COMPARE(b.updateCount, 1);
+}
+
+void WidgetStateChangeTest::commitUnchanged() {
+    UserInterface ui{{800.0f, 600.0f}, {800, 600}};
+    Plane plane{ui, {Snap::Left|Snap::Top, {400.0f, 300.0f}}, {}, {}};
+    Widget a{plane, {Snap::Bottom|Snap::Right, {100.0f, 100.0f}}};
+    Widget b{plane, {Snap::Left, a, {100.0f, 100.0f}}};
+    b.disable();
+    CORRADE_COMPARE(b.updateCount, 1);
+
+    /* Widgets that end up in the same state as before are not updated */
+    WidgetStateChange change;
+    change.hide(a)
+        .show(a)
+        .disable(b)
+        .enable({a});
+    CORRADE_COMPARE(change.commit(), 0);
+    CORRADE_COMPARE(a.flags(), WidgetFlags{});
+    CORRADE_COMPARE(b.flags(), WidgetFlag::Disabled);
+    CORRADE_COMPARE(a.updateCount, 0);
+    CORRADE_COMPARE(b.updateCount, 1);
+}
+
+void WidgetStateChangeTest::commitReuse() {
+    UserInterface ui{{800.0f, 600.0f}, {800, 600}};
+    Plane plane{ui, {Snap::Left|Snap::Top, {400.0f, 300.0f}}, {}, {}};
+    Widget a{plane, {Snap::Bottom|Snap::Right, {100.0f, 100.0f}}};
+
+    WidgetStateChange change;
+    CORRADE_COMPARE(change.hide(a).commit(), 1);
+    CORRADE_COMPARE(a.flags(), WidgetFlag::Hidden);
+
+    /* Changes from the previous commit are not applied again */
+    CORRADE_COMPARE(change.disable(a).commit(), 1);
+    CORRADE_COMPARE(a.flags(), WidgetFlag::Hidden|WidgetFlag::Disabled);
+    CORRADE_COMPARE(a.updateCount, 2);
+}
+
+void WidgetStateChangeTest::move() {
+    UserInterface ui{{800.0f, 600.0f}, {800, 600}};
+    Plane plane{ui, {Snap::Left|Snap::Top, {400.0f, 300.0f}}, {}, {}};
+    Widget a{plane, {Snap::Bottom|Snap::Right, {100.0f, 100.0f}}};
+
+    WidgetStateChange change;
+    change.hide(a);
+
+    WidgetStateChange moved{std::move(change)};
+    CORRADE_COMPARE(moved.size(), 1);
+
+    WidgetStateChange assigned;
+    assigned = std::move(moved);
+    CORRADE_COMPARE(assigned.size(), 1);
+    CORRADE_COMPARE(assigned.commit(), 1);
+    CORRADE_COMPARE(a.flags(), WidgetFlag::Hidden);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::WidgetStateChangeTest)
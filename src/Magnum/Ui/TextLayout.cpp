@@ -0,0 +1,277 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextLayout.h"
+
+#include <string>
+#include <tuple>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Unicode.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/Alignment.h>
+
+namespace Magnum { namespace Ui {
+
+Debug& operator<<(Debug& debug, const TextLayoutFlag value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case TextLayoutFlag::value: return debug << "Ui::TextLayoutFlag::" #value;
+        _c(Wrap)
+        _c(Ellipsis)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Ui::TextLayoutFlag(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const TextLayoutFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Ui::TextLayoutFlags{}", {
+        TextLayoutFlag::Wrap,
+        TextLayoutFlag::Ellipsis});
+}
+
+TextLayout::TextLayout() = default;
+
+TextLayout::~TextLayout() = default;
+
+void TextLayout::setText(Text::AbstractFont& font, const Text::AbstractGlyphCache& cache, const Float size, const Containers::ArrayView<const char> text) {
+    _glyphs.clear();
+    _paragraphs.clear();
+    _ellipsis.clear();
+    _lines.clear();
+    _laidOut = false;
+
+    const Float scale = size/font.size();
+    _lineHeight = font.lineHeight()*scale;
+    _ascent = font.ascent()*scale;
+    _descent = font.descent()*scale;
+
+    /* Shapes a newline-free string, marking glyphs of whitespace characters
+       as break opportunities if there's a glyph for each character */
+    auto shape = [&](const std::string& string, std::vector<Glyph>& out) {
+        Containers::Pointer<Text::AbstractLayouter> layouter = font.layout(cache, size, string);
+        const std::size_t offset = out.size();
+        for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
+            Vector2 cursor;
+            Range2D rectangle;
+            Glyph glyph{};
+            std::tie(glyph.position, glyph.textureCoordinates) = layouter->renderGlyph(i, cursor, rectangle);
+            glyph.advance = cursor.x();
+            out.push_back(glyph);
+        }
+
+        std::vector<char32_t> characters;
+        for(std::size_t i = 0; i < string.size(); ) {
+            char32_t character;
+            std::tie(character, i) = Utility::Unicode::nextChar(string, i);
+            characters.push_back(character);
+        }
+        if(characters.size() != layouter->glyphCount()) return;
+        for(std::size_t i = 0; i != characters.size(); ++i)
+            out[offset + i].space = characters[i] == U' ' || characters[i] == U'\t';
+    };
+
+    /* Shape each paragraph separately so the newlines don't get rendered as
+       glyphs */
+    const std::string string{text, text.size()};
+    std::size_t begin = 0;
+    for(;;) {
+        std::size_t end = string.find('\n', begin);
+        if(end == std::string::npos) end = string.size();
+
+        const std::size_t glyphOffset = _glyphs.size();
+        if(end != begin) shape(string.substr(begin, end - begin), _glyphs);
+        _paragraphs.emplace_back(glyphOffset, _glyphs.size());
+
+        if(end == string.size()) break;
+        begin = end + 1;
+    }
+
+    shape("...", _ellipsis);
+    _ellipsisWidth = 0.0f;
+    for(const Glyph& glyph: _ellipsis) _ellipsisWidth += glyph.advance;
+}
+
+bool TextLayout::layout(const Float width, const std::size_t maxLines, const TextLayoutFlags flags) {
+    if(_laidOut && width == _width && maxLines == _maxLines && flags == _flags)
+        return false;
+
+    _width = width;
+    _maxLines = maxLines;
+    _flags = flags;
+    _laidOut = true;
+    _lines.clear();
+
+    /* Lay out one line more than allowed so it's known if anything got
+       clipped */
+    for(const std::pair<std::size_t, std::size_t>& paragraph: _paragraphs) {
+        std::size_t begin = paragraph.first;
+        if(begin == paragraph.second) {
+            addLine(begin, begin, false);
+            continue;
+        }
+
+        while(begin != paragraph.second && (!maxLines || _lines.size() <= maxLines)) {
+            /* Find the longest run of glyphs that fits, always taking at
+               least one. Spaces don't count, as they're trimmed at the end
+               of the line. */
+            Float lineWidth = 0.0f;
+            std::size_t end = begin;
+            std::size_t lastSpace = begin;
+            for(; end != paragraph.second; ++end) {
+                const Glyph& glyph = _glyphs[end];
+                if(glyph.space) lastSpace = end;
+                else if(width > 0.0f && end != begin && lineWidth + glyph.advance > width)
+                    break;
+                lineWidth += glyph.advance;
+            }
+
+            /* Everything fits */
+            if(end == paragraph.second) {
+                addLine(begin, end, false);
+                break;
+            }
+
+            /* Not wrapping, the rest of the paragraph is clipped */
+            if(!(flags & TextLayoutFlag::Wrap)) {
+                addLine(begin, end, true);
+                break;
+            }
+
+            /* Break after the last space or in the middle of a word if it
+               doesn't fit on the line on its own, skip the spaces after */
+            if(lastSpace != begin) end = lastSpace;
+            addLine(begin, end, false);
+            begin = end;
+            while(begin != paragraph.second && _glyphs[begin].space) ++begin;
+        }
+
+        if(maxLines && _lines.size() > maxLines) break;
+    }
+
+    /* Clip the lines that don't fit, putting the ellipsis at the end of the
+       last visible one */
+    if(maxLines && _lines.size() > maxLines) {
+        _lines.resize(maxLines);
+        const Line last = _lines.back();
+        _lines.pop_back();
+        addLine(last.glyphOffset, last.glyphOffset + last.glyphCount, true);
+    }
+
+    return true;
+}
+
+void TextLayout::addLine(const std::size_t begin, std::size_t end, const bool clipped) {
+    while(end != begin && _glyphs[end - 1].space) --end;
+
+    Float width = 0.0f;
+    for(std::size_t i = begin; i != end; ++i) width += _glyphs[i].advance;
+
+    const bool ellipsis = clipped && (_flags & TextLayoutFlag::Ellipsis);
+    if(ellipsis) {
+        /* Remove glyphs to make space for the ellipsis, together with spaces
+           that would end up in front of it */
+        while(end != begin && _width > 0.0f && width + _ellipsisWidth > _width)
+            width -= _glyphs[--end].advance;
+        while(end != begin && _glyphs[end - 1].space)
+            width -= _glyphs[--end].advance;
+        width += _ellipsisWidth;
+    }
+
+    _lines.push_back({begin, end - begin, width, ellipsis});
+}
+
+Vector2 TextLayout::size() const {
+    if(_lines.empty()) return {};
+
+    Float width = 0.0f;
+    for(const Line& line: _lines) width = Math::max(width, line.width);
+    return {width, (_lines.size() - 1)*_lineHeight + _ascent - _descent};
+}
+
+std::size_t TextLayout::glyphCount() const {
+    std::size_t count = 0;
+    for(const Line& line: _lines)
+        count += line.glyphCount + (line.ellipsis ? _ellipsis.size() : 0);
+    return count;
+}
+
+std::size_t TextLayout::maxGlyphCount(std::size_t maxLines) const {
+    if(!maxLines) maxLines = _glyphs.size() + _paragraphs.size();
+    return _glyphs.size() + maxLines*_ellipsis.size();
+}
+
+void TextLayout::render(const Vector2& cursor, const Text::Alignment alignment, const Containers::ArrayView<Vector2> positions, const Containers::ArrayView<Vector2> textureCoordinates) const {
+    const std::size_t vertexCount = glyphCount()*4;
+    CORRADE_ASSERT(positions.size() >= vertexCount && textureCoordinates.size() >= vertexCount,
+        "Ui::TextLayout::render(): expected space for at least" << vertexCount << "vertices but got" << positions.size() << "and" << textureCoordinates.size(), );
+
+    /* Baseline of the first line */
+    /** @todo don't use implementation details */
+    Float y = cursor.y();
+    if((UnsignedByte(alignment) & Text::Implementation::AlignmentVertical) == Text::Implementation::AlignmentTop)
+        y -= _ascent;
+    else if((UnsignedByte(alignment) & Text::Implementation::AlignmentVertical) == Text::Implementation::AlignmentMiddle)
+        y += size().y()*0.5f - _ascent;
+
+    std::size_t i = 0;
+    auto addGlyph = [&](const Glyph& glyph, const Vector2& origin) {
+        const Range2D position = glyph.position.translated(origin);
+        positions[i] = position.topLeft();
+        positions[i + 1] = position.bottomLeft();
+        positions[i + 2] = position.topRight();
+        positions[i + 3] = position.bottomRight();
+        textureCoordinates[i] = glyph.textureCoordinates.topLeft();
+        textureCoordinates[i + 1] = glyph.textureCoordinates.bottomLeft();
+        textureCoordinates[i + 2] = glyph.textureCoordinates.topRight();
+        textureCoordinates[i + 3] = glyph.textureCoordinates.bottomRight();
+        i += 4;
+    };
+
+    for(const Line& line: _lines) {
+        Float x = cursor.x();
+        if((UnsignedByte(alignment) & Text::Implementation::AlignmentHorizontal) == Text::Implementation::AlignmentRight)
+            x -= line.width;
+        else if((UnsignedByte(alignment) & Text::Implementation::AlignmentHorizontal) == Text::Implementation::AlignmentCenter)
+            x -= line.width*0.5f;
+
+        for(std::size_t j = line.glyphOffset, end = line.glyphOffset + line.glyphCount; j != end; ++j) {
+            addGlyph(_glyphs[j], {x, y});
+            x += _glyphs[j].advance;
+        }
+        if(line.ellipsis) for(const Glyph& glyph: _ellipsis) {
+            addGlyph(glyph, {x, y});
+            x += glyph.advance;
+        }
+
+        y -= _lineHeight;
+    }
+}
+
+}}
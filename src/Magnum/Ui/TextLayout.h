@@ -0,0 +1,242 @@
+#ifndef Magnum_Ui_TextLayout_h
+#define Magnum_Ui_TextLayout_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Ui::TextLayout, enum @ref Magnum::Ui::TextLayoutFlag, enum set @ref Magnum::Ui::TextLayoutFlags
+ */
+
+#include <string>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/EnumSet.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Text/Text.h>
+
+#include "Magnum/Ui/Ui.h"
+#include "Magnum/Ui/visibility.h"
+
+namespace Magnum { namespace Ui {
+
+/**
+@brief Text layout flag
+
+@see @ref TextLayoutFlags, @ref TextLayout::layout()
+@experimental
+*/
+enum class TextLayoutFlag: UnsignedByte {
+    /**
+     * Break lines at spaces so they fit into the layout width. Words that
+     * don't fit on a line on their own get broken at an arbitrary glyph. If
+     * not set, lines are broken only at newline characters and the parts
+     * not fitting into the layout width are clipped.
+     */
+    Wrap = 1 << 0,
+
+    /**
+     * Put an ellipsis at the end of lines that were clipped horizontally and
+     * at the end of the last line if lines after it were clipped.
+     */
+    Ellipsis = 1 << 1
+};
+
+/** @debugoperatorenum{TextLayoutFlag}
+ * @experimental
+ */
+MAGNUM_UI_EXPORT Debug& operator<<(Debug& debug, TextLayoutFlag value);
+
+/**
+@brief Text layout flags
+
+@see @ref TextLayout::layout()
+@experimental
+*/
+typedef Containers::EnumSet<TextLayoutFlag> TextLayoutFlags;
+
+CORRADE_ENUMSET_OPERATORS(TextLayoutFlags)
+
+/** @debugoperatorenum{TextLayoutFlags}
+ * @experimental
+ */
+MAGNUM_UI_EXPORT Debug& operator<<(Debug& debug, TextLayoutFlags value);
+
+/**
+@brief Multi-line text layout
+
+Lays out a paragraph of text into lines with optional word wrapping, clipping
+and ellipsization. The text is shaped just once in @ref setText(), which
+remembers glyph quads, advances and break opportunities. @ref layout() then
+only re-runs the line breaking, so changing the width or line count is cheap.
+
+Lines are broken at newline characters and, with @ref TextLayoutFlag::Wrap,
+after spaces. The layout assumes the font produces one glyph per character,
+which is the case for all font plugins without complex text shaping.
+@experimental
+*/
+class MAGNUM_UI_EXPORT TextLayout {
+    public:
+        /**
+         * @brief Line
+         *
+         * @see @ref lines()
+         */
+        struct Line {
+            /** @brief Offset of the first glyph */
+            std::size_t glyphOffset;
+
+            /** @brief Glyph count, not including the ellipsis */
+            std::size_t glyphCount;
+
+            /** @brief Line width, including the ellipsis */
+            Float width;
+
+            /** @brief Whether the line ends with an ellipsis */
+            bool ellipsis;
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty layout. Call @ref setText() to fill it.
+         */
+        explicit TextLayout();
+
+        ~TextLayout();
+
+        /**
+         * @brief Set text
+         * @param font      Font to shape the text with
+         * @param cache     Glyph cache containing the glyphs
+         * @param size      Font size
+         * @param text      UTF-8 text
+         *
+         * Shapes the text and the ellipsis and resets the line layout, so
+         * @ref layout() has to be called again after.
+         */
+        void setText(Text::AbstractFont& font, const Text::AbstractGlyphCache& cache, Float size, Containers::ArrayView<const char> text);
+
+        /** @overload */
+        void setText(Text::AbstractFont& font, const Text::AbstractGlyphCache& cache, Float size, const std::string& text) {
+            setText(font, cache, size, Containers::ArrayView<const char>{text.data(), text.size()});
+        }
+
+        /** @overload */
+        template<std::size_t textSize> void setText(Text::AbstractFont& font, const Text::AbstractGlyphCache& cache, Float size, const char(&text)[textSize]) {
+            setText(font, cache, size, Containers::ArrayView<const char>{text, textSize - 1});
+        }
+
+        /** @brief Count of shaped glyphs */
+        std::size_t shapedGlyphCount() const { return _glyphs.size(); }
+
+        /** @brief Line height */
+        Float lineHeight() const { return _lineHeight; }
+
+        /**
+         * @brief Lay out the lines
+         * @param width     Layout width or @cpp 0.0f @ce for unlimited width
+         * @param maxLines  Max line count or @cpp 0 @ce for unlimited line
+         *      count. Lines after are clipped.
+         * @param flags     Flags
+         * @return Whether the layout changed
+         *
+         * Doesn't shape the text again. If called again with the same
+         * parameters and the text didn't change in the meantime, does
+         * nothing and returns @cpp false @ce.
+         */
+        bool layout(Float width, std::size_t maxLines = 0, TextLayoutFlags flags = {});
+
+        /** @brief Laid out lines */
+        const std::vector<Line>& lines() const { return _lines; }
+
+        /**
+         * @brief Size of the laid out text
+         *
+         * Width of the widest line and height from the ascent of the first
+         * line to the descent of the last line.
+         */
+        Vector2 size() const;
+
+        /**
+         * @brief Count of glyphs in the laid out text
+         *
+         * Including ellipses. The @ref render() function outputs four
+         * vertices for each.
+         */
+        std::size_t glyphCount() const;
+
+        /**
+         * @brief Max count of glyphs in the laid out text
+         *
+         * Upper bound of @ref glyphCount() for any @ref layout() of the
+         * current text with given @p maxLines --- all shaped glyphs and an
+         * ellipsis on each line. Useful for reserving space for text that
+         * gets laid out again with a different width later. If @p maxLines
+         * is @cpp 0 @ce, a line for each shaped glyph and each paragraph is
+         * assumed.
+         */
+        std::size_t maxGlyphCount(std::size_t maxLines) const;
+
+        /**
+         * @brief Render the laid out text
+         * @param cursor                Position of the text
+         * @param alignment             Text alignment
+         * @param positions             Where to put vertex positions
+         * @param textureCoordinates    Where to put vertex texture
+         *      coordinates
+         *
+         * Both @p positions and @p textureCoordinates are expected to have
+         * space for at least four times @ref glyphCount() items. Each line
+         * is aligned horizontally with respect to @p cursor; vertically the
+         * whole block is aligned, with @ref Text::Alignment::LineLeft and
+         * similar putting the baseline of the first line at @p cursor.
+         */
+        void render(const Vector2& cursor, Text::Alignment alignment, Containers::ArrayView<Vector2> positions, Containers::ArrayView<Vector2> textureCoordinates) const;
+
+    private:
+        struct Glyph {
+            Range2D position, textureCoordinates;
+            Float advance;
+            bool space;
+        };
+
+        void MAGNUM_UI_LOCAL addLine(std::size_t begin, std::size_t end, bool clipped);
+
+        std::vector<Glyph> _glyphs;
+        /* Glyph ranges of the paragraphs separated by newlines */
+        std::vector<std::pair<std::size_t, std::size_t>> _paragraphs;
+        std::vector<Glyph> _ellipsis;
+        Float _ellipsisWidth{}, _lineHeight{}, _ascent{}, _descent{};
+
+        std::vector<Line> _lines;
+        Float _width{};
+        std::size_t _maxLines{};
+        TextLayoutFlags _flags;
+        bool _laidOut{};
+};
+
+}}
+
+#endif
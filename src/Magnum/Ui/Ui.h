@@ -44,14 +44,21 @@ template<class> class BasicLayer;
 template<class> class BasicGLLayer;
 template<class...> class BasicPlane;
 template<class...> class BasicUserInterface;
+class GLBufferArena;
+class UpdateQueue;
 class Widget;
+class WidgetStateChange;
 
 class Button;
+class FontStack;
+class ImmediatePlane;
 class Input;
 class Label;
 class Modal;
+class NumericLabel;
 class Plane;
 class StyleConfiguration;
+class TextLayout;
 class UserInterface;
 
 enum class PlaneFlag: UnsignedInt;
@@ -60,6 +67,9 @@ typedef Containers::EnumSet<PlaneFlag> PlaneFlags;
 enum class WidgetFlag: UnsignedInt;
 typedef Containers::EnumSet<WidgetFlag> WidgetFlags;
 
+enum class TextLayoutFlag: UnsignedByte;
+typedef Containers::EnumSet<TextLayoutFlag> TextLayoutFlags;
+
 enum class State: UnsignedInt;
 enum class Style: UnsignedInt;
 enum class Type: UnsignedInt;
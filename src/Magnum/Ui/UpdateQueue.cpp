@@ -0,0 +1,132 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "UpdateQueue.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include "Magnum/Ui/Input.h"
+#include "Magnum/Ui/Label.h"
+
+namespace Magnum { namespace Ui {
+
+namespace {
+
+enum class UpdateType: UnsignedByte {
+    LabelText = 1 << 0,
+    InputValue = 1 << 1,
+    Visible = 1 << 2
+};
+
+}
+
+struct UpdateQueue::Update {
+    explicit Update(Widget& widget, UpdateType type, std::string&& text, bool visible): widget(widget), type{type}, text{std::move(text)}, visible{visible} {}
+
+    Update* next{};
+    Widget& widget;
+    UpdateType type;
+    std::string text;
+    bool visible;
+};
+
+UpdateQueue::UpdateQueue(): _head{nullptr} {}
+
+UpdateQueue::~UpdateQueue() {
+    Update* update = _head.exchange(nullptr, std::memory_order_acquire);
+    while(update) {
+        Update* next = update->next;
+        delete update;
+        update = next;
+    }
+}
+
+bool UpdateQueue::isEmpty() const {
+    return !_head.load(std::memory_order_relaxed);
+}
+
+UpdateQueue& UpdateQueue::setText(Label& label, std::string text) {
+    push(new Update{label, UpdateType::LabelText, std::move(text), false});
+    return *this;
+}
+
+UpdateQueue& UpdateQueue::setValue(Input& input, std::string value) {
+    push(new Update{input, UpdateType::InputValue, std::move(value), false});
+    return *this;
+}
+
+UpdateQueue& UpdateQueue::setVisible(Widget& widget, const bool visible) {
+    push(new Update{widget, UpdateType::Visible, {}, visible});
+    return *this;
+}
+
+void UpdateQueue::push(Update* const update) {
+    /* A lock-free stack. As the consumer always takes the whole list at once
+       and never pops individual items, there's no ABA problem. */
+    update->next = _head.load(std::memory_order_relaxed);
+    while(!_head.compare_exchange_weak(update->next, update, std::memory_order_release, std::memory_order_relaxed));
+}
+
+std::size_t UpdateQueue::apply() {
+    Update* update = _head.exchange(nullptr, std::memory_order_acquire);
+    if(!update) return 0;
+
+    /* The list is newest first, so the first update of each type for given
+       widget is the one to keep. Collect those and apply them in the order
+       they were queued. */
+    std::unordered_map<const Widget*, UnsignedByte> seen;
+    std::vector<Update*> latest;
+    while(update) {
+        Update* next = update->next;
+        UnsignedByte& types = seen[&update->widget];
+        if(types & UnsignedByte(update->type)) delete update;
+        else {
+            types |= UnsignedByte(update->type);
+            latest.push_back(update);
+        }
+        update = next;
+    }
+
+    for(auto it = latest.rbegin(); it != latest.rend(); ++it) {
+        Update& u = **it;
+        switch(u.type) {
+            case UpdateType::LabelText:
+                static_cast<Label&>(u.widget).setText(u.text);
+                break;
+            case UpdateType::InputValue:
+                static_cast<Input&>(u.widget).setValue(std::move(u.text));
+                break;
+            case UpdateType::Visible:
+                u.widget.setVisible(u.visible);
+                break;
+        }
+        delete *it;
+    }
+
+    return latest.size();
+}
+
+}}
@@ -0,0 +1,144 @@
+#ifndef Magnum_Ui_UpdateQueue_h
+#define Magnum_Ui_UpdateQueue_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Ui::UpdateQueue
+ */
+
+#include <atomic>
+#include <string>
+
+#include "Magnum/Ui/Ui.h"
+#include "Magnum/Ui/visibility.h"
+
+namespace Magnum { namespace Ui {
+
+/**
+@brief Cross-thread widget update queue
+
+Widget setters such as @ref Label::setText(), @ref Input::setValue() or
+@ref Widget::setVisible() write directly into plane layers and thus have to be
+called from the thread that draws the UI. This queue accepts the same updates
+from any number of threads without locking and applies them on the draw
+thread in @ref apply(), which is called by @ref BasicUserInterface::update().
+If a widget gets updated multiple times between two @ref apply() calls, only
+the latest value of each kind of update is applied, so a producer that's
+faster than the frame rate doesn't cause redundant text reshaping.
+
+An instance is owned by each user interface and accessible through
+@ref AbstractUserInterface::updateQueue().
+
+@section Ui-UpdateQueue-lifetime Widget lifetime
+
+The queue stores plain widget pointers. It's the user responsibility to ensure
+a widget is not destroyed while there are updates queued for it --- for
+example by calling @ref apply() before destroying the widget and stopping the
+producer threads first.
+@experimental
+*/
+class MAGNUM_UI_EXPORT UpdateQueue {
+    public:
+        /** @brief Constructor */
+        explicit UpdateQueue();
+
+        /** @brief Copying is not allowed */
+        UpdateQueue(const UpdateQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        UpdateQueue(UpdateQueue&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Discards all updates that were not applied.
+         */
+        ~UpdateQueue();
+
+        /** @brief Copying is not allowed */
+        UpdateQueue& operator=(const UpdateQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        UpdateQueue& operator=(UpdateQueue&&) = delete;
+
+        /**
+         * @brief Whether there are any updates queued
+         *
+         * As other threads can add updates at any time, the value is only
+         * informative.
+         */
+        bool isEmpty() const;
+
+        /**
+         * @brief Queue a label text update
+         * @return Reference to self (for method chaining)
+         *
+         * Can be called from any thread. The text will be set using
+         * @ref Label::setText() in the next @ref apply().
+         */
+        UpdateQueue& setText(Label& label, std::string text);
+
+        /**
+         * @brief Queue an input value update
+         * @return Reference to self (for method chaining)
+         *
+         * Can be called from any thread. The value will be set using
+         * @ref Input::setValue() in the next @ref apply().
+         */
+        UpdateQueue& setValue(Input& input, std::string value);
+
+        /**
+         * @brief Queue a widget visibility update
+         * @return Reference to self (for method chaining)
+         *
+         * Can be called from any thread. The visibility will be set using
+         * @ref Widget::setVisible() in the next @ref apply().
+         */
+        UpdateQueue& setVisible(Widget& widget, bool visible);
+
+        /**
+         * @brief Apply queued updates
+         * @return Count of updates that were applied
+         *
+         * Expected to be called only from the thread that draws the UI.
+         * Updates of the same kind for the same widget are collapsed to the
+         * most recent one, updates that are queued while this function runs
+         * get applied on the next call. Called automatically from
+         * @ref BasicUserInterface::update().
+         */
+        std::size_t apply();
+
+    private:
+        struct Update;
+
+        void push(Update* update);
+
+        std::atomic<Update*> _head;
+};
+
+}}
+
+#endif
@@ -36,6 +36,7 @@
 #include <Magnum/Text/AbstractFont.h>
 #include <Magnum/Text/GlyphCache.h>
 
+#include "Magnum/Ui/FontStack.h"
 #include "Magnum/Ui/Plane.h"
 #include "Magnum/Ui/visibility.h"
 
@@ -101,8 +102,8 @@ struct UserInterface::FontState {
     explicit FontState(const Vector2i& glyphCacheSize): glyphCache{glyphCacheSize} {}
 
     Containers::Optional<PluginManager::Manager<Text::AbstractFont>> manager;
-    Containers::Pointer<Text::AbstractFont> font;
     Text::GlyphCache glyphCache;
+    Containers::Pointer<FontStack> font;
 };
 
 UserInterface::UserInterface(const Vector2& size, const Vector2i& windowSize, const Vector2i& framebufferSize, const StyleConfiguration& styleConfiguration, const std::string& extraGlyphs): UserInterface{NoCreate, size, windowSize, framebufferSize} {
@@ -114,8 +115,9 @@ UserInterface::UserInterface(const Vector2& size, const Vector2i& windowSize, co
        so we can't pass it though extraGlyphs), it'll cause invalid glyph
        markers to get rendered. So can't use HB at the moment. */
     //_fontState->manager->setPreferredPlugins("TrueTypeFont", {"HarfBuzzFont", "FreeTypeFont"});
-    if(!(_fontState->font = _fontState->manager->loadAndInstantiate("TrueTypeFont")))
-        std::exit(1);
+    Containers::Pointer<Text::AbstractFont> font = _fontState->manager->loadAndInstantiate("TrueTypeFont");
+    if(!font) std::exit(1);
+    _fontState->font.reset(new FontStack{std::move(font), _fontState->glyphCache});
 
     /* Make the manager, font and glyph cache pointers public and finish the initialization */
     _fontManager = &*_fontState->manager;
@@ -130,8 +132,9 @@ UserInterface::UserInterface(PluginManager::Manager<Text::AbstractFont>& fontMan
     /* Load TTF font plugin using the external manager */
     _fontManager = &fontManager;
     _fontState.reset(new UserInterface::FontState{Vector2i{1024}});
-    if(!(_fontState->font = _fontManager->loadAndInstantiate("TrueTypeFont")))
-        std::exit(1);
+    Containers::Pointer<Text::AbstractFont> font = _fontManager->loadAndInstantiate("TrueTypeFont");
+    if(!font) std::exit(1);
+    _fontState->font.reset(new FontStack{std::move(font), _fontState->glyphCache});
 
     /* Make the and glyph cache pointers public and finish the initialization */
     _font = _fontState->font.get();
@@ -153,7 +156,8 @@ void UserInterface::initialize(const Vector2& size, const Vector2i& framebufferS
         styleConfiguration.fontSize()*2.0f*supersamplingRatio))
         std::exit(1);
 
-    /* Prepare glyph cache */
+    /* Prepare glyph cache. Other characters get added on demand, possibly
+       from fallback fonts. */
     _font->fillGlyphCache(*_glyphCache,
         "abcdefghijklmnopqrstuvwxyz"
         "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
@@ -175,7 +179,20 @@ UserInterface::UserInterface(const Vector2& size, const Vector2i& windowSize, co
     setStyleConfiguration(styleConfiguration);
 }
 
-UserInterface::~UserInterface() = default;
+UserInterface::~UserInterface() {
+    /* Planes would otherwise get deleted only in the base destructor, after
+       the buffer arena they release their data to is gone */
+    Containers::LinkedList<AbstractPlane>::clear();
+}
+
+UserInterface& UserInterface::addFallbackFont(const std::string& filename) {
+    CORRADE_ASSERT(_fontState,
+        "Ui::UserInterface::addFallbackFont(): can't add a fallback to a user-provided font", *this);
+
+    Containers::Pointer<Text::AbstractFont> font = _fontManager->loadAndInstantiate("TrueTypeFont");
+    if(font) _fontState->font->addFallbackFont(std::move(font), filename);
+    return *this;
+}
 
 const Plane* UserInterface::activePlane() const {
     return static_cast<const Plane*>(BasicUserInterface::activePlane());
@@ -188,12 +205,20 @@ Plane* UserInterface::activePlane() {
 void UserInterface::setStyleConfiguration(const StyleConfiguration& configuration) {
     _styleConfiguration = configuration;
     configuration.pack(_backgroundUniforms, _foregroundUniforms, _textUniforms);
+
+    /* Colors changed, which isn't reflected in the layer data */
+    invalidatePlaneCaches();
 }
 
 void UserInterface::relayout(const Vector2& size, const Vector2i& windowSize, const Vector2i&) {
     BasicUserInterface<Implementation::QuadLayer, Implementation::QuadLayer, Implementation::TextLayer>::relayout(size, windowSize);
 }
 
+void UserInterface::update() {
+    BasicUserInterface::update();
+    _bufferArena.upload();
+}
+
 void UserInterface::draw() {
     update();
 
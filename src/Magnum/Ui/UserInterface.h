@@ -38,6 +38,7 @@
 
 #include "Magnum/Ui/AbstractUiShader.h"
 #include "Magnum/Ui/BasicUserInterface.h"
+#include "Magnum/Ui/GLBufferArena.h"
 #include "Magnum/Ui/Style.h"
 #include "Magnum/Ui/visibility.h"
 
@@ -92,6 +93,11 @@ The plugin should be either in a system directory or be linked and correctly
 imported statically. If the plugin cannot be loaded, the application exits. See
 @ref plugins for more information.
 
+The font is wrapped in a @ref FontStack. Characters not present in it can be
+taken from fallback fonts added with @ref addFallbackFont(), which get opened
+only once text containing such characters is laid out. Their glyphs are added
+to the same glyph cache.
+
 @see @ref defaultStyleConfiguration(), @ref mcssDarkStyleConfiguration()
 @experimental
 */
@@ -258,6 +264,18 @@ class MAGNUM_UI_EXPORT UserInterface: public BasicUserInterface<Implementation::
         Text::AbstractFont& font() { return *_font; }
         const Text::AbstractFont& font() const { return *_font; } /**< @overload */
 
+        /**
+         * @brief Add a fallback font
+         * @return Reference to self (for method chaining)
+         *
+         * Instantiates a @cpp "TrueTypeFont" @ce plugin and adds it to the
+         * @ref FontStack as a fallback, to be opened from @p filename on
+         * first use. Expects that the interface wasn't constructed with a
+         * user-provided font. See @ref Ui-UserInterface-fonts for more
+         * information.
+         */
+        UserInterface& addFallbackFont(const std::string& filename);
+
         /** @brief Glyph cache used for the interface */
         Text::GlyphCache& glyphCache() { return *_glyphCache; }
         const Text::GlyphCache& glyphCache() const { return *_glyphCache; } /**< @overload */
@@ -272,6 +290,25 @@ class MAGNUM_UI_EXPORT UserInterface: public BasicUserInterface<Implementation::
          */
         Input* focusedInputWidget() { return _focusedInputWidget; }
 
+        /**
+         * @brief Buffer arena
+         *
+         * Arena from which GPU memory for layers of all planes in the
+         * interface is allocated.
+         */
+        GLBufferArena& bufferArena() { return _bufferArena; }
+
+        /**
+         * @brief Update the user interface
+         *
+         * Calls @ref BasicUserInterface::update() and then uploads data
+         * modified in all planes at once using @ref GLBufferArena::upload().
+         * Called automatically at the beginning of @ref draw(), but
+         * scheduling it explicitly in a different place might reduce the need
+         * for CPU/GPU synchronization.
+         */
+        void update();
+
         /** @brief Draw the user interface */
         void draw();
 
@@ -307,6 +344,9 @@ class MAGNUM_UI_EXPORT UserInterface: public BasicUserInterface<Implementation::
            plugin manager */
         void MAGNUM_UI_LOCAL initialize(const Vector2& size, const Vector2i& framebufferSize, const StyleConfiguration& styleConfiguration, const std::string& extraGlyphs);
 
+        /* Has to be before all other members that might use it */
+        GLBufferArena _bufferArena;
+
         GL::Buffer _backgroundUniforms,
             _foregroundUniforms,
             _textUniforms,
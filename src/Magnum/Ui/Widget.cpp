@@ -30,6 +30,7 @@
 
 #include "Magnum/Ui/BasicPlane.h"
 #include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/WidgetStateChange.h"
 
 #ifdef _MSC_VER
 #include "Magnum/Ui/BasicUserInterface.h" /* Why? */
@@ -63,27 +64,27 @@ Debug& operator<<(Debug& debug, const WidgetFlags value) {
 }
 
 void Widget::disable(const std::initializer_list<Containers::Reference<Widget>> widgets) {
-    for(Widget& widget: widgets) widget.disable();
+    WidgetStateChange{}.disable(widgets).commit();
 }
 
 void Widget::enable(const std::initializer_list<Containers::Reference<Widget>> widgets) {
-    for(Widget& widget: widgets) widget.enable();
+    WidgetStateChange{}.enable(widgets).commit();
 }
 
 void Widget::setEnabled(const bool enabled, const std::initializer_list<Containers::Reference<Widget>> widgets) {
-    enabled ? enable(widgets) : disable(widgets);
+    WidgetStateChange{}.setEnabled(enabled, widgets).commit();
 }
 
 void Widget::hide(const std::initializer_list<Containers::Reference<Widget>> widgets) {
-    for(Widget& widget: widgets) widget.hide();
+    WidgetStateChange{}.hide(widgets).commit();
 }
 
 void Widget::show(const std::initializer_list<Containers::Reference<Widget>> widgets) {
-    for(Widget& widget: widgets) widget.show();
+    WidgetStateChange{}.show(widgets).commit();
 }
 
 void Widget::setVisible(const bool visible, const std::initializer_list<Containers::Reference<Widget>> widgets) {
-    visible ? show(widgets) : hide(widgets);
+    WidgetStateChange{}.setVisible(visible, widgets).commit();
 }
 
 Widget::Widget(AbstractPlane& plane, const Anchor& anchor, const Range2D& padding): _plane(plane), _rect{anchor.rect(_plane)}, _padding{padding}, _planeIndex{plane.addWidget(*this)} {}
@@ -126,6 +127,10 @@ Widget& Widget::setVisible(const bool visible) {
 
 void Widget::update() {}
 
+void Widget::updateState(Implementation::WidgetStateUpdates&) {
+    update();
+}
+
 bool Widget::hoverEvent() { return false; }
 bool Widget::pressEvent() { return false; }
 bool Widget::releaseEvent() { return false; }
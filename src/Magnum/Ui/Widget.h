@@ -99,6 +99,10 @@ MAGNUM_UI_EXPORT Debug& operator<<(Debug& debug, WidgetFlags value);
 
 CORRADE_ENUMSET_OPERATORS(WidgetFlags)
 
+namespace Implementation {
+    struct WidgetStateUpdates;
+}
+
 /**
 @brief Base for widgets
 
@@ -106,47 +110,54 @@ CORRADE_ENUMSET_OPERATORS(WidgetFlags)
 */
 class MAGNUM_UI_EXPORT Widget {
     friend class AbstractPlane;
+    friend WidgetStateChange;
 
     public:
         /**
          * @brief Disable a set of widgets
          *
-         * Convenience batch alternative to @ref disable().
+         * Convenience batch alternative to @ref disable(). Widgets are updated
+         * together using @ref WidgetStateChange.
          */
         static void disable(std::initializer_list<Containers::Reference<Widget>> widgets);
 
         /**
          * @brief Enable a set of widgets
          *
-         * Convenience batch alternative to @ref enable().
+         * Convenience batch alternative to @ref enable(). Widgets are updated
+         * together using @ref WidgetStateChange.
          */
         static void enable(std::initializer_list<Containers::Reference<Widget>> widgets);
 
         /**
          * @brief Enable or disable a set of widgets
          *
-         * Convenience batch alternative to @ref setEnabled().
+         * Convenience batch alternative to @ref setEnabled(). Widgets are updated
+         * together using @ref WidgetStateChange.
          */
         static void setEnabled(bool enabled, std::initializer_list<Containers::Reference<Widget>> widgets);
 
         /**
          * @brief Hide a set of widgets
          *
-         * Convenience batch alternative to @ref hide().
+         * Convenience batch alternative to @ref hide(). Widgets are updated
+         * together using @ref WidgetStateChange.
          */
         static void hide(std::initializer_list<Containers::Reference<Widget>> widgets);
 
         /**
          * @brief Show a set of widgets
          *
-         * Convenience batch alternative to @ref show().
+         * Convenience batch alternative to @ref show(). Widgets are updated
+         * together using @ref WidgetStateChange.
          */
         static void show(std::initializer_list<Containers::Reference<Widget>> widgets);
 
         /**
          * @brief Set a set of widgets visible
          *
-         * Convenience batch alternative to @ref setVisible().
+         * Convenience batch alternative to @ref setVisible(). Widgets are updated
+         * together using @ref WidgetStateChange.
          */
         static void setVisible(bool visible, std::initializer_list<Containers::Reference<Widget>> widgets);
 
@@ -247,6 +258,16 @@ class MAGNUM_UI_EXPORT Widget {
          */
         virtual void update();
 
+        /**
+         * @brief Update the widget after a batched state change
+         *
+         * Called from @ref WidgetStateChange::commit() instead of
+         * @ref update(). The builtin widgets describe their layer elements
+         * here so the commit can update all widgets at once, default
+         * implementation calls @ref update().
+         */
+        virtual void updateState(Implementation::WidgetStateUpdates& updates);
+
         /**
          * @brief Hover event
          * @return `True` if the event was accepted, `false` if it was ignored
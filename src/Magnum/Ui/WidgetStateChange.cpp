@@ -0,0 +1,217 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "WidgetStateChange.h"
+
+#include <algorithm>
+#include <functional>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Ui/Plane.h"
+#include "Magnum/Ui/Implementation/WidgetState.h"
+
+namespace Magnum { namespace Ui {
+
+namespace {
+
+UnsignedByte colorIndex(const Implementation::WidgetStateUpdate& update) {
+    switch(update.layer) {
+        case Implementation::StateLayer::Background:
+            return Implementation::backgroundColorIndex(update.type, update.style, update.flags);
+        case Implementation::StateLayer::Foreground:
+            return Implementation::foregroundColorIndex(update.type, update.style, update.flags);
+        case Implementation::StateLayer::Text:
+            return Implementation::textColorIndex(update.type, update.style, update.flags);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Groups by layer, widget type, style and flags so the color index is
+   calculated just once for each distinct combination */
+void calculateColorIndices(std::vector<Implementation::WidgetStateUpdate>& updates) {
+    std::sort(updates.begin(), updates.end(), [](const Implementation::WidgetStateUpdate& a, const Implementation::WidgetStateUpdate& b) {
+        if(a.layer != b.layer) return a.layer < b.layer;
+        if(a.type != b.type) return a.type < b.type;
+        if(a.style != b.style) return a.style < b.style;
+        return UnsignedInt(a.flags) < UnsignedInt(b.flags);
+    });
+    for(std::size_t i = 0; i != updates.size(); ++i) {
+        Implementation::WidgetStateUpdate& update = updates[i];
+        const Implementation::WidgetStateUpdate* const previous = i ? &updates[i - 1] : nullptr;
+        if(previous && update.layer == previous->layer && update.type == previous->type && update.style == previous->style && update.flags == previous->flags)
+            update.colorIndex = previous->colorIndex;
+        else update.colorIndex = colorIndex(update);
+    }
+}
+
+}
+
+WidgetStateChange::WidgetStateChange() = default;
+
+WidgetStateChange::WidgetStateChange(WidgetStateChange&&) noexcept = default;
+
+WidgetStateChange::~WidgetStateChange() = default;
+
+WidgetStateChange& WidgetStateChange::operator=(WidgetStateChange&&) noexcept = default;
+
+WidgetStateChange& WidgetStateChange::add(Widget& widget, const WidgetFlags set, const WidgetFlags clear) {
+    _changes.push_back({&widget, set, clear});
+    return *this;
+}
+
+WidgetStateChange& WidgetStateChange::add(const std::initializer_list<Containers::Reference<Widget>> widgets, const WidgetFlags set, const WidgetFlags clear) {
+    for(Widget& widget: widgets) _changes.push_back({&widget, set, clear});
+    return *this;
+}
+
+WidgetStateChange& WidgetStateChange::disable(Widget& widget) {
+    return add(widget, WidgetFlag::Disabled, {});
+}
+
+WidgetStateChange& WidgetStateChange::disable(const std::initializer_list<Containers::Reference<Widget>> widgets) {
+    return add(widgets, WidgetFlag::Disabled, {});
+}
+
+WidgetStateChange& WidgetStateChange::enable(Widget& widget) {
+    return add(widget, {}, WidgetFlag::Disabled);
+}
+
+WidgetStateChange& WidgetStateChange::enable(const std::initializer_list<Containers::Reference<Widget>> widgets) {
+    return add(widgets, {}, WidgetFlag::Disabled);
+}
+
+WidgetStateChange& WidgetStateChange::setEnabled(const bool enabled, Widget& widget) {
+    return enabled ? enable(widget) : disable(widget);
+}
+
+WidgetStateChange& WidgetStateChange::setEnabled(const bool enabled, const std::initializer_list<Containers::Reference<Widget>> widgets) {
+    return enabled ? enable(widgets) : disable(widgets);
+}
+
+WidgetStateChange& WidgetStateChange::hide(Widget& widget) {
+    return add(widget, WidgetFlag::Hidden, {});
+}
+
+WidgetStateChange& WidgetStateChange::hide(const std::initializer_list<Containers::Reference<Widget>> widgets) {
+    return add(widgets, WidgetFlag::Hidden, {});
+}
+
+WidgetStateChange& WidgetStateChange::show(Widget& widget) {
+    return add(widget, {}, WidgetFlag::Hidden);
+}
+
+WidgetStateChange& WidgetStateChange::show(const std::initializer_list<Containers::Reference<Widget>> widgets) {
+    return add(widgets, {}, WidgetFlag::Hidden);
+}
+
+WidgetStateChange& WidgetStateChange::setVisible(const bool visible, Widget& widget) {
+    return visible ? show(widget) : hide(widget);
+}
+
+WidgetStateChange& WidgetStateChange::setVisible(const bool visible, const std::initializer_list<Containers::Reference<Widget>> widgets) {
+    return visible ? show(widgets) : hide(widgets);
+}
+
+std::size_t WidgetStateChange::commit() {
+    /* Group changes of the same widget together, keeping the order in which
+       they were made, and apply them. Remember only widgets whose flags
+       actually changed. */
+    std::stable_sort(_changes.begin(), _changes.end(), [](const Change& a, const Change& b) {
+        return std::less<const Widget*>{}(a.widget, b.widget);
+    });
+    std::vector<Widget*> changed;
+    for(auto first = _changes.begin(); first != _changes.end(); ) {
+        Widget& widget = *first->widget;
+        WidgetFlags flags = widget._flags;
+        auto last = first;
+        for(; last != _changes.end() && last->widget == &widget; ++last)
+            flags = (flags & ~last->clear)|last->set;
+
+        if(flags != widget._flags) {
+            widget._flags = flags;
+            changed.push_back(&widget);
+        }
+
+        first = last;
+    }
+    _changes.clear();
+
+    /* Group the widgets by plane, as each has its own layers */
+    std::sort(changed.begin(), changed.end(), [](const Widget* a, const Widget* b) {
+        return std::less<const AbstractPlane*>{}(&a->_plane, &b->_plane);
+    });
+    Implementation::WidgetStateUpdates updates;
+    for(auto first = changed.begin(); first != changed.end(); ) {
+        AbstractPlane& plane = (*first)->_plane;
+        auto last = first;
+        for(; last != changed.end() && &(*last)->_plane == &plane; ++last)
+            (*last)->updateState(updates);
+
+        /* Only the builtin widgets put anything here and these are always
+           in a Plane */
+        if(!updates.updates.empty())
+            Implementation::applyWidgetStateUpdates(static_cast<Plane&>(plane), updates);
+
+        first = last;
+    }
+
+    return changed.size();
+}
+
+namespace Implementation {
+
+void applyWidgetStateUpdates(Plane& plane, WidgetStateUpdates& updates) {
+    calculateColorIndices(updates.updates);
+
+    /* Write the layers front to back. Elements of each layer are contiguous
+       in memory in the order they were added, so this goes linearly through
+       the data. */
+    std::sort(updates.updates.begin(), updates.updates.end(), [](const WidgetStateUpdate& a, const WidgetStateUpdate& b) {
+        if(a.layer != b.layer) return a.layer < b.layer;
+        return a.element < b.element;
+    });
+    for(const WidgetStateUpdate& update: updates.updates) {
+        switch(update.layer) {
+            case StateLayer::Background:
+                plane._backgroundLayer.modifyElement(update.element).colorIndex = update.colorIndex;
+                break;
+            case StateLayer::Foreground:
+                plane._foregroundLayer.modifyElement(update.element).colorIndex = update.colorIndex;
+                break;
+            case StateLayer::Text:
+                for(TextVertex& v: plane._textLayer.modifyElement(update.element))
+                    v.colorIndex = update.colorIndex;
+                break;
+        }
+    }
+
+    updates.updates.clear();
+}
+
+}
+
+}}
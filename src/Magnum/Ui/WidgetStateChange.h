@@ -0,0 +1,192 @@
+#ifndef Magnum_Ui_WidgetStateChange_h
+#define Magnum_Ui_WidgetStateChange_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Ui::WidgetStateChange
+ */
+
+#include <initializer_list>
+#include <vector>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Ui/Ui.h"
+#include "Magnum/Ui/Widget.h"
+#include "Magnum/Ui/visibility.h"
+
+namespace Magnum { namespace Ui {
+
+/**
+@brief Batched widget state change
+
+Collects widget visibility and enabled state changes and applies them all at
+once in @ref commit(). Compared to calling @ref Widget::hide(),
+@ref Widget::enable() etc. on each widget separately, widgets whose state
+doesn't change in the end are skipped, color indices for all widgets are
+calculated in a single pass grouped by widget type and style and the layers
+of each plane are then written in ascending element order.
+
+@code{.cpp}
+Ui::WidgetStateChange change;
+change.hide({header, footer})
+      .disable(submit)
+      .enable(cancel);
+
+// ...
+
+change.commit();
+@endcode
+
+The @ref Widget::disable(std::initializer_list<Containers::Reference<Widget>>) "Widget::disable({...})"
+and other batch functions use this class internally.
+
+@section Ui-WidgetStateChange-lifetime Widget lifetime
+
+The change stores plain widget pointers. It's the user responsibility to
+ensure a widget is not destroyed before the change is committed or discarded.
+@experimental
+*/
+class MAGNUM_UI_EXPORT WidgetStateChange {
+    public:
+        /** @brief Constructor */
+        explicit WidgetStateChange();
+
+        /** @brief Copying is not allowed */
+        WidgetStateChange(const WidgetStateChange&) = delete;
+
+        /** @brief Move constructor */
+        WidgetStateChange(WidgetStateChange&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Discards all changes that were not committed.
+         */
+        ~WidgetStateChange();
+
+        /** @brief Copying is not allowed */
+        WidgetStateChange& operator=(const WidgetStateChange&) = delete;
+
+        /** @brief Move assignment */
+        WidgetStateChange& operator=(WidgetStateChange&&) noexcept;
+
+        /** @brief Count of changes that were not committed yet */
+        std::size_t size() const { return _changes.size(); }
+
+        /**
+         * @brief Disable a widget
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Widget::disable()
+         */
+        WidgetStateChange& disable(Widget& widget);
+
+        /** @overload */
+        WidgetStateChange& disable(std::initializer_list<Containers::Reference<Widget>> widgets);
+
+        /**
+         * @brief Enable a widget
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Widget::enable()
+         */
+        WidgetStateChange& enable(Widget& widget);
+
+        /** @overload */
+        WidgetStateChange& enable(std::initializer_list<Containers::Reference<Widget>> widgets);
+
+        /**
+         * @brief Enable or disable a widget
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Widget::setEnabled()
+         */
+        WidgetStateChange& setEnabled(bool enabled, Widget& widget);
+
+        /** @overload */
+        WidgetStateChange& setEnabled(bool enabled, std::initializer_list<Containers::Reference<Widget>> widgets);
+
+        /**
+         * @brief Hide a widget
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Widget::hide()
+         */
+        WidgetStateChange& hide(Widget& widget);
+
+        /** @overload */
+        WidgetStateChange& hide(std::initializer_list<Containers::Reference<Widget>> widgets);
+
+        /**
+         * @brief Show a widget
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Widget::show()
+         */
+        WidgetStateChange& show(Widget& widget);
+
+        /** @overload */
+        WidgetStateChange& show(std::initializer_list<Containers::Reference<Widget>> widgets);
+
+        /**
+         * @brief Show or hide a widget
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Widget::setVisible()
+         */
+        WidgetStateChange& setVisible(bool visible, Widget& widget);
+
+        /** @overload */
+        WidgetStateChange& setVisible(bool visible, std::initializer_list<Containers::Reference<Widget>> widgets);
+
+        /**
+         * @brief Commit the changes
+         * @return Count of widgets whose state changed
+         *
+         * Multiple changes of the same widget are applied in the order they
+         * were made. Widgets whose flags end up the same as before are not
+         * updated at all. Widgets that aren't part of a @ref Plane or that
+         * don't support batched updates are updated the same way as with
+         * @ref Widget::hide() and others. The change is empty afterwards and
+         * can be reused.
+         */
+        std::size_t commit();
+
+    private:
+        struct Change {
+            Widget* widget;
+            WidgetFlags set, clear;
+        };
+
+        WidgetStateChange& add(Widget& widget, WidgetFlags set, WidgetFlags clear);
+        WidgetStateChange& add(std::initializer_list<Containers::Reference<Widget>> widgets, WidgetFlags set, WidgetFlags clear);
+
+        std::vector<Change> _changes;
+};
+
+}}
+
+#endif
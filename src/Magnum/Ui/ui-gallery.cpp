@@ -23,12 +23,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/Interconnect/Receiver.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Format.h>
 #include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/GL/Renderer.h>
 #ifdef CORRADE_TARGET_ANDROID
@@ -40,8 +48,13 @@
 #endif
 #include <Magnum/Text/Alignment.h>
 
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_APPLE)
+#include <unistd.h>
+#endif
+
 #include "Magnum/Ui/Anchor.h"
 #include "Magnum/Ui/Button.h"
+#include "Magnum/Ui/GLBufferArena.h"
 #include "Magnum/Ui/Input.h"
 #include "Magnum/Ui/Label.h"
 #include "Magnum/Ui/Modal.h"
@@ -75,6 +88,8 @@ add_custom_command(OUTPUT ... COMMAND MagnumExtras::ui-gallery ...)
 
 @code{.sh}
 magnum-ui-gallery [--magnum-...] [-h|--help] [--style STYLE]
+    [--stress-planes N] [--stress-widgets N] [--stress-rate N]
+    [--stress-seed N] [--stress-frames N]
 @endcode
 
 Arguments:
@@ -83,9 +98,45 @@ Arguments:
 -   `--style STYLE` --- specify style to use (default: `mcss-dark`). One of:
     -   `default` --- the default style
     -   `mcss-dark` --- dark [m.css](http://mcss.mosra.cz) theme
+-   `--stress-planes N` --- replace the gallery with @p N planes full of
+    generated widgets and print frame statistics (default: `0`, which means
+    the stress test is disabled)
+-   `--stress-widgets N` --- count of widgets of each type in each stress
+    plane (default: `64`)
+-   `--stress-rate N` --- count of random text, style or visibility changes
+    per frame (default: `16`)
+-   `--stress-seed N` --- random seed for the stress test (default: `0`)
+-   `--stress-frames N` --- exit after @p N frames, printing a summary
+    (default: `0`, which means running until the window is closed)
 -   `--magnum-...` --- engine-specific options (see
     @ref GL-Context-command-line for details)
 
+@section magnum-ui-gallery-stress Stress test
+
+With `--stress-planes` specified, the gallery creates given count of planes,
+each with `--stress-widgets` buttons, labels and inputs, and then each frame
+applies `--stress-rate` random changes to them, hit-tests
+@cpp 64 @ce random cursor positions and redraws. The changes are generated
+from `--stress-seed`, so runs with the same options produce the same load.
+Every @cpp 100 @ce frames the following is printed:
+
+-   average and maximal frame time, measured between consecutive frames
+-   average time spent in UI update and draw
+-   average time of a single hit test
+-   average count of bytes uploaded to the GPU per frame, together with the
+    total size of layer buffers in @ref Ui::UserInterface::bufferArena()
+-   resident memory size of the process, on Linux and Android
+
+In stress mode the window is hidden where the platform supports it, vsync is
+disabled and redraw happens continuously. Together with `--stress-frames` it's
+suitable for running on CI, for example on a software GL implementation under
+a virtual X server:
+
+@code{.sh}
+xvfb-run magnum-ui-gallery --stress-planes 4 --stress-widgets 256 \
+    --stress-frames 1000
+@endcode
+
 */
 
 using namespace Magnum::Math::Literals;
@@ -249,6 +300,36 @@ struct BaseUiPlane: Ui::Plane {
         modalInfo;
 };
 
+/* Planes for the stress test, widgets are laid out in a grid and overlap
+   once they don't fit anymore */
+struct StressUiPlane: Ui::Plane {
+    /* Buttons and inputs have a foreground element, but all three have a
+       text element and the foreground capacity is used for the text element
+       count as well, so it has to be 3*count, not 2*count */
+    explicit StressUiPlane(Ui::UserInterface& ui, std::size_t count):
+        Ui::Plane{ui, Ui::Snap::Top|Ui::Snap::Bottom|Ui::Snap::Left|Ui::Snap::Right, 0, 3*count, 3*count*TextCapacity}
+    {
+        const std::size_t columns = std::max(std::size_t(rect().sizeX()/ButtonSize.x()), std::size_t(1));
+        const std::size_t rows = std::max(std::size_t(rect().sizeY()/WidgetHeight), std::size_t(1));
+        for(std::size_t i = 0; i != 3*count; ++i) {
+            const Ui::Anchor anchor{Ui::Snap::Top|Ui::Snap::Left, Range2D::fromSize(
+                Vector2{Float(i%columns), -Float(i/columns%rows)}*ButtonSize, ButtonSize)};
+            if(i%3 == 0)
+                buttons.emplace_back(new Ui::Button{*this, anchor, "Button", TextCapacity});
+            else if(i%3 == 1)
+                labels.emplace_back(new Ui::Label{*this, anchor, "Label", Text::Alignment::LineCenterIntegral, TextCapacity});
+            else
+                inputs.emplace_back(new Ui::Input{*this, anchor, "Input", TextCapacity});
+        }
+    }
+
+    enum: std::size_t { TextCapacity = 8 };
+
+    std::vector<Containers::Pointer<Ui::Button>> buttons;
+    std::vector<Containers::Pointer<Ui::Label>> labels;
+    std::vector<Containers::Pointer<Ui::Input>> inputs;
+};
+
 struct ModalUiPlane: Ui::Plane, Interconnect::Receiver {
     explicit ModalUiPlane(Ui::UserInterface& ui, Ui::Style style):
         Ui::Plane{ui, {{}, {320.0f, 240.0f}}, 2, 3, 128},
@@ -283,6 +364,8 @@ class Gallery: public Platform::Application, public Interconnect::Receiver {
         void textInputEvent(TextInputEvent& event) override;
         #endif
 
+        void stress();
+
         Containers::Optional<Ui::UserInterface> _ui;
         Containers::Optional<BaseUiPlane> _baseUiPlane;
         Containers::Optional<ModalUiPlane> _defaultModalUiPlane,
@@ -290,25 +373,39 @@ class Gallery: public Platform::Application, public Interconnect::Receiver {
             _successModalUiPlane,
             _warningModalUiPlane,
             _infoModalUiPlane;
+
+        std::vector<Containers::Pointer<StressUiPlane>> _stressUiPlanes;
+        std::mt19937 _stressRandom;
+        std::size_t _stressRate{}, _stressFrameLimit{};
+        std::size_t _stressFrame{};
+        std::chrono::high_resolution_clock::time_point _stressPreviousFrame;
+
+        /* Accumulated since the last printout and for the whole run */
+        struct StressStatistics {
+            std::chrono::nanoseconds frameTime{}, frameTimeMax{}, updateTime{}, hitTestTime{};
+            std::size_t hitTests{}, uploadedSize{};
+        } _stressStatistics, _stressTotalStatistics;
+
+        void printStressStatistics(const StressStatistics& statistics, std::size_t firstFrame) const;
 };
 
-Gallery::Gallery(const Arguments& arguments): Platform::Application{arguments, Configuration{}.setTitle("Magnum::Ui Gallery")
-    #ifndef CORRADE_TARGET_ANDROID
-    .setSize({640, 480})
-    #endif
-    #ifdef CORRADE_TARGET_IOS
-    .setWindowFlags(Configuration::WindowFlag::Borderless)
-    #endif
-    }
-{
+Gallery::Gallery(const Arguments& arguments): Platform::Application{arguments, NoCreate} {
     Utility::Arguments args;
     args.addOption("style", "mcss-dark").setHelp("style", "specify style to use")
+        .addOption("stress-planes", "0").setHelp("stress-planes", "run a stress test with given count of planes", "N")
+        .addOption("stress-widgets", "64").setHelp("stress-widgets", "count of widgets of each type in each stress plane", "N")
+        .addOption("stress-rate", "16").setHelp("stress-rate", "count of random widget changes per frame", "N")
+        .addOption("stress-seed", "0").setHelp("stress-seed", "random seed for the stress test", "N")
+        .addOption("stress-frames", "0").setHelp("stress-frames", "exit the stress test after given count of frames", "N")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setGlobalHelp(
 R"(Showcases different widgets in the Magnum::Ui library. The --style option can
 be one of:
   default       the default style
-  mcss-dark     dark m.css theme from http://mcss.mosra.cz)")
+  mcss-dark     dark m.css theme from http://mcss.mosra.cz
+
+With --stress-planes, the widgets are replaced with generated ones that get
+randomly changed every frame and frame statistics are printed.)")
         #ifndef CORRADE_TARGET_ANDROID
         .parse(arguments.argc, arguments.argv)
         #else
@@ -316,14 +413,32 @@ be one of:
         #endif
         ;
 
+    const std::size_t stressPlanes = args.value<std::size_t>("stress-planes");
+    Configuration conf;
+    conf.setTitle("Magnum::Ui Gallery")
+        #ifndef CORRADE_TARGET_ANDROID
+        .setSize({640, 480})
+        #endif
+        #ifdef CORRADE_TARGET_IOS
+        .setWindowFlags(Configuration::WindowFlag::Borderless)
+        #endif
+        ;
+    #if !defined(CORRADE_TARGET_ANDROID) && !defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(CORRADE_TARGET_IOS)
+    /* Nobody needs to see the stress test */
+    if(stressPlanes) conf.setWindowFlags(Configuration::WindowFlag::Hidden);
+    #endif
+    create(conf);
+
     /* Enable blending with premultiplied alpha */
     GL::Renderer::enable(GL::Renderer::Feature::Blending);
     GL::Renderer::setBlendFunction(GL::Renderer::BlendFunction::One, GL::Renderer::BlendFunction::OneMinusSourceAlpha);
     GL::Renderer::setBlendEquation(GL::Renderer::BlendEquation::Add, GL::Renderer::BlendEquation::Add);
 
     #if !defined(MAGNUM_TARGET_WEBGL) && !defined(CORRADE_TARGET_ANDROID)
-    /* Have some sane speed, please */
-    setMinimalLoopPeriod(16);
+    /* Have some sane speed, please. Except for the stress test, which should
+       go as fast as possible. */
+    if(stressPlanes) setSwapInterval(0);
+    else setMinimalLoopPeriod(16);
     #endif
 
     /* Decide about style to use */
@@ -343,6 +458,23 @@ be one of:
     Interconnect::connect(*_ui, &Ui::UserInterface::inputWidgetBlurred, *this, &Gallery::stopTextInput);
     #endif
 
+    /* Create stress test planes instead of the gallery if requested. Each
+       plane gets activated so all of them are drawn, not just the first. */
+    if(stressPlanes) {
+        const std::size_t stressWidgets = args.value<std::size_t>("stress-widgets");
+        _stressRate = args.value<std::size_t>("stress-rate");
+        _stressFrameLimit = args.value<std::size_t>("stress-frames");
+        _stressRandom.seed(args.value<std::mt19937::result_type>("stress-seed"));
+        for(std::size_t i = 0; i != stressPlanes; ++i) {
+            _stressUiPlanes.emplace_back(new StressUiPlane{*_ui, stressWidgets});
+            _stressUiPlanes.back()->activate();
+        }
+
+        Debug{} << "Stress test with" << stressPlanes << "planes," << stressWidgets << "widgets of each type per plane and" << _stressRate << "changes per frame";
+        _stressPreviousFrame = std::chrono::high_resolution_clock::now();
+        return;
+    }
+
     /* Create base UI plane */
     _baseUiPlane.emplace(*_ui);
 
@@ -368,9 +500,139 @@ be one of:
 void Gallery::drawEvent() {
     GL::defaultFramebuffer.clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
 
+    if(!_stressUiPlanes.empty()) {
+        stress();
+        return;
+    }
+
+    _ui->draw();
+
+    swapBuffers();
+}
+
+namespace {
+
+/* Not using std::uniform_int_distribution in the stress test as its output
+   differs between STL implementations, while std::mt19937 is the same
+   everywhere */
+std::size_t randomIndex(std::mt19937& random, const std::size_t count) {
+    return random() % count;
+}
+
+Ui::Style randomStyle(std::mt19937& random, const Containers::ArrayView<const Ui::Style> styles) {
+    return styles[randomIndex(random, styles.size())];
+}
+
+/* Resident set size on Linux and Android, 0 elsewhere */
+std::size_t residentMemorySize() {
+    #if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_APPLE)
+    std::size_t size, resident;
+    if(std::sscanf(Utility::Directory::readString("/proc/self/statm").data(), "%zu %zu", &size, &resident) == 2)
+        return resident*sysconf(_SC_PAGESIZE);
+    #endif
+    return 0;
+}
+
+}
+
+void Gallery::stress() {
+    using namespace std::chrono;
+
+    /* Random changes. Not all styles are available for all widgets. */
+    constexpr Ui::Style ButtonStyles[]{Ui::Style::Default, Ui::Style::Primary, Ui::Style::Danger, Ui::Style::Success, Ui::Style::Warning, Ui::Style::Flat};
+    constexpr Ui::Style LabelStyles[]{Ui::Style::Default, Ui::Style::Primary, Ui::Style::Danger, Ui::Style::Success, Ui::Style::Warning, Ui::Style::Info, Ui::Style::Dim};
+    constexpr Ui::Style InputStyles[]{Ui::Style::Default, Ui::Style::Danger, Ui::Style::Success, Ui::Style::Warning, Ui::Style::Flat};
+    const high_resolution_clock::time_point updateStart = high_resolution_clock::now();
+    for(std::size_t i = 0; i != _stressRate; ++i) {
+        StressUiPlane& plane = *_stressUiPlanes[randomIndex(_stressRandom, _stressUiPlanes.size())];
+        const std::size_t type = randomIndex(_stressRandom, 3);
+        const std::size_t change = randomIndex(_stressRandom, 3);
+        const std::string text = std::to_string(randomIndex(_stressRandom, 100000));
+        Ui::Widget* widget;
+        if(type == 0) {
+            if(plane.buttons.empty()) continue;
+            Ui::Button& button = *plane.buttons[randomIndex(_stressRandom, plane.buttons.size())];
+            if(change == 0) button.setText(text);
+            else if(change == 1) button.setStyle(randomStyle(_stressRandom, ButtonStyles));
+            widget = &button;
+        } else if(type == 1) {
+            if(plane.labels.empty()) continue;
+            Ui::Label& label = *plane.labels[randomIndex(_stressRandom, plane.labels.size())];
+            if(change == 0) label.setText(text);
+            else if(change == 1) label.setStyle(randomStyle(_stressRandom, LabelStyles));
+            widget = &label;
+        } else {
+            if(plane.inputs.empty()) continue;
+            Ui::Input& input = *plane.inputs[randomIndex(_stressRandom, plane.inputs.size())];
+            if(change == 0) input.setValue(text);
+            else if(change == 1) input.setStyle(randomStyle(_stressRandom, InputStyles));
+            widget = &input;
+        }
+        if(change == 2) widget->setVisible(!!(widget->flags() & Ui::WidgetFlag::Hidden));
+    }
+
+    /* Hit tests at random positions. Can cause hover changes, which then get
+       uploaded as well. */
+    constexpr std::size_t HitTests = 64;
+    const high_resolution_clock::time_point hitTestStart = high_resolution_clock::now();
+    for(std::size_t i = 0; i != HitTests; ++i) {
+        const Int x = randomIndex(_stressRandom, windowSize().x());
+        const Int y = randomIndex(_stressRandom, windowSize().y());
+        _ui->handleMoveEvent({x, y});
+    }
+    const high_resolution_clock::time_point hitTestEnd = high_resolution_clock::now();
+
+    /* Update separately from the draw to know how much got uploaded */
+    Ui::GLBufferArena& arena = _ui->bufferArena();
+    const std::size_t uploadedSize = arena.uploadedSize();
+    _ui->update();
     _ui->draw();
+    const high_resolution_clock::time_point updateEnd = high_resolution_clock::now();
 
     swapBuffers();
+    redraw();
+
+    const high_resolution_clock::time_point frameEnd = high_resolution_clock::now();
+    const nanoseconds frameTime = frameEnd - _stressPreviousFrame;
+    _stressPreviousFrame = frameEnd;
+    for(StressStatistics* statistics: {&_stressStatistics, &_stressTotalStatistics}) {
+        statistics->frameTime += frameTime;
+        statistics->frameTimeMax = std::max(statistics->frameTimeMax, frameTime);
+        /* Hit test time is excluded from the update time */
+        statistics->updateTime += (updateEnd - updateStart) - (hitTestEnd - hitTestStart);
+        statistics->hitTestTime += hitTestEnd - hitTestStart;
+        statistics->hitTests += HitTests;
+        statistics->uploadedSize += arena.uploadedSize() - uploadedSize;
+    }
+
+    ++_stressFrame;
+    if(_stressFrame % 100 == 0) {
+        printStressStatistics(_stressStatistics, _stressFrame - 100);
+        _stressStatistics = {};
+    }
+
+    #ifndef CORRADE_TARGET_ANDROID
+    if(_stressFrameLimit && _stressFrame == _stressFrameLimit) {
+        printStressStatistics(_stressTotalStatistics, 0);
+        exit();
+    }
+    #endif
+}
+
+void Gallery::printStressStatistics(const StressStatistics& statistics, const std::size_t firstFrame) const {
+    using namespace std::chrono;
+
+    const std::size_t frames = _stressFrame - firstFrame;
+    const Double frameTime = duration<Double, std::milli>(statistics.frameTime).count()/frames;
+    const Double frameTimeMax = duration<Double, std::milli>(statistics.frameTimeMax).count();
+    const Double updateTime = duration<Double, std::milli>(statistics.updateTime).count()/frames;
+    const Double hitTestTime = duration<Double, std::micro>(statistics.hitTestTime).count()/statistics.hitTests;
+    Debug{} << "Frames" << firstFrame << Debug::nospace << "-" << Debug::nospace << _stressFrame << Debug::nospace << ":"
+        << Utility::formatString("frame {:.2f} ms (max {:.2f}), update+draw {:.2f} ms, hit test {:.2f} us, upload {} kB/frame of {} kB, memory {} kB",
+            frameTime, frameTimeMax, updateTime, hitTestTime,
+            statistics.uploadedSize/frames/1024,
+            _ui->bufferArena().capacity()/1024,
+            residentMemorySize()/1024);
 }
 
 void Gallery::mousePressEvent(MouseEvent& event) {
@@ -25,6 +25,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <string>
+#include <vector>
 #include <Corrade/PluginManager/PluginManager.h>
 #include <Corrade/Utility/Utility.h>
 #include <Magnum/DebugTools/FrameProfiler.h>
@@ -39,6 +41,11 @@
 
 namespace Magnum { namespace Player {
 
+class FileTracker;
+class FrameClock;
+class TextureCache;
+class TextureDecoder;
+class Tracer;
 class Player;
 
 class AbstractUiScreen: public Platform::Screen {
@@ -61,10 +68,17 @@ class AbstractPlayer: public AbstractUiScreen {
         friend Player;
 
         virtual void load(const std::string& filename, Trade::AbstractImporter& importer, Int id) = 0;
+
+        /* Called on reload with a list of files that changed since the last
+           load. By default it does a full load again. */
+        virtual void reload(const std::string& filename, Trade::AbstractImporter& importer, Int id, const std::vector<std::string>& changedFiles) {
+            static_cast<void>(changedFiles);
+            load(filename, importer, id);
+        }
 };
 
 /* Extreme PIMPL. */
-Containers::Pointer<AbstractPlayer> createScenePlayer(Platform::ScreenedApplication& application, Ui::UserInterface& uiToStealFontFrom, const DebugTools::GLFrameProfiler::Values profilerValues, bool& drawUi);
+Containers::Pointer<AbstractPlayer> createScenePlayer(Platform::ScreenedApplication& application, Ui::UserInterface& uiToStealFontFrom, const DebugTools::GLFrameProfiler::Values profilerValues, Float interactionFrameTime, bool staticBatching, bool compressTextures, bool frameChecksum, bool& drawUi, const FrameClock& clock, FileTracker* fileTracker, TextureCache* textureCache, TextureDecoder* textureDecoder, Tracer* tracer);
 Containers::Pointer<AbstractPlayer> createImagePlayer(Platform::ScreenedApplication& application, Ui::UserInterface& uiToStealFontFrom, bool& drawUi);
 
 }}
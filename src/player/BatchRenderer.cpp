@@ -0,0 +1,435 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchRenderer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/String.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/VertexFormat.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Renderer.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/FunctionsBatch.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/MeshTools/Duplicate.h>
+#include <Magnum/MeshTools/GenerateIndices.h>
+#include <Magnum/Shaders/Phong.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/MeshData.h>
+#include <Magnum/Trade/MeshObjectData3D.h>
+#include <Magnum/Trade/PhongMaterialData.h>
+#include <Magnum/Trade/SceneData.h>
+
+#include "FrameCapture.h"
+#include "ImporterPool.h"
+#include "WorkerPool.h"
+
+namespace Magnum { namespace Player {
+
+namespace {
+
+using namespace Math::Literals;
+
+/* Same mapping as AnySceneImporter does, which can't be used from the
+   worker threads as it instantiates the concrete plugin on open */
+constexpr struct {
+    const char* extension;
+    const char* plugin;
+} SceneExtensions[]{
+    {".gltf", "GltfImporter"},
+    {".glb", "GltfImporter"},
+    {".obj", "ObjImporter"},
+    {".ply", "StanfordImporter"},
+    {".fbx", "FbxImporter"},
+    {".dae", "ColladaImporter"},
+    {".3ds", "3dsImporter"},
+    {".blend", "BlenderImporter"},
+    {".stl", "StlImporter"},
+    {".ogex", "OpenGexImporter"}
+};
+
+const char* scenePlugin(const std::string& filename) {
+    const std::string extension = Utility::String::lowercase(Utility::Directory::splitExtension(filename).second);
+    for(const auto& i: SceneExtensions)
+        if(extension == i.extension) return i.plugin;
+    return nullptr;
+}
+
+struct PreparedMesh {
+    /* Empty if the import failed or the mesh can't be drawn */
+    Containers::Optional<Trade::MeshData> data;
+    MeshTools::CompileFlags flags;
+    Range3D bounds;
+};
+
+struct MeshInstance {
+    UnsignedInt mesh;
+    Matrix4 transformation;
+    Color4 color;
+};
+
+struct ImportedFile {
+    std::size_t id;
+    std::vector<PreparedMesh> meshes;
+    std::vector<MeshInstance> instances;
+    Range3D bounds;
+};
+
+/* Imports the mesh and decides what needs to be generated for it, so the
+   main thread only uploads it. Materials and textures are not imported, only
+   material colors. */
+void prepareMesh(Trade::AbstractImporter& importer, const UnsignedInt id, PreparedMesh& mesh) {
+    Containers::Optional<Trade::MeshData> data = importer.mesh(id);
+    if(!data) return;
+
+    /* Lines and points are not drawn */
+    if((data->primitive() != MeshPrimitive::Triangles &&
+        data->primitive() != MeshPrimitive::TriangleStrip &&
+        data->primitive() != MeshPrimitive::TriangleFan) ||
+       !data->hasAttribute(Trade::MeshAttribute::Position))
+        return;
+
+    /* Generate normals the same way as the scene player does */
+    mesh.flags = MeshTools::CompileFlag::NoWarnOnCustomAttributes;
+    if(!data->hasAttribute(Trade::MeshAttribute::Normal) && data->attributeFormat(Trade::MeshAttribute::Position) == VertexFormat::Vector3) {
+        if(data->primitive() != MeshPrimitive::Triangles) {
+            if(data->isIndexed()) data = MeshTools::duplicate(*std::move(data));
+            data = MeshTools::generateIndices(*std::move(data));
+            mesh.flags |= MeshTools::CompileFlag::GenerateFlatNormals;
+        } else if(data->isIndexed())
+            mesh.flags |= MeshTools::CompileFlag::GenerateSmoothNormals;
+        else
+            mesh.flags |= MeshTools::CompileFlag::GenerateFlatNormals;
+    }
+
+    const Containers::Array<Vector3> positions = data->positions3DAsArray();
+    const std::pair<Vector3, Vector3> minmax = Math::minmax(Containers::arrayView(positions));
+    mesh.bounds = {minmax.first, minmax.second};
+    mesh.data = std::move(data);
+}
+
+void addObject(Trade::AbstractImporter& importer, const std::vector<Color4>& materialColors, ImportedFile& file, const UnsignedInt id, const Matrix4& parentTransformation) {
+    Containers::Pointer<Trade::ObjectData3D> object = importer.object3D(id);
+    if(!object) return;
+
+    const Matrix4 transformation = parentTransformation*object->transformation();
+    if(object->instanceType() == Trade::ObjectInstanceType3D::Mesh && object->instance() != -1 && UnsignedInt(object->instance()) < file.meshes.size() && file.meshes[object->instance()].data) {
+        const Int material = static_cast<const Trade::MeshObjectData3D&>(*object).material();
+        file.instances.push_back({UnsignedInt(object->instance()), transformation,
+            material != -1 && UnsignedInt(material) < materialColors.size() ? materialColors[material] : 0xffffffff_rgbaf});
+    }
+
+    for(const UnsignedInt child: object->children())
+        addObject(importer, materialColors, file, child, transformation);
+}
+
+ImportedFile importFile(Trade::AbstractImporter& importer, const std::string& filename) {
+    ImportedFile file{};
+    if(!importer.openFile(filename)) return file;
+
+    file.meshes.resize(importer.meshCount());
+    for(UnsignedInt i = 0; i != importer.meshCount(); ++i)
+        prepareMesh(importer, i, file.meshes[i]);
+
+    std::vector<Color4> materialColors(importer.materialCount(), 0xffffffff_rgbaf);
+    for(UnsignedInt i = 0; i != importer.materialCount(); ++i) {
+        Containers::Optional<Trade::MaterialData> material = importer.material(i);
+        if(material && material->types() & Trade::MaterialType::Phong)
+            materialColors[i] = material->as<Trade::PhongMaterialData>().diffuseColor();
+    }
+
+    /* If the format has no scene support, show just the first mesh */
+    const Int sceneId = importer.defaultScene() != -1 ? importer.defaultScene() : importer.sceneCount() ? 0 : -1;
+    if(sceneId != -1) {
+        if(Containers::Optional<Trade::SceneData> scene = importer.scene(sceneId))
+            for(const UnsignedInt child: scene->children3D())
+                addObject(importer, materialColors, file, child, {});
+    } else if(!file.meshes.empty() && file.meshes[0].data)
+        file.instances.push_back({0, {}, 0xffffffff_rgbaf});
+
+    /* Bounds of all instances, from corners of the transformed mesh bounds */
+    for(std::size_t i = 0; i != file.instances.size(); ++i) {
+        const MeshInstance& instance = file.instances[i];
+        const Range3D& bounds = file.meshes[instance.mesh].bounds;
+        for(UnsignedInt corner = 0; corner != 8; ++corner) {
+            const Vector3 point = instance.transformation.transformPoint({
+                (corner & 1 ? bounds.max() : bounds.min()).x(),
+                (corner & 2 ? bounds.max() : bounds.min()).y(),
+                (corner & 4 ? bounds.max() : bounds.min()).z()});
+            file.bounds = i || corner ?
+                Range3D{Math::min(file.bounds.min(), point), Math::max(file.bounds.max(), point)} :
+                Range3D{point, point};
+        }
+    }
+
+    importer.close();
+    return file;
+}
+
+}
+
+std::vector<std::string> batchFiles(const std::string& path) {
+    std::vector<std::string> files;
+
+    if(Utility::Directory::isDirectory(path)) {
+        for(const std::string& file: Utility::Directory::list(path, Utility::Directory::Flag::SkipDirectories|Utility::Directory::Flag::SkipDotAndDotDot|Utility::Directory::Flag::SortAscending))
+            if(scenePlugin(file)) files.push_back(Utility::Directory::join(path, file));
+
+    } else if(Utility::String::lowercase(Utility::Directory::splitExtension(path).second) == ".txt") {
+        for(std::string& line: Utility::String::splitWithoutEmptyParts(Utility::Directory::readString(path), '\n')) {
+            Utility::String::trimInPlace(line);
+            if(!line.empty() && line[0] != '#') files.push_back(std::move(line));
+        }
+
+    } else files.push_back(path);
+
+    return files;
+}
+
+std::size_t renderBatch(PluginManager::Manager<Trade::AbstractImporter>& importerManager, PluginManager::Manager<Trade::AbstractImageConverter>& converterManager, const std::vector<std::string>& files, const BatchOptions& options) {
+    std::size_t failed = 0;
+
+    FrameCapture capture{converterManager, options.converter, options.encodeThreads};
+    if(!capture.isValid()) return files.size();
+
+    if(!Utility::Directory::mkpath(options.outputDirectory)) {
+        Error{} << "Cannot create output directory" << options.outputDirectory;
+        return files.size();
+    }
+
+    /* Pick a concrete importer for each file */
+    std::vector<std::string> plugins;
+    plugins.reserve(files.size());
+    for(const std::string& file: files) {
+        if(options.importer != "AnySceneImporter")
+            plugins.push_back(options.importer);
+        else if(const char* plugin = scenePlugin(file))
+            plugins.push_back(plugin);
+        else {
+            Error{} << "Cannot determine an importer for" << file;
+            plugins.emplace_back();
+        }
+    }
+
+    /* Instantiate all plugins that are needed for each worker here, as the
+       plugin manager isn't thread-safe. The workers then only take the
+       already warm instances out of their pool. */
+    WorkerPool importPool{options.importThreads};
+    std::vector<ImporterPool> importers;
+    importers.reserve(importPool.workerCount());
+    for(std::size_t i = 0; i != importPool.workerCount(); ++i) {
+        importers.emplace_back(importerManager);
+        importers.back().setFlags(options.importerFlags);
+    }
+    std::unordered_map<std::string, bool> loaded;
+    for(std::string& plugin: plugins) {
+        if(plugin.empty()) continue;
+
+        auto found = loaded.find(plugin);
+        if(found == loaded.end()) {
+            bool success = true;
+            for(ImporterPool& pool: importers) {
+                Trade::AbstractImporter* importer = pool.get(plugin);
+                if(!importer) {
+                    success = false;
+                    break;
+                }
+                setImporterOptions(*importer, options.importerOptions);
+            }
+            found = loaded.emplace(plugin, success).first;
+        }
+
+        /* Treat files for plugins that failed to load as unknown */
+        if(!found->second) plugin.clear();
+    }
+
+    /* Imported files are handed over to the main thread through a queue. At
+       most two files per worker are in flight, so the imported data don't
+       pile up if drawing is the bottleneck. */
+    std::mutex mutex;
+    std::condition_variable importedCondition;
+    std::deque<ImportedFile> imported;
+    std::size_t next = 0, inFlight = 0;
+    auto submit = [&]() {
+        for(; next != files.size() && inFlight < 2*importPool.workerCount(); ++next) {
+            if(plugins[next].empty()) {
+                ++failed;
+                continue;
+            }
+
+            ++inFlight;
+            const std::size_t id = next;
+            importPool.submit([&, id](const std::size_t worker) {
+                ImportedFile file = importFile(*importers[worker].get(plugins[id]), files[id]);
+                file.id = id;
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    imported.push_back(std::move(file));
+                }
+                importedCondition.notify_one();
+            });
+        }
+    };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    const Int sampleCount = Math::min(GL::Renderbuffer::maxSamples(), 4);
+    GL::Renderbuffer color, depth, resolvedColor;
+    color.setStorageMultisample(sampleCount, GL::RenderbufferFormat::RGBA8, options.size);
+    depth.setStorageMultisample(sampleCount, GL::RenderbufferFormat::DepthComponent24, options.size);
+    resolvedColor.setStorage(GL::RenderbufferFormat::RGBA8, options.size);
+    GL::Framebuffer framebuffer{{{}, options.size}};
+    GL::Framebuffer resolved{{{}, options.size}};
+    resolved.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, resolvedColor);
+    #else
+    GL::Renderbuffer color, depth;
+    color.setStorage(GL::RenderbufferFormat::RGBA8, options.size);
+    depth.setStorage(GL::RenderbufferFormat::DepthComponent24, options.size);
+    GL::Framebuffer framebuffer{{{}, options.size}};
+    GL::Framebuffer& resolved = framebuffer;
+    #endif
+    framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, depth);
+
+    Shaders::Phong shader{{}, 2};
+    Shaders::Phong vertexColorShader{Shaders::Phong::Flag::VertexColor, 2};
+    for(Shaders::Phong* s: {&shader, &vertexColorShader}) (*s)
+        .setLightPositions({{-0.5f, 1.0f, 1.0f, 0.0f}, {1.0f, -0.25f, 0.5f, 0.0f}})
+        .setLightColors({0xffffff_rgbf, 0x555555_rgbf})
+        .setSpecularColor(0x11111100_rgbaf)
+        .setShininess(80.0f);
+
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+    GL::Renderer::setClearColor(0x22272e_rgbf);
+
+    /* Frame the bounding sphere in the narrower of the two fields of view */
+    constexpr Deg fov = 35.0_degf;
+    const Float aspectRatio = Vector2{options.size}.aspectRatio();
+    const Float tangent = Math::tan(fov*0.5f)*Math::min(aspectRatio, 1.0f);
+    const Float distanceToRadius = Math::sqrt(1.0f + 1.0f/(tangent*tangent));
+
+    using std::chrono::steady_clock;
+    const steady_clock::time_point start = steady_clock::now();
+    std::chrono::duration<double> waiting{};
+    std::size_t rendered = 0;
+
+    submit();
+    while(inFlight) {
+        ImportedFile file;
+        {
+            const steady_clock::time_point waitStart = steady_clock::now();
+            std::unique_lock<std::mutex> lock{mutex};
+            importedCondition.wait(lock, [&] { return !imported.empty(); });
+            file = std::move(imported.front());
+            imported.pop_front();
+            waiting += steady_clock::now() - waitStart;
+        }
+
+        /* Let the workers import more while this one is drawn */
+        --inFlight;
+        submit();
+
+        const std::string& filename = files[file.id];
+        if(file.instances.empty()) {
+            Error{} << "Nothing to render in" << filename;
+            ++failed;
+            continue;
+        }
+
+        std::vector<Containers::Optional<GL::Mesh>> meshes(file.meshes.size());
+        for(const MeshInstance& instance: file.instances)
+            if(!meshes[instance.mesh])
+                meshes[instance.mesh] = MeshTools::compile(*file.meshes[instance.mesh].data, file.meshes[instance.mesh].flags);
+
+        const Float radius = Math::max(file.bounds.size().length()*0.5f, 1.0e-4f);
+        const Float distance = radius*distanceToRadius;
+        const Matrix4 projection = Matrix4::perspectiveProjection(fov, aspectRatio, (distance - radius)*0.5f, (distance + radius)*1.5f);
+
+        const std::string name = Utility::Directory::join(options.outputDirectory, Utility::Directory::splitExtension(Utility::Directory::filename(filename)).first);
+        for(UnsignedInt view = 0; view != options.viewCount; ++view) {
+            const Matrix4 viewMatrix = (
+                Matrix4::translation(file.bounds.center())*
+                Matrix4::rotationY(360.0_degf*Float(view)/Float(options.viewCount))*
+                Matrix4::rotationX(-20.0_degf)*
+                Matrix4::translation(Vector3::zAxis(distance))).invertedRigid();
+
+            framebuffer
+                .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth)
+                .bind();
+            for(const MeshInstance& instance: file.instances) {
+                const Matrix4 transformation = viewMatrix*instance.transformation;
+                (file.meshes[instance.mesh].data->hasAttribute(Trade::MeshAttribute::Color) ? vertexColorShader : shader)
+                    .setTransformationMatrix(transformation)
+                    .setNormalMatrix(transformation.normalMatrix())
+                    .setProjectionMatrix(projection)
+                    .setAmbientColor(instance.color*0.06f)
+                    .setDiffuseColor(instance.color)
+                    .draw(*meshes[instance.mesh]);
+            }
+
+            #ifndef MAGNUM_TARGET_GLES2
+            GL::AbstractFramebuffer::blit(framebuffer, resolved, {{}, options.size}, GL::FramebufferBlit::Color);
+            #endif
+            capture.capture(resolved, {{}, options.size}, options.viewCount == 1 ?
+                Utility::formatString("{}.{}", name, options.extension) :
+                Utility::formatString("{}-{:.2}.{}", name, view, options.extension));
+        }
+
+        ++rendered;
+        Debug{} << Utility::formatString("[{}/{}]", rendered + failed, files.size()) << filename;
+
+        /* Pass reads of the previous files to the encoding threads */
+        capture.update();
+    }
+
+    /* The jobs may still be notifying the condition variable */
+    importPool.wait();
+    capture.finish();
+    failed += capture.failedCount();
+
+    const std::chrono::duration<double> elapsed = steady_clock::now() - start;
+    Debug{} << "Rendered" << rendered << "of" << files.size() << "files in" << Utility::formatString("{:.2f}", elapsed.count()) << "seconds," << Utility::formatString("{:.1f}", rendered*60.0/elapsed.count()) << "files per minute";
+    Debug{} << "Waited" << Utility::formatString("{:.2f}", waiting.count()) << "seconds for" << importPool.workerCount() << "import threads," << capture.savedCount() << "images saved by" << capture.workerCount() << "encoding threads";
+
+    return failed;
+}
+
+}}
@@ -0,0 +1,72 @@
+#ifndef Magnum_Player_BatchRenderer_h
+#define Magnum_Player_BatchRenderer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+#include <Corrade/PluginManager/PluginManager.h>
+#include <Magnum/Math/Vector2.h>
+#include <Magnum/Trade/Trade.h>
+
+namespace Magnum { namespace Player {
+
+struct BatchOptions {
+    /* Importer plugin to use for all files, if AnySceneImporter, a concrete
+       plugin is picked based on the file extension */
+    std::string importer;
+    std::string importerOptions;
+    Trade::ImporterFlags importerFlags;
+    /* Zero means one thread per core */
+    std::size_t importThreads;
+
+    /* Concrete converter plugin and the file extension matching it */
+    std::string converter;
+    std::string extension;
+    std::size_t encodeThreads;
+
+    std::string outputDirectory;
+    Vector2i size;
+    UnsignedInt viewCount;
+};
+
+/* Expands a directory to scene files in it, sorted by name, or a text file to
+   filenames listed in it, one per line, with empty lines and lines starting
+   with # ignored. Anything else is returned as a single file. */
+std::vector<std::string> batchFiles(const std::string& path);
+
+/* Renders each file into options.viewCount images from an automatically
+   framed camera rotating around the scene, using the current GL context.
+   Files are imported and their meshes prepared on a pool of threads, each
+   with its own importer instances, so the next files get imported while the
+   main thread uploads and draws the current one. The images are read back
+   and encoded asynchronously through a FrameCapture. Returns count of files
+   that failed to import plus count of images that failed to save. Not
+   available on Emscripten. */
+std::size_t renderBatch(PluginManager::Manager<Trade::AbstractImporter>& importerManager, PluginManager::Manager<Trade::AbstractImageConverter>& converterManager, const std::vector<std::string>& files, const BatchOptions& options);
+
+}}
+
+#endif
@@ -0,0 +1,241 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BlockCompression.h"
+
+#include <utility>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
+
+namespace Magnum { namespace Player {
+
+namespace {
+
+UnsignedShort packRgb565(const Vector3i& color) {
+    return UnsignedShort(((color.r()*31 + 127)/255) << 11|
+                         ((color.g()*63 + 127)/255) << 5|
+                          ((color.b()*31 + 127)/255));
+}
+
+Vector3i unpackRgb565(const UnsignedShort color) {
+    const Int r = color >> 11, g = (color >> 5) & 0x3f, b = color & 0x1f;
+    return {r << 3|r >> 2, g << 2|g >> 4, b << 3|b >> 2};
+}
+
+void writeLittleEndian(char* const out, const UnsignedLong value, const std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i) out[i] = char(value >> 8*i);
+}
+
+/* Two RGB565 endpoints followed by 2-bit indices, 8 bytes in total */
+void compressColorBlock(const Color4ub(&texels)[16], char* const out) {
+    Vector3i colors[16];
+    Vector3i min{255}, max{0};
+    for(std::size_t i = 0; i != 16; ++i) {
+        colors[i] = Vector3i{texels[i].rgb()};
+        min = Math::min(min, colors[i]);
+        max = Math::max(max, colors[i]);
+    }
+
+    /* The bounding box diagonal goes from min to max in all channels. Flip
+       the channels that decrease with the channel of the largest range, so
+       the diagonal follows the actual color distribution. */
+    const Vector3i range = max - min;
+    const std::size_t reference = range[0] >= range[1] && range[0] >= range[2] ? 0 : range[1] >= range[2] ? 1 : 2;
+    const Vector3i center = (min + max)/2;
+    Vector3i covariance;
+    for(const Vector3i& color: colors)
+        covariance += (color - center)*(color[reference] - center[reference]);
+    for(std::size_t i = 0; i != 3; ++i)
+        if(covariance[i] < 0) std::swap(min[i], max[i]);
+
+    /* Inset the endpoints a bit to reduce the error for the inner colors */
+    const Vector3i inset = (max - min)/16;
+    UnsignedShort endpoints[]{packRgb565(max - inset), packRgb565(min + inset)};
+
+    /* The four-color mode needs the first endpoint to be larger. With equal
+       endpoints it's the three-color mode where the last index is
+       transparent, so all texels use the first index instead. */
+    if(endpoints[0] < endpoints[1]) std::swap(endpoints[0], endpoints[1]);
+    UnsignedInt indices = 0;
+    if(endpoints[0] != endpoints[1]) {
+        const Vector3i a = unpackRgb565(endpoints[0]);
+        const Vector3i b = unpackRgb565(endpoints[1]);
+        const Vector3i palette[]{a, b, (a*2 + b)/3, (a + b*2)/3};
+        for(std::size_t i = 0; i != 16; ++i) {
+            UnsignedInt best = 0;
+            Int bestDistance = (colors[i] - palette[0]).dot();
+            for(UnsignedInt j = 1; j != 4; ++j) {
+                const Int distance = (colors[i] - palette[j]).dot();
+                if(distance < bestDistance) {
+                    best = j;
+                    bestDistance = distance;
+                }
+            }
+            indices |= best << 2*i;
+        }
+    }
+
+    writeLittleEndian(out + 0, endpoints[0], 2);
+    writeLittleEndian(out + 2, endpoints[1], 2);
+    writeLittleEndian(out + 4, indices, 4);
+}
+
+/* Two alpha endpoints followed by 3-bit indices, 8 bytes in total. The first
+   endpoint is the larger one, which selects the mode with six values
+   interpolated between the two. */
+void compressAlphaBlock(const Color4ub(&texels)[16], char* const out) {
+    Int min = 255, max = 0;
+    for(const Color4ub& texel: texels) {
+        min = Math::min(min, Int(texel.a()));
+        max = Math::max(max, Int(texel.a()));
+    }
+
+    /* The position between min and max rounded to sevenths is mapped to the
+       palette, which has max first, min second and then the interpolated
+       values going from max to min */
+    UnsignedLong indices = 0;
+    if(min != max) for(std::size_t i = 0; i != 16; ++i) {
+        const Int step = ((texels[i].a() - min)*14 + (max - min))/(2*(max - min));
+        const UnsignedLong index = step == 7 ? 0 : step == 0 ? 1 : 8 - step;
+        indices |= index << 3*i;
+    }
+
+    out[0] = char(max);
+    out[1] = char(min);
+    writeLittleEndian(out + 2, indices, 6);
+}
+
+std::size_t blockDataSize(const CompressedPixelFormat format) {
+    CORRADE_ASSERT(format == CompressedPixelFormat::Bc1RGBUnorm || format == CompressedPixelFormat::Bc3RGBAUnorm,
+        "Player: expected a BC1 or BC3 format but got" << format, {});
+    return format == CompressedPixelFormat::Bc1RGBUnorm ? 8 : 16;
+}
+
+}
+
+bool isBlockCompressible(const PixelFormat format) {
+    return format == PixelFormat::RGB8Unorm || format == PixelFormat::RGBA8Unorm;
+}
+
+CompressedPixelFormat blockCompressedFormat(const ImageView2D& image) {
+    CORRADE_ASSERT(isBlockCompressible(image.format()),
+        "Player::blockCompressedFormat(): expected an RGB8 or RGBA8 image but got" << image.format(), {});
+
+    if(image.format() == PixelFormat::RGBA8Unorm)
+        for(Containers::StridedArrayView1D<const Color4ub> row: image.pixels<Color4ub>())
+            for(const Color4ub& texel: row)
+                if(texel.a() != 255) return CompressedPixelFormat::Bc3RGBAUnorm;
+
+    return CompressedPixelFormat::Bc1RGBUnorm;
+}
+
+std::vector<Image2D> generateMips(const ImageView2D& image) {
+    CORRADE_ASSERT(isBlockCompressible(image.format()),
+        "Player::generateMips(): expected an RGB8 or RGBA8 image but got" << image.format(), {});
+
+    std::vector<Image2D> levels;
+    Vector2i size = image.size();
+
+    /* RGBA8 rows are always four-byte aligned so the default pixel storage
+       works for all levels */
+    {
+        Image2D level{PixelFormat::RGBA8Unorm, size, Containers::Array<char>{Containers::NoInit, std::size_t(size.product()*4)}};
+        const Containers::StridedArrayView2D<Color4ub> dst = level.pixels<Color4ub>();
+        if(image.format() == PixelFormat::RGBA8Unorm) {
+            const Containers::StridedArrayView2D<const Color4ub> src = image.pixels<Color4ub>();
+            for(std::size_t y = 0; y != dst.size()[0]; ++y)
+                for(std::size_t x = 0; x != dst.size()[1]; ++x)
+                    dst[y][x] = src[y][x];
+        } else {
+            const Containers::StridedArrayView2D<const Color3ub> src = image.pixels<Color3ub>();
+            for(std::size_t y = 0; y != dst.size()[0]; ++y)
+                for(std::size_t x = 0; x != dst.size()[1]; ++x)
+                    dst[y][x] = Color4ub{src[y][x], 255};
+        }
+        levels.push_back(std::move(level));
+    }
+
+    while(size != Vector2i{1}) {
+        const Containers::StridedArrayView2D<const Color4ub> src = levels.back().pixels<Color4ub>();
+        const Vector2i previousSize = size;
+        size = Math::max(size/2, Vector2i{1});
+
+        /* For odd sizes the last row or column gets dropped */
+        Image2D level{PixelFormat::RGBA8Unorm, size, Containers::Array<char>{Containers::NoInit, std::size_t(size.product()*4)}};
+        const Containers::StridedArrayView2D<Color4ub> dst = level.pixels<Color4ub>();
+        for(Int y = 0; y != size.y(); ++y) {
+            const std::size_t y0 = 2*y, y1 = Math::min(2*y + 1, previousSize.y() - 1);
+            for(Int x = 0; x != size.x(); ++x) {
+                const std::size_t x0 = 2*x, x1 = Math::min(2*x + 1, previousSize.x() - 1);
+                const Vector4i sum = Vector4i{src[y0][x0]} + Vector4i{src[y0][x1]} + Vector4i{src[y1][x0]} + Vector4i{src[y1][x1]};
+                dst[y][x] = Color4ub{(sum + Vector4i{2})/4};
+            }
+        }
+        levels.push_back(std::move(level));
+    }
+
+    return levels;
+}
+
+std::size_t compressedDataSize(const Vector2i& size, const CompressedPixelFormat format) {
+    const Vector2i blockCount = (size + Vector2i{3})/4;
+    return blockCount.product()*blockDataSize(format);
+}
+
+void compressBlocks(const ImageView2D& image, const CompressedPixelFormat format, const std::size_t blockRowBegin, const std::size_t blockRowEnd, const Containers::ArrayView<char> out) {
+    CORRADE_ASSERT(image.format() == PixelFormat::RGBA8Unorm,
+        "Player::compressBlocks(): expected an RGBA8 image but got" << image.format(), );
+    CORRADE_ASSERT(out.size() == compressedDataSize(image.size(), format),
+        "Player::compressBlocks(): expected" << compressedDataSize(image.size(), format) << "bytes of output but got" << out.size(), );
+
+    const Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    const std::size_t blockSize = blockDataSize(format);
+    const std::size_t blockCountX = (image.size().x() + 3)/4;
+    const std::size_t lastY = image.size().y() - 1;
+    const std::size_t lastX = image.size().x() - 1;
+    CORRADE_ASSERT(blockRowBegin <= blockRowEnd && blockRowEnd <= (lastY + 4)/4,
+        "Player::compressBlocks(): block rows" << blockRowBegin << "to" << blockRowEnd << "out of range for" << (lastY + 4)/4 << "rows", );
+
+    for(std::size_t blockY = blockRowBegin; blockY != blockRowEnd; ++blockY) {
+        for(std::size_t blockX = 0; blockX != blockCountX; ++blockX) {
+            Color4ub texels[16];
+            for(std::size_t y = 0; y != 4; ++y)
+                for(std::size_t x = 0; x != 4; ++x)
+                    texels[y*4 + x] = pixels[Math::min(blockY*4 + y, lastY)][Math::min(blockX*4 + x, lastX)];
+
+            char* block = out.data() + (blockY*blockCountX + blockX)*blockSize;
+            if(format == CompressedPixelFormat::Bc3RGBAUnorm) {
+                compressAlphaBlock(texels, block);
+                block += 8;
+            }
+            compressColorBlock(texels, block);
+        }
+    }
+}
+
+}}
@@ -0,0 +1,67 @@
+#ifndef Magnum_Player_BlockCompression_h
+#define Magnum_Player_BlockCompression_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/Image.h>
+#include <Magnum/ImageView.h>
+
+namespace Magnum { namespace Player {
+
+/* CPU compression of uncompressed textures on load, to save GPU memory.
+   Images without alpha are compressed to BC1 at 4 bits per texel, images
+   with alpha to BC3 at 8 bits per texel. The endpoints are picked from the
+   bounding box of the block colors with the diagonal flipped to follow the
+   color distribution, which is fast and good enough for textures that
+   weren't authored as compressed. The per-block code is plain loops over the
+   sixteen texels that compilers turn into SIMD code. */
+
+/* Whether an image of given format can be passed to blockCompressedFormat()
+   and generateMips(). Only RGB8 and RGBA8 unorm images are supported. */
+bool isBlockCompressible(PixelFormat format);
+
+/* BC1 if all texels of the image are opaque, BC3 otherwise */
+CompressedPixelFormat blockCompressedFormat(const ImageView2D& image);
+
+/* Converts the image to RGBA8 and creates a full mip chain down to 1x1 by
+   averaging 2x2 texels, with the first level being the converted image. The
+   values are averaged as they are, without converting from sRGB. */
+std::vector<Image2D> generateMips(const ImageView2D& image);
+
+/* Size of compressed data for an image of given size and format */
+std::size_t compressedDataSize(const Vector2i& size, CompressedPixelFormat format);
+
+/* Compresses rows of 4x4 blocks from blockRowBegin up to blockRowEnd of an
+   RGBA8 image into `out`, which is expected to be compressedDataSize()
+   large. Blocks on the right and bottom edge that don't have all texels in
+   the image repeat the edge texels. Different block row ranges can be
+   compressed from multiple threads at once. */
+void compressBlocks(const ImageView2D& image, CompressedPixelFormat format, std::size_t blockRowBegin, std::size_t blockRowEnd, Containers::ArrayView<char> out);
+
+}}
+
+#endif
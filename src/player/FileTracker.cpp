@@ -0,0 +1,173 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FileTracker.h"
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Directory.h>
+#include <Magnum/Trade/AbstractImporter.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <Corrade/Utility/FileWatcher.h>
+#endif
+
+namespace Magnum { namespace Player {
+
+struct FileTracker::Watcher {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* Editors often truncate the file first and write the contents after,
+       ignore the intermediate state */
+    explicit Watcher(const std::string& filename): watcher{filename, Utility::FileWatcher::Flag::IgnoreErrors|Utility::FileWatcher::Flag::IgnoreChangeIfEmpty} {}
+
+    Utility::FileWatcher watcher;
+    #endif
+};
+
+namespace {
+
+Utility::Sha1::Digest hashData(Containers::ArrayView<const char> data) {
+    Utility::Sha1 sha1;
+    sha1 << data;
+    return sha1.digest();
+}
+
+}
+
+FileTracker::FileTracker() = default;
+
+FileTracker::~FileTracker() = default;
+
+void FileTracker::setupImporter(Trade::AbstractImporter& importer) {
+    _accessedFiles.clear();
+    importer.setFileCallback(fileCallback, *this);
+}
+
+void FileTracker::clear() {
+    _data.clear();
+    _hashes.clear();
+    _watchers.clear();
+    _accessedFiles.clear();
+}
+
+Containers::ArrayView<const char> FileTracker::read(const std::string& filename) {
+    auto found = _data.find(filename);
+    if(found == _data.end()) {
+        if(!Utility::Directory::exists(filename)) return {};
+
+        found = _data.emplace(filename, Utility::Directory::read(filename)).first;
+        _hashes[filename] = hashData(found->second);
+        watch(filename);
+    }
+
+    return found->second;
+}
+
+void FileTracker::releaseData() {
+    _data.clear();
+}
+
+Utility::Sha1::Digest FileTracker::hash(const std::string& filename) {
+    auto found = _hashes.find(filename);
+    if(found == _hashes.end()) {
+        read(filename);
+        found = _hashes.find(filename);
+        if(found == _hashes.end()) return {};
+    }
+
+    return found->second;
+}
+
+std::vector<std::string> FileTracker::update() {
+    /* The importer isn't supposed to use anything anymore */
+    _data.clear();
+
+    std::vector<std::string> changed;
+    for(auto& file: _hashes) {
+        /* A file that disappeared is considered changed, but only once --
+           reset the hash to a zero digest so it isn't reported again */
+        if(!Utility::Directory::exists(file.first)) {
+            if(file.second != Utility::Sha1::Digest{}) {
+                changed.push_back(file.first);
+                file.second = {};
+            }
+            continue;
+        }
+
+        const Utility::Sha1::Digest hash = hashData(Utility::Directory::read(file.first));
+        if(hash == file.second) continue;
+
+        changed.push_back(file.first);
+        file.second = hash;
+    }
+
+    return changed;
+}
+
+void FileTracker::setWatched(bool watched) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    _watched = watched;
+    if(!watched) {
+        _watchers.clear();
+        return;
+    }
+
+    for(const auto& file: _hashes) watch(file.first);
+    #else
+    static_cast<void>(watched);
+    #endif
+}
+
+void FileTracker::watch(const std::string& filename) {
+    if(!_watched || _watchers.find(filename) != _watchers.end()) return;
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    _watchers.emplace(filename, Containers::pointer<Watcher>(filename));
+    #endif
+}
+
+bool FileTracker::hasChanged() {
+    bool changed = false;
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* Go through all so the state of each is refreshed */
+    for(auto& watcher: _watchers)
+        if(watcher.second->watcher.hasChanged()) changed = true;
+    #endif
+    return changed;
+}
+
+Containers::Optional<Containers::ArrayView<const char>> FileTracker::fileCallback(const std::string& filename, const InputFileCallbackPolicy policy, FileTracker& tracker) {
+    /* The data are kept until releaseData() so they can be reused if the
+       importer asks for the same file again, for example for each image
+       referencing the same atlas, or if another importer is tried on the
+       same file after the first failed */
+    if(policy == InputFileCallbackPolicy::Close) return {};
+
+    tracker._accessedFiles.push_back(filename);
+
+    if(!Utility::Directory::exists(filename)) return {};
+    return tracker.read(filename);
+}
+
+}}
@@ -0,0 +1,116 @@
+#ifndef Magnum_Player_FileTracker_h
+#define Magnum_Player_FileTracker_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/Sha1.h>
+#include <Magnum/Trade/Trade.h>
+
+namespace Magnum { namespace Player {
+
+/* Records files an importer opens through a file callback together with a
+   hash of their contents. The scene player uses the access log to know which
+   files each texture or mesh came from, and update() then tells which of
+   them changed on disk since, so a reload can re-import only those. */
+class FileTracker {
+    public:
+        explicit FileTracker();
+
+        /* Not copyable as the importer file callback references the
+           instance */
+        FileTracker(const FileTracker&) = delete;
+        FileTracker& operator=(const FileTracker&) = delete;
+
+        ~FileTracker();
+
+        /* Sets up a file callback in given importer and clears the access
+           log. Has to be called before opening a file. */
+        void setupImporter(Trade::AbstractImporter& importer);
+
+        /* Discards all tracked files and their hashes */
+        void clear();
+
+        /* Reads a file and starts tracking it, without recording it in the
+           access log. The data stay cached until releaseData() or update()
+           is called, so importers opening the file afterwards don't read it
+           again. Returns an empty view if the file can't be read. */
+        Containers::ArrayView<const char> read(const std::string& filename);
+
+        /* Releases data cached for the importers. Call once the importers
+           don't need them anymore. */
+        void releaseData();
+
+        /* Hash of a file contents, read and tracked if it isn't tracked yet.
+           The hash stays the same until the next update() call even if the
+           file changes. Returns a zero digest if the file can't be read. */
+        Utility::Sha1::Digest hash(const std::string& filename);
+
+        /* All files opened through the callback since the last
+           setupImporter() call, in the order they were opened. To get files
+           opened during a particular import, remember the size before and
+           look at what got added after. */
+        const std::vector<std::string>& accessedFiles() const {
+            return _accessedFiles;
+        }
+
+        /* Hashes all tracked files again and returns the ones whose contents
+           changed since they were opened or since the last update() call.
+           Files that can't be read anymore are reported as changed as well.
+           Releases all data kept for the importer, so it's meant to be called
+           only when the importer is not used anymore. */
+        std::vector<std::string> update();
+
+        /* If enabled, a FileWatcher gets attached to each tracked file and
+           hasChanged() can be used to poll for modifications. Not available
+           on Emscripten. */
+        bool isWatched() const { return _watched; }
+        void setWatched(bool watched);
+
+        /* Returns true if any of the tracked files got modified since the
+           last call. Always returns false if watching is disabled. */
+        bool hasChanged();
+
+    private:
+        struct Watcher;
+
+        static Containers::Optional<Containers::ArrayView<const char>> fileCallback(const std::string& filename, InputFileCallbackPolicy policy, FileTracker& tracker);
+
+        void watch(const std::string& filename);
+
+        std::unordered_map<std::string, Containers::Array<char>> _data;
+        std::unordered_map<std::string, Utility::Sha1::Digest> _hashes;
+        std::unordered_map<std::string, Containers::Pointer<Watcher>> _watchers;
+        std::vector<std::string> _accessedFiles;
+        bool _watched = false;
+};
+
+}}
+
+#endif
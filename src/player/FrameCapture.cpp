@@ -0,0 +1,188 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameCapture.h"
+
+#include <cstring>
+#include <memory>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Magnum/Image.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/AbstractFramebuffer.h>
+#include <Magnum/GL/BufferImage.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/OpenGL.h>
+#include <Magnum/GL/PixelFormat.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Trade/AbstractImageConverter.h>
+
+namespace Magnum { namespace Player {
+
+struct FrameCapture::Slot {
+    #ifndef MAGNUM_TARGET_GLES2
+    GL::BufferImage2D image{GL::PixelFormat::RGBA, GL::PixelType::UnsignedByte};
+    GLsync fence{};
+    #endif
+    std::string filename;
+};
+
+namespace {
+
+struct Frame {
+    Image2D image;
+    std::string filename;
+};
+
+}
+
+FrameCapture::FrameCapture(PluginManager::Manager<Trade::AbstractImageConverter>& manager, const std::string& plugin, const std::size_t workerCount, const std::size_t bufferCount): _pool{workerCount} {
+    #ifndef MAGNUM_TARGET_GLES2
+    #ifndef MAGNUM_TARGET_GLES
+    _async = GL::Context::current().isExtensionSupported<GL::Extensions::ARB::sync>();
+    #else
+    _async = true;
+    #endif
+    if(_async) {
+        _slots.reserve(bufferCount);
+        for(std::size_t i = 0; i != bufferCount; ++i)
+            _slots.push_back(Containers::pointer<Slot>());
+    }
+    #else
+    static_cast<void>(bufferCount);
+    #endif
+
+    /* Instantiated here and not in the jobs as the plugin manager isn't
+       thread-safe */
+    _converters.reserve(_pool.workerCount());
+    for(std::size_t i = 0; i != _pool.workerCount(); ++i) {
+        Containers::Pointer<Trade::AbstractImageConverter> converter = manager.loadAndInstantiate(plugin);
+        if(!converter) {
+            _converters.clear();
+            return;
+        }
+        _converters.push_back(std::move(converter));
+    }
+}
+
+FrameCapture::~FrameCapture() {
+    if(isValid()) finish();
+}
+
+void FrameCapture::capture(GL::AbstractFramebuffer& framebuffer, const Range2Di& rectangle, std::string filename) {
+    if(!_async) {
+        save(framebuffer.read(rectangle, {PixelFormat::RGBA8Unorm}), std::move(filename));
+        return;
+    }
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* All buffers in use, have to wait for the oldest */
+    if(_count == _slots.size()) {
+        read(*_slots[_first]);
+        _first = (_first + 1) % _slots.size();
+        --_count;
+    }
+
+    Slot& slot = *_slots[(_first + _count) % _slots.size()];
+    framebuffer.read(rectangle, slot.image, GL::BufferUsage::StreamRead);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.filename = std::move(filename);
+    ++_count;
+    #endif
+}
+
+void FrameCapture::update() {
+    #ifndef MAGNUM_TARGET_GLES2
+    /* The reads finish in order, so stop at the first one that isn't done
+       yet */
+    while(_count) {
+        Slot& slot = *_slots[_first];
+        if(glClientWaitSync(slot.fence, 0, 0) == GL_TIMEOUT_EXPIRED) break;
+
+        read(slot);
+        _first = (_first + 1) % _slots.size();
+        --_count;
+    }
+    #endif
+}
+
+void FrameCapture::finish() {
+    #ifndef MAGNUM_TARGET_GLES2
+    while(_count) {
+        read(*_slots[_first]);
+        _first = (_first + 1) % _slots.size();
+        --_count;
+    }
+    #endif
+
+    _pool.wait();
+}
+
+void FrameCapture::read(Slot& slot) {
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Flush on the first wait so the fence gets signaled at all, then wait
+       as long as needed */
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while(glClientWaitSync(slot.fence, flags, 1000000000ull) == GL_TIMEOUT_EXPIRED)
+        flags = 0;
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    /* Copy the data out so the buffer can be reused right away. The rows of
+       a four-byte format are always aligned, so there's no padding. */
+    const std::size_t size = std::size_t(slot.image.size().product())*4;
+    Containers::Array<char> data{Containers::NoInit, size};
+    const Containers::ArrayView<char> mapped = slot.image.buffer().map(0, size, GL::Buffer::MapFlag::Read);
+    std::memcpy(data.data(), mapped.data(), size);
+    slot.image.buffer().unmap();
+
+    save(Image2D{PixelFormat::RGBA8Unorm, slot.image.size(), std::move(data)}, std::move(slot.filename));
+    #else
+    static_cast<void>(slot);
+    #endif
+}
+
+void FrameCapture::save(Image2D&& image, std::string&& filename) {
+    /* If the encoding can't keep up with the rendering, slow the rendering
+       down instead of queuing an unbounded amount of frames */
+    _pool.wait(2*_pool.workerCount());
+
+    /* Has to be copyable to be put into a std::function */
+    std::shared_ptr<Frame> frame = std::make_shared<Frame>(Frame{std::move(image), std::move(filename)});
+    _pool.submit([this, frame](const std::size_t worker) {
+        /* Alpha of the default framebuffer has no meaning, make the output
+           opaque */
+        for(Color4ub& pixel: Containers::arrayCast<Color4ub>(frame->image.data()))
+            pixel.a() = 255;
+
+        if(_converters[worker]->exportToFile(frame->image, frame->filename))
+            ++_savedCount;
+        else
+            ++_failedCount;
+    });
+}
+
+}}
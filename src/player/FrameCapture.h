@@ -0,0 +1,106 @@
+#ifndef Magnum_Player_FrameCapture_h
+#define Magnum_Player_FrameCapture_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/PluginManager.h>
+#include <Magnum/GL/GL.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/Trade/Trade.h>
+
+#include "WorkerPool.h"
+
+namespace Magnum { namespace Player {
+
+/* Saves framebuffer contents to image files without stalling the rendering.
+   Pixels are read into a ring of pixel pack buffers guarded by fences and
+   mapped only once the GPU is done with them, usually a frame or two later.
+   The mapped data are then encoded and written in parallel on a worker
+   pool, with each worker owning an instance of the converter plugin, as a
+   single plugin instance can't be used from more threads at once. On GLES2
+   and on drivers without ARB_sync the pixels are read synchronously, the
+   encoding is still done on the workers. Not available on Emscripten. */
+class FrameCapture {
+    public:
+        /* Instantiates the converter plugin for each worker, workerCount
+           being 0 means one worker for each hardware thread. If the plugin
+           can't be loaded, isValid() returns false. The plugin has to be a
+           concrete one as the Any* plugins instantiate their delegates when
+           converting, which would access the manager from worker threads. */
+        explicit FrameCapture(PluginManager::Manager<Trade::AbstractImageConverter>& manager, const std::string& plugin, std::size_t workerCount, std::size_t bufferCount = 3);
+
+        /* Not copyable as the worker jobs reference the instance */
+        FrameCapture(const FrameCapture&) = delete;
+        FrameCapture& operator=(const FrameCapture&) = delete;
+
+        /* Reads and saves all frames that are still pending */
+        ~FrameCapture();
+
+        bool isValid() const { return !_converters.empty(); }
+
+        std::size_t workerCount() const { return _pool.workerCount(); }
+
+        /* Starts reading given framebuffer rectangle and saves it to given
+           file once the read finishes. If all buffers in the ring are in
+           use, waits for the oldest one first. */
+        void capture(GL::AbstractFramebuffer& framebuffer, const Range2Di& rectangle, std::string filename);
+
+        /* Passes frames whose read finished to the workers, without
+           blocking. Should be called every frame while readCount() is
+           non-zero. */
+        void update();
+
+        /* Count of frames still being read from the GPU */
+        std::size_t readCount() const { return _count; }
+
+        /* Count of frames that got saved or failed to save so far */
+        std::size_t savedCount() const { return _savedCount; }
+        std::size_t failedCount() const { return _failedCount; }
+
+        /* Waits until all frames are read and saved */
+        void finish();
+
+    private:
+        struct Slot;
+
+        void read(Slot& slot);
+        void save(Image2D&& image, std::string&& filename);
+
+        std::vector<Containers::Pointer<Trade::AbstractImageConverter>> _converters;
+        std::vector<Containers::Pointer<Slot>> _slots;
+        std::size_t _first{}, _count{};
+        bool _async{};
+        std::atomic<std::size_t> _savedCount{}, _failedCount{};
+        /* Destroyed first so the workers don't use the converters anymore */
+        WorkerPool _pool;
+};
+
+}}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef Magnum_Player_FrameClock_h
+#define Magnum_Player_FrameClock_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <Magnum/Magnum.h>
+
+namespace Magnum { namespace Player {
+
+/* Time source for animation playback. By default it reports the system clock
+   time, in the fixed-step mode it starts at zero and moves forward by the
+   same step with each drawn frame, so the animation state of a particular
+   frame doesn't depend on how long the previous frames took. */
+class FrameClock {
+    public:
+        /* Uses the system clock */
+        explicit FrameClock();
+
+        /* Advances by step on each frame. A zero step means the system clock
+           is used. */
+        explicit FrameClock(std::chrono::nanoseconds step);
+
+        bool isFixed() const { return _step != std::chrono::nanoseconds{}; }
+
+        /* Step in the fixed-step mode, zero otherwise */
+        std::chrono::nanoseconds step() const { return _step; }
+
+        /* Count of frames finished so far */
+        UnsignedLong frame() const { return _frame; }
+
+        /* Current time. In the fixed-step mode it's frame() times step(),
+           otherwise the system clock time since epoch. */
+        std::chrono::nanoseconds now() const;
+
+        /* Called once a frame is drawn */
+        void nextFrame() { ++_frame; }
+
+    private:
+        std::chrono::nanoseconds _step;
+        UnsignedLong _frame{};
+};
+
+}}
+
+#endif
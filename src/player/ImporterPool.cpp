@@ -0,0 +1,130 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImporterPool.h"
+
+#include <cstring>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/String.h>
+
+namespace Magnum { namespace Player {
+
+namespace {
+
+constexpr struct {
+    const char* magic;
+    std::size_t size;
+    FileType type;
+    const char* plugin;
+} Signatures[] {
+    {"glTF", 4, FileType::Scene, "GltfImporter"},
+    {"ply ", 4, FileType::Scene, "StanfordImporter"},
+    {"Kaydara FBX Binary", 18, FileType::Scene, "FbxImporter"},
+    {"\x89PNG\x0d\x0a\x1a\x0a", 8, FileType::Image, "PngImporter"},
+    {"\xff\xd8\xff", 3, FileType::Image, "JpegImporter"},
+    {"\xabKTX 20\xbb\x0d\x0a\x1a\x0a", 12, FileType::Image, "KtxImporter"},
+    /* Basis has just a two-byte signature, which is too weak on its own, so
+       check also the 16-bit version (0x13) and header size (77) that
+       follow it */
+    {"sB\x13\x00\x4d\x00", 6, FileType::Image, "BasisImporter"},
+    {"DDS ", 4, FileType::Image, "DdsImporter"},
+    {"\x76\x2f\x31\x01", 4, FileType::Image, "OpenExrImporter"},
+    {"#?RADIANCE", 10, FileType::Image, "HdrImporter"},
+    {"#?RGBE", 6, FileType::Image, "HdrImporter"}
+};
+
+}
+
+FileFormat detectFileFormat(const Containers::ArrayView<const char> data) {
+    for(const auto& signature: Signatures)
+        if(data.size() >= signature.size && std::memcmp(data.data(), signature.magic, signature.size) == 0)
+            return {signature.type, signature.plugin};
+
+    return {FileType::Unknown, ""};
+}
+
+void setImporterOptions(Trade::AbstractImporter& importer, const std::string& options) {
+    for(const std::string& option: Utility::String::splitWithoutEmptyParts(options, ',')) {
+        auto keyValue = Utility::String::partition(option, '=');
+        Utility::String::trimInPlace(keyValue[0]);
+        Utility::String::trimInPlace(keyValue[2]);
+
+        std::vector<std::string> keyParts = Utility::String::split(keyValue[0], '/');
+        CORRADE_INTERNAL_ASSERT(!keyParts.empty());
+        Utility::ConfigurationGroup* group = &importer.configuration();
+        bool groupNotRecognized = false;
+        for(std::size_t i = 0; i != keyParts.size() - 1; ++i) {
+            Utility::ConfigurationGroup* subgroup = group->group(keyParts[i]);
+            if(!subgroup) {
+                groupNotRecognized = true;
+                subgroup = group->addGroup(keyParts[i]);
+            }
+            group = subgroup;
+        }
+
+        /* Provide a warning message in case the plugin doesn't define given
+           option in its default config. The plugin is not *required* to have
+           those tho (could be backward compatibility entries, for example), so
+           not an error. */
+        if(groupNotRecognized || !group->hasValue(keyParts.back()))
+            Warning{} << "Option" << keyValue[0] << "not recognized by" << importer.plugin();
+
+        /* If the option doesn't have an =, treat it as a boolean flag that's
+           set to true. While there's no similar way to do an inverse, it's
+           still nicer than causing a fatal error with those. */
+        if(keyValue[1].empty())
+            group->setValue(keyParts.back(), true);
+        else
+            group->setValue(keyParts.back(), keyValue[2]);
+    }
+}
+
+ImporterPool::ImporterPool(PluginManager::Manager<Trade::AbstractImporter>& manager): _manager(manager) {}
+
+void ImporterPool::setFlags(const Trade::ImporterFlags flags) {
+    _flags = flags;
+    for(auto& importer: _importers) importer.second->setFlags(flags);
+}
+
+Trade::AbstractImporter* ImporterPool::get(const std::string& plugin) {
+    auto found = _importers.find(plugin);
+    if(found == _importers.end()) {
+        Containers::Pointer<Trade::AbstractImporter> importer = _manager.loadAndInstantiate(plugin);
+        if(!importer) return nullptr;
+
+        importer->setFlags(_flags);
+        found = _importers.emplace(plugin, std::move(importer)).first;
+    } else found->second->close();
+
+    return found->second.get();
+}
+
+void ImporterPool::close() {
+    for(auto& importer: _importers) importer.second->close();
+}
+
+}}
@@ -0,0 +1,87 @@
+#ifndef Magnum_Player_ImporterPool_h
+#define Magnum_Player_ImporterPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <unordered_map>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/PluginManager.h>
+#include <Magnum/Trade/AbstractImporter.h>
+
+namespace Magnum { namespace Player {
+
+enum class FileType: UnsignedByte {
+    Unknown,
+    Scene,
+    Image
+};
+
+struct FileFormat {
+    FileType type;
+    /* Plugin to open the file with, empty if the type is unknown */
+    const char* plugin;
+};
+
+/* Detects a file format from its magic bytes. Only binary formats with an
+   unambiguous signature are recognized, text-based formats such as glTF JSON
+   or OBJ are left to the Any* plugins, which decide based on the file
+   extension. */
+FileFormat detectFileFormat(Containers::ArrayView<const char> data);
+
+/* Propagates user-defined options from the command line, in the form of
+   key=val,key2=val2 with subgroups separated by a slash, to the importer
+   configuration */
+void setImporterOptions(Trade::AbstractImporter& importer, const std::string& options);
+
+/* Keeps instantiated importer plugins alive between loads, so reloads and
+   fallbacks don't need to go through plugin loading and instantiation
+   again, and the importer configuration is preserved */
+class ImporterPool {
+    public:
+        explicit ImporterPool(PluginManager::Manager<Trade::AbstractImporter>& manager);
+
+        /* Flags set on all instances, including already created ones */
+        void setFlags(Trade::ImporterFlags flags);
+
+        /* Returns a warm instance of given plugin, instantiating it on first
+           use, or nullptr if the plugin can't be loaded. A file previously
+           opened in the instance is closed. */
+        Trade::AbstractImporter* get(const std::string& plugin);
+
+        /* Closes files opened in all instances to release memory while
+           keeping the instances alive */
+        void close();
+
+    private:
+        PluginManager::Manager<Trade::AbstractImporter>& _manager;
+        std::unordered_map<std::string, Containers::Pointer<Trade::AbstractImporter>> _importers;
+        Trade::ImporterFlags _flags;
+};
+
+}}
+
+#endif
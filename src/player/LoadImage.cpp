@@ -25,6 +25,8 @@
 
 #include "LoadImage.h"
 
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/PixelFormat.h>
 #include <Magnum/Math/Functions.h>
@@ -34,6 +36,52 @@
 
 namespace Magnum { namespace Player {
 
+void loadImage(GL::Texture2D& texture, const Containers::ArrayView<const CompressedImageView2D> levels) {
+    CORRADE_INTERNAL_ASSERT(!levels.empty());
+
+    /* Blacklist things we *cannot* display */
+    GL::TextureFormat format;
+    switch(levels[0].format()) {
+        /** @todo signed formats, float formats */
+        case CompressedPixelFormat::Bc4RSnorm:
+        case CompressedPixelFormat::Bc5RGSnorm:
+        case CompressedPixelFormat::EacR11Snorm:
+        case CompressedPixelFormat::EacRG11Snorm:
+        case CompressedPixelFormat::Bc6hRGBUfloat:
+        case CompressedPixelFormat::Bc6hRGBSfloat:
+        case CompressedPixelFormat::Astc4x4RGBAF:
+        case CompressedPixelFormat::Astc5x4RGBAF:
+        case CompressedPixelFormat::Astc5x5RGBAF:
+        case CompressedPixelFormat::Astc6x5RGBAF:
+        case CompressedPixelFormat::Astc6x6RGBAF:
+        case CompressedPixelFormat::Astc8x5RGBAF:
+        case CompressedPixelFormat::Astc8x6RGBAF:
+        case CompressedPixelFormat::Astc8x8RGBAF:
+        case CompressedPixelFormat::Astc10x5RGBAF:
+        case CompressedPixelFormat::Astc10x6RGBAF:
+        case CompressedPixelFormat::Astc10x8RGBAF:
+        case CompressedPixelFormat::Astc10x10RGBAF:
+        case CompressedPixelFormat::Astc12x10RGBAF:
+        case CompressedPixelFormat::Astc12x12RGBAF:
+            Warning{} << "Cannot load an image of format" << levels[0].format();
+            return;
+
+        default: format = GL::textureFormat(levels[0].format());
+    }
+
+    /* Use only levels that form a valid mip chain */
+    std::size_t levelCount = 1;
+    for(; levelCount != levels.size(); ++levelCount) {
+        if(levels[levelCount].format() != levels[0].format() ||
+           levels[levelCount].size() != Math::max(levels[0].size() >> Int(levelCount), Vector2i{1}))
+            break;
+    }
+
+    texture.setStorage(Int(levelCount), format, levels[0].size());
+    for(std::size_t i = 0; i != levelCount; ++i)
+        texture.setCompressedSubImage(Int(i), {}, levels[i]);
+}
+
 void loadImage(GL::Texture2D& texture, Trade::ImageData2D& image) {
     if(!image.isCompressed()) {
         /* Whitelist only things we *can* display */
@@ -61,40 +109,8 @@ void loadImage(GL::Texture2D& texture, Trade::ImageData2D& image) {
             .generateMipmap();
 
     } else {
-        /* Blacklist things we *cannot* display */
-        GL::TextureFormat format;
-        switch(image.compressedFormat()) {
-            /** @todo signed formats, float formats */
-            case CompressedPixelFormat::Bc4RSnorm:
-            case CompressedPixelFormat::Bc5RGSnorm:
-            case CompressedPixelFormat::EacR11Snorm:
-            case CompressedPixelFormat::EacRG11Snorm:
-            case CompressedPixelFormat::Bc6hRGBUfloat:
-            case CompressedPixelFormat::Bc6hRGBSfloat:
-            case CompressedPixelFormat::Astc4x4RGBAF:
-            case CompressedPixelFormat::Astc5x4RGBAF:
-            case CompressedPixelFormat::Astc5x5RGBAF:
-            case CompressedPixelFormat::Astc6x5RGBAF:
-            case CompressedPixelFormat::Astc6x6RGBAF:
-            case CompressedPixelFormat::Astc8x5RGBAF:
-            case CompressedPixelFormat::Astc8x6RGBAF:
-            case CompressedPixelFormat::Astc8x8RGBAF:
-            case CompressedPixelFormat::Astc10x5RGBAF:
-            case CompressedPixelFormat::Astc10x6RGBAF:
-            case CompressedPixelFormat::Astc10x8RGBAF:
-            case CompressedPixelFormat::Astc10x10RGBAF:
-            case CompressedPixelFormat::Astc12x10RGBAF:
-            case CompressedPixelFormat::Astc12x12RGBAF:
-                Warning{} << "Cannot load an image of format" << image.compressedFormat();
-                return;
-
-            default: format = GL::textureFormat(image.compressedFormat());
-        }
-
-        texture
-            .setStorage(1, format, image.size())
-            .setCompressedSubImage(0, {}, image);
-            /** @todo mip level loading */
+        const CompressedImageView2D level = image;
+        loadImage(texture, {&level, 1});
     }
 }
 
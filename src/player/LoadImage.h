@@ -25,6 +25,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Containers.h>
+#include <Magnum/Magnum.h>
 #include <Magnum/GL/GL.h>
 #include <Magnum/Trade/Trade.h>
 
@@ -32,6 +34,10 @@ namespace Magnum { namespace Player {
 
 void loadImage(GL::Texture2D& texture, Trade::ImageData2D& image);
 
+/* Uploads a compressed mip chain. Levels after the first one that doesn't
+   match the format or the expected size of the first level are ignored. */
+void loadImage(GL::Texture2D& texture, Containers::ArrayView<const CompressedImageView2D> levels);
+
 }}
 
 #endif
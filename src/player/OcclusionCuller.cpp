@@ -0,0 +1,241 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OcclusionCuller.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/Math/Constants.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/Math/Range.h>
+
+namespace Magnum { namespace Player {
+
+OcclusionCuller::OcclusionCuller(const Vector2i& size) {
+    CORRADE_ASSERT(size.product() > 0,
+        "Player::OcclusionCuller: expected a non-zero size but got" << size, );
+
+    /* Calculate the pyramid layout, all levels are in a single allocation */
+    std::size_t offset = 0;
+    Vector2i levelSize = size;
+    for(;;) {
+        arrayAppend(_levels, Level{offset, levelSize});
+        offset += levelSize.product();
+        if(levelSize == Vector2i{1}) break;
+        levelSize = (levelSize + Vector2i{1})/2;
+    }
+
+    _data = Containers::Array<Float>{Containers::NoInit, offset};
+    clear();
+}
+
+Vector2i OcclusionCuller::levelSize(const UnsignedInt level) const {
+    CORRADE_ASSERT(level < _levels.size(),
+        "Player::OcclusionCuller::levelSize(): index" << level << "out of range for" << _levels.size() << "levels", {});
+    return _levels[level].size;
+}
+
+Containers::ArrayView<const Float> OcclusionCuller::level(const UnsignedInt level) const {
+    CORRADE_ASSERT(level < _levels.size(),
+        "Player::OcclusionCuller::level(): index" << level << "out of range for" << _levels.size() << "levels", {});
+    return _data.slice(_levels[level].offset, _levels[level].offset + _levels[level].size.product());
+}
+
+void OcclusionCuller::clear() {
+    std::fill(_data.begin(), _data.end(), 1.0f);
+}
+
+void OcclusionCuller::rasterize(const Matrix4& transformationProjection, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::ArrayView<const UnsignedInt> indices) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "Player::OcclusionCuller::rasterize(): expected index count divisible by 3, got" << indices.size(), );
+
+    const Vector2i size = _levels[0].size;
+    const Vector2 halfSize = Vector2{size}*0.5f;
+    Float* const depth = _data.data();
+
+    for(std::size_t i = 0; i < indices.size(); i += 3) {
+        /* Project to the window space, skip triangles crossing the near
+           plane */
+        Vector3 v[3];
+        bool clipped = false;
+        for(std::size_t j = 0; j != 3; ++j) {
+            const Vector4 clip = transformationProjection*Vector4{positions[indices[i + j]], 1.0f};
+            if(clip.w() <= 0.0f || clip.z() < -clip.w()) {
+                clipped = true;
+                break;
+            }
+
+            const Vector3 ndc = clip.xyz()/clip.w();
+            v[j] = {(ndc.x() + 1.0f)*halfSize.x(),
+                    (ndc.y() + 1.0f)*halfSize.y(),
+                    (ndc.z() + 1.0f)*0.5f};
+        }
+        if(clipped) continue;
+
+        /* Make the winding counterclockwise, skip degenerate triangles */
+        Float area = (v[1].x() - v[0].x())*(v[2].y() - v[0].y()) -
+                     (v[2].x() - v[0].x())*(v[1].y() - v[0].y());
+        if(area < 0.0f) {
+            std::swap(v[1], v[2]);
+            area = -area;
+        }
+        if(area < 1.0e-6f) continue;
+
+        /* Pixel range covered by the triangle, clamped to the buffer. Pixel
+           centers are at half-integer coordinates. */
+        const Int minX = Math::max(Int(Math::floor(Math::min(Math::min(v[0].x(), v[1].x()), v[2].x()))), 0);
+        const Int minY = Math::max(Int(Math::floor(Math::min(Math::min(v[0].y(), v[1].y()), v[2].y()))), 0);
+        const Int maxX = Math::min(Int(Math::ceil(Math::max(Math::max(v[0].x(), v[1].x()), v[2].x()))), size.x() - 1);
+        const Int maxY = Math::min(Int(Math::ceil(Math::max(Math::max(v[0].y(), v[1].y()), v[2].y()))), size.y() - 1);
+        if(minX > maxX || minY > maxY) continue;
+
+        /* Edge functions a*x + b*y + c, each positive on the inner side of
+           the edge opposite to given vertex and equal to the doubled area at
+           that vertex. The depth is then a barycentric interpolation, which
+           is linear in window space. */
+        Float a[3], b[3], c[3];
+        for(std::size_t j = 0; j != 3; ++j) {
+            const Vector3& p = v[(j + 1) % 3];
+            const Vector3& q = v[(j + 2) % 3];
+            a[j] = p.y() - q.y();
+            b[j] = q.x() - p.x();
+            c[j] = -a[j]*p.x() - b[j]*p.y();
+        }
+        const Float za = (a[0]*v[0].z() + a[1]*v[1].z() + a[2]*v[2].z())/area;
+        const Float zb = (b[0]*v[0].z() + b[1]*v[1].z() + b[2]*v[2].z())/area;
+        const Float zc = (c[0]*v[0].z() + c[1]*v[1].z() + c[2]*v[2].z())/area;
+
+        for(Int y = minY; y <= maxY; ++y) {
+            const Float py = y + 0.5f;
+            Float* const row = depth + std::size_t(y)*size.x();
+
+            /* Four pixels at a time, the lanes past the end of the range are
+               masked out */
+            for(Int x = minX; x <= maxX; x += 4) {
+                Float pz[4];
+                bool inside[4];
+                for(Int lane = 0; lane != 4; ++lane) {
+                    const Float px = x + lane + 0.5f;
+                    const Float e0 = a[0]*px + b[0]*py + c[0];
+                    const Float e1 = a[1]*px + b[1]*py + c[1];
+                    const Float e2 = a[2]*px + b[2]*py + c[2];
+                    pz[lane] = za*px + zb*py + zc;
+                    inside[lane] = e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f;
+                }
+
+                const Int count = Math::min(maxX - x + 1, 4);
+                for(Int lane = 0; lane != count; ++lane)
+                    if(inside[lane] && pz[lane] < row[x + lane])
+                        row[x + lane] = pz[lane];
+            }
+        }
+    }
+}
+
+void OcclusionCuller::buildPyramid() {
+    for(std::size_t i = 1; i < _levels.size(); ++i) {
+        const Float* const prev = _data.data() + _levels[i - 1].offset;
+        const Vector2i prevSize = _levels[i - 1].size;
+        Float* const next = _data.data() + _levels[i].offset;
+        const Vector2i nextSize = _levels[i].size;
+
+        /* Odd sizes have the last row / column taken twice */
+        for(Int y = 0; y != nextSize.y(); ++y) {
+            const Float* const row0 = prev + std::size_t(2*y)*prevSize.x();
+            const Float* const row1 = prev + std::size_t(Math::min(2*y + 1, prevSize.y() - 1))*prevSize.x();
+            for(Int x = 0; x != nextSize.x(); ++x) {
+                const Int x0 = 2*x;
+                const Int x1 = Math::min(2*x + 1, prevSize.x() - 1);
+                next[std::size_t(y)*nextSize.x() + x] = Math::max(
+                    Math::max(row0[x0], row0[x1]),
+                    Math::max(row1[x0], row1[x1]));
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::isVisible(const Matrix4& transformationProjection, const Range3D& bounds) const {
+    /* Transform all corners to the clip space and classify them against the
+       frustum planes. If all corners are outside of any plane, the box is
+       not visible. */
+    Vector4 clip[8];
+    UnsignedByte outside = 0x3f;
+    bool crossesNearPlane = false;
+    for(std::size_t i = 0; i != 8; ++i) {
+        clip[i] = transformationProjection*Vector4{
+            (i & 1 ? bounds.max() : bounds.min()).x(),
+            (i & 2 ? bounds.max() : bounds.min()).y(),
+            (i & 4 ? bounds.max() : bounds.min()).z(), 1.0f};
+        const Vector4& p = clip[i];
+        outside &= (p.x() < -p.w() ? 0x01 : 0)|
+                   (p.x() >  p.w() ? 0x02 : 0)|
+                   (p.y() < -p.w() ? 0x04 : 0)|
+                   (p.y() >  p.w() ? 0x08 : 0)|
+                   (p.z() < -p.w() ? 0x10 : 0)|
+                   (p.z() >  p.w() ? 0x20 : 0);
+        if(p.w() <= 0.0f || p.z() < -p.w()) crossesNearPlane = true;
+    }
+    if(outside) return false;
+
+    /* Can't project a box crossing the near plane, treat it as visible */
+    if(crossesNearPlane) return true;
+
+    /* Window-space rectangle and the nearest depth of the box */
+    Vector3 min{Constants::inf()}, max{-Constants::inf()};
+    for(const Vector4& p: clip) {
+        const Vector3 ndc = p.xyz()/p.w();
+        min = Math::min(min, ndc);
+        max = Math::max(max, ndc);
+    }
+    const Vector2i size = _levels[0].size;
+    const Vector2 halfSize = Vector2{size}*0.5f;
+    Int minX = Math::clamp(Int(Math::floor((min.x() + 1.0f)*halfSize.x())), 0, size.x() - 1);
+    Int minY = Math::clamp(Int(Math::floor((min.y() + 1.0f)*halfSize.y())), 0, size.y() - 1);
+    Int maxX = Math::clamp(Int(Math::floor((max.x() + 1.0f)*halfSize.x())), 0, size.x() - 1);
+    Int maxY = Math::clamp(Int(Math::floor((max.y() + 1.0f)*halfSize.y())), 0, size.y() - 1);
+    const Float nearest = (min.z() + 1.0f)*0.5f;
+
+    /* Go up the pyramid until the rectangle spans at most 2x2 texels */
+    std::size_t level = 0;
+    while(level + 1 < _levels.size() && (maxX - minX > 1 || maxY - minY > 1)) {
+        minX >>= 1;
+        minY >>= 1;
+        maxX >>= 1;
+        maxY >>= 1;
+        ++level;
+    }
+
+    const Float* const data = _data.data() + _levels[level].offset;
+    const Int width = _levels[level].size.x();
+    for(Int y = minY; y <= maxY; ++y)
+        for(Int x = minX; x <= maxX; ++x)
+            if(nearest <= data[std::size_t(y)*width + x]) return true;
+
+    return false;
+}
+
+}}
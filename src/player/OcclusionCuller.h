@@ -0,0 +1,87 @@
+#ifndef Magnum_Player_OcclusionCuller_h
+#define Magnum_Player_OcclusionCuller_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Magnum/Magnum.h>
+#include <Magnum/Math/Vector2.h>
+
+namespace Magnum { namespace Player {
+
+/* Software occlusion culling. Occluder triangles are rasterized into a small
+   CPU-side depth buffer, from which a hierarchical depth pyramid is built
+   with each texel containing the farthest depth of the 2x2 texels below it.
+   Bounding boxes are then tested against a pyramid level where they span at
+   most 2x2 texels, which is conservative -- an object is reported as hidden
+   only if it's behind the occluders everywhere it could be.
+
+   Depth is the NDC Z mapped to [0, 1], the buffer is cleared to 1. The
+   rasterizer evaluates the edge functions for four pixels at a time in plain
+   loops that compilers turn into SIMD code on all targets, including
+   WebAssembly. */
+class OcclusionCuller {
+    public:
+        explicit OcclusionCuller(const Vector2i& size);
+
+        Vector2i size() const { return _levels[0].size; }
+
+        /* Pyramid levels, level 0 is the depth buffer itself and the last
+           level is 1x1 */
+        UnsignedInt levelCount() const { return _levels.size(); }
+        Vector2i levelSize(UnsignedInt level) const;
+        Containers::ArrayView<const Float> level(UnsignedInt level) const;
+
+        /* Clears the depth buffer to the far plane */
+        void clear();
+
+        /* Rasterizes indexed triangles into the depth buffer. Triangles
+           crossing the near plane are skipped, as clipping them isn't worth
+           the complexity and not drawing an occluder is always correct. Both
+           windings are rasterized. */
+        void rasterize(const Matrix4& transformationProjection, const Containers::StridedArrayView1D<const Vector3>& positions, Containers::ArrayView<const UnsignedInt> indices);
+
+        /* Builds the depth pyramid. Has to be called after rasterizing all
+           occluders and before testing any boxes. */
+        void buildPyramid();
+
+        /* Returns false if the box is outside of the view frustum or hidden
+           behind the rasterized occluders, true otherwise. Boxes crossing the
+           near plane are always visible. */
+        bool isVisible(const Matrix4& transformationProjection, const Range3D& bounds) const;
+
+    private:
+        struct Level {
+            std::size_t offset;
+            Vector2i size;
+        };
+
+        Containers::Array<Level> _levels;
+        Containers::Array<Float> _data;
+};
+
+}}
+
+#endif
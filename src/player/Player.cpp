@@ -39,8 +39,11 @@
 #include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/GL/Extensions.h>
 #include <Magnum/GL/Renderer.h>
+#include <Magnum/Math/ConfigurationValue.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/Platform/Screen.h>
 #include <Magnum/Platform/ScreenedApplication.h>
+#include <Magnum/Trade/AbstractImageConverter.h>
 #include <Magnum/Trade/AbstractImporter.h>
 
 #include "Magnum/Ui/Anchor.h"
@@ -61,6 +64,17 @@
 #endif
 
 #include "AbstractPlayer.h"
+#include "FileTracker.h"
+#include "FrameClock.h"
+#include "ImporterPool.h"
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include "BatchRenderer.h"
+#include "FrameCapture.h"
+#include "TextureCache.h"
+#include "TextureDecoder.h"
+#include "Tracer.h"
+#endif
 
 namespace Magnum { namespace Player {
 
@@ -90,6 +104,20 @@ struct ImportErrorUiPlane: Ui::Plane, Interconnect::Receiver {
 };
 #endif
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+/* Concrete plugins for formats accepted by --capture-format. Any* plugins
+   can't be used from the encoding threads. */
+const struct {
+    const char* format;
+    const char* plugin;
+} CaptureFormats[]{
+    {"png", "PngImageConverter"},
+    {"jpg", "JpegImageConverter"},
+    {"tga", "TgaImageConverter"},
+    {"bmp", "BmpImageConverter"}
+};
+#endif
+
 struct OverlayUiPlane: Ui::Plane {
     explicit OverlayUiPlane(Ui::UserInterface& ui):
         Ui::Plane{ui, Ui::Snap::Top|Ui::Snap::Bottom|Ui::Snap::Left|Ui::Snap::Right, 1, 50, 640},
@@ -167,17 +195,26 @@ class Player: public Platform::ScreenedApplication, public Interconnect::Receive
         /* Accessed from Overlay */
         void toggleControls();
         #ifndef CORRADE_TARGET_EMSCRIPTEN
-        void reload();
+        void reload(bool full);
+        void takeScreenshot();
+        void toggleRecording();
         #endif
 
     private:
         void globalViewportEvent(ViewportEvent& size) override;
         void globalDrawEvent() override;
-        #ifdef CORRADE_IS_DEBUG_BUILD
+        #if defined(CORRADE_IS_DEBUG_BUILD) || !defined(CORRADE_TARGET_EMSCRIPTEN)
         void tickEvent() override;
         #endif
 
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        /* Creates the frame capture on first use, returns false if the
+           converter plugin can't be loaded */
+        bool setupFrameCapture();
+        #endif
+
         PluginManager::Manager<Trade::AbstractImporter> _manager;
+        ImporterPool _importers{_manager};
 
         /* Screens */
         Containers::Optional<Overlay> _overlay;
@@ -190,6 +227,19 @@ class Player: public Platform::ScreenedApplication, public Interconnect::Receive
         #ifndef CORRADE_TARGET_EMSCRIPTEN
         std::string _importer, _file;
         Int _id{-1};
+        FileTracker _fileTracker;
+        Containers::Optional<TextureCache> _textureCache;
+        Containers::Optional<TextureDecoder> _textureDecoder;
+
+        PluginManager::Manager<Trade::AbstractImageConverter> _converterManager;
+        /* Declared after the manager so the converter instances are gone
+           before it */
+        Containers::Pointer<FrameCapture> _frameCapture;
+        std::string _capturePlugin, _captureFormat, _capturePrefix;
+        std::size_t _captureThreads;
+        UnsignedInt _screenshotId{}, _recordingId{}, _recordingFrame{};
+        bool _screenshotRequested{}, _recording{};
+        UnsignedLong _frameCount{};
         #endif
         bool _controlsVisible =
             #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -201,10 +251,16 @@ class Player: public Platform::ScreenedApplication, public Interconnect::Receive
         bool _drawUi = true;
 
         DebugTools::GLFrameProfiler::Values _profilerValues;
+        Float _interactionFrameTime;
+        bool _staticBatching;
+        bool _compressTextures{};
+        bool _frameChecksum{};
+        FrameClock _clock;
+        /* Not created on Emscripten, as there's nowhere to save the file */
+        Containers::Optional<Tracer> _tracer;
         #ifdef CORRADE_IS_DEBUG_BUILD
         Utility::Tweakable _tweakable;
         #endif
-        Trade::ImporterFlags _importerFlags;
 };
 
 bool AbstractUiScreen::controlsVisible() const {
@@ -258,8 +314,17 @@ void Overlay::viewportEvent(ViewportEvent& event) {
 
 void Overlay::keyPressEvent(KeyEvent& event) {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
-    if(event.key() == KeyEvent::Key::F5 && !(event.modifiers() & (KeyEvent::Modifier::Shift|KeyEvent::Modifier::Ctrl|KeyEvent::Modifier::Super|KeyEvent::Modifier::Alt|KeyEvent::Modifier::AltGr))) {
-        application<Player>().reload();
+    /* F5 reloads only what changed, Shift+F5 reloads everything */
+    if(event.key() == KeyEvent::Key::F5 && !(event.modifiers() & (KeyEvent::Modifier::Ctrl|KeyEvent::Modifier::Super|KeyEvent::Modifier::Alt|KeyEvent::Modifier::AltGr))) {
+        application<Player>().reload(event.modifiers() >= KeyEvent::Modifier::Shift);
+    } else
+    /* F12 saves a screenshot, Shift+F12 starts or stops recording a frame
+       sequence */
+    if(event.key() == KeyEvent::Key::F12 && !(event.modifiers() & (KeyEvent::Modifier::Ctrl|KeyEvent::Modifier::Super|KeyEvent::Modifier::Alt|KeyEvent::Modifier::AltGr))) {
+        if(event.modifiers() >= KeyEvent::Modifier::Shift)
+            application<Player>().toggleRecording();
+        else
+            application<Player>().takeScreenshot();
     } else
     #endif
     /* Toggle UI drawing (useful for screenshots) */
@@ -351,11 +416,29 @@ Player::Player(const Arguments& arguments): Platform::ScreenedApplication{argume
     args.addArgument("file").setHelp("file", "file to load")
         .addOption('I', "importer", "AnySceneImporter").setHelp("importer", "importer plugin to use")
         .addOption('i', "importer-options").setHelp("importer-options", "configuration options to pass to the importer", "key=val,key2=val2,…")
-        .addOption("id").setHelp("id", "image or scene ID to import");
+        .addOption("id").setHelp("id", "image or scene ID to import")
+        .addBooleanOption("watch").setHelp("watch", "reload automatically when any of the loaded files changes")
+        .addOption("texture-cache").setHelp("texture-cache", "directory to cache transcoded Basis textures in", "DIR")
+        .addOption("texture-threads", "0").setHelp("texture-threads", "number of threads importing scene textures (0 for one per core, 1 to import on the main thread)", "N")
+        .addOption("capture-format", "png").setHelp("capture-format", "file format for screenshots and recorded frames", "png|jpg|tga|bmp")
+        .addOption("capture-prefix", "magnum-player-").setHelp("capture-prefix", "filename prefix for screenshots and recorded frames", "PREFIX")
+        .addOption("capture-threads", "0").setHelp("capture-threads", "number of threads encoding captured frames (0 for one per core)", "N")
+        .addBooleanOption("batch").setHelp("batch", "render images of all files in a directory or a list instead of opening a window")
+        .addOption("batch-output", ".").setHelp("batch-output", "directory to save the batch images to", "DIR")
+        .addOption("batch-size", "256 256").setHelp("batch-size", "size of the batch images", "\"X Y\"")
+        .addOption("batch-views", "1").setHelp("batch-views", "number of batch images rotating around each file", "N")
+        .addOption("batch-threads", "0").setHelp("batch-threads", "number of threads importing the batch files (0 for one per core)", "N")
+        .addOption("frames", "0").setHelp("frames", "exit after drawing given number of frames (0 to run until closed)", "N")
+        .addOption("trace").setHelp("trace", "write a timeline of the frame stages to a Chrome trace event file", "file.json");
     #endif
     args.addBooleanOption("no-merge-animations").setHelp("no-merge-animations", "don't merge glTF animations into a single clip")
         .addOption("msaa").setHelp("msaa", "MSAA level to use (if not set, defaults to 8x or 2x for HiDPI)", "N")
         .addOption("profile", "FrameTime CpuDuration GpuDuration").setHelp("profile", "profile the rendering", "VALUES")
+        .addOption("interaction-frame-time", "16").setHelp("interaction-frame-time", "frame time target when moving the camera, reduce resolution if exceeded (0 to disable)", "MS")
+        .addBooleanOption("static-batch").setHelp("static-batch", "merge objects that aren't animated into per-material batches drawn with a single multi-draw")
+        .addBooleanOption("compress-textures").setHelp("compress-textures", "compress uncompressed scene textures to BC1 or BC3 on load")
+        .addOption("fixed-dt", "0").setHelp("fixed-dt", "advance animations by a fixed time step each frame instead of following the wall clock (0 to disable)", "MS")
+        .addBooleanOption("frame-checksum").setHelp("frame-checksum", "print a checksum of the scene state after each frame")
         #ifdef CORRADE_IS_DEBUG_BUILD
         .addBooleanOption("tweakable").setHelp("tweakable", "enable live source tweakability")
         #endif
@@ -370,7 +453,45 @@ subgroups using a slash.
 
 The --profile option accepts a space-separated list of measured values.
 Available values are FrameTime, CpuDuration, GpuDuration, VertexFetchRatio and
-PrimitiveClipRatio.)")
+PrimitiveClipRatio.
+
+If drawing a frame takes longer than --interaction-frame-time milliseconds,
+the scene is drawn at a reduced resolution and without multisampling while the
+camera is moving, with a full-quality frame drawn once the movement stops.
+
+With --static-batch, opaque objects that aren't animated and share a material
+and a vertex layout are merged into a single mesh on load and drawn with one
+multi-draw call per material, culled per object. This keeps a CPU copy of the
+meshes.
+
+With --compress-textures, RGB8 and RGBA8 scene textures are compressed to BC1,
+or BC3 if they have alpha, together with mip levels generated on the CPU.
+
+With --fixed-dt, animations advance by given number of milliseconds with each
+drawn frame, starting from zero, and reduced resolution rendering is disabled.
+Together with --frames and --frame-checksum, which prints a hash of all object
+transformations and draw counts for each frame, this gives reproducible runs
+that can be compared against each other.
+
+Scene textures are imported on --texture-threads threads, each opening its own
+copy of the file, and uploaded in the original order. With --texture-cache,
+compressed textures are saved to given directory per Basis target format and
+uploaded from there on the next load.
+
+With --trace, CPU time of the main stages of each frame, such as animation,
+opaque and transparent drawing or UI update and drawing, is written to given
+file in the Chrome trace event format, which can be opened in Perfetto or
+chrome://tracing. Stages that submit GPU work are measured with GPU timestamp
+queries as well, if supported.
+
+F12 saves a screenshot and Shift+F12 starts or stops recording every drawn
+frame, named with --capture-prefix and numbered. The pixels are read back
+asynchronously and encoded on --capture-threads worker threads.
+
+With --batch, the file argument is a directory or a *.txt file with one file
+per line. Each file is imported on one of --batch-threads threads, drawn from
+--batch-views directions with an automatically framed camera and saved to
+--batch-output in --capture-format, after which the application exits.)")
         .parse(arguments.argc, arguments.argv);
 
     /* Try 8x MSAA, fall back to zero samples if not possible. Enable only 2x
@@ -381,6 +502,11 @@ PrimitiveClipRatio.)")
         conf.setTitle("Magnum Player")
             .setWindowFlags(Configuration::WindowFlag::Resizable)
             .setSize(conf.size(), dpiScaling);
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        /* Batch rendering goes to an offscreen framebuffer */
+        if(args.isSet("batch"))
+            conf.setWindowFlags(Configuration::WindowFlag::Hidden);
+        #endif
         GLConfiguration glConf;
         glConf.setSampleCount(args.value("msaa").empty() ? dpiScaling.max() < 2.0f ? 8 : 2 : args.value<Int>("msaa"));
         #ifdef MAGNUM_TARGET_WEBGL
@@ -396,11 +522,38 @@ PrimitiveClipRatio.)")
     }
 
     _profilerValues = args.value<DebugTools::GLFrameProfiler::Values>("profile");
+    _interactionFrameTime = args.value<Float>("interaction-frame-time");
+    _staticBatching = args.isSet("static-batch");
+    _frameChecksum = args.isSet("frame-checksum");
+
+    /* Interaction scaling depends on how long the frames take, which would
+       make the frame contents differ between runs */
+    const Float fixedDt = args.value<Float>("fixed-dt");
+    if(fixedDt > 0.0f) {
+        _clock = FrameClock{std::chrono::nanoseconds{Long(Double(fixedDt)*1.0e6)}};
+        _interactionFrameTime = 0.0f;
+    }
 
     #ifdef CORRADE_IS_DEBUG_BUILD
     if(args.isSet("tweakable")) _tweakable.enable();
     #endif
-    if(args.isSet("verbose")) _importerFlags |= Trade::ImporterFlag::Verbose;
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    _fileTracker.setWatched(args.isSet("watch"));
+    _frameCount = args.value<UnsignedLong>("frames");
+
+    _captureFormat = args.value("capture-format");
+    for(const auto& format: CaptureFormats) if(_captureFormat == format.format) {
+        _capturePlugin = format.plugin;
+        break;
+    }
+    if(_capturePlugin.empty()) {
+        Error{} << "Unknown capture format" << _captureFormat << Debug::nospace << ", expected png, jpg, tga or bmp";
+        std::exit(1);
+    }
+    _capturePrefix = args.value("capture-prefix");
+    _captureThreads = args.value<std::size_t>("capture-threads");
+    #endif
+    if(args.isSet("verbose")) _importers.setFlags(Trade::ImporterFlag::Verbose);
 
     /* Setup renderer defaults */
     GL::Renderer::enable(GL::Renderer::Feature::FaceCulling);
@@ -488,6 +641,70 @@ PrimitiveClipRatio.)")
         }
     }
 
+    /* Compress textures on load only if the GPU can sample them */
+    if(args.isSet("compress-textures")) {
+        GL::Context& context = GL::Context::current();
+        #ifdef MAGNUM_TARGET_WEBGL
+        if(context.isExtensionSupported<GL::Extensions::WEBGL::compressed_texture_s3tc>())
+        #elif defined(MAGNUM_TARGET_GLES)
+        if(context.isExtensionSupported<GL::Extensions::EXT::texture_compression_s3tc>() || context.isExtensionSupported<GL::Extensions::ANGLE::texture_compression_dxt5>())
+        #else
+        if(context.isExtensionSupported<GL::Extensions::EXT::texture_compression_s3tc>())
+        #endif
+        {
+            _compressTextures = true;
+        } else Warning{} << "S3TC texture compression is not supported, textures will be uploaded uncompressed";
+    }
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* Transcoded textures depend on the Basis target format picked above
+       and on the importer options, entries made with different ones are
+       not used. Same for textures compressed on load. */
+    if(!args.value("texture-cache").empty()) {
+        std::string configuration = args.value("importer-options");
+        if(PluginManager::PluginMetadata* const metadata = _manager.metadata("BasisImporter"))
+            configuration += '\n' + metadata->configuration().value("format");
+        if(_compressTextures) configuration += "\ncompressed";
+        _textureCache.emplace(args.value("texture-cache"), std::move(configuration));
+    }
+
+    /* In batch mode render everything right away and exit without entering
+       the main loop */
+    if(args.isSet("batch")) {
+        BatchOptions options;
+        options.importer = args.value("importer");
+        options.importerOptions = args.value("importer-options");
+        if(args.isSet("verbose")) options.importerFlags = Trade::ImporterFlag::Verbose;
+        options.importThreads = args.value<std::size_t>("batch-threads");
+        options.converter = _capturePlugin;
+        options.extension = _captureFormat;
+        options.encodeThreads = _captureThreads;
+        options.outputDirectory = args.value("batch-output");
+        options.size = args.value<Vector2i>("batch-size");
+        options.viewCount = Math::max(args.value<UnsignedInt>("batch-views"), 1u);
+
+        const std::vector<std::string> files = batchFiles(args.value("file"));
+        if(files.empty()) {
+            Error{} << "No files to render in" << args.value("file");
+            exit(1);
+            return;
+        }
+
+        exit(renderBatch(_manager, _converterManager, files, options) ? 1 : 0);
+        return;
+    }
+
+    /* Created only after all plugin defaults are set above, as the workers
+       copy them */
+    if(args.value<std::size_t>("texture-threads") != 1)
+        _textureDecoder.emplace(_manager, args.value<std::size_t>("texture-threads"), args.value("importer-options"), args.isSet("verbose") ? Trade::ImporterFlag::Verbose : Trade::ImporterFlags{});
+
+    if(!args.value("trace").empty()) {
+        _tracer.emplace(args.value("trace"), true);
+        if(!_tracer->isValid()) _tracer = Containers::NullOpt;
+    }
+    #endif
+
     /* Set up the screens */
     _overlay.emplace(*this, _drawUi);
 
@@ -497,66 +714,58 @@ PrimitiveClipRatio.)")
     /* Scene / image ID to load. If not specified, -1 is used. */
     if(!args.value("id").empty()) _id = args.value<Int>("id");
 
-    /* Load a scene importer plugin */
-    Containers::Pointer<Trade::AbstractImporter> importer =
-        _manager.loadAndInstantiate(args.value("importer"));
-    if(importer) importer->setFlags(_importerFlags);
-
-    /* Propagate user-defined options from the command line */
-    if(importer) for(const std::string& option: Utility::String::splitWithoutEmptyParts(args.value("importer-options"), ',')) {
-        auto keyValue = Utility::String::partition(option, '=');
-        Utility::String::trimInPlace(keyValue[0]);
-        Utility::String::trimInPlace(keyValue[2]);
-
-        std::vector<std::string> keyParts = Utility::String::split(keyValue[0], '/');
-        CORRADE_INTERNAL_ASSERT(!keyParts.empty());
-        Utility::ConfigurationGroup* group = &importer->configuration();
-        bool groupNotRecognized = false;
-        for(std::size_t i = 0; i != keyParts.size() - 1; ++i) {
-            Utility::ConfigurationGroup* subgroup = group->group(keyParts[i]);
-            if(!subgroup) {
-                groupNotRecognized = true;
-                subgroup = group->addGroup(keyParts[i]);
-            }
-            group = subgroup;
+    /* Unless a particular importer was requested, detect the file type from
+       magic bytes and go directly to the plugin that handles it. The file is
+       read just once, importers opening it below reuse the data. */
+    std::string importerPlugin = args.value("importer");
+    FileType fileType = FileType::Unknown;
+    if(importerPlugin == "AnySceneImporter") {
+        const FileFormat format = detectFileFormat(_fileTracker.read(_file));
+        if(format.type != FileType::Unknown && _manager.loadState(format.plugin) != PluginManager::LoadState::NotFound) {
+            importerPlugin = format.plugin;
+            fileType = format.type;
         }
-
-        /* Provide a warning message in case the plugin doesn't define given
-           option in its default config. The plugin is not *required* to have
-           those tho (could be backward compatibility entries, for example), so
-           not an error. */
-        if(groupNotRecognized || !group->hasValue(keyParts.back()))
-            Warning{} << "Option" << keyValue[0] << "not recognized by" << importer->plugin();
-
-        /* If the option doesn't have an =, treat it as a boolean flag that's
-           set to true. While there's no similar way to do an inverse, it's
-           still nicer than causing a fatal error with those. */
-        if(keyValue[1].empty())
-            group->setValue(keyParts.back(), true);
-        else
-            group->setValue(keyParts.back(), keyValue[2]);
     }
 
-    Debug{} << "Opening file" << _file;
+    /* Load the importer plugin and propagate user-defined options from the
+       command line. The instance is kept in the pool, so the options get
+       applied only once. */
+    Trade::AbstractImporter* importer = _importers.get(importerPlugin);
+    if(importer) setImporterOptions(*importer, args.value("importer-options"));
+
+    Debug{} << "Opening file" << _file << "with" << importerPlugin;
 
-    /* Load file. If fails and this was not a custom importer, try loading it
-       as an image instead */
+    /* Load file. If the plugin picked from the file signature isn't
+       available or fails to open it, try the generic scene importer. If that
+       fails as well, try loading it as an image instead. */
     /** @todo redo once canOpen*() is implemented */
-    if(importer && importer->openFile(_file)) {
+    const auto openFile = [&](Trade::AbstractImporter* const importer) {
+        if(!importer) return false;
+        _fileTracker.setupImporter(*importer);
+        return importer->openFile(_file);
+    };
+    bool opened = openFile(importer);
+    if(!opened && fileType != FileType::Unknown) {
+        Debug{} << "Opening with" << importerPlugin << "failed, trying AnySceneImporter...";
+        importerPlugin = "AnySceneImporter";
+        importer = _importers.get(importerPlugin);
+        if(importer) setImporterOptions(*importer, args.value("importer-options"));
+        opened = openFile(importer);
+    }
+    if(opened) {
         /* If we passed a custom importer, try to figure out if it's an image
            or a scene */
         /** @todo ugh the importer should have an API for that */
-        if(args.value("importer") != "AnySceneImporter" && !importer->object3DCount() && !importer->meshCount() && importer->image2DCount() >= 1)
+        if(importerPlugin != "AnySceneImporter" && !importer->object3DCount() && !importer->meshCount() && importer->image2DCount() >= 1)
             _player = createImagePlayer(*this, *_overlay->ui, _drawUi);
         else
-            _player = createScenePlayer(*this, *_overlay->ui, _profilerValues, _drawUi);
+            _player = createScenePlayer(*this, *_overlay->ui, _profilerValues, _interactionFrameTime, _staticBatching, _compressTextures, _frameChecksum, _drawUi, _clock, &_fileTracker, _textureCache ? &*_textureCache : nullptr, _textureDecoder ? &*_textureDecoder : nullptr, _tracer ? &*_tracer : nullptr);
         _player->load(_file, *importer, _id);
-        _importer = args.value("importer");
-    } else if(args.value("importer") == "AnySceneImporter") {
+        _importer = importerPlugin;
+    } else if(importerPlugin == "AnySceneImporter") {
         Debug{} << "Opening as a scene failed, trying as an image...";
-        Containers::Pointer<Trade::AbstractImporter> imageImporter = _manager.loadAndInstantiate("AnyImageImporter");
-        if(imageImporter) imageImporter->setFlags(_importerFlags);
-        if(imageImporter && imageImporter->openFile(_file)) {
+        Trade::AbstractImporter* imageImporter = _importers.get("AnyImageImporter");
+        if(openFile(imageImporter)) {
             if(!imageImporter->image2DCount()) {
                 Error{} << "No 2D images found in the file";
                 std::exit(3);
@@ -567,15 +776,22 @@ PrimitiveClipRatio.)")
         } else std::exit(2);
     } else std::exit(1);
     #else
-    Containers::Pointer<Trade::AbstractImporter> importer =
-        _manager.loadAndInstantiate("TinyGltfImporter");
-    importer->setFlags(_importerFlags);
+    Trade::AbstractImporter* importer = _importers.get("TinyGltfImporter");
     Utility::Resource rs{"data"};
     importer->openData(rs.getRaw("artwork/default.glb"));
-    _player = createScenePlayer(*this, *_overlay->ui, _profilerValues, _drawUi);
+    _player = createScenePlayer(*this, *_overlay->ui, _profilerValues, _interactionFrameTime, _staticBatching, _compressTextures, _frameChecksum, _drawUi, _clock, nullptr, nullptr, nullptr, nullptr);
     _player->load({}, *importer, -1);
     #endif
 
+    /* Everything is uploaded to the GPU, release the imported data but keep
+       the importer instances around for reloads */
+    _importers.close();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    _fileTracker.releaseData();
+    if(_textureCache)
+        Debug{} << "Uploaded" << _textureCache->hitCount() << "textures from the cache in" << _textureCache->directory() << "and saved" << _textureCache->savedCount() << "new ones";
+    #endif
+
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     setSwapInterval(1);
     #endif
@@ -586,11 +802,68 @@ PrimitiveClipRatio.)")
 }
 
 #ifndef CORRADE_TARGET_EMSCRIPTEN
-void Player::reload() {
-    Containers::Pointer<Trade::AbstractImporter> importer =
-        _manager.loadAndInstantiate(_importer);
-    if(importer && importer->openFile(_file))
-        _player->load(_file, *importer, _id);
+void Player::reload(const bool full) {
+    /* Figure out what changed. Do this even for a full reload so the hashes
+       are up-to-date. */
+    const std::vector<std::string> changedFiles = _fileTracker.update();
+    if(!full && changedFiles.empty()) {
+        Debug{} << "No changes in" << _file << "or files it references, nothing to reload";
+        return;
+    }
+
+    /* Reuse the importer instance from the initial load, which also has
+       the command-line options already set */
+    Trade::AbstractImporter* importer = _importers.get(_importer);
+    if(!importer) return;
+
+    /* For a full reload start from scratch, so the tracker doesn't keep
+       files that are no longer referenced */
+    if(full) _fileTracker.clear();
+    _fileTracker.setupImporter(*importer);
+    if(importer->openFile(_file)) {
+        if(full) _player->load(_file, *importer, _id);
+        else _player->reload(_file, *importer, _id, changedFiles);
+    }
+
+    importer->close();
+    _fileTracker.releaseData();
+}
+
+bool Player::setupFrameCapture() {
+    if(!_frameCapture) {
+        _frameCapture = Containers::pointer<FrameCapture>(_converterManager, _capturePlugin, _captureThreads);
+        if(_frameCapture->isValid())
+            Debug{} << "Encoding captured frames with" << _capturePlugin << "on" << _frameCapture->workerCount() << "threads";
+    }
+
+    return _frameCapture->isValid();
+}
+
+void Player::takeScreenshot() {
+    if(!setupFrameCapture()) return;
+
+    /* Done in globalDrawEvent() before the buffers get swapped */
+    _screenshotRequested = true;
+    redraw();
+}
+
+void Player::toggleRecording() {
+    if(_recording) {
+        Debug{} << "Recording" << _recordingId << "stopped after" << _recordingFrame << "frames";
+        _recording = false;
+        return;
+    }
+
+    if(!setupFrameCapture()) return;
+
+    /* Find a recording ID that doesn't overwrite existing files */
+    while(Utility::Directory::exists(Utility::formatString("{}{:.4}-{:.5}.{}", _capturePrefix, _recordingId, 0, _captureFormat)))
+        ++_recordingId;
+
+    Debug{} << "Recording" << _recordingId << "started";
+    _recording = true;
+    _recordingFrame = 0;
+    redraw();
 }
 #endif
 
@@ -628,8 +901,7 @@ void Player::loadFile(std::size_t totalCount, const char* filename, Containers::
 
     /* There's a glTF file, load it */
     if(gltfFile) {
-        Containers::Pointer<Trade::AbstractImporter> importer =
-            _manager.loadAndInstantiate("TinyGltfImporter");
+        Trade::AbstractImporter* importer = _importers.get("TinyGltfImporter");
         if(!importer) std::exit(1);
 
         /* Make the extra files available to the importer */
@@ -662,12 +934,12 @@ void Player::loadFile(std::size_t totalCount, const char* filename, Containers::
             return;
         }
 
-        _player = createScenePlayer(*this, *_overlay->ui, _profilerValues, _drawUi);
+        _player = createScenePlayer(*this, *_overlay->ui, _profilerValues, _interactionFrameTime, _staticBatching, _compressTextures, _frameChecksum, _drawUi, _clock, nullptr, nullptr, nullptr, nullptr);
         _player->load(*gltfFile, *importer, -1);
 
     /* If there's just one non-glTF file, try to load it as an image instead */
     } else if(_droppedFiles.size() == 1) {
-        Containers::Pointer<Trade::AbstractImporter> imageImporter = _manager.loadAndInstantiate("AnyImageImporter");
+        Trade::AbstractImporter* imageImporter = _importers.get("AnyImageImporter");
         if(imageImporter->openData(_droppedFiles.begin()->second) && imageImporter->image2DCount()) {
             _player = createImagePlayer(*this, *_overlay->ui, _drawUi);
             _player->load(_droppedFiles.begin()->first, *imageImporter, -1);
@@ -688,7 +960,9 @@ void Player::loadFile(std::size_t totalCount, const char* filename, Containers::
         return;
     }
 
-    /* Clear all loaded files, not needed anymore */
+    /* Clear all loaded files, not needed anymore. Close the importers first
+       as they may still reference the data. */
+    _importers.close();
     _droppedFiles.clear();
 
     Ui::Widget::hide({
@@ -708,19 +982,79 @@ void Player::globalViewportEvent(ViewportEvent& event) {
 }
 
 void Player::globalDrawEvent() {
-    swapBuffers();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* Start reading the frame before the buffers get swapped, it gets saved
+       once the GPU is done with it */
+    if(_screenshotRequested) {
+        std::string filename;
+        do filename = Utility::formatString("{}{:.4}.{}", _capturePrefix, _screenshotId++, _captureFormat);
+        while(Utility::Directory::exists(filename));
+
+        Debug{} << "Saving a screenshot to" << filename;
+        TraceZone zone{_tracer ? &*_tracer : nullptr, "Frame capture"};
+        _frameCapture->capture(GL::defaultFramebuffer, GL::defaultFramebuffer.viewport(), filename);
+        _screenshotRequested = false;
+    }
+    if(_recording) {
+        TraceZone zone{_tracer ? &*_tracer : nullptr, "Frame capture"};
+        _frameCapture->capture(GL::defaultFramebuffer, GL::defaultFramebuffer.viewport(), Utility::formatString("{}{:.4}-{:.5}.{}", _capturePrefix, _recordingId, _recordingFrame++, _captureFormat));
+    }
+    #endif
+
+    {
+        TraceZone zone{_tracer ? &*_tracer : nullptr, "Swap buffers"};
+        swapBuffers();
+    }
+    if(_tracer) _tracer->endFrame();
+    _clock.nextFrame();
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* Keep drawing until given count of frames is reached even if nothing
+       is animated, then wait for captured frames to be saved and exit */
+    if(_frameCount) {
+        if(_clock.frame() < _frameCount) redraw();
+        else {
+            if(_frameCapture) _frameCapture->finish();
+            exit();
+            return;
+        }
+    }
+
+    /* Pass finished reads to the encoding threads. Record at full frame
+       rate and otherwise keep drawing until all reads are done, as the
+       tick event may not be called anymore. */
+    if(_frameCapture) {
+        _frameCapture->update();
+        if(_recording || _frameCapture->readCount()) redraw();
+    }
+    #endif
 }
 
-#ifdef CORRADE_IS_DEBUG_BUILD
+#if defined(CORRADE_IS_DEBUG_BUILD) || !defined(CORRADE_TARGET_EMSCRIPTEN)
 void Player::tickEvent() {
-    /* If tweakable is not enabled, call the base tick event implementation,
-       which effectively stops it from being called again */
-    if(!_tweakable.isEnabled()) {
-        Platform::ScreenedApplication::tickEvent();
-        return;
+    bool active = false;
+
+    #ifdef CORRADE_IS_DEBUG_BUILD
+    if(_tweakable.isEnabled()) {
+        _tweakable.update();
+        active = true;
     }
+    #endif
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(_fileTracker.isWatched()) {
+        if(_fileTracker.hasChanged()) {
+            reload(false);
+            redraw();
+        }
+        active = true;
+    }
+    #endif
 
-    _tweakable.update();
+    /* If neither tweakable nor file watching is enabled, call the base tick
+       event implementation, which effectively stops it from being called
+       again */
+    if(!active) Platform::ScreenedApplication::tickEvent();
 }
 #endif
 
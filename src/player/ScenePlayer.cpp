@@ -24,6 +24,9 @@
 */
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unordered_set>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
@@ -36,6 +39,7 @@
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Sha1.h>
 #include <Magnum/Image.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/Mesh.h>
@@ -45,9 +49,11 @@
 #include <Magnum/DebugTools/FrameProfiler.h>
 #include <Magnum/GL/Context.h>
 #include <Magnum/GL/DefaultFramebuffer.h>
+#include <Magnum/GL/Buffer.h>
 #include <Magnum/GL/Extensions.h>
 #include <Magnum/GL/Framebuffer.h>
 #include <Magnum/GL/Mesh.h>
+#include <Magnum/GL/MeshView.h>
 #include <Magnum/GL/PixelFormat.h>
 #include <Magnum/GL/Renderbuffer.h>
 #include <Magnum/GL/RenderbufferFormat.h>
@@ -56,16 +62,21 @@
 #include <Magnum/GL/TextureFormat.h>
 #include <Magnum/Math/CubicHermite.h>
 #include <Magnum/Math/FunctionsBatch.h>
+#include <Magnum/Math/Packing.h>
 #include <Magnum/Math/Swizzle.h>
 #include <Magnum/MeshTools/Compile.h>
+#include <Magnum/MeshTools/Concatenate.h>
 #include <Magnum/MeshTools/Duplicate.h>
+#include <Magnum/MeshTools/GenerateNormals.h>
 #include <Magnum/MeshTools/GenerateIndices.h>
+#include <Magnum/MeshTools/Reference.h>
 #include <Magnum/MeshTools/Transform.h>
 #include <Magnum/Primitives/Axis.h>
 #include <Magnum/Primitives/Crosshair.h>
 #include <Magnum/Primitives/Cone.h>
 #include <Magnum/Primitives/Circle.h>
 #include <Magnum/Primitives/Line.h>
+#include <Magnum/Primitives/Square.h>
 #include <Magnum/Primitives/UVSphere.h>
 #include <Magnum/SceneGraph/Camera.h>
 #include <Magnum/SceneGraph/Drawable.h>
@@ -84,6 +95,7 @@
 #include <Magnum/Trade/MeshObjectData3D.h>
 #include <Magnum/Trade/PhongMaterialData.h>
 #include <Magnum/Trade/SceneData.h>
+#include <Magnum/Trade/SkinData.h>
 #include <Magnum/Trade/TextureData.h>
 
 #include "Magnum/Ui/Anchor.h"
@@ -106,7 +118,19 @@
 #endif
 
 #include "AbstractPlayer.h"
+#include "BlockCompression.h"
+#include "FileTracker.h"
+#include "FrameClock.h"
 #include "LoadImage.h"
+#include "OcclusionCuller.h"
+#include "Skinning.h"
+#include "Tracer.h"
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include "TextureCache.h"
+#include "TextureDecoder.h"
+#include "WorkerPool.h"
+#endif
 
 #ifdef CORRADE_IS_DEBUG_BUILD
 #include <Corrade/Utility/Tweakable.h>
@@ -229,7 +253,42 @@ struct MeshInfo {
     UnsignedInt objectIdCount;
     std::size_t size;
     std::string name;
-    bool hasTangents, hasSeparateBitangents;
+    bool hasVertexColors, hasTangents, hasSeparateBitangents;
+
+    /* For occlusion culling. Occluder triangles are filled only for
+       reasonably small triangle meshes. */
+    Range3D bounds;
+    Containers::Array<Vector3> occluderPositions;
+    Containers::Array<UnsignedInt> occluderIndices;
+
+    /* Skinned meshes are compiled again for each instance, the CPU-side
+       data are kept for that and for skinning them every frame */
+    Containers::Optional<Trade::MeshData> skinnedMeshData;
+    MeshTools::CompileFlags compileFlags;
+    Containers::Array<Vector3> skinPositions, skinNormals;
+    Containers::Array<Vector4ui> jointIds;
+    Containers::Array<Vector4> jointWeights;
+
+    /* Kept for static batching, only for meshes that can be batched */
+    Containers::Optional<Trade::MeshData> batchMeshData;
+};
+
+/* Instance of a skinned mesh. Has its own copy of the mesh, with positions
+   and normals sourced from a buffer that's updated every frame. */
+struct SkinnedInstance {
+    UnsignedInt meshId;
+    UnsignedInt skin;
+    GL::Buffer vertices{NoCreate};
+    GL::Mesh mesh{NoCreate};
+    /* Interleaved positions and normals */
+    Containers::Array<Vector3> skinnedVertices;
+};
+
+/* Files a texture or a mesh was imported from and a hash of the imported
+   data, used to decide what to re-import on reload */
+struct AssetInfo {
+    std::vector<std::string> files;
+    Utility::Sha1::Digest hash;
 };
 
 struct LightInfo {
@@ -248,12 +307,76 @@ struct ObjectInfo {
 };
 
 class MeshVisualizerDrawable;
+class PhongDrawable;
+
+/* State set by the previously drawn opaque drawable, so it isn't set again,
+   together with counts of the changes for profiling. Uniforms set by other
+   passes are not tracked, so it's reset for each opaque pass. */
+struct DrawState {
+    GL::AbstractShaderProgram* shader;
+    GL::Texture2D* diffuseTexture;
+    GL::Texture2D* normalTexture;
+    bool hasMaterial;
+    Color4 color;
+    Float normalTextureScale, alphaMask;
+    Matrix3 textureMatrix;
+
+    UnsignedInt drawCount, objectCount, shaderChanges, textureChanges, materialChanges;
+};
+
+/* Opaque drawables with the same material and vertex layout on objects that
+   aren't animated, merged into a single mesh in world space on load. Each
+   frame the views of the ones that weren't culled are drawn with a single
+   multi-draw. */
+struct StaticBatch {
+    /* Drawable setting up the shader and the material for the batch */
+    PhongDrawable* drawable;
+    GL::Mesh mesh{NoCreate};
+    std::vector<GL::MeshView> views;
+    std::vector<Containers::Reference<GL::MeshView>> visibleViews;
+};
+
+/* Per-instance data for instanced drawing of opaque drawables */
+struct InstanceData {
+    Matrix4 transformationMatrix;
+    Matrix3x3 normalMatrix;
+};
+
+/* Drawable using a particular material, to be able to patch it on reload */
+struct MaterialDrawable {
+    PhongDrawable* drawable;
+    UnsignedInt meshId;
+};
 
 struct Data {
     Containers::Array<MeshInfo> meshes;
     Containers::Array<LightInfo> lights;
     Containers::Array<Containers::Optional<GL::Texture2D>> textures;
 
+    /* Reload bookkeeping. Materials that failed to import have a zero
+       hash. */
+    Containers::Array<AssetInfo> textureAssets, meshAssets;
+    Containers::Array<Utility::Sha1::Digest> materialHashes;
+    Containers::Array<Containers::Array<MaterialDrawable>> materialDrawables;
+    Utility::Sha1::Digest sceneHash;
+
+    /* Mesh used by each opaque drawable, for occlusion culling */
+    std::unordered_map<const SceneGraph::Drawable3D*, UnsignedInt> drawableMeshes;
+
+    /* Objects with animation tracks, these and their children are not put
+       into static batches. For drawables that are, the batch and view
+       index. */
+    std::unordered_set<const Object3D*> animatedObjects;
+    std::vector<Containers::Pointer<StaticBatch>> staticBatches;
+    std::unordered_map<const SceneGraph::Drawable3D*, std::pair<UnsignedInt, UnsignedInt>> staticBatchDrawables;
+
+    /* Skinning. Skins that failed to import have no joints. The joint
+       objects are in the same order as the palette. */
+    Containers::Array<Containers::Array<UnsignedInt>> skinJoints;
+    SkinPalette skinPalette;
+    std::vector<std::reference_wrapper<Object3D>> jointObjects;
+    Containers::Array<Containers::Pointer<SkinnedInstance>> skinnedInstances;
+
     Scene3D scene;
     Object3D* cameraObject{};
     SceneGraph::Camera3D* camera;
@@ -279,6 +402,115 @@ struct Data {
     std::string modelInfo, objectInfo;
 };
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+std::string textureCacheKey(const Trade::AbstractImporter& importer, const std::string& filename, const UnsignedInt image) {
+    return Utility::formatString("{}\n{}\n{}", Utility::Directory::join(Utility::Directory::current(), filename), importer.plugin(), image);
+}
+#endif
+
+template<class T> void hashValue(Utility::Sha1& sha1, const T& value) {
+    sha1 << Containers::ArrayView<const char>{reinterpret_cast<const char*>(&value), sizeof(T)};
+}
+
+/* Joint IDs and weights come in various formats, convert them to a common
+   one. Returns an empty array if the format isn't supported. */
+template<class T, class U> void convertInto(const Containers::StridedArrayView1D<const T>& from, Containers::ArrayView<U> to) {
+    for(std::size_t i = 0; i != from.size(); ++i) to[i] = U{from[i]};
+}
+
+Containers::Array<Vector4ui> jointIdsAsArray(const Trade::MeshData& mesh, const Trade::MeshAttribute name) {
+    Containers::Array<Vector4ui> out{Containers::NoInit, mesh.vertexCount()};
+    switch(mesh.attributeFormat(name)) {
+        case VertexFormat::Vector4ub:
+            convertInto(mesh.attribute<Vector4ub>(name), Containers::arrayView(out));
+            return out;
+        case VertexFormat::Vector4us:
+            convertInto(mesh.attribute<Vector4us>(name), Containers::arrayView(out));
+            return out;
+        case VertexFormat::Vector4ui:
+            convertInto(mesh.attribute<Vector4ui>(name), Containers::arrayView(out));
+            return out;
+        default: return {};
+    }
+}
+
+Containers::Array<Vector4> jointWeightsAsArray(const Trade::MeshData& mesh, const Trade::MeshAttribute name) {
+    Containers::Array<Vector4> out{Containers::NoInit, mesh.vertexCount()};
+    switch(mesh.attributeFormat(name)) {
+        case VertexFormat::Vector4:
+            convertInto(mesh.attribute<Vector4>(name), Containers::arrayView(out));
+            return out;
+        case VertexFormat::Vector4ubNormalized: {
+            const Containers::StridedArrayView1D<const Vector4ub> weights = mesh.attribute<Vector4ub>(name);
+            for(std::size_t i = 0; i != weights.size(); ++i)
+                out[i] = Math::unpack<Vector4>(weights[i]);
+            return out;
+        }
+        case VertexFormat::Vector4usNormalized: {
+            const Containers::StridedArrayView1D<const Vector4us> weights = mesh.attribute<Vector4us>(name);
+            for(std::size_t i = 0; i != weights.size(); ++i)
+                out[i] = Math::unpack<Vector4>(weights[i]);
+            return out;
+        }
+        default: return {};
+    }
+}
+
+/* Static batches are transformed into world space on the CPU, which is done
+   only for indexed triangle meshes with float positions and tangent frames
+   that don't need normals generated */
+bool isBatchable(const Trade::MeshData& mesh, const MeshTools::CompileFlags flags) {
+    if(mesh.primitive() != MeshPrimitive::Triangles || !mesh.isIndexed() ||
+       flags & (MeshTools::CompileFlag::GenerateFlatNormals|MeshTools::CompileFlag::GenerateSmoothNormals) ||
+       !mesh.hasAttribute(Trade::MeshAttribute::Position) ||
+       mesh.attributeFormat(Trade::MeshAttribute::Position) != VertexFormat::Vector3)
+        return false;
+    for(const Trade::MeshAttribute name: {Trade::MeshAttribute::Normal, Trade::MeshAttribute::Tangent, Trade::MeshAttribute::Bitangent}) {
+        if(mesh.attributeCount(name) > 1) return false;
+        if(!mesh.hasAttribute(name)) continue;
+        const VertexFormat format = mesh.attributeFormat(name);
+        if(format != VertexFormat::Vector3 && !(name == Trade::MeshAttribute::Tangent && format == VertexFormat::Vector4))
+            return false;
+    }
+    return true;
+}
+
+bool hasSameLayout(const Trade::MeshData& a, const Trade::MeshData& b) {
+    if(a.attributeCount() != b.attributeCount()) return false;
+    for(UnsignedInt i = 0; i != a.attributeCount(); ++i) {
+        if(a.attributeName(i) != b.attributeName(i) ||
+           a.attributeFormat(i) != b.attributeFormat(i) ||
+           a.attributeArraySize(i) != b.attributeArraySize(i))
+            return false;
+    }
+    return true;
+}
+
+/* Transforms a vertex range of a batchable mesh */
+void transformVertices(Trade::MeshData& mesh, const std::size_t offset, const std::size_t count, const Matrix4& transformation) {
+    for(Vector3& position: mesh.mutableAttribute<Vector3>(Trade::MeshAttribute::Position).slice(offset, offset + count))
+        position = transformation.transformPoint(position);
+
+    const Matrix3x3 normalMatrix = transformation.normalMatrix();
+    if(mesh.hasAttribute(Trade::MeshAttribute::Normal))
+        for(Vector3& normal: mesh.mutableAttribute<Vector3>(Trade::MeshAttribute::Normal).slice(offset, offset + count))
+            normal = (normalMatrix*normal).normalized();
+
+    /* Bitangent direction flips for mirroring transformations */
+    const Matrix3x3 rotationScaling = transformation.rotationScaling();
+    if(mesh.hasAttribute(Trade::MeshAttribute::Tangent)) {
+        if(mesh.attributeFormat(Trade::MeshAttribute::Tangent) == VertexFormat::Vector4) {
+            const Float handedness = rotationScaling.determinant() < 0.0f ? -1.0f : 1.0f;
+            for(Vector4& tangent: mesh.mutableAttribute<Vector4>(Trade::MeshAttribute::Tangent).slice(offset, offset + count))
+                tangent = {(rotationScaling*tangent.xyz()).normalized(), tangent.w()*handedness};
+        } else for(Vector3& tangent: mesh.mutableAttribute<Vector3>(Trade::MeshAttribute::Tangent).slice(offset, offset + count))
+            tangent = (rotationScaling*tangent).normalized();
+    }
+    if(mesh.hasAttribute(Trade::MeshAttribute::Bitangent))
+        for(Vector3& bitangent: mesh.mutableAttribute<Vector3>(Trade::MeshAttribute::Bitangent).slice(offset, offset + count))
+            bitangent = (rotationScaling*bitangent).normalized();
+}
+
 template<class T> struct EnumSetHash: std::hash<typename std::underlying_type<typename T::Type>::type> {
     std::size_t operator()(const T& value) const {
         return std::hash<typename std::underlying_type<typename T::Type>::type>::operator()(Containers::enumCastUnderlyingType(value));
@@ -306,7 +538,7 @@ enum class Visualization: UnsignedByte {
 
 class ScenePlayer: public AbstractPlayer, public Interconnect::Receiver {
     public:
-        explicit ScenePlayer(Platform::ScreenedApplication& application, Ui::UserInterface& uiToStealFontFrom, const DebugTools::GLFrameProfiler::Values profilerValues, bool& drawUi);
+        explicit ScenePlayer(Platform::ScreenedApplication& application, Ui::UserInterface& uiToStealFontFrom, const DebugTools::GLFrameProfiler::Values profilerValues, Float interactionFrameTime, bool staticBatching, bool compressTextures, bool frameChecksum, bool& drawUi, const FrameClock& clock, FileTracker* fileTracker, TextureCache* textureCache, TextureDecoder* textureDecoder, Tracer* tracer);
 
     private:
         void drawEvent() override;
@@ -319,8 +551,21 @@ class ScenePlayer: public AbstractPlayer, public Interconnect::Receiver {
         void mouseScrollEvent(MouseScrollEvent& event) override;
 
         void load(const std::string& filename, Trade::AbstractImporter& importer, Int id) override;
+        void reload(const std::string& filename, Trade::AbstractImporter& importer, Int id, const std::vector<std::string>& changedFiles) override;
         void setControlsVisible(bool visible) override;
 
+        /* The returned texture / mesh is NullOpt if the import fails or if
+           the imported data hash is equal to `unchangedHash`. If
+           `decodedLevels` are not empty, the image was already imported
+           with files it came from recorded in `asset`. */
+        Containers::Optional<GL::Texture2D> loadTexture(Trade::AbstractImporter& importer, const std::string& filename, UnsignedInt id, AssetInfo& asset, const Utility::Sha1::Digest& unchangedHash = {}, Containers::ArrayView<Trade::ImageData2D> decodedLevels = {});
+        /* Compresses an image together with generated mip levels, on the
+           texture decoder threads if there are any */
+        std::vector<Trade::ImageData2D> compressTexture(const ImageView2D& image);
+        void loadMesh(Trade::AbstractImporter& importer, UnsignedInt id, MeshInfo& info, AssetInfo& asset, const Utility::Sha1::Digest& unchangedHash = {});
+        Containers::Optional<Trade::PhongMaterialData> loadMaterial(Trade::AbstractImporter& importer, UnsignedInt id, Utility::Sha1::Digest& hash);
+        Utility::Sha1::Digest hashScene(Trade::AbstractImporter& importer, Int id);
+
         void initializeUi();
 
         void toggleShadeless();
@@ -340,7 +585,22 @@ class ScenePlayer: public AbstractPlayer, public Interconnect::Receiver {
         Float depthAt(const Vector2i& windowPosition);
         Vector3 unproject(const Vector2i& windowPosition, Float depth) const;
 
-        void addObject(Containers::ArrayView<const Containers::Pointer<Trade::ObjectData3D>> objects, Containers::ArrayView<const Containers::Optional<Trade::PhongMaterialData>> materials, Containers::ArrayView<const bool> hasVertexColors, Object3D& parent, UnsignedInt i);
+        void setupInteractionFramebuffer(const Vector2i& size);
+        void updateInteractionScale();
+        void printFrameChecksum() const;
+        void printProfilerStatistics();
+
+        void cullOccluded(std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>>& drawableTransformations);
+        void sortOpaque(std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>>& drawableTransformations);
+        void drawOpaque(const std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>>& drawableTransformations);
+        void drawOpaqueObjects(const std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>>& drawableTransformations);
+        void buildStaticBatches();
+
+        SkinnedInstance* addSkinnedInstance(UnsignedInt meshId, Int skin);
+        void updateSkinning();
+
+        void addObject(Containers::ArrayView<const Containers::Pointer<Trade::ObjectData3D>> objects, Containers::ArrayView<const Containers::Optional<Trade::PhongMaterialData>> materials, Object3D& parent, UnsignedInt i);
+        Shaders::Phong::Flags setupMaterial(const Trade::PhongMaterialData& material, const MeshInfo& mesh, Shaders::Phong::Flags flags, GL::Texture2D*& diffuseTexture, GL::Texture2D*& normalTexture, Float& normalTextureScale);
 
         Shaders::Flat3D& flatShader(Shaders::Flat3D::Flags flags);
         Shaders::Phong& phongShader(Shaders::Phong::Flags flags);
@@ -364,6 +624,15 @@ class ScenePlayer: public AbstractPlayer, public Interconnect::Receiver {
 
         /* Data loading */
         Containers::Optional<Data> _data;
+        FileTracker* _fileTracker;
+        TextureCache* _textureCache;
+        TextureDecoder* _textureDecoder;
+
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        /* Skinning workers, created for the first skinned frame and kept for
+           the rest of the player lifetime */
+        Containers::Optional<WorkerPool> _skinningPool;
+        #endif
 
         /* UI */
         bool& _drawUi;
@@ -396,32 +665,184 @@ class ScenePlayer: public AbstractPlayer, public Interconnect::Receiver {
         DebugTools::GLFrameProfiler _profiler;
         Debug _profilerOut{Debug::Flag::NoNewlineAtTheEnd|
             (Debug::isTty() ? Debug::Flags{} : Debug::Flag::DisableColors)};
+        /* Lines of the last printed statistics block, to be overwritten by
+           the next one on a terminal. Zero if nothing to overwrite. */
+        std::size_t _profilerLineCount = 0;
+
+        /* Reduced resolution rendering during camera interaction, if the
+           frame time goes over the target. Zero frame size means the last
+           frame was rendered directly to the default framebuffer. */
+        Float _interactionFrameTime;
+        Float _interactionScale{1.0f};
+        Vector2i _interactionFrameSize;
+        std::chrono::steady_clock::time_point _lastInteraction;
+        DebugTools::GLFrameProfiler _interactionProfiler;
+        DebugTools::GLFrameProfiler::Value _interactionProfilerValue;
+        GL::Texture2D _interactionColor{NoCreate};
+        GL::Renderbuffer _interactionDepth{NoCreate};
+        GL::Framebuffer _interactionFramebuffer{NoCreate};
+        GL::Mesh _interactionQuad{NoCreate};
+        Shaders::Flat2D _interactionShader{NoCreate};
+
+        /* Software occlusion culling of opaque drawables, at 1/8 of the
+           framebuffer resolution */
+        bool _occlusionCulling = false;
+        OcclusionCuller _occlusionCuller{Vector2i{1}};
+
+        /* Opaque drawables sorted by shader, textures, mesh and depth, with
+           state changes of the last frame shown in the profiler output */
+        bool _sortOpaque = true;
+        DrawState _drawState{};
+
+        /* Transformations of all opaque Phong drawables are uploaded into
+           one buffer once per frame, each draw then only sets its base
+           instance and consecutive drawables sharing a mesh and a material
+           are drawn with a single instanced draw. The buffer grows
+           geometrically and is otherwise only updated in place. */
+        bool _instancingSupported = false;
+        bool _instancedDrawing = false;
+        GL::Buffer _instanceBuffer{NoCreate};
+        std::size_t _instanceBufferCapacity = 0;
+        std::vector<InstanceData> _instanceData;
+
+        /* Static geometry merged into per-material batches on load. Keeps
+           a CPU copy of all batchable meshes for that. */
+        bool _staticBatching;
+
+        /* Uncompressed textures compressed to BC1 or BC3 on load */
+        bool _compressTextures;
+
+        /* Time source for the animations and a per-frame checksum of the
+           scene state to compare runs in the fixed-step mode */
+        const FrameClock& _clock;
+        bool _frameChecksum;
+
+        /* Zones of the frame stages written to a trace file, if enabled */
+        Tracer* _tracer;
 };
 
-class FlatDrawable: public SceneGraph::Drawable3D {
+/* Hash of material parameters folded to the 10 bits it has in the draw key.
+   Collisions only make the sorting less efficient. */
+UnsignedInt materialKey(const Color4& color, const Float normalTextureScale = 1.0f, const Float alphaMask = 0.5f, const Matrix3& textureMatrix = {}) {
+    Float data[15];
+    std::memcpy(data, color.data(), sizeof(Color4));
+    data[4] = normalTextureScale;
+    data[5] = alphaMask;
+    std::memcpy(data + 6, textureMatrix.data(), sizeof(Matrix3));
+
+    /* FNV-1a */
+    UnsignedInt hash = 2166136261u;
+    const char* const bytes = reinterpret_cast<const char*>(data);
+    for(std::size_t i = 0; i != sizeof(data); ++i)
+        hash = (hash ^ UnsignedByte(bytes[i]))*16777619u;
+    return (hash ^ hash >> 10 ^ hash >> 20) & 0x3ff;
+}
+
+/* Drawables in the opaque group, which are drawn sorted by a key and skip
+   state that's the same as set by the previous drawable */
+class SortableDrawable: public SceneGraph::Drawable3D {
     public:
-        explicit FlatDrawable(Object3D& object, Shaders::Flat3D& shader, GL::Mesh& mesh, UnsignedInt objectId, const Color4& color, const Vector3& scale, SceneGraph::DrawableGroup3D& group): SceneGraph::Drawable3D{object, &group}, _shader(shader), _mesh(mesh), _objectId{objectId}, _color{color}, _scale{scale} {}
+        explicit SortableDrawable(Object3D& object, SceneGraph::DrawableGroup3D& group): SceneGraph::Drawable3D{object, &group} {}
+
+        /* Shader, texture and mesh IDs and a material hash in the upper 48
+           bits of the draw key, the lower 16 bits are filled with depth */
+        virtual UnsignedLong stateKey() const = 0;
+
+        virtual void drawSorted(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera, DrawState& state) = 0;
+
+        /* Only Phong drawables are drawn instanced */
+        virtual PhongDrawable* asPhong() { return nullptr; }
 
     private:
-        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override;
+        /* Drawing outside of the opaque pass, such as for object picking,
+           sets all state */
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+            DrawState state{};
+            drawSorted(transformationMatrix, camera, state);
+        }
+};
+
+class FlatDrawable: public SortableDrawable {
+    public:
+        explicit FlatDrawable(Object3D& object, Shaders::Flat3D& shader, GL::Mesh& mesh, UnsignedInt objectId, const Color4& color, const Vector3& scale, SceneGraph::DrawableGroup3D& group): SortableDrawable{object, group}, _shader(shader), _mesh(mesh), _objectId{objectId}, _color{color}, _scale{scale}, _materialKey{materialKey(color)} {}
 
+        UnsignedLong stateKey() const override {
+            return UnsignedLong(_shader.id() & 0xff) << 56|
+                UnsignedLong(_mesh.id() & 0xfff) << 26|
+                UnsignedLong(_materialKey) << 16;
+        }
+
+        void drawSorted(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera, DrawState& state) override;
+
+    private:
         Shaders::Flat3D& _shader;
         GL::Mesh& _mesh;
         UnsignedInt _objectId;
         Color4 _color;
         Vector3 _scale;
+        UnsignedInt _materialKey;
 };
 
-class PhongDrawable: public SceneGraph::Drawable3D {
+class PhongDrawable: public SortableDrawable {
     public:
-        explicit PhongDrawable(Object3D& object, Shaders::Phong& shader, GL::Mesh& mesh, UnsignedInt objectId, const Color4& color, GL::Texture2D* diffuseTexture, GL::Texture2D* normalTexture, Float normalTextureScale, Float alphaMask, Matrix3 textureMatrix, const bool& shadeless, SceneGraph::DrawableGroup3D& group): SceneGraph::Drawable3D{object, &group}, _shader(shader), _mesh(mesh), _objectId{objectId}, _color{color}, _diffuseTexture{diffuseTexture}, _normalTexture{normalTexture}, _normalTextureScale{normalTextureScale}, _alphaMask{alphaMask}, _textureMatrix{textureMatrix}, _shadeless(shadeless) {}
+        explicit PhongDrawable(Object3D& object, Shaders::Phong& shader, GL::Mesh& mesh, UnsignedInt objectId, const Color4& color, GL::Texture2D* diffuseTexture, GL::Texture2D* normalTexture, Float normalTextureScale, Float alphaMask, Matrix3 textureMatrix, const bool& shadeless, SceneGraph::DrawableGroup3D& group): SortableDrawable{object, group}, _shader(shader), _mesh(mesh), _objectId{objectId}, _color{color}, _diffuseTexture{diffuseTexture}, _normalTexture{normalTexture}, _normalTextureScale{normalTextureScale}, _alphaMask{alphaMask}, _textureMatrix{textureMatrix}, _shadeless(shadeless), _materialKey{materialKey(color, normalTextureScale, alphaMask, textureMatrix)} {}
+
+        explicit PhongDrawable(Object3D& object, Shaders::Phong& shader, GL::Mesh& mesh, UnsignedInt objectId, const Color4& color, const bool& shadeless, SceneGraph::DrawableGroup3D& group): SortableDrawable{object, group}, _shader(shader), _mesh(mesh), _objectId{objectId}, _color{color}, _diffuseTexture{nullptr}, _normalTexture{nullptr}, _normalTextureScale{1.0f}, _alphaMask{0.5f}, _shadeless{shadeless}, _materialKey{materialKey(color)} {}
+
+        void setShader(Shaders::Phong& shader) { _shader = shader; }
+
+        void setMaterial(const Color4& color, GL::Texture2D* diffuseTexture, GL::Texture2D* normalTexture, Float normalTextureScale, Float alphaMask, const Matrix3& textureMatrix) {
+            _color = color;
+            _diffuseTexture = diffuseTexture;
+            _normalTexture = normalTexture;
+            _normalTextureScale = normalTextureScale;
+            _alphaMask = alphaMask;
+            _textureMatrix = textureMatrix;
+            _materialKey = materialKey(color, normalTextureScale, alphaMask, textureMatrix);
+        }
+
+        Shaders::Phong& shader() { return *_shader; }
+
+        /* GL object names are small numbers in practice, collisions after
+           masking only make the sorting less efficient. The mesh and
+           material are last so instances of the same mesh with the same
+           material end up next to each other. */
+        UnsignedLong stateKey() const override {
+            return UnsignedLong(_shader->id() & 0xff) << 56|
+                UnsignedLong(_diffuseTexture ? _diffuseTexture->id() & 0x1ff : 0) << 47|
+                UnsignedLong(_normalTexture ? _normalTexture->id() & 0x1ff : 0) << 38|
+                UnsignedLong(_mesh.id() & 0xfff) << 26|
+                UnsignedLong(_materialKey) << 16;
+        }
+
+        void drawSorted(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera, DrawState& state) override;
+
+        PhongDrawable* asPhong() override { return this; }
+
+        bool hasSameMaterial(const PhongDrawable& other) const {
+            return &*_shader == &*other._shader && _color == other._color && _diffuseTexture == other._diffuseTexture && _normalTexture == other._normalTexture && _normalTextureScale == other._normalTextureScale && _alphaMask == other._alphaMask && _textureMatrix == other._textureMatrix;
+        }
+
+        /* Whether the two can be drawn with a single instanced draw */
+        bool isInstanceOf(const PhongDrawable& other) const {
+            return &_mesh == &other._mesh && hasSameMaterial(other);
+        }
 
-        explicit PhongDrawable(Object3D& object, Shaders::Phong& shader, GL::Mesh& mesh, UnsignedInt objectId, const Color4& color, const bool& shadeless, SceneGraph::DrawableGroup3D& group): SceneGraph::Drawable3D{object, &group}, _shader(shader), _mesh(mesh), _objectId{objectId}, _color{color}, _diffuseTexture{nullptr}, _normalTexture{nullptr}, _alphaMask{0.5f}, _shadeless{shadeless} {}
+        /* Draws views of a static batch with this drawable's material. The
+           batch is in world space. */
+        void drawBatch(Containers::ArrayView<const Containers::Reference<GL::MeshView>> views, SceneGraph::Camera3D& camera, DrawState& state);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /* Draws instanceCount instances from the instance buffer starting at
+           baseInstance, using given variant of the shader with instanced
+           transformation enabled */
+        void drawInstanced(Shaders::Phong& shader, SceneGraph::Camera3D& camera, DrawState& state, UnsignedInt baseInstance, UnsignedInt instanceCount);
+        #endif
 
     private:
-        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override;
+        void setupState(Shaders::Phong& shader, SceneGraph::Camera3D& camera, DrawState& state);
 
-        Shaders::Phong& _shader;
+        Containers::Reference<Shaders::Phong> _shader;
         GL::Mesh& _mesh;
         UnsignedInt _objectId;
         Color4 _color;
@@ -431,6 +852,7 @@ class PhongDrawable: public SceneGraph::Drawable3D {
         Float _alphaMask;
         Matrix3 _textureMatrix;
         const bool& _shadeless;
+        UnsignedInt _materialKey;
 };
 
 class MeshVisualizerDrawable: public SceneGraph::Drawable3D {
@@ -471,7 +893,7 @@ class LightDrawable: public SceneGraph::Drawable3D {
         Containers::Array<Vector4>& _positions;
 };
 
-ScenePlayer::ScenePlayer(Platform::ScreenedApplication& application, Ui::UserInterface& uiToStealFontFrom, DebugTools::GLFrameProfiler::Values profilerValues, bool& drawUi): AbstractPlayer{application, PropagatedEvent::Draw|PropagatedEvent::Input}, _drawUi(drawUi) {
+ScenePlayer::ScenePlayer(Platform::ScreenedApplication& application, Ui::UserInterface& uiToStealFontFrom, DebugTools::GLFrameProfiler::Values profilerValues, const Float interactionFrameTime, const bool staticBatching, const bool compressTextures, const bool frameChecksum, bool& drawUi, const FrameClock& clock, FileTracker* fileTracker, TextureCache* textureCache, TextureDecoder* textureDecoder, Tracer* tracer): AbstractPlayer{application, PropagatedEvent::Draw|PropagatedEvent::Input}, _fileTracker{fileTracker}, _textureCache{textureCache}, _textureDecoder{textureDecoder}, _drawUi(drawUi), _interactionFrameTime{interactionFrameTime}, _staticBatching{staticBatching}, _compressTextures{compressTextures}, _clock(clock), _frameChecksum{frameChecksum}, _tracer{tracer} {
     /* Color maps */
     _colorMapTexture
         .setMinificationFilter(SamplerFilter::Linear, SamplerMipmap::Linear)
@@ -557,9 +979,17 @@ ScenePlayer::ScenePlayer(Platform::ScreenedApplication& application, Ui::UserInt
     _fullscreenTriangle.setCount(3);
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES
+    const bool gpuTimerSupported = GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>();
+    #elif !defined(MAGNUM_TARGET_WEBGL)
+    const bool gpuTimerSupported = GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>();
+    #else
+    const bool gpuTimerSupported = GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query_webgl2>();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     /* Set up the profiler, filter away unsupported values */
-    if(profilerValues & DebugTools::GLFrameProfiler::Value::GpuDuration && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>()) {
+    if(profilerValues & DebugTools::GLFrameProfiler::Value::GpuDuration && !gpuTimerSupported) {
         Debug{} << "ARB_timer_query not supported, GPU time profiling will be unavailable";
         profilerValues &= ~DebugTools::GLFrameProfiler::Value::GpuDuration;
     }
@@ -570,16 +1000,12 @@ ScenePlayer::ScenePlayer(Platform::ScreenedApplication& application, Ui::UserInt
         profilerValues &= ~(DebugTools::GLFrameProfiler::Value::VertexFetchRatio|DebugTools::GLFrameProfiler::Value::PrimitiveClipRatio);
     }
     #elif !defined(MAGNUM_TARGET_WEBGL)
-    if(profilerValues & DebugTools::GLFrameProfiler::Value::GpuDuration &&
-        !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>()
-    ) {
+    if(profilerValues & DebugTools::GLFrameProfiler::Value::GpuDuration && !gpuTimerSupported) {
         Debug{} << "EXT_disjoint_timer_query not supported, GPU time profiling will be unavailable";
         profilerValues &= ~DebugTools::GLFrameProfiler::Value::GpuDuration;
     }
     #else
-    if(profilerValues & DebugTools::GLFrameProfiler::Value::GpuDuration &&
-        !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query_webgl2>()
-    ) {
+    if(profilerValues & DebugTools::GLFrameProfiler::Value::GpuDuration && !gpuTimerSupported) {
         Debug{} << "EXT_disjoint_timer_query_webgl2 not supported, GPU time profiling will be unavailable";
         profilerValues &= ~DebugTools::GLFrameProfiler::Value::GpuDuration;
     }
@@ -588,6 +1014,428 @@ ScenePlayer::ScenePlayer(Platform::ScreenedApplication& application, Ui::UserInt
     /* Disable profiler by default */
     _profiler = DebugTools::GLFrameProfiler{profilerValues, 50};
     _profiler.disable();
+
+    /* Set up reduced resolution rendering for camera interaction. The GPU
+       time is what matters, fall back to CPU time if it can't be measured.
+       Averaging over just a few frames to react quickly. */
+    if(_interactionFrameTime > 0.0f) {
+        _interactionProfilerValue = gpuTimerSupported ?
+            DebugTools::GLFrameProfiler::Value::GpuDuration :
+            DebugTools::GLFrameProfiler::Value::CpuDuration;
+        _interactionProfiler = DebugTools::GLFrameProfiler{_interactionProfilerValue, 4};
+        _interactionQuad = MeshTools::compile(Primitives::squareSolid(Primitives::SquareFlag::TextureCoordinates));
+        _interactionShader = Shaders::Flat2D{Shaders::Flat2D::Flag::Textured|Shaders::Flat2D::Flag::TextureTransformation};
+        setupInteractionFramebuffer(application.framebufferSize());
+    } else _interactionProfiler.disable();
+
+    _occlusionCuller = OcclusionCuller{Math::max(application.framebufferSize()/8, Vector2i{1})};
+
+    /* Instanced drawing needs to offset the instanced attributes for each
+       draw. The buffer has to contain at least one instance for the meshes
+       to be drawable non-instanced. */
+    #ifndef MAGNUM_TARGET_GLES
+    if(GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>() &&
+       GL::Context::current().isExtensionSupported<GL::Extensions::ARB::base_instance>())
+    {
+        const InstanceData instance;
+        _instanceBuffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+        _instanceBuffer.setData(Containers::arrayView(&instance, 1), GL::BufferUsage::StreamDraw);
+        _instanceBufferCapacity = 1;
+        _instancingSupported = _instancedDrawing = true;
+    } else Debug{} << "ARB_base_instance not supported, opaque objects will be drawn without instancing";
+    #endif
+}
+
+void ScenePlayer::setupInteractionFramebuffer(const Vector2i& size) {
+    /* Allocated for the full size, only a part of it is used depending on
+       the current scale. No multisampling, a linearly filtered texture for
+       upscaling. The depth format matches the default framebuffer so it can
+       be blitted for depth reading on WebGL. */
+    _interactionColor = GL::Texture2D{};
+    _interactionColor.setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, GL::TextureFormat::RGBA8, size);
+    _interactionDepth = GL::Renderbuffer{};
+    _interactionDepth.setStorage(GL::RenderbufferFormat::Depth24Stencil8, size);
+    _interactionFramebuffer = GL::Framebuffer{{{}, size}};
+    _interactionFramebuffer
+        .attachTexture(GL::Framebuffer::ColorAttachment{0}, _interactionColor, 0)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::DepthStencil, _interactionDepth);
+    _interactionFrameSize = {};
+}
+
+void ScenePlayer::updateInteractionScale() {
+    /* If the interaction profiler is disabled, the GPU time is measured by
+       the main profiler instead, see keyPressEvent() */
+    Double duration;
+    if(_interactionProfiler.isEnabled()) {
+        if(!_interactionProfiler.isMeasurementAvailable(_interactionProfilerValue))
+            return;
+        duration = _interactionProfilerValue == DebugTools::GLFrameProfiler::Value::GpuDuration ? _interactionProfiler.gpuDurationMean() : _interactionProfiler.cpuDurationMean();
+    } else {
+        if(!_profiler.isMeasurementAvailable(DebugTools::GLFrameProfiler::Value::GpuDuration))
+            return;
+        duration = _profiler.gpuDurationMean();
+    }
+    const Float ratio = Float(_interactionFrameTime/(duration/1.0e6));
+
+    /* The duration depends roughly on the pixel count, so scale the side by a
+       square root of the ratio. Limit the steps and go up only with some
+       headroom to avoid oscillating around the target. */
+    if(ratio < 1.0f)
+        _interactionScale *= Math::max(Math::sqrt(ratio), 0.75f);
+    else if(ratio > 1.25f)
+        _interactionScale *= Math::min(Math::sqrt(ratio), 1.25f);
+    _interactionScale = Math::clamp(_interactionScale, 0.25f, 1.0f);
+}
+
+void ScenePlayer::printProfilerStatistics() {
+    /* State changes of the opaque pass are a part of the same block as the
+       profiler statistics, so they get overwritten together */
+    std::string statistics = _profiler.statistics();
+    if(!statistics.empty() && statistics.back() != '\n') statistics += '\n';
+    statistics += Utility::formatString("  {} {} opaque draws: {} for {} objects, {} shader, {} texture and {} material changes\n",
+        _sortOpaque ? "Sorted" : "Unsorted",
+        _instancedDrawing ? "instanced" : "non-instanced",
+        _drawState.drawCount, _drawState.objectCount,
+        _drawState.shaderChanges, _drawState.textureChanges,
+        _drawState.materialChanges);
+
+    /* On a terminal move the cursor up to the start of the previous block
+       and clear everything after */
+    if(_profilerLineCount && Debug::isTty())
+        _profilerOut << Debug::nospace << Utility::formatString("\033[{}A\033[J", _profilerLineCount) << Debug::nospace;
+    _profilerOut << Debug::nospace << statistics << Debug::nospace;
+    _profilerLineCount = std::count(statistics.begin(), statistics.end(), '\n');
+}
+
+void ScenePlayer::printFrameChecksum() const {
+    /* Absolute object transformations capture the animation state including
+       skin joints, the draw counts of the opaque pass then what got culled
+       and how it got batched */
+    Utility::Sha1 sha1;
+    for(const ObjectInfo& info: _data->objects) {
+        if(!info.object) continue;
+        const Matrix4 transformation = info.object->absoluteTransformationMatrix();
+        sha1 << Containers::arrayView(reinterpret_cast<const char*>(transformation.data()), sizeof(Matrix4));
+    }
+    const Matrix4 cameraMatrix = _data->camera->cameraMatrix();
+    sha1 << Containers::arrayView(reinterpret_cast<const char*>(cameraMatrix.data()), sizeof(Matrix4));
+    const UnsignedInt counts[]{
+        _drawState.drawCount,
+        _drawState.objectCount,
+        _drawState.shaderChanges,
+        _drawState.textureChanges,
+        _drawState.materialChanges
+    };
+    sha1 << Containers::arrayView(reinterpret_cast<const char*>(counts), sizeof(counts));
+
+    Debug{} << "Frame" << _clock.frame() << "draws" << _drawState.drawCount << "checksum" << sha1.digest().hexString();
+}
+
+SkinnedInstance* ScenePlayer::addSkinnedInstance(const UnsignedInt meshId, const Int skin) {
+    const MeshInfo& info = _data->meshes[meshId];
+    if(!info.skinnedMeshData || skin < 0 || UnsignedInt(skin) >= _data->skinJoints.size() || _data->skinJoints[skin].empty())
+        return nullptr;
+
+    Containers::Pointer<SkinnedInstance> instance{Containers::InPlaceInit};
+    instance->meshId = meshId;
+    instance->skin = skin;
+    instance->skinnedVertices = Containers::Array<Vector3>{Containers::ValueInit, info.skinPositions.size()*2};
+    instance->vertices = GL::Buffer{};
+    instance->vertices.setData(Containers::arrayView(instance->skinnedVertices), GL::BufferUsage::DynamicDraw);
+
+    /* Positions and normals from the skinned buffer replace the ones from
+       the compiled mesh, as attribute bindings added later override earlier
+       ones on the same location */
+    instance->mesh = MeshTools::compile(*info.skinnedMeshData, info.compileFlags);
+    instance->mesh.addVertexBuffer(instance->vertices, 0,
+        Shaders::Phong::Position{},
+        Shaders::Phong::Normal{});
+
+    SkinnedInstance* const out = instance.get();
+    arrayAppend(_data->skinnedInstances, std::move(instance));
+    return out;
+}
+
+void ScenePlayer::updateSkinning() {
+    /* Not sharing the texture decoder pool, as parallelFor() waits for all
+       jobs in the pool and its workers hold importer instances */
+    WorkerPool* pool = nullptr;
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!_skinningPool) _skinningPool.emplace(0);
+    pool = &*_skinningPool;
+    #endif
+
+    /* Calculate absolute transformations of all joints in a single batch,
+       reusing the shared parent transformations, then the palette */
+    const std::vector<Matrix4> jointTransformations = _data->scene.transformationMatrices(_data->jointObjects);
+    _data->skinPalette.update({jointTransformations.data(), jointTransformations.size()}, pool);
+
+    /* Instances are independent, skin them in parallel. The result is in
+       world space, matching the drawable attached to the scene root. */
+    parallelFor(pool, _data->skinnedInstances.size(), 4, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            SkinnedInstance& instance = *_data->skinnedInstances[i];
+            const MeshInfo& mesh = _data->meshes[instance.meshId];
+            const Containers::StridedArrayView1D<Vector3> positions{Containers::arrayView(instance.skinnedVertices), instance.skinnedVertices.data(), mesh.skinPositions.size(), 2*sizeof(Vector3)};
+            const Containers::StridedArrayView1D<Vector3> normals{Containers::arrayView(instance.skinnedVertices), instance.skinnedVertices.data() + 1, mesh.skinPositions.size(), 2*sizeof(Vector3)};
+            skinVertices(_data->skinPalette.jointMatrices(instance.skin),
+                Containers::arrayView(mesh.jointIds),
+                Containers::arrayView(mesh.jointWeights),
+                Containers::arrayView(mesh.skinPositions),
+                Containers::arrayView(mesh.skinNormals),
+                positions, normals);
+        }
+    });
+
+    /* GL calls have to be done from the main thread */
+    for(Containers::Pointer<SkinnedInstance>& instance: _data->skinnedInstances)
+        instance->vertices.setSubData(0, Containers::arrayView(instance->skinnedVertices));
+}
+
+void ScenePlayer::cullOccluded(std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>>& drawableTransformations) {
+    const Matrix4& projection = _data->camera->projectionMatrix();
+
+    /* Pick the occluders covering the largest part of the view, estimated
+       from the bounding sphere radius relative to the distance. Rasterizing
+       everything would be too slow and small occluders hide next to
+       nothing. */
+    std::vector<std::pair<Float, std::size_t>> occluders;
+    for(std::size_t i = 0; i != drawableTransformations.size(); ++i) {
+        auto found = _data->drawableMeshes.find(&drawableTransformations[i].first.get());
+        if(found == _data->drawableMeshes.end()) continue;
+        const MeshInfo& mesh = _data->meshes[found->second];
+        if(mesh.occluderIndices.empty()) continue;
+
+        const Matrix4& transformation = drawableTransformations[i].second;
+        const Float radius = (transformation.scaling()*mesh.bounds.size()).length()*0.5f;
+        const Float distance = Math::max(-transformation.transformPoint(mesh.bounds.center()).z(), 0.001f);
+        occluders.emplace_back(radius/distance, i);
+    }
+    const std::size_t occluderCount = Math::min(occluders.size(), std::size_t{16});
+    std::partial_sort(occluders.begin(), occluders.begin() + occluderCount, occluders.end(),
+        [](const std::pair<Float, std::size_t>& a, const std::pair<Float, std::size_t>& b) {
+            return a.first > b.first;
+        });
+
+    _occlusionCuller.clear();
+    for(std::size_t i = 0; i != occluderCount; ++i) {
+        const auto& drawableTransformation = drawableTransformations[occluders[i].second];
+        const MeshInfo& mesh = _data->meshes[_data->drawableMeshes.at(&drawableTransformation.first.get())];
+        _occlusionCuller.rasterize(projection*drawableTransformation.second, Containers::arrayView(mesh.occluderPositions), mesh.occluderIndices);
+    }
+    _occlusionCuller.buildPyramid();
+
+    /* Drawables with no mesh info are kept. The occluders themselves pass
+       the test as well, as their depth is equal to what got rasterized. */
+    drawableTransformations.erase(std::remove_if(drawableTransformations.begin(), drawableTransformations.end(),
+        [&](const std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>& drawableTransformation) {
+            auto found = _data->drawableMeshes.find(&drawableTransformation.first.get());
+            return found != _data->drawableMeshes.end() && !_occlusionCuller.isVisible(projection*drawableTransformation.second, _data->meshes[found->second].bounds);
+        }), drawableTransformations.end());
+}
+
+void ScenePlayer::drawOpaque(const std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>>& drawableTransformations) {
+    _drawState = {};
+    if(_data->staticBatches.empty()) {
+        drawOpaqueObjects(drawableTransformations);
+        return;
+    }
+
+    /* Collect views of batched drawables that survived culling, draw each
+       batch with a single multi-draw and the remaining drawables after */
+    for(Containers::Pointer<StaticBatch>& batch: _data->staticBatches)
+        batch->visibleViews.clear();
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>> remaining;
+    remaining.reserve(drawableTransformations.size());
+    for(const auto& drawableTransformation: drawableTransformations) {
+        auto found = _data->staticBatchDrawables.find(&drawableTransformation.first.get());
+        if(found == _data->staticBatchDrawables.end()) {
+            remaining.push_back(drawableTransformation);
+            continue;
+        }
+
+        StaticBatch& batch = *_data->staticBatches[found->second.first];
+        batch.visibleViews.emplace_back(batch.views[found->second.second]);
+    }
+
+    for(Containers::Pointer<StaticBatch>& batch: _data->staticBatches) {
+        if(batch->visibleViews.empty()) continue;
+        batch->drawable->drawBatch(Containers::arrayView(batch->visibleViews.data(), batch->visibleViews.size()), *_data->camera, _drawState);
+    }
+
+    drawOpaqueObjects(remaining);
+}
+
+void ScenePlayer::drawOpaqueObjects(const std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>>& drawableTransformations) {
+    if(!_instancedDrawing) {
+        for(const auto& drawableTransformation: drawableTransformations)
+            static_cast<SortableDrawable&>(drawableTransformation.first.get()).drawSorted(drawableTransformation.second, *_data->camera, _drawState);
+        return;
+    }
+
+    /* Instanced drawing is enabled only if base instance is supported, which
+       is desktop-only */
+    #ifndef MAGNUM_TARGET_GLES
+    /* Put transformations of all Phong drawables into the instance buffer,
+       with runs of drawables that can be instanced next to each other. A run
+       can also be just a single drawable, which then avoids the per-draw
+       transformation uniform setup. Skinned meshes have a copy for each
+       instance and aren't in drawableMeshes, so they're skipped. */
+    struct Run {
+        std::size_t begin, end;
+        UnsignedInt baseInstance;
+    };
+    std::vector<Run> runs;
+    _instanceData.clear();
+    for(std::size_t i = 0; i != drawableTransformations.size(); ) {
+        PhongDrawable* const first = static_cast<SortableDrawable&>(drawableTransformations[i].first.get()).asPhong();
+        if(!first || _data->drawableMeshes.find(first) == _data->drawableMeshes.end()) {
+            ++i;
+            continue;
+        }
+
+        std::size_t end = i + 1;
+        for(; end != drawableTransformations.size(); ++end) {
+            PhongDrawable* const next = static_cast<SortableDrawable&>(drawableTransformations[end].first.get()).asPhong();
+            if(!next || !next->isInstanceOf(*first)) break;
+        }
+
+        runs.push_back({i, end, UnsignedInt(_instanceData.size())});
+        for(std::size_t j = i; j != end; ++j) {
+            const Matrix4& transformationMatrix = drawableTransformations[j].second;
+            _instanceData.push_back({transformationMatrix, transformationMatrix.normalMatrix()});
+        }
+
+        i = end;
+    }
+
+    /* Reallocate only if the data don't fit, doubling the size to not do
+       that again the next frame if a few more objects get visible. Otherwise
+       orphan the previous contents so the upload doesn't wait for draws of
+       the previous frame still using them. */
+    if(!_instanceData.empty()) {
+        if(_instanceData.size() > _instanceBufferCapacity) {
+            _instanceBufferCapacity = Math::max(_instanceData.size(), 2*_instanceBufferCapacity);
+            _instanceBuffer.setData({nullptr, _instanceBufferCapacity*sizeof(InstanceData)}, GL::BufferUsage::StreamDraw);
+        } else _instanceBuffer.invalidateData();
+        _instanceBuffer.setSubData(0, Containers::arrayView(_instanceData.data(), _instanceData.size()));
+    }
+
+    /* Draw the runs instanced and everything else as usual, in the original
+       order */
+    std::size_t nextRun = 0;
+    for(std::size_t i = 0; i != drawableTransformations.size(); ) {
+        if(nextRun != runs.size() && runs[nextRun].begin == i) {
+            const Run& run = runs[nextRun++];
+            PhongDrawable& drawable = *static_cast<SortableDrawable&>(drawableTransformations[i].first.get()).asPhong();
+            drawable.drawInstanced(phongShader(drawable.shader().flags()|Shaders::Phong::Flag::InstancedTransformation), *_data->camera, _drawState, run.baseInstance, run.end - run.begin);
+            i = run.end;
+            continue;
+        }
+
+        static_cast<SortableDrawable&>(drawableTransformations[i].first.get()).drawSorted(drawableTransformations[i].second, *_data->camera, _drawState);
+        ++i;
+    }
+    #endif
+}
+
+void ScenePlayer::sortOpaque(std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>>& drawableTransformations) {
+    /* Lower 16 bits of the key are the view-space distance, front to back.
+       Bits of a positive float compare the same as its value, the lowest
+       mantissa bits are dropped, which still leaves a relative precision of
+       about half a percent. Calculate the keys up front to avoid virtual
+       calls in the comparator. */
+    std::vector<std::pair<UnsignedLong, std::size_t>> keys;
+    keys.reserve(drawableTransformations.size());
+    for(std::size_t i = 0; i != drawableTransformations.size(); ++i) {
+        const Float distance = Math::max(-drawableTransformations[i].second.translation().z(), 0.0f);
+        UnsignedInt distanceBits;
+        std::memcpy(&distanceBits, &distance, sizeof(Float));
+        keys.emplace_back(static_cast<SortableDrawable&>(drawableTransformations[i].first.get()).stateKey()|distanceBits >> 15, i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>> sorted;
+    sorted.reserve(drawableTransformations.size());
+    for(const std::pair<UnsignedLong, std::size_t>& key: keys)
+        sorted.push_back(drawableTransformations[key.second]);
+    drawableTransformations = std::move(sorted);
+}
+
+void ScenePlayer::buildStaticBatches() {
+    _data->staticBatches.clear();
+    _data->staticBatchDrawables.clear();
+
+    /* Group batchable drawables by material and vertex layout. Linear
+       search, as the count of distinct materials is usually small. */
+    struct Group {
+        std::vector<PhongDrawable*> drawables;
+        std::vector<Containers::Reference<const Trade::MeshData>> meshes;
+    };
+    std::vector<Group> groups;
+    for(std::size_t i = 0; i != _data->opaqueDrawables.size(); ++i) {
+        PhongDrawable* const drawable = static_cast<SortableDrawable&>(_data->opaqueDrawables[i]).asPhong();
+        if(!drawable) continue;
+
+        /* Skinned meshes aren't in drawableMeshes */
+        auto found = _data->drawableMeshes.find(drawable);
+        if(found == _data->drawableMeshes.end() || !_data->meshes[found->second].batchMeshData)
+            continue;
+        const Trade::MeshData& mesh = *_data->meshes[found->second].batchMeshData;
+
+        bool animated = false;
+        for(const Object3D* object = &static_cast<Object3D&>(drawable->object()); object; object = object->parent()) {
+            if(_data->animatedObjects.find(object) == _data->animatedObjects.end()) continue;
+            animated = true;
+            break;
+        }
+        if(animated) continue;
+
+        auto group = std::find_if(groups.begin(), groups.end(), [&](const Group& existing) {
+            return existing.drawables.front()->hasSameMaterial(*drawable) && hasSameLayout(existing.meshes.front(), mesh);
+        });
+        if(group == groups.end()) group = groups.insert(groups.end(), Group{});
+        group->drawables.push_back(drawable);
+        group->meshes.emplace_back(mesh);
+    }
+
+    /* Merge each group into a single mesh in world space, with a view for
+       each drawable. Groups of just one drawable are left as they are. */
+    std::size_t objectCount = 0;
+    for(const Group& group: groups) {
+        if(group.drawables.size() < 2) continue;
+
+        Trade::MeshData merged = MeshTools::concatenate(Containers::arrayView(group.meshes.data(), group.meshes.size()));
+        std::size_t vertexOffset = 0;
+        for(std::size_t i = 0; i != group.drawables.size(); ++i) {
+            const std::size_t vertexCount = group.meshes[i]->vertexCount();
+            transformVertices(merged, vertexOffset, vertexCount, group.drawables[i]->object().absoluteTransformationMatrix());
+            vertexOffset += vertexCount;
+        }
+
+        Containers::Pointer<StaticBatch> batch{Containers::InPlaceInit};
+        batch->drawable = group.drawables.front();
+        batch->mesh = MeshTools::compile(merged, MeshTools::CompileFlag::NoWarnOnCustomAttributes);
+        batch->views.reserve(group.drawables.size());
+        UnsignedInt indexOffset = 0;
+        for(std::size_t i = 0; i != group.drawables.size(); ++i) {
+            const UnsignedInt indexCount = group.meshes[i]->indexCount();
+            batch->views.emplace_back(batch->mesh);
+            batch->views.back()
+                .setCount(indexCount)
+                .setIndexRange(indexOffset);
+            indexOffset += indexCount;
+            _data->staticBatchDrawables.emplace(group.drawables[i], std::make_pair(UnsignedInt(_data->staticBatches.size()), UnsignedInt(i)));
+        }
+
+        objectCount += group.drawables.size();
+        _data->staticBatches.push_back(std::move(batch));
+    }
+
+    Debug{} << "Merged" << objectCount << "static objects into" << _data->staticBatches.size() << "batches";
 }
 
 Shaders::Flat3D& ScenePlayer::flatShader(Shaders::Flat3D::Flags flags) {
@@ -607,6 +1455,17 @@ Shaders::Phong& ScenePlayer::phongShader(Shaders::Phong::Flags flags) {
         found->second
             .setSpecularColor(0x11111100_rgbaf)
             .setShininess(80.0f);
+
+        /* Shaders created while drawing, such as the instanced variants,
+           need the lights set up as well */
+        if(_data->lightColors.size() == found->second.lightCount()) {
+            Containers::Array<Color3> lightColorsBrightness{Containers::NoInit, _data->lightColors.size()};
+            for(UnsignedInt i = 0; i != lightColorsBrightness.size(); ++i)
+                lightColorsBrightness[i] = _data->lightColors[i]*_brightness;
+            found->second.setLightColors(lightColorsBrightness);
+        }
+        if(_data->lightPositions.size() == found->second.lightCount())
+            found->second.setLightPositions(_data->lightPositions);
     }
     return found->second;
 }
@@ -808,7 +1667,7 @@ void ScenePlayer::play() {
         _baseUiPlane->backward,
         _baseUiPlane->stop,
         _baseUiPlane->forward});
-    _data->player.play(std::chrono::system_clock::now().time_since_epoch());
+    _data->player.play(_clock.now());
 }
 
 void ScenePlayer::pause() {
@@ -816,7 +1675,7 @@ void ScenePlayer::pause() {
 
     _baseUiPlane->play.show();
     _baseUiPlane->pause.hide();
-    _data->player.pause(std::chrono::system_clock::now().time_since_epoch());
+    _data->player.pause(_clock.now());
 }
 
 void ScenePlayer::stop() {
@@ -866,32 +1725,60 @@ void ScenePlayer::load(const std::string& filename, Trade::AbstractImporter& imp
 
     _data.emplace();
 
+    /* Remember the scene structure to know if it's possible to reload just
+       parts of it later */
+    _data->sceneHash = hashScene(importer, id);
+
     /* Load all textures. Textures that fail to load will be NullOpt. */
     Debug{} << "Loading" << importer.textureCount() << "textures";
     _data->textures = Containers::Array<Containers::Optional<GL::Texture2D>>{importer.textureCount()};
-    for(UnsignedInt i = 0; i != importer.textureCount(); ++i) {
-        Containers::Optional<Trade::TextureData> textureData = importer.texture(i);
-        if(!textureData || textureData->type() != Trade::TextureData::Type::Texture2D) {
-            Warning{} << "Cannot load texture" << i << importer.textureName(i);
-            continue;
-        }
+    _data->textureAssets = Containers::Array<AssetInfo>{importer.textureCount()};
+
+    /* If possible, import the images on multiple threads first, except for
+       ones that are in the texture cache already. Textures are then created
+       from them one by one in the original order below. */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::vector<std::size_t> decodedImageIds(importer.textureCount(), ~std::size_t{});
+    std::vector<DecodedImage> decodedImages;
+    if(_textureDecoder && !filename.empty()) {
+        std::vector<UnsignedInt> images;
+        for(UnsignedInt i = 0; i != importer.textureCount(); ++i) {
+            Containers::Optional<Trade::TextureData> textureData = importer.texture(i);
+            if(!textureData || textureData->type() != Trade::TextureData::Type::Texture2D)
+                continue;
+            if(_textureCache && _fileTracker && _textureCache->contains(textureCacheKey(importer, filename, textureData->image()), *_fileTracker))
+                continue;
 
-        Containers::Optional<Trade::ImageData2D> imageData = importer.image2D(textureData->image());
-        if(!imageData) {
-            Warning{} << "Cannot load texture" << i << importer.image2DName(textureData->image());
-            continue;
+            const auto found = std::find(images.begin(), images.end(), textureData->image());
+            decodedImageIds[i] = found - images.begin();
+            if(found == images.end()) images.push_back(textureData->image());
         }
 
-        /* Configure the texture */
-        GL::Texture2D texture;
-        texture
-            .setMagnificationFilter(textureData->magnificationFilter())
-            .setMinificationFilter(textureData->minificationFilter(), textureData->mipmapFilter())
-            .setWrapping(textureData->wrapping().xy());
+        if(!images.empty()) {
+            Debug{} << "Importing" << images.size() << "images on" << _textureDecoder->threadCount() << "threads";
+            decodedImages = _textureDecoder->decode(importer.plugin(), filename, images);
+        }
+    }
+    #endif
 
-        loadImage(texture, *imageData);
+    for(UnsignedInt i = 0; i != importer.textureCount(); ++i) {
+        /* If the parallel import failed for an image, it's imported again
+           here to get a proper error message */
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        if(decodedImageIds[i] < decodedImages.size() && !decodedImages[decodedImageIds[i]].levels.empty()) {
+            DecodedImage& decoded = decodedImages[decodedImageIds[i]];
+
+            /* The workers don't go through the file tracker, start tracking
+               the files here so reloads know about them */
+            if(_fileTracker) for(const std::string& file: decoded.files)
+                _fileTracker->hash(file);
+            _data->textureAssets[i].files = decoded.files;
+            _data->textures[i] = loadTexture(importer, filename, i, _data->textureAssets[i], {}, Containers::arrayView(decoded.levels.data(), decoded.levels.size()));
+            continue;
+        }
+        #endif
 
-        _data->textures[i] = std::move(texture);
+        _data->textures[i] = loadTexture(importer, filename, i, _data->textureAssets[i]);
     }
 
     /* Load all lights. Lights that fail to load will be NullOpt, saving the
@@ -929,107 +1816,33 @@ void ScenePlayer::load(const std::string& filename, Trade::AbstractImporter& imp
        temporarily. */
     Debug{} << "Loading" << importer.materialCount() << "materials";
     Containers::Array<Containers::Optional<Trade::PhongMaterialData>> materials{importer.materialCount()};
-    for(UnsignedInt i = 0; i != importer.materialCount(); ++i) {
-        Containers::Optional<Trade::MaterialData> materialData = importer.material(i);
-        if(!materialData || !(materialData->types() & Trade::MaterialType::Phong) || (materialData->as<Trade::PhongMaterialData>().hasTextureTransformation() && !materialData->as<Trade::PhongMaterialData>().hasCommonTextureTransformation()) || materialData->as<Trade::PhongMaterialData>().hasTextureCoordinates()) {
-            Warning{} << "Cannot load material" << i << importer.materialName(i);
-            continue;
-        }
+    _data->materialHashes = Containers::Array<Utility::Sha1::Digest>{Containers::ValueInit, importer.materialCount()};
+    _data->materialDrawables = Containers::Array<Containers::Array<MaterialDrawable>>{importer.materialCount()};
+    for(UnsignedInt i = 0; i != importer.materialCount(); ++i)
+        materials[i] = loadMaterial(importer, i, _data->materialHashes[i]);
 
-        materials[i] = std::move(*materialData).as<Trade::PhongMaterialData>();
-    }
-
-    /* Load all meshes. Meshes that fail to load will be NullOpt. Remember
-       which have vertex colors, so in case there's no material we can use that
-       instead. */
+    /* Load all meshes. Meshes that fail to load will be NullOpt. */
     Debug{} << "Loading" << importer.meshCount() << "meshes";
     _data->meshes = Containers::Array<MeshInfo>{importer.meshCount()};
-    Containers::Array<bool> hasVertexColors{Containers::DirectInit, importer.meshCount(), false};
-    for(UnsignedInt i = 0; i != importer.meshCount(); ++i) {
-        Containers::Optional<Trade::MeshData> meshData = importer.mesh(i);
-        if(!meshData) {
-            Warning{} << "Cannot load mesh" << i << importer.meshName(i);
+    _data->meshAssets = Containers::Array<AssetInfo>{importer.meshCount()};
+    for(UnsignedInt i = 0; i != importer.meshCount(); ++i)
+        loadMesh(importer, i, _data->meshes[i], _data->meshAssets[i]);
+
+    /* Load all skins. Skins that fail to load are added to the palette
+       empty to keep the IDs matching, meshes using them get drawn in the
+       bind pose. */
+    Debug{} << "Loading" << importer.skin3DCount() << "skins";
+    _data->skinJoints = Containers::Array<Containers::Array<UnsignedInt>>{importer.skin3DCount()};
+    for(UnsignedInt i = 0; i != importer.skin3DCount(); ++i) {
+        Containers::Optional<Trade::SkinData3D> skin = importer.skin3D(i);
+        if(!skin) {
+            Warning{} << "Cannot load skin" << i << importer.skin3DName(i);
+            _data->skinPalette.addSkin({});
             continue;
         }
 
-        std::string meshName = importer.meshName(i);
-        if(meshName.empty()) meshName = Utility::formatString("#{}", i);
-
-        /* Disable warnings on custom attributes, as we printed them with
-           actual string names below. Generate normals for triangle meshes
-           (and don't do anything for line/point meshes, there it makes no
-           sense). */
-        MeshTools::CompileFlags flags = MeshTools::CompileFlag::NoWarnOnCustomAttributes;
-        if((meshData->primitive() == MeshPrimitive::Triangles ||
-            meshData->primitive() == MeshPrimitive::TriangleStrip ||
-            meshData->primitive() == MeshPrimitive::TriangleFan) &&
-           !meshData->attributeCount(Trade::MeshAttribute::Normal) &&
-            meshData->attributeFormat(Trade::MeshAttribute::Position) == VertexFormat::Vector3) {
-
-            /* If the mesh is a triangle strip/fan, convert to an indexed one
-               first. The tool additionally expects the mesh to be non-indexed,
-               so duplicate if necessary. Generating smooth normals for those
-               will most probably cause weird artifacts, so  */
-            if(meshData->primitive() == MeshPrimitive::TriangleStrip ||
-               meshData->primitive() == MeshPrimitive::TriangleFan) {
-                Debug{} << "Mesh" << meshName << "doesn't have normals, generating flat ones for a" << meshData->primitive();
-                if(meshData->isIndexed())
-                    meshData = MeshTools::duplicate(*std::move(meshData));
-                meshData = MeshTools::generateIndices(*std::move(meshData));
-                flags |= MeshTools::CompileFlag::GenerateFlatNormals;
-
-            /* Otherwise prefer smooth normals, if we have an index buffer
-               telling us neighboring faces */
-            } else if(meshData->isIndexed()) {
-                Debug{} << "Mesh" << meshName << "doesn't have normals, generating smooth ones using information from the index buffer";
-                flags |= MeshTools::CompileFlag::GenerateSmoothNormals;
-            } else {
-                Debug{} << "Mesh" << meshName << "doesn't have normals, generating flat ones";
-                flags |= MeshTools::CompileFlag::GenerateFlatNormals;
-            }
-        }
-
-        /* Print messages about ignored attributes / levels */
-        for(UnsignedInt i = 0; i != meshData->attributeCount(); ++i) {
-            const Trade::MeshAttribute name = meshData->attributeName(i);
-            if(Trade::isMeshAttributeCustom(name)) {
-                const std::string stringName = importer.meshAttributeName(name);
-                if(!stringName.empty())
-                    Warning{} << "Mesh" << meshName << "has a custom mesh attribute" << stringName << Debug::nospace << ", ignoring";
-                else
-                    Warning{} << "Mesh" << meshName << "has a custom mesh attribute" << name << Debug::nospace << ", ignoring";
-                continue;
-            }
-
-            const VertexFormat format = meshData->attributeFormat(i);
-            if(isVertexFormatImplementationSpecific(format))
-                Warning{} << "Mesh" << meshName << "has" << name << "of format" << format << Debug::nospace << ", ignoring";
-        }
-        const UnsignedInt meshLevels = importer.meshLevelCount(i);
-        if(meshLevels > 1)
-            Warning{} << "Mesh" << meshName << "has" << meshLevels - 1 << "additional mesh levels, ignoring";
-
-        hasVertexColors[i] = meshData->hasAttribute(Trade::MeshAttribute::Color);
-
-        /* Save metadata, compile the mesh */
-        _data->meshes[i].attributes = meshData->attributeCount();
-        _data->meshes[i].vertices = meshData->vertexCount();
-        _data->meshes[i].size = meshData->vertexData().size();
-        if(meshData->isIndexed()) {
-            _data->meshes[i].primitives = MeshTools::primitiveCount(meshData->primitive(), meshData->indexCount());
-            _data->meshes[i].size += meshData->indexData().size();
-        } else _data->meshes[i].primitives = MeshTools::primitiveCount(meshData->primitive(), meshData->vertexCount());
-        /* Needed for a warning when using a mesh with no tangents with a
-           normal map (as, unlike with normals, we have no builtin way to
-           generate tangents right now) */
-        _data->meshes[i].hasTangents = meshData->hasAttribute(Trade::MeshAttribute::Tangent);
-        /* Needed to decide how to visualize tangent space */
-        _data->meshes[i].hasSeparateBitangents = meshData->hasAttribute(Trade::MeshAttribute::Bitangent);
-        if(meshData->hasAttribute(Trade::MeshAttribute::ObjectId)) {
-            _data->meshes[i].objectIdCount = Math::max(meshData->objectIdsAsArray());
-        } else _data->meshes[i].objectIdCount = 0;
-        _data->meshes[i].mesh = MeshTools::compile(*meshData, flags);
-        _data->meshes[i].name = std::move(meshName);
+        arrayAppend(_data->skinJoints[i], skin->joints());
+        _data->skinPalette.addSkin(skin->inverseBindMatrices());
     }
 
     /* Load the scene. Save the object pointers in an array for easier mapping
@@ -1078,7 +1891,20 @@ void ScenePlayer::load(const std::string& filename, Trade::AbstractImporter& imp
 
         /* Recursively add all children */
         for(UnsignedInt objectId: sceneData->children3D())
-            addObject(objects, materials, hasVertexColors, _data->scene, objectId);
+            addObject(objects, materials, _data->scene, objectId);
+
+        /* Gather joint objects of all skins so their transformations can be
+           calculated in a single batch */
+        for(std::size_t i = 0; i != _data->skinJoints.size(); ++i) {
+            for(const UnsignedInt joint: _data->skinJoints[i]) {
+                if(joint < _data->objects.size() && _data->objects[joint].object)
+                    _data->jointObjects.emplace_back(*_data->objects[joint].object);
+                else {
+                    Warning{} << "Skin" << i << "references joint" << joint << "that's not in the scene, using identity";
+                    _data->jointObjects.emplace_back(_data->scene);
+                }
+            }
+        }
 
     /* The format has no scene support, display just the first loaded mesh with
        a default material and be done with it */
@@ -1087,7 +1913,7 @@ void ScenePlayer::load(const std::string& filename, Trade::AbstractImporter& imp
         _data->objects[0].object = &_data->scene;
         _data->objects[0].meshId = 0;
         _data->objects[0].name = "object #0";
-        new PhongDrawable{_data->scene, phongShader(hasVertexColors[0] ? Shaders::Phong::Flag::VertexColor : Shaders::Phong::Flags{}), *_data->meshes[0].mesh, 0, 0xffffff_rgbf, _shadeless, _data->opaqueDrawables};
+        new PhongDrawable{_data->scene, phongShader(_data->meshes[0].hasVertexColors ? Shaders::Phong::Flag::VertexColor : Shaders::Phong::Flags{}), *_data->meshes[0].mesh, 0, 0xffffff_rgbf, _shadeless, _data->opaqueDrawables};
     }
 
     /* Create a camera object in case it wasn't present in the scene already */
@@ -1151,6 +1977,7 @@ void ScenePlayer::load(const std::string& filename, Trade::AbstractImporter& imp
                 continue;
 
             Object3D& animatedObject = *_data->objects[animation->trackTarget(j)].object;
+            _data->animatedObjects.insert(&animatedObject);
 
             if(animation->trackTargetType(j) == Trade::AnimationTrackTargetType::Translation3D) {
                 const auto callback = [](Float, const Vector3& translation, Object3D& object) {
@@ -1196,6 +2023,8 @@ void ScenePlayer::load(const std::string& filename, Trade::AbstractImporter& imp
         break;
     }
 
+    if(_staticBatching) buildStaticBatches();
+
     /* Populate the model info */
     _baseUiPlane->modelInfo.setText(_data->modelInfo = Utility::formatString(
         "{}: {} objs, {} cams, {} meshes, {} mats, {}/{} texs, {} anims",
@@ -1215,7 +2044,7 @@ void ScenePlayer::load(const std::string& filename, Trade::AbstractImporter& imp
         }, _data->elapsedTimeAnimationDestination, *this);
 
         /* Start the animation */
-        _data->player.play(std::chrono::system_clock::now().time_since_epoch());
+        _data->player.play(_clock.now());
     }
 
     /* If this is not the initial animation, make it repeat indefinitely and
@@ -1226,7 +2055,602 @@ void ScenePlayer::load(const std::string& filename, Trade::AbstractImporter& imp
     }
 }
 
-void ScenePlayer::addObject(Containers::ArrayView<const Containers::Pointer<Trade::ObjectData3D>> objects, Containers::ArrayView<const Containers::Optional<Trade::PhongMaterialData>> materials, Containers::ArrayView<const bool> hasVertexColors, Object3D& parent, UnsignedInt i) {
+Containers::Optional<GL::Texture2D> ScenePlayer::loadTexture(Trade::AbstractImporter& importer, const std::string& filename, const UnsignedInt id, AssetInfo& asset, const Utility::Sha1::Digest& unchangedHash, const Containers::ArrayView<Trade::ImageData2D> decodedLevels) {
+    const std::size_t accessedFileCount = _fileTracker ? _fileTracker->accessedFiles().size() : 0;
+
+    Containers::Optional<Trade::TextureData> textureData = importer.texture(id);
+    if(!textureData || textureData->type() != Trade::TextureData::Type::Texture2D) {
+        Warning{} << "Cannot load texture" << id << importer.textureName(id);
+        return {};
+    }
+
+    const auto createTexture = [&]() {
+        GL::Texture2D texture;
+        texture
+            .setMagnificationFilter(textureData->magnificationFilter())
+            .setMinificationFilter(textureData->minificationFilter(), textureData->mipmapFilter())
+            .setWrapping(textureData->wrapping().xy());
+        return texture;
+    };
+
+    /* If the image was transcoded before, upload it straight from the cache.
+       The first file the entry depends on is the top-level file, which isn't
+       tracked per asset. */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::string cacheKey;
+    if(_textureCache && _fileTracker && !filename.empty()) {
+        cacheKey = textureCacheKey(importer, filename, textureData->image());
+        if(Containers::Optional<TextureCache::Entry> entry = _textureCache->find(cacheKey, *_fileTracker)) {
+            asset.files.assign(entry->files.begin() + 1, entry->files.end());
+            asset.hash = entry->hash;
+            if(asset.hash == unchangedHash) return {};
+
+            GL::Texture2D texture = createTexture();
+            loadImage(texture, Containers::arrayView(entry->levels.data(), entry->levels.size()));
+            return texture;
+        }
+    }
+    #else
+    static_cast<void>(filename);
+    #endif
+
+    std::vector<Trade::ImageData2D> importedLevels;
+    if(decodedLevels.empty()) {
+        Containers::Optional<Trade::ImageData2D> imageData = importer.image2D(textureData->image());
+        if(!imageData) {
+            Warning{} << "Cannot load texture" << id << importer.image2DName(textureData->image());
+            return {};
+        }
+
+        /* Remember the files the texture came from */
+        if(_fileTracker) asset.files.assign(_fileTracker->accessedFiles().begin() + accessedFileCount, _fileTracker->accessedFiles().end());
+        importedLevels.push_back(std::move(*imageData));
+    }
+    Trade::ImageData2D& imageData = decodedLevels.empty() ? importedLevels[0] : decodedLevels[0];
+
+    /* Hash the imported data to be able to tell later if it changed */
+    {
+        Utility::Sha1 sha1;
+        hashValue(sha1, textureData->magnificationFilter());
+        hashValue(sha1, textureData->minificationFilter());
+        hashValue(sha1, textureData->mipmapFilter());
+        hashValue(sha1, textureData->wrapping());
+        if(imageData.isCompressed())
+            hashValue(sha1, imageData.compressedFormat());
+        else
+            hashValue(sha1, imageData.format());
+        hashValue(sha1, imageData.size());
+        sha1 << imageData.data();
+        asset.hash = sha1.digest();
+    }
+    if(asset.hash == unchangedHash) return {};
+
+    GL::Texture2D texture = createTexture();
+    std::vector<Trade::ImageData2D> compressedLevels;
+    if(!imageData.isCompressed()) {
+        if(!_compressTextures || !isBlockCompressible(imageData.format())) {
+            loadImage(texture, imageData);
+            return texture;
+        }
+
+        /* The hash above is of the uncompressed data, so reloads can tell
+           the image didn't change without compressing it again */
+        compressedLevels = compressTexture(imageData);
+
+    /* Compressed images can't have mips generated, import all levels the
+       file has, unless that was done already */
+    } else if(decodedLevels.empty()) {
+        for(UnsignedInt i = 1, levelCount = importer.image2DLevelCount(textureData->image()); i != levelCount; ++i) {
+            Containers::Optional<Trade::ImageData2D> level = importer.image2D(textureData->image(), i);
+            if(!level || !level->isCompressed()) break;
+            importedLevels.push_back(std::move(*level));
+        }
+    }
+    Containers::ArrayView<Trade::ImageData2D> chain = decodedLevels.empty() ? Containers::arrayView(importedLevels.data(), importedLevels.size()) : decodedLevels;
+    if(!compressedLevels.empty())
+        chain = Containers::arrayView(compressedLevels.data(), compressedLevels.size());
+    std::vector<CompressedImageView2D> levels;
+    for(const Trade::ImageData2D& level: chain) levels.emplace_back(level);
+    loadImage(texture, Containers::arrayView(levels.data(), levels.size()));
+
+    /* Save them to the cache for next time, together with the top-level
+       file and the files the image came from */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!cacheKey.empty()) {
+        std::vector<std::string> files{filename};
+        files.insert(files.end(), asset.files.begin(), asset.files.end());
+        _textureCache->save(cacheKey, *_fileTracker, files, asset.hash, Containers::arrayView(levels.data(), levels.size()));
+    }
+    #endif
+
+    return texture;
+}
+
+std::vector<Trade::ImageData2D> ScenePlayer::compressTexture(const ImageView2D& image) {
+    const CompressedPixelFormat format = blockCompressedFormat(image);
+    const std::vector<Image2D> mips = generateMips(image);
+
+    /* Split each level into bands of block rows, so even a single large
+       texture keeps all threads busy. The bands of all levels are compressed
+       at the same time. */
+    constexpr std::size_t BandSize = 16;
+    std::vector<Containers::Array<char>> data;
+    data.reserve(mips.size());
+    for(const Image2D& mip: mips)
+        data.emplace_back(Containers::NoInit, compressedDataSize(mip.size(), format));
+    for(std::size_t i = 0; i != mips.size(); ++i) {
+        const std::size_t blockRowCount = (mips[i].size().y() + 3)/4;
+        for(std::size_t begin = 0; begin < blockRowCount; begin += BandSize) {
+            const std::size_t end = Math::min(begin + BandSize, blockRowCount);
+            #ifndef CORRADE_TARGET_EMSCRIPTEN
+            if(_textureDecoder) {
+                _textureDecoder->pool().submit([&mips, &data, format, i, begin, end](std::size_t) {
+                    compressBlocks(mips[i], format, begin, end, data[i]);
+                });
+                continue;
+            }
+            #endif
+            compressBlocks(mips[i], format, begin, end, data[i]);
+        }
+    }
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(_textureDecoder) _textureDecoder->pool().wait();
+    #endif
+
+    std::vector<Trade::ImageData2D> levels;
+    for(std::size_t i = 0; i != mips.size(); ++i)
+        levels.emplace_back(format, mips[i].size(), std::move(data[i]));
+    return levels;
+}
+
+void ScenePlayer::loadMesh(Trade::AbstractImporter& importer, const UnsignedInt id, MeshInfo& info, AssetInfo& asset, const Utility::Sha1::Digest& unchangedHash) {
+    const std::size_t accessedFileCount = _fileTracker ? _fileTracker->accessedFiles().size() : 0;
+
+    Containers::Optional<Trade::MeshData> meshData = importer.mesh(id);
+    if(!meshData) {
+        Warning{} << "Cannot load mesh" << id << importer.meshName(id);
+        return;
+    }
+
+    /* Remember the files the mesh came from and hash the imported data to be
+       able to tell later if it changed */
+    if(_fileTracker) asset.files.assign(_fileTracker->accessedFiles().begin() + accessedFileCount, _fileTracker->accessedFiles().end());
+    {
+        Utility::Sha1 sha1;
+        hashValue(sha1, meshData->primitive());
+        if(meshData->isIndexed()) {
+            hashValue(sha1, meshData->indexType());
+            sha1 << meshData->indexData();
+        }
+        for(UnsignedInt i = 0; i != meshData->attributeCount(); ++i) {
+            hashValue(sha1, meshData->attributeName(i));
+            hashValue(sha1, meshData->attributeFormat(i));
+            hashValue(sha1, meshData->attributeOffset(i));
+            hashValue(sha1, meshData->attributeStride(i));
+        }
+        hashValue(sha1, meshData->vertexCount());
+        sha1 << meshData->vertexData();
+        asset.hash = sha1.digest();
+    }
+    if(asset.hash == unchangedHash) return;
+
+    std::string meshName = importer.meshName(id);
+    if(meshName.empty()) meshName = Utility::formatString("#{}", id);
+
+    /* Disable warnings on custom attributes, as we printed them with
+       actual string names below. Generate normals for triangle meshes
+       (and don't do anything for line/point meshes, there it makes no
+       sense). */
+    MeshTools::CompileFlags flags = MeshTools::CompileFlag::NoWarnOnCustomAttributes;
+    if((meshData->primitive() == MeshPrimitive::Triangles ||
+        meshData->primitive() == MeshPrimitive::TriangleStrip ||
+        meshData->primitive() == MeshPrimitive::TriangleFan) &&
+       !meshData->attributeCount(Trade::MeshAttribute::Normal) &&
+        meshData->attributeFormat(Trade::MeshAttribute::Position) == VertexFormat::Vector3) {
+
+        /* If the mesh is a triangle strip/fan, convert to an indexed one
+           first. The tool additionally expects the mesh to be non-indexed,
+           so duplicate if necessary. Generating smooth normals for those
+           will most probably cause weird artifacts, so  */
+        if(meshData->primitive() == MeshPrimitive::TriangleStrip ||
+           meshData->primitive() == MeshPrimitive::TriangleFan) {
+            Debug{} << "Mesh" << meshName << "doesn't have normals, generating flat ones for a" << meshData->primitive();
+            if(meshData->isIndexed())
+                meshData = MeshTools::duplicate(*std::move(meshData));
+            meshData = MeshTools::generateIndices(*std::move(meshData));
+            flags |= MeshTools::CompileFlag::GenerateFlatNormals;
+
+        /* Otherwise prefer smooth normals, if we have an index buffer
+           telling us neighboring faces */
+        } else if(meshData->isIndexed()) {
+            Debug{} << "Mesh" << meshName << "doesn't have normals, generating smooth ones using information from the index buffer";
+            flags |= MeshTools::CompileFlag::GenerateSmoothNormals;
+        } else {
+            Debug{} << "Mesh" << meshName << "doesn't have normals, generating flat ones";
+            flags |= MeshTools::CompileFlag::GenerateFlatNormals;
+        }
+    }
+
+    /* Print messages about ignored attributes / levels */
+    for(UnsignedInt i = 0; i != meshData->attributeCount(); ++i) {
+        const Trade::MeshAttribute name = meshData->attributeName(i);
+        if(Trade::isMeshAttributeCustom(name)) {
+            const std::string stringName = importer.meshAttributeName(name);
+            if(!stringName.empty())
+                Warning{} << "Mesh" << meshName << "has a custom mesh attribute" << stringName << Debug::nospace << ", ignoring";
+            else
+                Warning{} << "Mesh" << meshName << "has a custom mesh attribute" << name << Debug::nospace << ", ignoring";
+            continue;
+        }
+
+        const VertexFormat format = meshData->attributeFormat(i);
+        if(isVertexFormatImplementationSpecific(format))
+            Warning{} << "Mesh" << meshName << "has" << name << "of format" << format << Debug::nospace << ", ignoring";
+    }
+    const UnsignedInt meshLevels = importer.meshLevelCount(id);
+    if(meshLevels > 1)
+        Warning{} << "Mesh" << meshName << "has" << meshLevels - 1 << "additional mesh levels, ignoring";
+
+    info.hasVertexColors = meshData->hasAttribute(Trade::MeshAttribute::Color);
+
+    /* Save metadata, compile the mesh */
+    info.attributes = meshData->attributeCount();
+    info.vertices = meshData->vertexCount();
+    info.size = meshData->vertexData().size();
+    if(meshData->isIndexed()) {
+        info.primitives = MeshTools::primitiveCount(meshData->primitive(), meshData->indexCount());
+        info.size += meshData->indexData().size();
+    } else info.primitives = MeshTools::primitiveCount(meshData->primitive(), meshData->vertexCount());
+    /* Needed for a warning when using a mesh with no tangents with a
+       normal map (as, unlike with normals, we have no builtin way to
+       generate tangents right now) */
+    info.hasTangents = meshData->hasAttribute(Trade::MeshAttribute::Tangent);
+    /* Needed to decide how to visualize tangent space */
+    info.hasSeparateBitangents = meshData->hasAttribute(Trade::MeshAttribute::Bitangent);
+    if(meshData->hasAttribute(Trade::MeshAttribute::ObjectId)) {
+        info.objectIdCount = Math::max(meshData->objectIdsAsArray());
+    } else info.objectIdCount = 0;
+    /* Bounds and occluder geometry for occlusion culling. Big meshes would
+       take too long to rasterize on the CPU, those only get tested. */
+    if(meshData->hasAttribute(Trade::MeshAttribute::Position)) {
+        Containers::Array<Vector3> positions = meshData->positions3DAsArray();
+        const std::pair<Vector3, Vector3> minmax = Math::minmax(Containers::arrayView(positions));
+        info.bounds = {minmax.first, minmax.second};
+        if(meshData->primitive() == MeshPrimitive::Triangles && info.primitives <= 4096) {
+            if(meshData->isIndexed())
+                info.occluderIndices = meshData->indicesAsArray();
+            else {
+                info.occluderIndices = Containers::Array<UnsignedInt>{NoInit, positions.size()};
+                for(std::size_t i = 0; i != positions.size(); ++i)
+                    info.occluderIndices[i] = UnsignedInt(i);
+            }
+            info.occluderPositions = std::move(positions);
+        }
+    }
+
+    /* Skinned meshes are identified by glTF joint and weight attributes,
+       which are imported as custom. Flat normal generation duplicates the
+       vertices, so in that case the mesh is drawn in bind pose; for indexed
+       meshes the smooth normals are generated here to be able to skin
+       them. */
+    const Trade::MeshAttribute jointIdsAttribute = importer.meshAttributeForName("JOINTS_0");
+    const Trade::MeshAttribute weightsAttribute = importer.meshAttributeForName("WEIGHTS_0");
+    if(jointIdsAttribute != Trade::MeshAttribute{} && weightsAttribute != Trade::MeshAttribute{} && meshData->hasAttribute(jointIdsAttribute) && meshData->hasAttribute(weightsAttribute) && meshData->hasAttribute(Trade::MeshAttribute::Position)) {
+        Containers::Array<Vector4ui> jointIds = jointIdsAsArray(*meshData, jointIdsAttribute);
+        Containers::Array<Vector4> jointWeights = jointWeightsAsArray(*meshData, weightsAttribute);
+        if(flags & MeshTools::CompileFlag::GenerateFlatNormals)
+            Warning{} << "Mesh" << meshName << "is skinned but has no normals or index buffer, drawing it in bind pose";
+        else if(jointIds.empty() || jointWeights.empty())
+            Warning{} << "Mesh" << meshName << "has joints of format" << meshData->attributeFormat(jointIdsAttribute) << "and weights of format" << meshData->attributeFormat(weightsAttribute) << Debug::nospace << ", drawing it in bind pose";
+        else {
+            info.jointIds = std::move(jointIds);
+            info.jointWeights = std::move(jointWeights);
+            info.skinPositions = meshData->positions3DAsArray();
+            if(meshData->hasAttribute(Trade::MeshAttribute::Normal))
+                info.skinNormals = meshData->normalsAsArray();
+            else
+                info.skinNormals = MeshTools::generateSmoothNormals(Containers::arrayView(meshData->indicesAsArray()), Containers::arrayView(info.skinPositions));
+            info.compileFlags = flags;
+        }
+    }
+
+    info.mesh = MeshTools::compile(*meshData, flags);
+    #ifndef MAGNUM_TARGET_GLES
+    if(_instancingSupported) info.mesh->addVertexBufferInstanced(_instanceBuffer, 1, 0,
+        Shaders::Phong::TransformationMatrix{},
+        Shaders::Phong::NormalMatrix{});
+    #endif
+    info.name = std::move(meshName);
+    if(!info.skinPositions.empty()) info.skinnedMeshData = std::move(*meshData);
+    else if(_staticBatching && isBatchable(*meshData, flags))
+        info.batchMeshData = MeshTools::owned(*std::move(meshData));
+}
+
+Containers::Optional<Trade::PhongMaterialData> ScenePlayer::loadMaterial(Trade::AbstractImporter& importer, const UnsignedInt id, Utility::Sha1::Digest& hash) {
+    Containers::Optional<Trade::MaterialData> materialData = importer.material(id);
+    if(!materialData || !(materialData->types() & Trade::MaterialType::Phong) || (materialData->as<Trade::PhongMaterialData>().hasTextureTransformation() && !materialData->as<Trade::PhongMaterialData>().hasCommonTextureTransformation()) || materialData->as<Trade::PhongMaterialData>().hasTextureCoordinates()) {
+        Warning{} << "Cannot load material" << id << importer.materialName(id);
+        return {};
+    }
+
+    /* The attribute data are self-contained, so it's enough to hash them
+       together with the layer offsets */
+    Utility::Sha1 sha1;
+    hashValue(sha1, materialData->types());
+    sha1 << Containers::arrayCast<const char>(materialData->layerData());
+    sha1 << Containers::arrayCast<const char>(materialData->attributeData());
+    hash = sha1.digest();
+
+    return std::move(*materialData).as<Trade::PhongMaterialData>();
+}
+
+Utility::Sha1::Digest ScenePlayer::hashScene(Trade::AbstractImporter& importer, const Int id) {
+    Utility::Sha1 sha1;
+    hashValue(sha1, id);
+    hashValue(sha1, importer.defaultScene());
+    hashValue(sha1, importer.object3DCount());
+    hashValue(sha1, importer.textureCount());
+    hashValue(sha1, importer.materialCount());
+    hashValue(sha1, importer.meshCount());
+
+    const Int sceneId = id < 0 ? importer.defaultScene() : id;
+    if(sceneId >= 0 && UnsignedInt(sceneId) < importer.sceneCount()) {
+        if(Containers::Optional<Trade::SceneData> scene = importer.scene(sceneId))
+            for(UnsignedInt child: scene->children3D()) hashValue(sha1, child);
+    }
+
+    for(UnsignedInt i = 0; i != importer.object3DCount(); ++i) {
+        Containers::Pointer<Trade::ObjectData3D> object = importer.object3D(i);
+        if(!object) continue;
+
+        hashValue(sha1, object->instanceType());
+        hashValue(sha1, object->instance());
+        hashValue(sha1, object->flags());
+        if(object->flags() & Trade::ObjectFlag3D::HasTranslationRotationScaling) {
+            hashValue(sha1, object->translation());
+            hashValue(sha1, object->rotation());
+            hashValue(sha1, object->scaling());
+        } else hashValue(sha1, object->transformation());
+        if(object->instanceType() == Trade::ObjectInstanceType3D::Mesh) {
+            hashValue(sha1, static_cast<const Trade::MeshObjectData3D&>(*object).material());
+            hashValue(sha1, static_cast<const Trade::MeshObjectData3D&>(*object).skin());
+        }
+        for(UnsignedInt child: object->children()) hashValue(sha1, child);
+    }
+
+    hashValue(sha1, importer.lightCount());
+    for(UnsignedInt i = 0; i != importer.lightCount(); ++i) {
+        Containers::Optional<Trade::LightData> light = importer.light(i);
+        if(!light) continue;
+
+        hashValue(sha1, light->type());
+        hashValue(sha1, light->color());
+        hashValue(sha1, light->intensity());
+        hashValue(sha1, light->range());
+        hashValue(sha1, light->attenuation());
+        hashValue(sha1, light->innerConeAngle());
+        hashValue(sha1, light->outerConeAngle());
+    }
+
+    hashValue(sha1, importer.cameraCount());
+    for(UnsignedInt i = 0; i != importer.cameraCount(); ++i) {
+        Containers::Optional<Trade::CameraData> camera = importer.camera(i);
+        if(!camera) continue;
+
+        hashValue(sha1, camera->type());
+        hashValue(sha1, camera->size());
+        hashValue(sha1, camera->near());
+        hashValue(sha1, camera->far());
+    }
+
+    hashValue(sha1, importer.animationCount());
+    for(UnsignedInt i = 0; i != importer.animationCount(); ++i) {
+        Containers::Optional<Trade::AnimationData> animation = importer.animation(i);
+        if(!animation) continue;
+
+        for(UnsignedInt j = 0; j != animation->trackCount(); ++j) {
+            hashValue(sha1, animation->trackType(j));
+            hashValue(sha1, animation->trackTargetType(j));
+            hashValue(sha1, animation->trackTarget(j));
+        }
+        sha1 << animation->data();
+    }
+
+    return sha1.digest();
+}
+
+void ScenePlayer::reload(const std::string& filename, Trade::AbstractImporter& importer, const Int id, const std::vector<std::string>& changedFiles) {
+    /* Nothing to patch if there's nothing loaded */
+    if(!_data) {
+        load(filename, importer, id);
+        return;
+    }
+
+    const auto isChanged = [&changedFiles](const std::string& file) {
+        return std::find(changedFiles.begin(), changedFiles.end(), file) != changedFiles.end();
+    };
+    const auto isAnyChanged = [&isChanged](const std::vector<std::string>& files) {
+        return std::find_if(files.begin(), files.end(), isChanged) != files.end();
+    };
+
+    /* If the top-level file changed, anything in it could have changed. If
+       the scene structure, lights, cameras or animations differ, there's no
+       other way than to load everything again. Otherwise all textures, meshes
+       and materials get imported again and compared to what was there
+       before, as they could be embedded in the top-level file. */
+    const bool topLevelChanged = isChanged(filename);
+    if(topLevelChanged && (
+        importer.textureCount() != _data->textures.size() ||
+        importer.meshCount() != _data->meshes.size() ||
+        importer.materialCount() != _data->materialHashes.size() ||
+        hashScene(importer, id) != _data->sceneHash))
+    {
+        Debug{} << "Scene structure changed, reloading everything";
+        load(filename, importer, id);
+        return;
+    }
+
+    /* Textures and meshes are moved into the existing instances so all
+       drawables referencing them pick up the change. Assets that failed to
+       import before aren't referenced by anything, so a full reload is
+       needed in that case. */
+    UnsignedInt textureCount = 0;
+    for(UnsignedInt i = 0; i != _data->textures.size(); ++i) {
+        if(!topLevelChanged && !isAnyChanged(_data->textureAssets[i].files))
+            continue;
+
+        if(!_data->textures[i]) {
+            Debug{} << "Texture" << i << "wasn't loaded before, reloading everything";
+            load(filename, importer, id);
+            return;
+        }
+
+        AssetInfo asset;
+        Containers::Optional<GL::Texture2D> texture = loadTexture(importer, filename, i, asset, _data->textureAssets[i].hash);
+        /* If the import failed, keep the previous version */
+        if(asset.hash != _data->textureAssets[i].hash && !texture) continue;
+
+        if(texture) {
+            *_data->textures[i] = std::move(*texture);
+            ++textureCount;
+        }
+        _data->textureAssets[i] = std::move(asset);
+    }
+
+    UnsignedInt meshCount = 0;
+    for(UnsignedInt i = 0; i != _data->meshes.size(); ++i) {
+        if(!topLevelChanged && !isAnyChanged(_data->meshAssets[i].files))
+            continue;
+
+        MeshInfo& existing = _data->meshes[i];
+        if(!existing.mesh) {
+            Debug{} << "Mesh" << i << "wasn't loaded before, reloading everything";
+            load(filename, importer, id);
+            return;
+        }
+
+        MeshInfo info;
+        AssetInfo asset;
+        loadMesh(importer, i, info, asset, _data->meshAssets[i].hash);
+        /* If the import failed, keep the previous version */
+        if(asset.hash != _data->meshAssets[i].hash && !info.mesh) continue;
+
+        if(info.mesh) {
+            /* Drawables have the shader picked based on what attributes are
+               present, if that changes they need to be created again */
+            if(info.skinnedMeshData || existing.skinnedMeshData ||
+               info.mesh->primitive() != existing.mesh->primitive() ||
+               info.hasVertexColors != existing.hasVertexColors ||
+               info.hasTangents != existing.hasTangents ||
+               info.hasSeparateBitangents != existing.hasSeparateBitangents) {
+                Debug{} << "Mesh" << existing.name << "changed its layout, reloading everything";
+                load(filename, importer, id);
+                return;
+            }
+
+            *existing.mesh = std::move(*info.mesh);
+            existing.attributes = info.attributes;
+            existing.vertices = info.vertices;
+            existing.primitives = info.primitives;
+            existing.objectIdCount = info.objectIdCount;
+            existing.size = info.size;
+            existing.name = std::move(info.name);
+            existing.bounds = info.bounds;
+            existing.occluderPositions = std::move(info.occluderPositions);
+            existing.occluderIndices = std::move(info.occluderIndices);
+            existing.batchMeshData = std::move(info.batchMeshData);
+            ++meshCount;
+        }
+        _data->meshAssets[i] = std::move(asset);
+    }
+
+    /* Materials are always in the top-level file. Patch the drawables using
+       them, switching the shader or the drawable group if needed. */
+    UnsignedInt materialCount = 0;
+    if(topLevelChanged) for(UnsignedInt i = 0; i != _data->materialHashes.size(); ++i) {
+        Utility::Sha1::Digest hash;
+        Containers::Optional<Trade::PhongMaterialData> material = loadMaterial(importer, i, hash);
+        if(hash == _data->materialHashes[i]) continue;
+
+        /* If the material failed to import either now or before, the objects
+           using it have a default material and thus a different drawable
+           setup */
+        if(!material || _data->materialHashes[i] == Utility::Sha1::Digest{}) {
+            Debug{} << "Material" << i << "failed to load now or before, reloading everything";
+            load(filename, importer, id);
+            return;
+        }
+
+        for(const MaterialDrawable& use: _data->materialDrawables[i]) {
+            const MeshInfo& mesh = _data->meshes[use.meshId];
+            Shaders::Phong::Flags flags;
+            if(mesh.hasVertexColors)
+                flags |= Shaders::Phong::Flag::VertexColor;
+            if(mesh.hasSeparateBitangents)
+                flags |= Shaders::Phong::Flag::Bitangent;
+
+            GL::Texture2D* diffuseTexture = nullptr;
+            GL::Texture2D* normalTexture = nullptr;
+            Float normalTextureScale = 1.0f;
+            flags = setupMaterial(*material, mesh, flags, diffuseTexture, normalTexture, normalTextureScale);
+
+            use.drawable->setShader(phongShader(flags));
+            use.drawable->setMaterial(material->diffuseColor(), diffuseTexture, normalTexture, normalTextureScale, material->alphaMask(), material->commonTextureMatrix());
+            (material->alphaMode() == Trade::MaterialAlphaMode::Blend ?
+                _data->transparentDrawables : _data->opaqueDrawables).add(*use.drawable);
+        }
+
+        _data->materialHashes[i] = hash;
+        ++materialCount;
+    }
+
+    /* Newly created shaders need light colors set up */
+    if(materialCount) updateLightColorBrightness();
+
+    /* Batches contain copies of the meshes and are grouped by material */
+    if(_staticBatching && (meshCount || materialCount)) buildStaticBatches();
+
+    Debug{} << "Reloaded" << textureCount << "textures," << meshCount << "meshes and" << materialCount << "materials";
+}
+
+Shaders::Phong::Flags ScenePlayer::setupMaterial(const Trade::PhongMaterialData& material, const MeshInfo& mesh, Shaders::Phong::Flags flags, GL::Texture2D*& diffuseTexture, GL::Texture2D*& normalTexture, Float& normalTextureScale) {
+    /* Textured material. If the texture failed to load, again just use
+       a default-colored material. */
+    if(material.hasAttribute(Trade::MaterialAttribute::DiffuseTexture)) {
+        Containers::Optional<GL::Texture2D>& texture = _data->textures[material.diffuseTexture()];
+        if(texture) {
+            diffuseTexture = &*texture;
+            flags |= Shaders::Phong::Flag::AmbientTexture|
+                Shaders::Phong::Flag::DiffuseTexture;
+            if(material.hasTextureTransformation())
+                flags |= Shaders::Phong::Flag::TextureTransformation;
+            if(material.alphaMode() == Trade::MaterialAlphaMode::Mask)
+                flags |= Shaders::Phong::Flag::AlphaMask;
+        }
+    }
+
+    /* Normal textured material. If the textures fail to load, again
+       just use a default-colored material. */
+    if(material.hasAttribute(Trade::MaterialAttribute::NormalTexture)) {
+        Containers::Optional<GL::Texture2D>& texture = _data->textures[material.normalTexture()];
+        /* If there are no tangents, the mesh would render all black.
+           Ignore the normal map in that case. */
+        /** @todo generate tangents instead once we have the algo */
+        if(!mesh.hasTangents) {
+            Warning{} << "Mesh" << mesh.name << "doesn't have tangents and Magnum can't generate them yet, ignoring a normal map";
+        } else if(texture) {
+            normalTexture = &*texture;
+            normalTextureScale = material.normalTextureScale();
+            flags |= Shaders::Phong::Flag::NormalTexture;
+            if(material.hasTextureTransformation())
+                flags |= Shaders::Phong::Flag::TextureTransformation;
+        }
+    }
+
+    return flags;
+}
+
+void ScenePlayer::addObject(Containers::ArrayView<const Containers::Pointer<Trade::ObjectData3D>> objects, Containers::ArrayView<const Containers::Optional<Trade::PhongMaterialData>> materials, Object3D& parent, UnsignedInt i) {
     /* Object failed to import, skip */
     if(!objects[i]) return;
 
@@ -1253,10 +2677,15 @@ void ScenePlayer::addObject(Containers::ArrayView<const Containers::Pointer<Trad
            selection */
         _data->objects[i].meshId = objectData.instance();
 
-        GL::Mesh& mesh = *_data->meshes[objectData.instance()].mesh;
+        /* Skinned meshes get their own copy with vertices in world space,
+           so the drawable is attached to the scene root instead. These are
+           not occlusion-culled as the bounds are for the bind pose. */
+        SkinnedInstance* const skinned = addSkinnedInstance(objectData.instance(), static_cast<const Trade::MeshObjectData3D&>(objectData).skin());
+        GL::Mesh& mesh = skinned ? skinned->mesh : *_data->meshes[objectData.instance()].mesh;
+        Object3D& drawableObject = skinned ? _data->scene : *object;
 
         Shaders::Phong::Flags flags;
-        if(hasVertexColors[objectData.instance()])
+        if(_data->meshes[objectData.instance()].hasVertexColors)
             flags |= Shaders::Phong::Flag::VertexColor;
         if(_data->meshes[objectData.instance()].hasSeparateBitangents)
             flags |= Shaders::Phong::Flag::Bitangent;
@@ -1265,61 +2694,37 @@ void ScenePlayer::addObject(Containers::ArrayView<const Containers::Pointer<Trad
            use that, otherwise apply a default material; use a flat shader for
            lines / points */
         if(materialId == -1 || !materials[materialId]) {
+            SceneGraph::Drawable3D* drawable;
             if(mesh.primitive() == GL::MeshPrimitive::Triangles ||
                mesh.primitive() == GL::MeshPrimitive::TriangleStrip ||
                mesh.primitive() == GL::MeshPrimitive::TriangleFan)
-                new PhongDrawable{*object, phongShader(flags),
+                drawable = new PhongDrawable{drawableObject, phongShader(flags),
                     mesh, i,
                     0xffffff_rgbf, _shadeless, _data->opaqueDrawables};
             else
-                new FlatDrawable{*object, flatShader(hasVertexColors[objectData.instance()] ? Shaders::Flat3D::Flag::VertexColor : Shaders::Flat3D::Flags{}), mesh, i, 0xffffff_rgbf, Vector3{Constants::nan()}, _data->opaqueDrawables};
+                drawable = new FlatDrawable{drawableObject, flatShader(_data->meshes[objectData.instance()].hasVertexColors ? Shaders::Flat3D::Flag::VertexColor : Shaders::Flat3D::Flags{}), mesh, i, 0xffffff_rgbf, Vector3{Constants::nan()}, _data->opaqueDrawables};
+            if(!skinned) _data->drawableMeshes.emplace(drawable, objectData.instance());
 
         /* Material available */
         } else {
             const Trade::PhongMaterialData& material = *materials[materialId];
 
-            /* Textured material. If the texture failed to load, again just use
-               a default-colored material. */
             GL::Texture2D* diffuseTexture = nullptr;
             GL::Texture2D* normalTexture = nullptr;
             Float normalTextureScale = 1.0f;
-            if(material.hasAttribute(Trade::MaterialAttribute::DiffuseTexture)) {
-                Containers::Optional<GL::Texture2D>& texture = _data->textures[material.diffuseTexture()];
-                if(texture) {
-                    diffuseTexture = &*texture;
-                    flags |= Shaders::Phong::Flag::AmbientTexture|
-                        Shaders::Phong::Flag::DiffuseTexture;
-                    if(material.hasTextureTransformation())
-                        flags |= Shaders::Phong::Flag::TextureTransformation;
-                    if(material.alphaMode() == Trade::MaterialAlphaMode::Mask)
-                        flags |= Shaders::Phong::Flag::AlphaMask;
-                }
-            }
+            flags = setupMaterial(material, _data->meshes[objectData.instance()], flags, diffuseTexture, normalTexture, normalTextureScale);
 
-            /* Normal textured material. If the textures fail to load, again
-               just use a default-colored material. */
-            if(material.hasAttribute(Trade::MaterialAttribute::NormalTexture)) {
-                Containers::Optional<GL::Texture2D>& texture = _data->textures[material.normalTexture()];
-                /* If there are no tangents, the mesh would render all black.
-                   Ignore the normal map in that case. */
-                /** @todo generate tangents instead once we have the algo */
-                if(!_data->meshes[objectData.instance()].hasTangents) {
-                    Warning{} << "Mesh" << _data->meshes[objectData.instance()].name << "doesn't have tangents and Magnum can't generate them yet, ignoring a normal map";
-                } else if(texture) {
-                    normalTexture = &*texture;
-                    normalTextureScale = material.normalTextureScale();
-                    flags |= Shaders::Phong::Flag::NormalTexture;
-                    if(material.hasTextureTransformation())
-                        flags |= Shaders::Phong::Flag::TextureTransformation;
-                }
-            }
-
-            new PhongDrawable{*object, phongShader(flags),
+            auto* drawable = new PhongDrawable{drawableObject, phongShader(flags),
                 mesh, i,
                 material.diffuseColor(), diffuseTexture, normalTexture, normalTextureScale,
                 material.alphaMask(), material.commonTextureMatrix(), _shadeless,
                 material.alphaMode() == Trade::MaterialAlphaMode::Blend ?
                     _data->transparentDrawables : _data->opaqueDrawables};
+
+            /* Remember the drawable so it can be updated when the material
+               changes on reload */
+            arrayAppend(_data->materialDrawables[materialId], MaterialDrawable{drawable, UnsignedInt(objectData.instance())});
+            if(!skinned) _data->drawableMeshes.emplace(drawable, objectData.instance());
         }
 
     /* Light */
@@ -1390,7 +2795,21 @@ void ScenePlayer::addObject(Containers::ArrayView<const Containers::Pointer<Trad
         addObject(objects, materials, hasVertexColors, *object, id);
 }
 
-void FlatDrawable::draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) {
+void FlatDrawable::drawSorted(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera, DrawState& state) {
+    ++state.drawCount;
+    ++state.objectCount;
+    if(state.shader != &_shader) {
+        ++state.shaderChanges;
+        state.shader = &_shader;
+        state.hasMaterial = false;
+    }
+    if(!state.hasMaterial || state.color != _color) {
+        ++state.materialChanges;
+        state.hasMaterial = true;
+        state.color = _color;
+        _shader.setColor(_color);
+    }
+
     /* Override the inherited scale, if requested */
     Matrix4 transformation;
     if(_scale == _scale) transformation =
@@ -1399,39 +2818,103 @@ void FlatDrawable::draw(const Matrix4& transformationMatrix, SceneGraph::Camera3
     else transformation = transformationMatrix;
 
     _shader
-        .setColor(_color)
         .setTransformationProjectionMatrix(camera.projectionMatrix()*transformation)
         .setObjectId(_objectId)
         .draw(_mesh);
 }
 
-void PhongDrawable::draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) {
-    _shader
+void PhongDrawable::drawSorted(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera, DrawState& state) {
+    Shaders::Phong& shader = *_shader;
+    setupState(shader, camera, state);
+    ++state.drawCount;
+    ++state.objectCount;
+
+    shader
         .setTransformationMatrix(transformationMatrix)
         .setNormalMatrix(transformationMatrix.normalMatrix())
-        .setProjectionMatrix(camera.projectionMatrix())
-        .setObjectId(_objectId);
+        .setObjectId(_objectId)
+        .draw(_mesh);
+}
 
-    if(_diffuseTexture) _shader
-        .bindAmbientTexture(*_diffuseTexture)
-        .bindDiffuseTexture(*_diffuseTexture);
-    if(_normalTexture) _shader
-        .bindNormalTexture(*_normalTexture)
-        .setNormalTextureScale(_normalTextureScale);
+#ifndef MAGNUM_TARGET_GLES
+void PhongDrawable::drawInstanced(Shaders::Phong& shader, SceneGraph::Camera3D& camera, DrawState& state, const UnsignedInt baseInstance, const UnsignedInt instanceCount) {
+    setupState(shader, camera, state);
+    ++state.drawCount;
+    state.objectCount += instanceCount;
+
+    /* The instanced transformations are already relative to the camera. The
+       mesh is drawn non-instanced everywhere else, so reset it back after. */
+    _mesh
+        .setInstanceCount(instanceCount)
+        .setBaseInstance(baseInstance);
+    shader
+        .setTransformationMatrix({})
+        .setNormalMatrix({})
+        .draw(_mesh);
+    _mesh
+        .setInstanceCount(1)
+        .setBaseInstance(0);
+}
+#endif
 
-    if(_shadeless) _shader
-        .setAmbientColor(_color)
-        .setDiffuseColor(0x00000000_rgbaf);
-    else _shader
-        .setAmbientColor(_color*0.06f)
-        .setDiffuseColor(_color);
+void PhongDrawable::drawBatch(const Containers::ArrayView<const Containers::Reference<GL::MeshView>> views, SceneGraph::Camera3D& camera, DrawState& state) {
+    Shaders::Phong& shader = *_shader;
+    setupState(shader, camera, state);
+    ++state.drawCount;
+    state.objectCount += views.size();
 
-    if(_shader.flags() & Shaders::Phong::Flag::TextureTransformation)
-        _shader.setTextureMatrix(_textureMatrix);
-    if(_shader.flags() & Shaders::Phong::Flag::AlphaMask)
-        _shader.setAlphaMask(_alphaMask);
+    shader
+        .setTransformationMatrix(camera.cameraMatrix())
+        .setNormalMatrix(camera.cameraMatrix().normalMatrix())
+        .draw(views);
+}
 
-    _shader.draw(_mesh);
+void PhongDrawable::setupState(Shaders::Phong& shader, SceneGraph::Camera3D& camera, DrawState& state) {
+    /* The material uniforms in a newly used shader are from a different
+       draw, set them all again. Texture bindings are not per-shader. */
+    if(state.shader != &shader) {
+        ++state.shaderChanges;
+        state.shader = &shader;
+        state.hasMaterial = false;
+        shader.setProjectionMatrix(camera.projectionMatrix());
+    }
+
+    if(_diffuseTexture && _diffuseTexture != state.diffuseTexture) {
+        ++state.textureChanges;
+        state.diffuseTexture = _diffuseTexture;
+        shader
+            .bindAmbientTexture(*_diffuseTexture)
+            .bindDiffuseTexture(*_diffuseTexture);
+    }
+    if(_normalTexture && _normalTexture != state.normalTexture) {
+        ++state.textureChanges;
+        state.normalTexture = _normalTexture;
+        shader.bindNormalTexture(*_normalTexture);
+    }
+
+    if(!state.hasMaterial || state.color != _color || state.normalTextureScale != _normalTextureScale || state.alphaMask != _alphaMask || state.textureMatrix != _textureMatrix) {
+        ++state.materialChanges;
+        state.hasMaterial = true;
+        state.color = _color;
+        state.normalTextureScale = _normalTextureScale;
+        state.alphaMask = _alphaMask;
+        state.textureMatrix = _textureMatrix;
+
+        if(_normalTexture)
+            shader.setNormalTextureScale(_normalTextureScale);
+
+        if(_shadeless) shader
+            .setAmbientColor(_color)
+            .setDiffuseColor(0x00000000_rgbaf);
+        else shader
+            .setAmbientColor(_color*0.06f)
+            .setDiffuseColor(_color);
+
+        if(shader.flags() & Shaders::Phong::Flag::TextureTransformation)
+            shader.setTextureMatrix(_textureMatrix);
+        if(shader.flags() & Shaders::Phong::Flag::AlphaMask)
+            shader.setAlphaMask(_alphaMask);
+    }
 }
 
 void MeshVisualizerDrawable::draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) {
@@ -1474,33 +2957,82 @@ void MeshVisualizerDrawable::draw(const Matrix4& transformationMatrix, SceneGrap
 
 void ScenePlayer::drawEvent() {
     _profiler.beginFrame();
-
-    /* Another FB could be bound from a depth / object ID read (moreover with
-       color output disabled), set it back to the default framebuffer */
-    GL::defaultFramebuffer.bind(); /** @todo mapForDraw() should bind implicitly */
-    GL::defaultFramebuffer
-        .mapForDraw({{Shaders::Phong::ColorOutput, GL::DefaultFramebuffer::DrawAttachment::Back}})
-        .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+    _interactionProfiler.beginFrame();
+
+    /* While the camera is being moved and the frames take longer than the
+       target, render to a smaller non-multisampled framebuffer and upscale
+       it. A full-quality frame gets drawn once the interaction stops. */
+    const bool interacting = _interactionFrameTime > 0.0f && std::chrono::steady_clock::now() - _lastInteraction < std::chrono::milliseconds{150};
+    if(interacting) updateInteractionScale();
+    const Vector2i framebufferSize = GL::defaultFramebuffer.viewport().size();
+    if(interacting && _interactionScale < 1.0f) {
+        _interactionFrameSize = Math::max(Vector2i{Vector2{framebufferSize}*_interactionScale}, Vector2i{1});
+        _interactionFramebuffer.setViewport({{}, _interactionFrameSize});
+        _interactionFramebuffer.bind(); /** @todo mapForDraw() should bind implicitly */
+        _interactionFramebuffer
+            .mapForDraw({{Shaders::Phong::ColorOutput, GL::Framebuffer::ColorAttachment{0}}})
+            .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+    } else {
+        _interactionFrameSize = {};
+
+        /* Another FB could be bound from a depth / object ID read (moreover
+           with color output disabled), set it back to the default
+           framebuffer */
+        GL::defaultFramebuffer.bind(); /** @todo mapForDraw() should bind implicitly */
+        GL::defaultFramebuffer
+            .mapForDraw({{Shaders::Phong::ColorOutput, GL::DefaultFramebuffer::DrawAttachment::Back}})
+            .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+    }
 
     GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
 
     if(_data) {
-        _data->player.advance(std::chrono::system_clock::now().time_since_epoch());
+        {
+            TraceZone zone{_tracer, "Animation"};
+            _data->player.advance(_clock.now());
+        }
+
+        /* Update skinned meshes after the animation moved the joints */
+        if(!_data->skinnedInstances.empty()) {
+            TraceZone zone{_tracer, "Skinning"};
+            updateSkinning();
+        }
 
         /* Calculate light positions first, upload them to all shaders -- all
            of them are there only if they are actually used, so it's not doing
            any wasteful work */
-        arrayResize(_data->lightPositions, 0);
-        _data->camera->draw(_data->lightDrawables);
-        CORRADE_INTERNAL_ASSERT(_data->lightPositions.size() == _data->lightCount);
-        for(auto&& shader: _phongShaders)
-            shader.second.setLightPositions(_data->lightPositions);
+        {
+            TraceZone zone{_tracer, "Lights"};
+            arrayResize(_data->lightPositions, 0);
+            _data->camera->draw(_data->lightDrawables);
+            CORRADE_INTERNAL_ASSERT(_data->lightPositions.size() == _data->lightCount);
+            for(auto&& shader: _phongShaders)
+                shader.second.setLightPositions(_data->lightPositions);
+        }
 
-        /* Draw opaque stuff as usual */
-        _data->camera->draw(_data->opaqueDrawables);
+        /* Draw opaque stuff, skipping what's hidden behind the biggest
+           occluders if enabled. Sorted to minimize state changes, the state
+           of the previous drawable is tracked to skip setting the same
+           again, and instances of the same mesh and material are drawn
+           together if possible. */
+        {
+            TraceZone zone{_tracer, "Opaque", true};
+            std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>>
+                drawableTransformations = _data->camera->drawableTransformations(_data->opaqueDrawables);
+            if(_occlusionCulling) {
+                TraceZone cullZone{_tracer, "Occlusion culling"};
+                cullOccluded(drawableTransformations);
+            }
+            if(_sortOpaque) {
+                TraceZone sortZone{_tracer, "Sort"};
+                sortOpaque(drawableTransformations);
+            }
+            drawOpaque(drawableTransformations);
+        }
 
         /* Draw transparent stuff back-to-front with blending enabled */
         if(!_data->transparentDrawables.isEmpty()) {
+            TraceZone zone{_tracer, "Transparent", true};
             GL::Renderer::setDepthMask(false);
             GL::Renderer::enable(GL::Renderer::Feature::Blending);
             /* Ugh non-premultiplied alpha */
@@ -1541,13 +3073,39 @@ void ScenePlayer::drawEvent() {
         }
     }
 
+    /* Upscale the reduced resolution frame to the default framebuffer */
+    if(!_interactionFrameSize.isZero()) {
+        GL::defaultFramebuffer.bind(); /** @todo mapForDraw() should bind implicitly */
+        GL::defaultFramebuffer
+            .mapForDraw({{Shaders::Flat2D::ColorOutput, GL::DefaultFramebuffer::DrawAttachment::Back}})
+            .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+
+        GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+        _interactionShader
+            .setTextureMatrix(Matrix3::scaling(Vector2{_interactionFrameSize}/Vector2{framebufferSize}))
+            .bindTexture(_interactionColor)
+            .draw(_interactionQuad);
+        GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+    }
+
     /* Don't profile UI drawing */
     _profiler.endFrame();
-    _profiler.printStatistics(_profilerOut, 10);
+    if(_profiler.isEnabled() && _profiler.measuredFrameCount() % 10 == 0)
+        printProfilerStatistics();
+    _interactionProfiler.endFrame();
+
+    if(_frameChecksum && _data) printFrameChecksum();
 
     /* Draw the UI. Disable the depth buffer and enable premultiplied alpha
        blending. */
     if(_drawUi) {
+        /* Updated explicitly to see the buffer upload separately */
+        {
+            TraceZone zone{_tracer, "UI update"};
+            _ui->update();
+        }
+
+        TraceZone zone{_tracer, "UI draw", true};
         GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
         GL::Renderer::enable(GL::Renderer::Feature::Blending);
         GL::Renderer::setBlendFunction(GL::Renderer::BlendFunction::One, GL::Renderer::BlendFunction::OneMinusSourceAlpha);
@@ -1557,15 +3115,21 @@ void ScenePlayer::drawEvent() {
         GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
     }
 
-    /* Schedule a redraw only if profiling is enabled or the player is playing
-       to avoid hogging the CPU */
-    if(_profiler.isEnabled() || (_data && _data->player.state() == Animation::State::Playing))
+    /* Schedule a redraw only if profiling is enabled, the player is playing
+       or the frame was drawn at a reduced resolution and needs to be
+       refined, to avoid hogging the CPU */
+    if(_profiler.isEnabled() || (_data && _data->player.state() == Animation::State::Playing) || !_interactionFrameSize.isZero())
         redraw();
 
     #ifdef MAGNUM_TARGET_WEBGL
     /* The rendered depth buffer might get lost later, so resolve it to our
-       depth texture before swapping it to the canvas */
-    GL::Framebuffer::blit(GL::defaultFramebuffer, _depthResolveFramebuffer, GL::defaultFramebuffer.viewport(), GL::FramebufferBlit::Depth);
+       depth texture before swapping it to the canvas. For a reduced
+       resolution frame take the depth from the offscreen framebuffer,
+       upscaled. */
+    if(!_interactionFrameSize.isZero())
+        GL::Framebuffer::blit(_interactionFramebuffer, _depthResolveFramebuffer, {{}, _interactionFrameSize}, GL::defaultFramebuffer.viewport(), GL::FramebufferBlit::Depth, GL::FramebufferBlitFilter::Nearest);
+    else
+        GL::Framebuffer::blit(GL::defaultFramebuffer, _depthResolveFramebuffer, GL::defaultFramebuffer.viewport(), GL::FramebufferBlit::Depth);
     #endif
 }
 
@@ -1588,6 +3152,11 @@ void ScenePlayer::viewportEvent(ViewportEvent& event) {
     for(auto& i: _meshVisualizerShaders)
         i.second.setViewportSize(Vector2{event.framebufferSize()});
 
+    if(_interactionFrameTime > 0.0f)
+        setupInteractionFramebuffer(event.framebufferSize());
+
+    _occlusionCuller = OcclusionCuller{Math::max(event.framebufferSize()/8, Vector2i{1})};
+
     /* Recreate object ID reading renderbuffers that depend on viewport size */
     _selectionDepth = GL::Renderbuffer{};
     _selectionDepth.setStorage(GL::RenderbufferFormat::DepthComponent24, event.framebufferSize());
@@ -1624,10 +3193,17 @@ Float ScenePlayer::depthAt(const Vector2i& windowPosition) {
     const Vector2i fbPosition{position.x(), GL::defaultFramebuffer.viewport().sizeY() - position.y() - 1};
     const Range2Di area = Range2Di::fromSize(fbPosition, Vector2i{1}).padded(Vector2i{2});
 
-    /* Easy on sane platforms */
+    /* Easy on sane platforms. If the last frame was drawn at a reduced
+       resolution, the depth is in the offscreen framebuffer. */
     #ifndef MAGNUM_TARGET_WEBGL
-    GL::defaultFramebuffer.mapForRead(GL::DefaultFramebuffer::ReadAttachment::Front);
-    Image2D image = GL::defaultFramebuffer.read(area, {GL::PixelFormat::DepthComponent, GL::PixelType::Float});
+    Image2D image{PixelFormat::R32F};
+    if(!_interactionFrameSize.isZero()) {
+        const Vector2 scale = Vector2{_interactionFrameSize}/Vector2{GL::defaultFramebuffer.viewport().size()};
+        image = _interactionFramebuffer.read(Range2Di::fromSize(Vector2i{Vector2{fbPosition}*scale}, Vector2i{1}).padded(Vector2i{2}), {GL::PixelFormat::DepthComponent, GL::PixelType::Float});
+    } else {
+        GL::defaultFramebuffer.mapForRead(GL::DefaultFramebuffer::ReadAttachment::Front);
+        image = GL::defaultFramebuffer.read(area, {GL::PixelFormat::DepthComponent, GL::PixelType::Float});
+    }
 
     return Math::min<Float>(Containers::arrayCast<const Float>(image.data()));
 
@@ -1723,6 +3299,34 @@ void ScenePlayer::keyPressEvent(KeyEvent& event) {
     /* Toggle profiling */
     } else if(event.key() == KeyEvent::Key::P) {
         _profiler.isEnabled() ? _profiler.disable() : _profiler.enable();
+        _profilerLineCount = 0;
+
+        /* GL_TIME_ELAPSED queries can't be nested, so while the profiler
+           measures the GPU time, the interaction scale is calculated from
+           its measurement instead of a second query */
+        if(_interactionFrameTime > 0.0f &&
+           _interactionProfilerValue == DebugTools::GLFrameProfiler::Value::GpuDuration &&
+           _profiler.values() & DebugTools::GLFrameProfiler::Value::GpuDuration)
+            _profiler.isEnabled() ? _interactionProfiler.disable() : _interactionProfiler.enable();
+
+    /* Toggle occlusion culling */
+    } else if(event.key() == KeyEvent::Key::O) {
+        _occlusionCulling = !_occlusionCulling;
+        Debug{} << "Occlusion culling" << (_occlusionCulling ? "enabled" : "disabled");
+
+    /* Toggle state-sorted drawing */
+    } else if(event.key() == KeyEvent::Key::S) {
+        _sortOpaque = !_sortOpaque;
+        Debug{} << "Sorting of opaque drawables" << (_sortOpaque ? "enabled" : "disabled");
+
+    /* Toggle instanced drawing */
+    } else if(event.key() == KeyEvent::Key::I) {
+        if(!_instancingSupported) {
+            Debug{} << "Instanced drawing is not supported";
+            return;
+        }
+        _instancedDrawing = !_instancedDrawing;
+        Debug{} << "Instanced drawing" << (_instancedDrawing ? "enabled" : "disabled");
 
     } else return;
 
@@ -1739,6 +3343,7 @@ void ScenePlayer::mousePressEvent(MouseEvent& event) {
 
     /* RMB to select */
     if(event.button() == MouseEvent::Button::Right && _data) {
+        TraceZone zone{_tracer, "Selection", true};
         _selectionFramebuffer.bind(); /** @todo mapForDraw() should bind implicitly */
         _selectionFramebuffer.mapForDraw({
                 {Shaders::Generic3D::ColorOutput, GL::Framebuffer::DrawAttachment::None},
@@ -1939,6 +3544,7 @@ void ScenePlayer::mouseMoveEvent(MouseMoveEvent& event) {
             .rotateLocal(r);
     }
 
+    _lastInteraction = std::chrono::steady_clock::now();
     redraw();
 }
 
@@ -1970,14 +3576,15 @@ void ScenePlayer::mouseScrollEvent(MouseScrollEvent& event) {
     _data->cameraObject->translateLocal(
         _data->cameraObject->rotation().transformVector(_rotationPoint*event.offset().y()*0.1f));
 
+    _lastInteraction = std::chrono::steady_clock::now();
     event.setAccepted();
     redraw();
 }
 
 }
 
-Containers::Pointer<AbstractPlayer> createScenePlayer(Platform::ScreenedApplication& application, Ui::UserInterface& uiToStealFontFrom, const DebugTools::GLFrameProfiler::Values profilerValues, bool& drawUi) {
-    return Containers::Pointer<ScenePlayer>{Containers::InPlaceInit, application, uiToStealFontFrom, profilerValues, drawUi};
+Containers::Pointer<AbstractPlayer> createScenePlayer(Platform::ScreenedApplication& application, Ui::UserInterface& uiToStealFontFrom, const DebugTools::GLFrameProfiler::Values profilerValues, const Float interactionFrameTime, const bool staticBatching, const bool compressTextures, const bool frameChecksum, bool& drawUi, const FrameClock& clock, FileTracker* fileTracker, TextureCache* textureCache, TextureDecoder* textureDecoder, Tracer* tracer) {
+    return Containers::Pointer<ScenePlayer>{Containers::InPlaceInit, application, uiToStealFontFrom, profilerValues, interactionFrameTime, staticBatching, compressTextures, frameChecksum, drawUi, clock, fileTracker, textureCache, textureDecoder, tracer};
 }
 
 }}
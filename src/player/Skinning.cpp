@@ -0,0 +1,139 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Skinning.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Matrix4.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include "WorkerPool.h"
+#endif
+
+namespace Magnum { namespace Player {
+
+SkinPalette::SkinPalette() {
+    arrayAppend(_offsets, std::size_t{0});
+}
+
+UnsignedInt SkinPalette::addSkin(const Containers::ArrayView<const Matrix4> inverseBindMatrices) {
+    arrayAppend(_inverseBindMatrices, inverseBindMatrices);
+    arrayResize(_jointMatrices, _inverseBindMatrices.size());
+    arrayAppend(_offsets, _inverseBindMatrices.size());
+    return _offsets.size() - 2;
+}
+
+std::size_t SkinPalette::jointOffset(const UnsignedInt skin) const {
+    CORRADE_ASSERT(skin < skinCount(),
+        "Player::SkinPalette::jointOffset(): index" << skin << "out of range for" << skinCount() << "skins", {});
+    return _offsets[skin];
+}
+
+Containers::ArrayView<const Matrix4> SkinPalette::jointMatrices(const UnsignedInt skin) const {
+    CORRADE_ASSERT(skin < skinCount(),
+        "Player::SkinPalette::jointMatrices(): index" << skin << "out of range for" << skinCount() << "skins", {});
+    return _jointMatrices.slice(_offsets[skin], _offsets[skin + 1]);
+}
+
+void SkinPalette::update(const Containers::ArrayView<const Matrix4> jointTransformations, WorkerPool* const pool) {
+    CORRADE_ASSERT(jointTransformations.size() == _jointMatrices.size(),
+        "Player::SkinPalette::update(): expected" << _jointMatrices.size() << "transformations but got" << jointTransformations.size(), );
+
+    /* Skins are independent, so each chunk of skins can go to a separate
+       thread. A single skin has at most a few hundred joints, so it's not
+       worth splitting further. */
+    parallelFor(pool, skinCount(), 16, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = _offsets[begin], iMax = _offsets[end]; i != iMax; ++i)
+            _jointMatrices[i] = jointTransformations[i]*_inverseBindMatrices[i];
+    });
+}
+
+void skinVertices(const Containers::ArrayView<const Matrix4> jointMatrices, const Containers::StridedArrayView1D<const Vector4ui>& jointIds, const Containers::StridedArrayView1D<const Vector4>& weights, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<Vector3>& skinnedPositions, const Containers::StridedArrayView1D<Vector3>& skinnedNormals) {
+    CORRADE_ASSERT(jointIds.size() == positions.size() && weights.size() == positions.size() && skinnedPositions.size() == positions.size(),
+        "Player::skinVertices(): expected" << positions.size() << "joint IDs, weights and output positions but got" << jointIds.size() << Debug::nospace << "," << weights.size() << "and" << skinnedPositions.size(), );
+    CORRADE_ASSERT(normals.size() == skinnedNormals.size() && (normals.empty() || normals.size() == positions.size()),
+        "Player::skinVertices(): expected either no normals or" << positions.size() << "normals and output normals but got" << normals.size() << "and" << skinnedNormals.size(), );
+
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        const Vector4ui& ids = jointIds[i];
+        const Vector4& w = weights[i];
+        #ifndef CORRADE_NO_ASSERT
+        for(std::size_t j = 0; j != 4; ++j)
+            CORRADE_ASSERT(ids[j] < jointMatrices.size() || w[j] == 0.0f,
+                "Player::skinVertices(): joint ID" << ids[j] << "out of range for" << jointMatrices.size() << "joints", );
+        #endif
+
+        /* Blend the matrices first, it's cheaper than transforming the
+           position and normal four times. Joints with a zero weight can
+           point anywhere, so they're skipped instead of being multiplied by
+           zero. The sixteen elements are contiguous, which makes the inner
+           loop a few SIMD multiply-adds. */
+        Matrix4 matrix{Math::ZeroInit};
+        Float* blended = matrix.data();
+        for(std::size_t j = 0; j != 4; ++j) {
+            if(w[j] == 0.0f) continue;
+            const Float* joint = jointMatrices[ids[j]].data();
+            for(std::size_t k = 0; k != 16; ++k)
+                blended[k] += joint[k]*w[j];
+        }
+
+        skinnedPositions[i] = matrix.transformPoint(positions[i]);
+
+        /* Using the upper 3x3 part directly instead of its inverse transpose.
+           That's wrong for non-uniform scaling, but joints rarely have that
+           and it'd be a costly per-vertex inversion. */
+        if(!normals.empty())
+            skinnedNormals[i] = matrix.transformVector(normals[i]).normalized();
+    }
+}
+
+void parallelFor(WorkerPool* const pool, const std::size_t count, const std::size_t minChunk, const std::function<void(std::size_t, std::size_t)>& function) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const std::size_t chunkCount = pool ? Math::min(pool->workerCount(), count/Math::max(minChunk, std::size_t{1})) : 0;
+    if(chunkCount > 1) {
+        /* The calling thread does the last chunk instead of idling in
+           wait() */
+        for(std::size_t i = 0; i != chunkCount - 1; ++i) {
+            const std::size_t begin = i*count/chunkCount;
+            const std::size_t end = (i + 1)*count/chunkCount;
+            pool->submit([&function, begin, end](std::size_t) {
+                function(begin, end);
+            });
+        }
+        function((chunkCount - 1)*count/chunkCount, count);
+        pool->wait();
+        return;
+    }
+    #else
+    static_cast<void>(pool);
+    static_cast<void>(minChunk);
+    #endif
+
+    if(count) function(0, count);
+}
+
+}}
@@ -0,0 +1,88 @@
+#ifndef Magnum_Player_Skinning_h
+#define Magnum_Player_Skinning_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <functional>
+#include <Corrade/Containers/Array.h>
+#include <Magnum/Magnum.h>
+
+namespace Magnum { namespace Player {
+
+class WorkerPool;
+
+/* Joint matrix palette of all skins in a scene, stored in a single flat
+   array with the joints of each skin next to each other. Given absolute
+   joint transformations in the same layout, update() calculates the matrices
+   to be used for skinning, chunks of skins in parallel. */
+class SkinPalette {
+    public:
+        explicit SkinPalette();
+
+        /* Adds a skin with given inverse bind matrices, one for each joint.
+           Returns its ID. */
+        UnsignedInt addSkin(Containers::ArrayView<const Matrix4> inverseBindMatrices);
+
+        UnsignedInt skinCount() const { return _offsets.size() - 1; }
+
+        /* Joint count of all skins together */
+        std::size_t jointCount() const { return _jointMatrices.size(); }
+
+        /* Offset of the first joint of given skin in the flat array */
+        std::size_t jointOffset(UnsignedInt skin) const;
+
+        /* Joint matrices of given skin, calculated by the last update() */
+        Containers::ArrayView<const Matrix4> jointMatrices(UnsignedInt skin) const;
+
+        /* Multiplies absolute joint transformations with the inverse bind
+           matrices. Expects jointCount() transformations, ordered the same
+           as the skins were added. If pool is not null, chunks of skins are
+           distributed among its workers, see parallelFor(). */
+        void update(Containers::ArrayView<const Matrix4> jointTransformations, WorkerPool* pool = nullptr);
+
+    private:
+        Containers::Array<std::size_t> _offsets;
+        Containers::Array<Matrix4> _inverseBindMatrices, _jointMatrices;
+};
+
+/* Transforms positions and optionally also normals with a weighted blend of
+   up to four joint matrices. The weights are expected to be normalized, the
+   normals are renormalized after the transformation. Pass empty normal views
+   to skin just the positions. Runs through the blended matrix elements in
+   plain loops that compilers can vectorize. */
+void skinVertices(Containers::ArrayView<const Matrix4> jointMatrices, const Containers::StridedArrayView1D<const Vector4ui>& jointIds, const Containers::StridedArrayView1D<const Vector4>& weights, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<Vector3>& skinnedPositions, const Containers::StridedArrayView1D<Vector3>& skinnedNormals);
+
+/* Splits the [0, count) range into contiguous chunks of at least minChunk
+   items, one for each worker of the pool, and calls the function for each,
+   with the calling thread taking the last chunk. Blocks until all are done,
+   which means waiting for all jobs in the pool, so it shouldn't be shared
+   with unrelated work running at the same time. Runs on the calling thread
+   only if the pool is null, there isn't enough work or on Emscripten, which
+   is built without thread support. */
+void parallelFor(WorkerPool* pool, std::size_t count, std::size_t minChunk, const std::function<void(std::size_t, std::size_t)>& function);
+
+}}
+
+#endif
@@ -0,0 +1,290 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Math/Color.h>
+
+#include "../BlockCompression.h"
+
+namespace Magnum { namespace Player { namespace Test { namespace {
+
+struct BlockCompressionTest: TestSuite::Tester {
+    explicit BlockCompressionTest();
+
+    void compressible();
+    void compressedFormat();
+    void compressedDataSize();
+
+    void generateMips();
+    void generateMipsRgb();
+
+    void compressSolid();
+    void compressSolidAlpha();
+    void compressTwoColors();
+    void compressFlippedDiagonal();
+    void compressAlphaGradient();
+    void compressEdge();
+    void compressBlockRows();
+};
+
+using namespace Math::Literals;
+
+BlockCompressionTest::BlockCompressionTest() {
+    addTests({&BlockCompressionTest::compressible,
+              &BlockCompressionTest::compressedFormat,
+              &BlockCompressionTest::compressedDataSize,
+
+              &BlockCompressionTest::generateMips,
+              &BlockCompressionTest::generateMipsRgb,
+
+              &BlockCompressionTest::compressSolid,
+              &BlockCompressionTest::compressSolidAlpha,
+              &BlockCompressionTest::compressTwoColors,
+              &BlockCompressionTest::compressFlippedDiagonal,
+              &BlockCompressionTest::compressAlphaGradient,
+              &BlockCompressionTest::compressEdge,
+              &BlockCompressionTest::compressBlockRows});
+}
+
+Vector3i unpackRgb565(const UnsignedShort color) {
+    const Int r = color >> 11, g = (color >> 5) & 0x3f, b = color & 0x1f;
+    return {r << 3|r >> 2, g << 2|g >> 4, b << 3|b >> 2};
+}
+
+/* Reference decoder for a single texel */
+Color4ub decode(const Containers::ArrayView<const char> data, const CompressedPixelFormat format, const Vector2i& size, const Vector2i& position) {
+    const bool bc3 = format == CompressedPixelFormat::Bc3RGBAUnorm;
+    const std::size_t blockIndex = (position.y()/4)*((size.x() + 3)/4) + position.x()/4;
+    const UnsignedByte* block = reinterpret_cast<const UnsignedByte*>(data.data()) + blockIndex*(bc3 ? 16 : 8);
+    const std::size_t texel = (position.y() % 4)*4 + position.x() % 4;
+
+    Int alpha = 255;
+    if(bc3) {
+        const Int a0 = block[0], a1 = block[1];
+        UnsignedLong bits = 0;
+        for(std::size_t i = 0; i != 6; ++i)
+            bits |= UnsignedLong(block[2 + i]) << 8*i;
+        const Int index = (bits >> 3*texel) & 7;
+        if(index == 0) alpha = a0;
+        else if(index == 1) alpha = a1;
+        else if(a0 > a1) alpha = ((8 - index)*a0 + (index - 1)*a1)/7;
+        else if(index == 6) alpha = 0;
+        else if(index == 7) alpha = 255;
+        else alpha = ((6 - index)*a0 + (index - 1)*a1)/5;
+        block += 8;
+    }
+
+    const UnsignedShort c0 = block[0]|block[1] << 8;
+    const UnsignedShort c1 = block[2]|block[3] << 8;
+    const UnsignedInt indices = block[4]|block[5] << 8|block[6] << 16|UnsignedInt(block[7]) << 24;
+    const UnsignedInt index = (indices >> 2*texel) & 3;
+    const Vector3i a = unpackRgb565(c0), b = unpackRgb565(c1);
+    Vector3i color;
+    if(index == 0) color = a;
+    else if(index == 1) color = b;
+    else if(c0 > c1 || bc3) color = index == 2 ? (a*2 + b)/3 : (a + b*2)/3;
+    else color = index == 2 ? (a + b)/2 : Vector3i{};
+    return Color4ub{Vector4i{color, alpha}};
+}
+
+/* Largest per-channel difference between the original and decoded image */
+Int maxError(const ImageView2D& image, const Containers::ArrayView<const char> data, const CompressedPixelFormat format) {
+    const Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    Int error = 0;
+    for(Int y = 0; y != image.size().y(); ++y) {
+        for(Int x = 0; x != image.size().x(); ++x) {
+            const Vector4i difference = Math::abs(Vector4i{pixels[y][x]} - Vector4i{decode(data, format, image.size(), {x, y})});
+            error = Math::max(error, difference.max());
+        }
+    }
+    return error;
+}
+
+Containers::Array<char> compress(const ImageView2D& image, const CompressedPixelFormat format) {
+    Containers::Array<char> out{Containers::ValueInit, Player::compressedDataSize(image.size(), format)};
+    compressBlocks(image, format, 0, (image.size().y() + 3)/4, out);
+    return out;
+}
+
+void BlockCompressionTest::compressible() {
+    CORRADE_VERIFY(isBlockCompressible(PixelFormat::RGBA8Unorm));
+    CORRADE_VERIFY(isBlockCompressible(PixelFormat::RGB8Unorm));
+    CORRADE_VERIFY(!isBlockCompressible(PixelFormat::RGBA8Srgb));
+    CORRADE_VERIFY(!isBlockCompressible(PixelFormat::R8Unorm));
+    CORRADE_VERIFY(!isBlockCompressible(PixelFormat::RGBA16F));
+}
+
+void BlockCompressionTest::compressedFormat() {
+    const Color3ub rgb[]{0x336699_rgb, 0x000000_rgb, 0xffffff_rgb, 0x112233_rgb};
+    Color4ub rgba[]{0x336699ff_rgba, 0x000000ff_rgba, 0xffffffff_rgba, 0x112233ff_rgba};
+
+    CORRADE_COMPARE(blockCompressedFormat(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, rgb}), CompressedPixelFormat::Bc1RGBUnorm);
+    CORRADE_COMPARE(blockCompressedFormat(ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, rgba}), CompressedPixelFormat::Bc1RGBUnorm);
+
+    /* A single translucent texel is enough to need BC3 */
+    rgba[3].a() = 254;
+    CORRADE_COMPARE(blockCompressedFormat(ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, rgba}), CompressedPixelFormat::Bc3RGBAUnorm);
+}
+
+void BlockCompressionTest::compressedDataSize() {
+    CORRADE_COMPARE(Player::compressedDataSize({8, 4}, CompressedPixelFormat::Bc1RGBUnorm), 16);
+    CORRADE_COMPARE(Player::compressedDataSize({8, 4}, CompressedPixelFormat::Bc3RGBAUnorm), 32);
+    /* Partial blocks count as whole */
+    CORRADE_COMPARE(Player::compressedDataSize({5, 3}, CompressedPixelFormat::Bc1RGBUnorm), 16);
+    CORRADE_COMPARE(Player::compressedDataSize({1, 1}, CompressedPixelFormat::Bc3RGBAUnorm), 16);
+}
+
+void BlockCompressionTest::generateMips() {
+    Color4ub data[15];
+    for(std::size_t y = 0; y != 3; ++y)
+        for(std::size_t x = 0; x != 5; ++x)
+            data[y*5 + x] = Color4ub(x*10 + y*100, 20, 30, 40);
+
+    std::vector<Image2D> levels = Player::generateMips(ImageView2D{PixelFormat::RGBA8Unorm, {5, 3}, data});
+    CORRADE_COMPARE(levels.size(), 3);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{5, 3}));
+    CORRADE_COMPARE(levels[1].size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(levels[2].size(), (Vector2i{1, 1}));
+    for(const Image2D& level: levels)
+        CORRADE_COMPARE(level.format(), PixelFormat::RGBA8Unorm);
+
+    /* First level is a copy, the others average 2x2 texels with the odd last
+       row and column dropped */
+    CORRADE_COMPARE(levels[0].pixels<Color4ub>()[2][4], Color4ub(240, 20, 30, 40));
+    CORRADE_COMPARE(levels[1].pixels<Color4ub>()[0][0], Color4ub(55, 20, 30, 40));
+    CORRADE_COMPARE(levels[1].pixels<Color4ub>()[0][1], Color4ub(75, 20, 30, 40));
+    CORRADE_COMPARE(levels[2].pixels<Color4ub>()[0][0], Color4ub(65, 20, 30, 40));
+}
+
+void BlockCompressionTest::generateMipsRgb() {
+    const Color3ub data[]{0x336699_rgb, 0x336699_rgb, 0x336699_rgb, 0x336699_rgb};
+
+    /* RGB gets converted to opaque RGBA */
+    std::vector<Image2D> levels = Player::generateMips(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, data});
+    CORRADE_COMPARE(levels.size(), 2);
+    CORRADE_COMPARE(levels[0].pixels<Color4ub>()[1][1], 0x336699ff_rgba);
+    CORRADE_COMPARE(levels[1].pixels<Color4ub>()[0][0], 0x336699ff_rgba);
+}
+
+void BlockCompressionTest::compressSolid() {
+    Color4ub data[16];
+    for(Color4ub& i: data) i = 0x336699ff_rgba;
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {4, 4}, data};
+
+    /* The color gets quantized to RGB565 and expanded back */
+    Containers::Array<char> out = compress(image, CompressedPixelFormat::Bc1RGBUnorm);
+    CORRADE_COMPARE(out.size(), 8);
+    for(Int i = 0; i != 16; ++i)
+        CORRADE_COMPARE(decode(out, CompressedPixelFormat::Bc1RGBUnorm, {4, 4}, {i % 4, i/4}), (Color4ub{49, 101, 156, 255}));
+}
+
+void BlockCompressionTest::compressSolidAlpha() {
+    Color4ub data[16];
+    for(Color4ub& i: data) i = 0x33669980_rgba;
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {4, 4}, data};
+
+    /* Alpha is preserved exactly */
+    Containers::Array<char> out = compress(image, CompressedPixelFormat::Bc3RGBAUnorm);
+    CORRADE_COMPARE(out.size(), 16);
+    for(Int i = 0; i != 16; ++i)
+        CORRADE_COMPARE(decode(out, CompressedPixelFormat::Bc3RGBAUnorm, {4, 4}, {i % 4, i/4}), (Color4ub{49, 101, 156, 0x80}));
+}
+
+void BlockCompressionTest::compressTwoColors() {
+    Color4ub data[16];
+    for(std::size_t i = 0; i != 16; ++i)
+        data[i] = (i + i/4) % 2 ? 0xffffffff_rgba : 0x000000ff_rgba;
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {4, 4}, data};
+
+    /* The inset endpoints are 15 values away from the extremes, plus the
+       RGB565 quantization */
+    Containers::Array<char> out = compress(image, CompressedPixelFormat::Bc1RGBUnorm);
+    CORRADE_COMPARE_AS(maxError(image, out, CompressedPixelFormat::Bc1RGBUnorm), 16, TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE(decode(out, CompressedPixelFormat::Bc1RGBUnorm, {4, 4}, {0, 0}).r(), 16);
+    CORRADE_COMPARE(decode(out, CompressedPixelFormat::Bc1RGBUnorm, {4, 4}, {1, 0}).r(), 239);
+}
+
+void BlockCompressionTest::compressFlippedDiagonal() {
+    /* Red goes up while green goes down. Without flipping the bounding box
+       diagonal the endpoints would be dark and yellow and the error would be
+       over 100. */
+    Color4ub data[16];
+    for(std::size_t i = 0; i != 16; ++i)
+        data[i] = Color4ub(i*16, 255 - i*16, 0, 255);
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {4, 4}, data};
+
+    Containers::Array<char> out = compress(image, CompressedPixelFormat::Bc1RGBUnorm);
+    CORRADE_COMPARE_AS(maxError(image, out, CompressedPixelFormat::Bc1RGBUnorm), 48, TestSuite::Compare::LessOrEqual);
+}
+
+void BlockCompressionTest::compressAlphaGradient() {
+    Color4ub data[16];
+    for(std::size_t i = 0; i != 16; ++i)
+        data[i] = Color4ub(0x33, 0x66, 0x99, i*17);
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {4, 4}, data};
+
+    /* Eight alpha values spread over the whole range, the extremes are
+       exact */
+    Containers::Array<char> out = compress(image, CompressedPixelFormat::Bc3RGBAUnorm);
+    CORRADE_COMPARE(decode(out, CompressedPixelFormat::Bc3RGBAUnorm, {4, 4}, {0, 0}).a(), 0);
+    CORRADE_COMPARE(decode(out, CompressedPixelFormat::Bc3RGBAUnorm, {4, 4}, {3, 3}).a(), 255);
+    CORRADE_COMPARE_AS(maxError(image, out, CompressedPixelFormat::Bc3RGBAUnorm), 19, TestSuite::Compare::LessOrEqual);
+}
+
+void BlockCompressionTest::compressEdge() {
+    /* The partial blocks repeat the edge texels, so a single color stays a
+       single color */
+    Color4ub data[15];
+    for(Color4ub& i: data) i = 0x336699ff_rgba;
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {5, 3}, data};
+
+    Containers::Array<char> out = compress(image, CompressedPixelFormat::Bc1RGBUnorm);
+    CORRADE_COMPARE(out.size(), 16);
+    CORRADE_COMPARE(decode(out, CompressedPixelFormat::Bc1RGBUnorm, {5, 3}, {4, 2}), (Color4ub{49, 101, 156, 255}));
+    CORRADE_COMPARE(decode(out, CompressedPixelFormat::Bc1RGBUnorm, {5, 3}, {7, 3}), (Color4ub{49, 101, 156, 255}));
+}
+
+void BlockCompressionTest::compressBlockRows() {
+    Color4ub data[64];
+    for(std::size_t i = 0; i != 64; ++i)
+        data[i] = Color4ub(i*4, 255 - i*3, i*i % 256, 128 + i);
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {8, 8}, data};
+
+    /* Compressing the rows separately gives the same result as at once */
+    Containers::Array<char> all = compress(image, CompressedPixelFormat::Bc3RGBAUnorm);
+    Containers::Array<char> separate{Containers::ValueInit, all.size()};
+    compressBlocks(image, CompressedPixelFormat::Bc3RGBAUnorm, 1, 2, separate);
+    compressBlocks(image, CompressedPixelFormat::Bc3RGBAUnorm, 0, 1, separate);
+    CORRADE_COMPARE_AS(Containers::arrayView(separate), Containers::arrayView(all), TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Player::Test::BlockCompressionTest)
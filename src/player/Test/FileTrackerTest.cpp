@@ -0,0 +1,238 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/System.h>
+
+#include "../FileTracker.h"
+
+namespace Magnum { namespace Player { namespace Test { namespace {
+
+struct FileTrackerTest: TestSuite::Tester {
+    explicit FileTrackerTest();
+
+    void read();
+    void readNonexistent();
+    void hash();
+    void hashNonexistent();
+
+    void updateUnchanged();
+    void updateChanged();
+    void updateSameContents();
+    void updateRemoved();
+    void clear();
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void watch();
+    void watchDisabled();
+    #endif
+
+    std::string _path, _filename;
+};
+
+FileTrackerTest::FileTrackerTest() {
+    addTests({&FileTrackerTest::read,
+              &FileTrackerTest::readNonexistent,
+              &FileTrackerTest::hash,
+              &FileTrackerTest::hashNonexistent,
+
+              &FileTrackerTest::updateUnchanged,
+              &FileTrackerTest::updateChanged,
+              &FileTrackerTest::updateSameContents,
+              &FileTrackerTest::updateRemoved,
+              &FileTrackerTest::clear,
+
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &FileTrackerTest::watch,
+              &FileTrackerTest::watchDisabled
+              #endif
+              });
+
+    _path = Utility::Directory::join(Utility::Directory::tmp(), "PlayerFileTrackerTest");
+    _filename = Utility::Directory::join(_path, "file.txt");
+    Utility::Directory::mkpath(_path);
+}
+
+Utility::Sha1::Digest sha1(const std::string& data) {
+    Utility::Sha1 sha1;
+    sha1 << data;
+    return sha1.digest();
+}
+
+void FileTrackerTest::read() {
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "hello"));
+
+    FileTracker tracker;
+    const Containers::ArrayView<const char> data = tracker.read(_filename);
+    CORRADE_COMPARE((std::string{data.data(), data.size()}), "hello");
+
+    /* The data are cached until released, so the same memory is returned
+       even if the file changes in the meantime */
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "bye"));
+    CORRADE_COMPARE(tracker.read(_filename).data(), data.data());
+
+    tracker.releaseData();
+    const Containers::ArrayView<const char> reread = tracker.read(_filename);
+    CORRADE_COMPARE((std::string{reread.data(), reread.size()}), "bye");
+}
+
+void FileTrackerTest::readNonexistent() {
+    FileTracker tracker;
+    CORRADE_VERIFY(tracker.read(Utility::Directory::join(_path, "nonexistent.txt")).empty());
+}
+
+void FileTrackerTest::hash() {
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "hello"));
+
+    /* Not read before, gets read by the call */
+    FileTracker tracker;
+    CORRADE_COMPARE(tracker.hash(_filename), sha1("hello"));
+
+    /* The hash stays until the next update() */
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "bye"));
+    CORRADE_COMPARE(tracker.hash(_filename), sha1("hello"));
+    tracker.update();
+    CORRADE_COMPARE(tracker.hash(_filename), sha1("bye"));
+}
+
+void FileTrackerTest::hashNonexistent() {
+    FileTracker tracker;
+    CORRADE_COMPARE(tracker.hash(Utility::Directory::join(_path, "nonexistent.txt")), Utility::Sha1::Digest{});
+}
+
+void FileTrackerTest::updateUnchanged() {
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "hello"));
+
+    FileTracker tracker;
+    tracker.read(_filename);
+    CORRADE_COMPARE_AS(tracker.update(), std::vector<std::string>{},
+        TestSuite::Compare::Container);
+}
+
+void FileTrackerTest::updateChanged() {
+    const std::string other = Utility::Directory::join(_path, "other.txt");
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "hello"));
+    CORRADE_VERIFY(Utility::Directory::writeString(other, "other"));
+
+    FileTracker tracker;
+    tracker.read(_filename);
+    tracker.read(other);
+
+    /* Only the rewritten file is reported and just once */
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "bye"));
+    CORRADE_COMPARE_AS(tracker.update(), std::vector<std::string>{_filename},
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(tracker.update(), std::vector<std::string>{},
+        TestSuite::Compare::Container);
+}
+
+void FileTrackerTest::updateSameContents() {
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "hello"));
+
+    FileTracker tracker;
+    tracker.read(_filename);
+
+    /* Writing the same contents again isn't a change */
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "hello"));
+    CORRADE_COMPARE_AS(tracker.update(), std::vector<std::string>{},
+        TestSuite::Compare::Container);
+}
+
+void FileTrackerTest::updateRemoved() {
+    const std::string filename = Utility::Directory::join(_path, "removed.txt");
+    CORRADE_VERIFY(Utility::Directory::writeString(filename, "hello"));
+
+    FileTracker tracker;
+    tracker.read(filename);
+
+    /* A removed file is reported just once */
+    CORRADE_VERIFY(Utility::Directory::rm(filename));
+    CORRADE_COMPARE_AS(tracker.update(), std::vector<std::string>{filename},
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(tracker.update(), std::vector<std::string>{},
+        TestSuite::Compare::Container);
+
+    /* And again once it appears with different contents */
+    CORRADE_VERIFY(Utility::Directory::writeString(filename, "back"));
+    CORRADE_COMPARE_AS(tracker.update(), std::vector<std::string>{filename},
+        TestSuite::Compare::Container);
+}
+
+void FileTrackerTest::clear() {
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "hello"));
+
+    FileTracker tracker;
+    tracker.read(_filename);
+    tracker.clear();
+
+    /* Untracked files aren't reported */
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "bye"));
+    CORRADE_COMPARE_AS(tracker.update(), std::vector<std::string>{},
+        TestSuite::Compare::Container);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void FileTrackerTest::watch() {
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "hello"));
+
+    FileTracker tracker;
+    tracker.setWatched(true);
+    CORRADE_VERIFY(tracker.isWatched());
+    tracker.read(_filename);
+    CORRADE_VERIFY(!tracker.hasChanged());
+
+    /* Modification time can have a granularity of a second */
+    Utility::System::sleep(1100);
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "bye"));
+    CORRADE_VERIFY(tracker.hasChanged());
+    /* Reported only once */
+    CORRADE_VERIFY(!tracker.hasChanged());
+
+    /* Editors often truncate the file first, that's not a change yet */
+    Utility::System::sleep(1100);
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, ""));
+    CORRADE_VERIFY(!tracker.hasChanged());
+}
+
+void FileTrackerTest::watchDisabled() {
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "hello"));
+
+    FileTracker tracker;
+    tracker.read(_filename);
+    CORRADE_VERIFY(!tracker.isWatched());
+
+    Utility::System::sleep(1100);
+    CORRADE_VERIFY(Utility::Directory::writeString(_filename, "bye"));
+    CORRADE_VERIFY(!tracker.hasChanged());
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Player::Test::FileTrackerTest)
@@ -0,0 +1,89 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "../FrameClock.h"
+
+namespace Magnum { namespace Player { namespace Test { namespace {
+
+struct FrameClockTest: TestSuite::Tester {
+    explicit FrameClockTest();
+
+    void construct();
+    void constructFixed();
+
+    void fixed();
+    void systemClock();
+};
+
+FrameClockTest::FrameClockTest() {
+    addTests({&FrameClockTest::construct,
+              &FrameClockTest::constructFixed,
+
+              &FrameClockTest::fixed,
+              &FrameClockTest::systemClock});
+}
+
+void FrameClockTest::construct() {
+    FrameClock clock;
+    CORRADE_VERIFY(!clock.isFixed());
+    CORRADE_COMPARE(clock.step().count(), 0);
+    CORRADE_COMPARE(clock.frame(), 0);
+}
+
+void FrameClockTest::constructFixed() {
+    FrameClock clock{std::chrono::milliseconds{16}};
+    CORRADE_VERIFY(clock.isFixed());
+    CORRADE_COMPARE(clock.step().count(), 16000000);
+    CORRADE_COMPARE(clock.frame(), 0);
+    CORRADE_COMPARE(clock.now().count(), 0);
+}
+
+void FrameClockTest::fixed() {
+    FrameClock clock{std::chrono::microseconds{16667}};
+    clock.nextFrame();
+    clock.nextFrame();
+    clock.nextFrame();
+
+    /* The time depends only on the frame index */
+    CORRADE_COMPARE(clock.frame(), 3);
+    CORRADE_COMPARE(clock.now().count(), 50001000);
+    CORRADE_COMPARE(clock.now().count(), 50001000);
+}
+
+void FrameClockTest::systemClock() {
+    FrameClock clock;
+    const std::chrono::nanoseconds before = std::chrono::system_clock::now().time_since_epoch();
+    clock.nextFrame();
+    const std::chrono::nanoseconds now = clock.now();
+    CORRADE_COMPARE(clock.frame(), 1);
+    CORRADE_VERIFY(now >= before);
+    CORRADE_VERIFY(now <= std::chrono::system_clock::now().time_since_epoch());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Player::Test::FrameClockTest)
@@ -0,0 +1,110 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "../ImporterPool.h"
+
+namespace Magnum { namespace Player { namespace Test { namespace {
+
+struct ImporterPoolTest: TestSuite::Tester {
+    explicit ImporterPoolTest();
+
+    void detect();
+    void detectUnknown();
+};
+
+/* The data are padded with extra bytes to verify only the prefix matters */
+const struct {
+    const char* name;
+    const char* data;
+    std::size_t size;
+    FileType type;
+    const char* plugin;
+} DetectData[]{
+    {"glTF", "glTF\x02\x00\x00\x00", 8, FileType::Scene, "GltfImporter"},
+    {"PLY", "ply \nformat", 11, FileType::Scene, "StanfordImporter"},
+    {"FBX", "Kaydara FBX Binary  \x00", 21, FileType::Scene, "FbxImporter"},
+    {"PNG", "\x89PNG\x0d\x0a\x1a\x0a\x00\x00", 10, FileType::Image, "PngImporter"},
+    {"JPEG", "\xff\xd8\xff\xe0\x00\x10", 6, FileType::Image, "JpegImporter"},
+    {"KTX2", "\xabKTX 20\xbb\x0d\x0a\x1a\x0a\x00", 13, FileType::Image, "KtxImporter"},
+    {"Basis", "sB\x13\x00\x4d\x00\x00\x00", 8, FileType::Image, "BasisImporter"},
+    {"DDS", "DDS \x7c\x00\x00\x00", 8, FileType::Image, "DdsImporter"},
+    {"OpenEXR", "\x76\x2f\x31\x01\x02\x00", 6, FileType::Image, "OpenExrImporter"},
+    {"Radiance HDR", "#?RADIANCE\n", 11, FileType::Image, "HdrImporter"},
+    {"RGBE HDR", "#?RGBE\n", 7, FileType::Image, "HdrImporter"}
+};
+
+const struct {
+    const char* name;
+    const char* data;
+    std::size_t size;
+} DetectUnknownData[]{
+    {"empty", "", 0},
+    {"glTF JSON", "{\"asset\":", 9},
+    {"OBJ", "v 0 0 0\n", 8},
+    {"truncated PNG signature", "\x89PNG\x0d\x0a", 6},
+    /* Just the two-byte Basis signature isn't enough */
+    {"Basis signature only", "sB", 2},
+    {"Basis signature, text after", "sB is not Basis", 15},
+    {"Basis with an unknown version", "sB\x10\x00\x4d\x00\x00\x00", 8},
+    {"Basis with a wrong header size", "sB\x13\x00\x50\x00\x00\x00", 8}
+};
+
+ImporterPoolTest::ImporterPoolTest() {
+    addInstancedTests({&ImporterPoolTest::detect},
+        Containers::arraySize(DetectData));
+
+    addInstancedTests({&ImporterPoolTest::detectUnknown},
+        Containers::arraySize(DetectUnknownData));
+}
+
+void ImporterPoolTest::detect() {
+    auto&& data = DetectData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const FileFormat format = detectFileFormat({data.data, data.size});
+    CORRADE_COMPARE(UnsignedByte(format.type), UnsignedByte(data.type));
+    CORRADE_COMPARE(std::string{format.plugin}, data.plugin);
+
+    /* A signature cut in the middle isn't recognized */
+    const FileFormat truncated = detectFileFormat({data.data, 1});
+    CORRADE_COMPARE(UnsignedByte(truncated.type), UnsignedByte(FileType::Unknown));
+}
+
+void ImporterPoolTest::detectUnknown() {
+    auto&& data = DetectUnknownData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const FileFormat format = detectFileFormat({data.data, data.size});
+    CORRADE_COMPARE(UnsignedByte(format.type), UnsignedByte(FileType::Unknown));
+    CORRADE_COMPARE(std::string{format.plugin}, "");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Player::Test::ImporterPoolTest)
@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/Math/Range.h>
+
+#include "../OcclusionCuller.h"
+
+namespace Magnum { namespace Player { namespace Test { namespace {
+
+struct OcclusionCullerTest: TestSuite::Tester {
+    explicit OcclusionCullerTest();
+
+    void construct();
+
+    void rasterize();
+    void rasterizeWinding();
+    void rasterizeNearest();
+    void rasterizeNearPlane();
+
+    void pyramid();
+    void pyramidOddSize();
+
+    void visibleNoOccluders();
+    void visibleOutsideFrustum();
+    void visibleOccluded();
+    void visiblePartiallyOccluded();
+    void visibleNearPlane();
+};
+
+/* With an identity transformation the positions are directly in NDC, a
+   quad covering the left half of the view at given depth */
+const Vector3 LeftHalf[]{
+    {-1.0f, -1.0f, 0.0f},
+    { 0.0f, -1.0f, 0.0f},
+    { 0.0f,  1.0f, 0.0f},
+    {-1.0f,  1.0f, 0.0f}
+};
+const UnsignedInt QuadIndices[]{0, 1, 2, 0, 2, 3};
+const UnsignedInt QuadIndicesClockwise[]{0, 2, 1, 0, 3, 2};
+
+Containers::Array<Vector3> quad(const Range2D& rect, Float depth) {
+    return Containers::array<Vector3>({
+        {rect.bottomLeft(), depth},
+        {rect.bottomRight(), depth},
+        {rect.topRight(), depth},
+        {rect.topLeft(), depth}
+    });
+}
+
+OcclusionCullerTest::OcclusionCullerTest() {
+    addTests({&OcclusionCullerTest::construct,
+
+              &OcclusionCullerTest::rasterize,
+              &OcclusionCullerTest::rasterizeWinding,
+              &OcclusionCullerTest::rasterizeNearest,
+              &OcclusionCullerTest::rasterizeNearPlane,
+
+              &OcclusionCullerTest::pyramid,
+              &OcclusionCullerTest::pyramidOddSize,
+
+              &OcclusionCullerTest::visibleNoOccluders,
+              &OcclusionCullerTest::visibleOutsideFrustum,
+              &OcclusionCullerTest::visibleOccluded,
+              &OcclusionCullerTest::visiblePartiallyOccluded,
+              &OcclusionCullerTest::visibleNearPlane});
+}
+
+void OcclusionCullerTest::construct() {
+    OcclusionCuller culler{{8, 4}};
+    CORRADE_COMPARE(culler.size(), (Vector2i{8, 4}));
+    CORRADE_COMPARE(culler.levelCount(), 4);
+    CORRADE_COMPARE(culler.levelSize(1), (Vector2i{4, 2}));
+    CORRADE_COMPARE(culler.levelSize(2), (Vector2i{2, 1}));
+    CORRADE_COMPARE(culler.levelSize(3), (Vector2i{1, 1}));
+
+    for(Float depth: culler.level(0)) CORRADE_COMPARE(depth, 1.0f);
+}
+
+void OcclusionCullerTest::rasterize() {
+    OcclusionCuller culler{{8, 4}};
+    culler.rasterize({}, Containers::arrayView(LeftHalf), QuadIndices);
+
+    /* Depth 0 in NDC is 0.5 in the buffer, the right half stays untouched */
+    CORRADE_COMPARE_AS(culler.level(0), Containers::arrayView<Float>({
+        0.5f, 0.5f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f, 1.0f,
+        0.5f, 0.5f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f, 1.0f,
+        0.5f, 0.5f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f, 1.0f,
+        0.5f, 0.5f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f, 1.0f
+    }), TestSuite::Compare::Container);
+}
+
+void OcclusionCullerTest::rasterizeWinding() {
+    OcclusionCuller culler{{8, 4}};
+    culler.rasterize({}, Containers::arrayView(LeftHalf), QuadIndicesClockwise);
+
+    /* Back-facing triangles are rasterized as well */
+    CORRADE_COMPARE(culler.level(0)[0], 0.5f);
+    CORRADE_COMPARE(culler.level(0)[27], 0.5f);
+    CORRADE_COMPARE(culler.level(0)[31], 1.0f);
+}
+
+void OcclusionCullerTest::rasterizeNearest() {
+    OcclusionCuller culler{{8, 4}};
+    Containers::Array<Vector3> farQuad = quad({{-1.0f, -1.0f}, {1.0f, 1.0f}}, 0.5f);
+    Containers::Array<Vector3> nearQuad = quad({{0.0f, -1.0f}, {1.0f, 1.0f}}, -0.5f);
+
+    /* The nearer depth wins regardless of the order */
+    culler.rasterize({}, Containers::arrayView(nearQuad), QuadIndices);
+    culler.rasterize({}, Containers::arrayView(farQuad), QuadIndices);
+    CORRADE_COMPARE(culler.level(0)[0], 0.75f);
+    CORRADE_COMPARE(culler.level(0)[7], 0.25f);
+}
+
+void OcclusionCullerTest::rasterizeNearPlane() {
+    OcclusionCuller culler{{8, 4}};
+
+    /* One corner in front of the near plane, the whole quad is skipped */
+    Containers::Array<Vector3> positions = quad({{-1.0f, -1.0f}, {1.0f, 1.0f}}, 0.0f);
+    positions[0].z() = -1.5f;
+    positions[1].z() = -1.5f;
+    culler.rasterize({}, Containers::arrayView(positions), QuadIndices);
+
+    for(Float depth: culler.level(0)) CORRADE_COMPARE(depth, 1.0f);
+}
+
+void OcclusionCullerTest::pyramid() {
+    OcclusionCuller culler{{8, 4}};
+    culler.rasterize({}, Containers::arrayView(LeftHalf), QuadIndices);
+    culler.buildPyramid();
+
+    CORRADE_COMPARE_AS(culler.level(1), Containers::arrayView<Float>({
+        0.5f, 0.5f, 1.0f, 1.0f,
+        0.5f, 0.5f, 1.0f, 1.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(culler.level(2), Containers::arrayView<Float>({
+        0.5f, 1.0f
+    }), TestSuite::Compare::Container);
+
+    /* The top level has the farthest depth */
+    CORRADE_COMPARE(culler.level(3)[0], 1.0f);
+}
+
+void OcclusionCullerTest::pyramidOddSize() {
+    OcclusionCuller culler{{3, 3}};
+    Containers::Array<Vector3> positions = quad({{-1.0f, -1.0f}, {1.0f, 1.0f}}, -0.5f);
+    culler.rasterize({}, Containers::arrayView(positions), QuadIndices);
+    culler.buildPyramid();
+
+    /* The last row and column are taken twice, not reading out of bounds */
+    CORRADE_COMPARE(culler.levelSize(1), (Vector2i{2, 2}));
+    CORRADE_COMPARE_AS(culler.level(1), Containers::arrayView<Float>({
+        0.25f, 0.25f,
+        0.25f, 0.25f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(culler.level(2)[0], 0.25f);
+}
+
+void OcclusionCullerTest::visibleNoOccluders() {
+    OcclusionCuller culler{{8, 4}};
+    culler.buildPyramid();
+
+    CORRADE_VERIFY(culler.isVisible({}, {{-0.5f, -0.5f, 0.9f}, {0.5f, 0.5f, 0.95f}}));
+}
+
+void OcclusionCullerTest::visibleOutsideFrustum() {
+    OcclusionCuller culler{{8, 4}};
+    culler.buildPyramid();
+
+    /* Left of the view, behind the far plane, in front of the near plane */
+    CORRADE_VERIFY(!culler.isVisible({}, {{-3.0f, -0.5f, 0.0f}, {-1.5f, 0.5f, 0.5f}}));
+    CORRADE_VERIFY(!culler.isVisible({}, {{-0.5f, -0.5f, 1.5f}, {0.5f, 0.5f, 2.0f}}));
+    CORRADE_VERIFY(!culler.isVisible({}, {{-0.5f, -0.5f, -3.0f}, {0.5f, 0.5f, -2.0f}}));
+
+    /* A translation moving it inside makes it visible */
+    CORRADE_VERIFY(culler.isVisible(Matrix4::translation(Vector3::xAxis(2.0f)), {{-3.0f, -0.5f, 0.0f}, {-1.5f, 0.5f, 0.5f}}));
+}
+
+void OcclusionCullerTest::visibleOccluded() {
+    OcclusionCuller culler{{8, 4}};
+    Containers::Array<Vector3> positions = quad({{-1.0f, -1.0f}, {1.0f, 1.0f}}, 0.0f);
+    culler.rasterize({}, Containers::arrayView(positions), QuadIndices);
+    culler.buildPyramid();
+
+    /* Behind the occluder */
+    CORRADE_VERIFY(!culler.isVisible({}, {{-0.5f, -0.5f, 0.25f}, {0.5f, 0.5f, 0.75f}}));
+    /* In front of it */
+    CORRADE_VERIFY(culler.isVisible({}, {{-0.5f, -0.5f, -0.75f}, {0.5f, 0.5f, -0.25f}}));
+    /* Intersecting it */
+    CORRADE_VERIFY(culler.isVisible({}, {{-0.5f, -0.5f, -0.25f}, {0.5f, 0.5f, 0.25f}}));
+}
+
+void OcclusionCullerTest::visiblePartiallyOccluded() {
+    OcclusionCuller culler{{8, 4}};
+    culler.rasterize({}, Containers::arrayView(LeftHalf), QuadIndices);
+    culler.buildPyramid();
+
+    /* Fully behind the left half */
+    CORRADE_VERIFY(!culler.isVisible({}, {{-0.75f, -0.5f, 0.25f}, {-0.25f, 0.5f, 0.75f}}));
+    /* Reaching into the right half */
+    CORRADE_VERIFY(culler.isVisible({}, {{-0.75f, -0.5f, 0.25f}, {0.5f, 0.5f, 0.75f}}));
+}
+
+void OcclusionCullerTest::visibleNearPlane() {
+    OcclusionCuller culler{{8, 4}};
+    Containers::Array<Vector3> positions = quad({{-1.0f, -1.0f}, {1.0f, 1.0f}}, -0.5f);
+    culler.rasterize({}, Containers::arrayView(positions), QuadIndices);
+    culler.buildPyramid();
+
+    /* Can't be projected, so it's conservatively visible even though the
+       part in the frustum is behind the occluder */
+    CORRADE_VERIFY(culler.isVisible({}, {{-0.5f, -0.5f, -2.0f}, {0.5f, 0.5f, 0.5f}}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Player::Test::OcclusionCullerTest)
@@ -0,0 +1,307 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Magnum/Math/Matrix4.h>
+
+#include "../Skinning.h"
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <Corrade/Containers/Optional.h>
+
+#include "../WorkerPool.h"
+#endif
+
+namespace Magnum { namespace Player { namespace Test { namespace {
+
+struct SkinningTest: TestSuite::Tester {
+    explicit SkinningTest();
+
+    void paletteEmpty();
+    void paletteAddSkin();
+    void paletteUpdate();
+    void paletteUpdateManySkins();
+
+    void skinSingleJoint();
+    void skinBlend();
+    void skinNormals();
+    void skinNoNormals();
+    void skinZeroWeight();
+
+    void parallelFor();
+};
+
+const struct {
+    const char* name;
+    std::size_t count, minChunk;
+    bool pool;
+} ParallelForData[]{
+    {"empty", 0, 1, true},
+    {"single item", 1, 1, true},
+    {"less than a chunk", 7, 16, true},
+    {"uneven split", 1001, 1, true},
+    {"zero chunk size", 33, 0, true},
+    {"no pool", 1001, 1, false}
+};
+
+using namespace Math::Literals;
+
+SkinningTest::SkinningTest() {
+    addTests({&SkinningTest::paletteEmpty,
+              &SkinningTest::paletteAddSkin,
+              &SkinningTest::paletteUpdate,
+              &SkinningTest::paletteUpdateManySkins,
+
+              &SkinningTest::skinSingleJoint,
+              &SkinningTest::skinBlend,
+              &SkinningTest::skinNormals,
+              &SkinningTest::skinNoNormals,
+              &SkinningTest::skinZeroWeight});
+
+    addInstancedTests({&SkinningTest::parallelFor},
+        Containers::arraySize(ParallelForData));
+}
+
+void SkinningTest::paletteEmpty() {
+    SkinPalette palette;
+    CORRADE_COMPARE(palette.skinCount(), 0);
+    CORRADE_COMPARE(palette.jointCount(), 0);
+
+    /* Updating an empty palette shouldn't do anything */
+    palette.update({});
+}
+
+void SkinningTest::paletteAddSkin() {
+    const Matrix4 a[]{Matrix4::translation(Vector3::xAxis()), Matrix4::translation(Vector3::yAxis())};
+    const Matrix4 b[]{Matrix4::translation(Vector3::zAxis())};
+
+    SkinPalette palette;
+    CORRADE_COMPARE(palette.addSkin(a), 0);
+    /* Skins that failed to import are added empty to keep the IDs */
+    CORRADE_COMPARE(palette.addSkin({}), 1);
+    CORRADE_COMPARE(palette.addSkin(b), 2);
+
+    CORRADE_COMPARE(palette.skinCount(), 3);
+    CORRADE_COMPARE(palette.jointCount(), 3);
+    CORRADE_COMPARE(palette.jointOffset(0), 0);
+    CORRADE_COMPARE(palette.jointOffset(1), 2);
+    CORRADE_COMPARE(palette.jointOffset(2), 2);
+    CORRADE_COMPARE(palette.jointMatrices(0).size(), 2);
+    CORRADE_COMPARE(palette.jointMatrices(1).size(), 0);
+    CORRADE_COMPARE(palette.jointMatrices(2).size(), 1);
+}
+
+void SkinningTest::paletteUpdate() {
+    const Matrix4 a[]{
+        Matrix4::translation(-Vector3::xAxis()),
+        Matrix4::translation(-Vector3::yAxis())
+    };
+    const Matrix4 b[]{
+        Matrix4::scaling(Vector3{0.5f})
+    };
+
+    SkinPalette palette;
+    palette.addSkin(a);
+    palette.addSkin(b);
+
+    const Matrix4 transformations[]{
+        Matrix4::translation(Vector3::xAxis()),
+        Matrix4::rotationZ(90.0_degf),
+        Matrix4::scaling(Vector3{2.0f})
+    };
+    palette.update(transformations);
+
+    CORRADE_COMPARE_AS(palette.jointMatrices(0), Containers::arrayView<Matrix4>({
+        Matrix4{Math::IdentityInit},
+        Matrix4::rotationZ(90.0_degf)*Matrix4::translation(-Vector3::yAxis())
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(palette.jointMatrices(1), Containers::arrayView<Matrix4>({
+        Matrix4{Math::IdentityInit}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinningTest::paletteUpdateManySkins() {
+    /* Enough skins to be split across threads, each with a different joint
+       count to verify the offsets are respected */
+    SkinPalette palette;
+    for(std::size_t i = 0; i != 100; ++i) {
+        Containers::Array<Matrix4> inverseBindMatrices{Containers::NoInit, i % 5 + 1};
+        for(std::size_t j = 0; j != inverseBindMatrices.size(); ++j)
+            inverseBindMatrices[j] = Matrix4::translation(Vector3::xAxis(-Float(j)));
+        palette.addSkin(inverseBindMatrices);
+    }
+    Containers::Array<Matrix4> transformations{Containers::NoInit, palette.jointCount()};
+    for(std::size_t i = 0; i != palette.skinCount(); ++i)
+        for(std::size_t j = 0; j != palette.jointMatrices(i).size(); ++j)
+            transformations[palette.jointOffset(i) + j] = Matrix4::translation({Float(j), Float(i), 0.0f});
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    WorkerPool pool{4};
+    palette.update(transformations, &pool);
+    #else
+    palette.update(transformations);
+    #endif
+
+    for(std::size_t i = 0; i != palette.skinCount(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(palette.jointMatrices(i).size(), i % 5 + 1);
+        for(const Matrix4& matrix: palette.jointMatrices(i))
+            CORRADE_COMPARE(matrix, Matrix4::translation(Vector3::yAxis(Float(i))));
+    }
+}
+
+void SkinningTest::skinSingleJoint() {
+    const Matrix4 joints[]{
+        Matrix4::translation({1.0f, 2.0f, 3.0f}),
+        Matrix4::translation({-1.0f, 0.0f, 0.0f})
+    };
+    const Vector4ui ids[]{{1, 0, 0, 0}, {0, 0, 0, 0}};
+    const Vector4 weights[]{{1.0f, 0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f, 0.0f}};
+    const Vector3 positions[]{{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}};
+    Vector3 skinnedPositions[2];
+
+    skinVertices(joints, ids, weights, positions, nullptr, skinnedPositions, nullptr);
+    CORRADE_COMPARE_AS(Containers::arrayView(skinnedPositions), Containers::arrayView<Vector3>({
+        {-1.0f, 0.0f, 0.0f},
+        {2.0f, 3.0f, 4.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinningTest::skinBlend() {
+    const Matrix4 joints[]{
+        Matrix4::translation({2.0f, 0.0f, 0.0f}),
+        Matrix4::translation({0.0f, 4.0f, 0.0f}),
+        Matrix4::translation({0.0f, 0.0f, 8.0f}),
+        Matrix4::scaling(Vector3{2.0f})
+    };
+    const Vector4ui ids[]{{0, 1, 0, 0}, {0, 1, 2, 3}};
+    const Vector4 weights[]{{0.5f, 0.5f, 0.0f, 0.0f}, {0.25f, 0.25f, 0.25f, 0.25f}};
+    const Vector3 positions[]{{1.0f, 1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}};
+    Vector3 skinnedPositions[2];
+
+    skinVertices(joints, ids, weights, positions, nullptr, skinnedPositions, nullptr);
+    CORRADE_COMPARE_AS(Containers::arrayView(skinnedPositions), Containers::arrayView<Vector3>({
+        {2.0f, 3.0f, 1.0f},
+        {1.75f, 2.25f, 3.25f}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinningTest::skinNormals() {
+    const Matrix4 joints[]{
+        Matrix4::rotationZ(90.0_degf)*Matrix4::translation({5.0f, 0.0f, 0.0f}),
+        Matrix4::scaling(Vector3{3.0f})
+    };
+    const Vector4ui ids[]{{0, 0, 0, 0}, {1, 0, 0, 0}};
+    const Vector4 weights[]{{1.0f, 0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f, 0.0f}};
+    const Vector3 positions[]{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}};
+    const Vector3 normals[]{{1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+    Vector3 skinnedPositions[2];
+    Vector3 skinnedNormals[2];
+
+    skinVertices(joints, ids, weights, positions, normals, skinnedPositions, skinnedNormals);
+    CORRADE_COMPARE_AS(Containers::arrayView(skinnedPositions), Containers::arrayView<Vector3>({
+        {0.0f, 5.0f, 0.0f},
+        {3.0f, 0.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    /* Translation doesn't affect normals and they're renormalized after
+       scaling */
+    CORRADE_COMPARE_AS(Containers::arrayView(skinnedNormals), Containers::arrayView<Vector3>({
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinningTest::skinNoNormals() {
+    const Matrix4 joints[]{
+        Matrix4::translation({1.0f, 0.0f, 0.0f})
+    };
+    const Vector4ui ids[]{{}};
+    const Vector4 weights[]{{1.0f, 0.0f, 0.0f, 0.0f}};
+    const Vector3 positions[]{{1.0f, 2.0f, 3.0f}};
+
+    /* Output interleaved with something else to verify strides are
+       respected */
+    Vector3 out[2]{Vector3{7.0f}, Vector3{7.0f}};
+    const Containers::StridedArrayView1D<Vector3> skinnedPositions{Containers::arrayView(out), out + 1, 1, 2*sizeof(Vector3)};
+
+    skinVertices(joints, ids, weights, positions, nullptr, skinnedPositions, nullptr);
+    CORRADE_COMPARE(out[0], Vector3{7.0f});
+    CORRADE_COMPARE(out[1], (Vector3{2.0f, 2.0f, 3.0f}));
+}
+
+void SkinningTest::skinZeroWeight() {
+    /* Joints with zero weight can have any ID, they're not accessed */
+    const Matrix4 joints[]{
+        Matrix4::translation({1.0f, 0.0f, 0.0f})
+    };
+    const Vector4ui ids[]{{0, 255, 65535, 3}};
+    const Vector4 weights[]{{1.0f, 0.0f, 0.0f, 0.0f}};
+    const Vector3 positions[]{{1.0f, 2.0f, 3.0f}};
+    Vector3 skinnedPositions[1];
+
+    skinVertices(joints, ids, weights, positions, nullptr, skinnedPositions, nullptr);
+    CORRADE_COMPARE(skinnedPositions[0], (Vector3{2.0f, 2.0f, 3.0f}));
+}
+
+void SkinningTest::parallelFor() {
+    auto&& data = ParallelForData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    WorkerPool* pool = nullptr;
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    Containers::Optional<WorkerPool> workerPool;
+    if(data.pool) {
+        workerPool.emplace(4);
+        pool = &*workerPool;
+    }
+    #endif
+
+    /* Each item should be visited exactly once in each run, the second run
+       verifies the pool is reusable */
+    Containers::Array<std::atomic<Int>> visited{data.count};
+    for(std::atomic<Int>& i: visited) i = 0;
+    std::atomic<Int> calls{0};
+    for(std::size_t run = 0; run != 2; ++run) {
+        Player::parallelFor(pool, data.count, data.minChunk, [&](std::size_t begin, std::size_t end) {
+            ++calls;
+            for(std::size_t i = begin; i != end; ++i) ++visited[i];
+        });
+    }
+
+    for(std::size_t i = 0; i != data.count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(Int(visited[i]), 2);
+    }
+    /* No calls for empty ranges */
+    CORRADE_COMPARE(calls == 0, data.count == 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Player::Test::SkinningTest)
@@ -0,0 +1,115 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/String.h>
+
+#include "../Tracer.h"
+
+namespace Magnum { namespace Player { namespace Test { namespace {
+
+struct TracerTest: TestSuite::Tester {
+    explicit TracerTest();
+
+    void zones();
+    void emptyFrame();
+    void nullTracer();
+    void cantWrite();
+
+    std::string _filename;
+};
+
+TracerTest::TracerTest() {
+    addTests({&TracerTest::zones,
+              &TracerTest::emptyFrame,
+              &TracerTest::nullTracer,
+              &TracerTest::cantWrite});
+
+    _filename = Utility::Directory::join(Utility::Directory::tmp(), "PlayerTracerTest.json");
+}
+
+void TracerTest::zones() {
+    {
+        /* No GL context here, so GPU zones are disabled */
+        Tracer tracer{_filename, false};
+        CORRADE_VERIFY(tracer.isValid());
+        CORRADE_VERIFY(!tracer.isGpuEnabled());
+
+        {
+            TraceZone outer{&tracer, "Outer"};
+            TraceZone inner{&tracer, "Inner", true};
+        }
+        tracer.endFrame();
+        CORRADE_COMPARE(tracer.frameCount(), 1);
+
+        {
+            TraceZone zone{&tracer, "Second"};
+        }
+        tracer.endFrame();
+        CORRADE_COMPARE(tracer.frameCount(), 2);
+    }
+
+    /* The array gets closed on destruction */
+    const std::string out = Utility::Directory::readString(_filename);
+    CORRADE_VERIFY(Utility::String::beginsWith(out, "[\n"));
+    CORRADE_VERIFY(Utility::String::endsWith(out, "}\n]\n"));
+    CORRADE_VERIFY(out.find(R"("name":"thread_name")") != std::string::npos);
+    CORRADE_VERIFY(out.find(R"("name":"Outer","ph":"X")") != std::string::npos);
+    CORRADE_VERIFY(out.find(R"("name":"Inner","ph":"X")") != std::string::npos);
+    CORRADE_VERIFY(out.find(R"("name":"Second","ph":"X")") != std::string::npos);
+    CORRADE_VERIFY(out.find(R"("args":{"frame":0})") != std::string::npos);
+    CORRADE_VERIFY(out.find(R"("args":{"frame":1})") != std::string::npos);
+
+    /* The inner zone is written first as it ends first */
+    CORRADE_VERIFY(out.find(R"("name":"Inner")") < out.find(R"("name":"Outer")"));
+}
+
+void TracerTest::emptyFrame() {
+    Tracer tracer{_filename, false};
+
+    /* A frame starts only with the first zone */
+    tracer.endFrame();
+    tracer.endFrame();
+    CORRADE_COMPARE(tracer.frameCount(), 0);
+}
+
+void TracerTest::nullTracer() {
+    /* Shouldn't crash */
+    TraceZone zone{nullptr, "Nothing"};
+    CORRADE_VERIFY(true);
+}
+
+void TracerTest::cantWrite() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    Tracer tracer{Utility::Directory::join(_filename, "nonexistent.json"), false};
+    CORRADE_VERIFY(!tracer.isValid());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Player::Test::TracerTest)
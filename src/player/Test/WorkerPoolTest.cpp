@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "../WorkerPool.h"
+
+namespace Magnum { namespace Player { namespace Test { namespace {
+
+struct WorkerPoolTest: TestSuite::Tester {
+    explicit WorkerPoolTest();
+
+    void construct();
+    void constructDefaultWorkerCount();
+
+    void wait();
+    void waitEmpty();
+    void waitMaxPending();
+    void workerIndex();
+    void submitFromJob();
+    void destructWaits();
+};
+
+WorkerPoolTest::WorkerPoolTest() {
+    addTests({&WorkerPoolTest::construct,
+              &WorkerPoolTest::constructDefaultWorkerCount,
+
+              &WorkerPoolTest::wait,
+              &WorkerPoolTest::waitEmpty,
+              &WorkerPoolTest::waitMaxPending,
+              &WorkerPoolTest::workerIndex,
+              &WorkerPoolTest::submitFromJob,
+              &WorkerPoolTest::destructWaits});
+}
+
+void WorkerPoolTest::construct() {
+    WorkerPool pool{3};
+    CORRADE_COMPARE(pool.workerCount(), 3);
+    CORRADE_COMPARE(pool.pendingCount(), 0);
+}
+
+void WorkerPoolTest::constructDefaultWorkerCount() {
+    WorkerPool pool{0};
+    CORRADE_VERIFY(pool.workerCount() >= 1);
+}
+
+void WorkerPoolTest::wait() {
+    WorkerPool pool{4};
+
+    /* Each job should be run exactly once */
+    Containers::Array<std::atomic<Int>> visited{1000};
+    for(std::atomic<Int>& i: visited) i = 0;
+    for(std::size_t i = 0; i != visited.size(); ++i)
+        pool.submit([&visited, i](std::size_t) { ++visited[i]; });
+
+    pool.wait();
+    CORRADE_COMPARE(pool.pendingCount(), 0);
+    for(std::size_t i = 0; i != visited.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(Int(visited[i]), 1);
+    }
+}
+
+void WorkerPoolTest::waitEmpty() {
+    WorkerPool pool{2};
+
+    /* Shouldn't block if nothing was submitted */
+    pool.wait();
+    CORRADE_COMPARE(pool.pendingCount(), 0);
+}
+
+void WorkerPoolTest::waitMaxPending() {
+    WorkerPool pool{1};
+
+    /* Block the only worker until all jobs are submitted */
+    std::atomic<bool> release{false};
+    std::atomic<Int> count{0};
+    pool.submit([&](std::size_t) {
+        while(!release) std::this_thread::yield();
+        ++count;
+    });
+    for(std::size_t i = 0; i != 10; ++i)
+        pool.submit([&](std::size_t) { ++count; });
+    CORRADE_COMPARE(pool.pendingCount(), 11);
+
+    release = true;
+    pool.wait(5);
+    CORRADE_VERIFY(pool.pendingCount() <= 5);
+    CORRADE_VERIFY(count >= 6);
+
+    pool.wait();
+    CORRADE_COMPARE(Int(count), 11);
+}
+
+void WorkerPoolTest::workerIndex() {
+    WorkerPool pool{3};
+
+    std::atomic<Int> outOfRange{0};
+    for(std::size_t i = 0; i != 100; ++i) pool.submit([&](std::size_t worker) {
+        if(worker >= 3) ++outOfRange;
+    });
+
+    pool.wait();
+    CORRADE_COMPARE(Int(outOfRange), 0);
+}
+
+void WorkerPoolTest::submitFromJob() {
+    WorkerPool pool{2};
+
+    /* Jobs submitted from a running job are waited for as well, as the
+       running job is still counted when the new one gets queued */
+    std::atomic<Int> count{0};
+    pool.submit([&](std::size_t) {
+        ++count;
+        pool.submit([&](std::size_t) { ++count; });
+    });
+
+    pool.wait();
+    CORRADE_COMPARE(Int(count), 2);
+}
+
+void WorkerPoolTest::destructWaits() {
+    std::atomic<Int> count{0};
+    {
+        WorkerPool pool{2};
+        for(std::size_t i = 0; i != 100; ++i)
+            pool.submit([&](std::size_t) { ++count; });
+    }
+
+    /* Jobs that were still queued got done before the threads exited */
+    CORRADE_COMPARE(Int(count), 100);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Player::Test::WorkerPoolTest)
@@ -0,0 +1,162 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureCache.h"
+
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Magnum/PixelFormat.h>
+
+#include "FileTracker.h"
+
+namespace Magnum { namespace Player {
+
+namespace {
+
+/* Bump when the layout changes, older entries are then ignored */
+constexpr char Magic[]{'M', 'P', 'T', 'C', 0, 0, 0, 1};
+
+/* Native endianness, the cache isn't meant to be shared between machines */
+struct Header {
+    char magic[sizeof(Magic)];
+    UnsignedInt format;
+    UnsignedInt fileCount;
+    UnsignedInt levelCount;
+    Utility::Sha1::Digest hash;
+};
+
+struct LevelHeader {
+    Vector2i size;
+    UnsignedInt dataSize;
+};
+
+template<class T> void append(Containers::Array<char>& out, const T& value) {
+    arrayAppend(out, Containers::arrayView(reinterpret_cast<const char*>(&value), sizeof(T)));
+}
+
+/* Copies a value out of the data and advances them, returns false if there's
+   not enough data */
+template<class T> bool consume(Containers::ArrayView<const char>& data, T& value) {
+    if(data.size() < sizeof(T)) return false;
+    std::memcpy(&value, data.data(), sizeof(T));
+    data = data.suffix(sizeof(T));
+    return true;
+}
+
+}
+
+TextureCache::TextureCache(std::string directory, std::string configuration): _directory{std::move(directory)}, _configuration{std::move(configuration)} {
+    if(!Utility::Directory::mkpath(_directory))
+        Warning{} << "Cannot create texture cache directory" << _directory;
+}
+
+std::string TextureCache::filename(const std::string& key) const {
+    return Utility::Directory::join(_directory, Utility::Sha1::digest(_configuration + '\n' + key).hexString() + ".bin");
+}
+
+Containers::Optional<TextureCache::Entry> TextureCache::find(const std::string& key, FileTracker& tracker) {
+    Containers::Optional<Entry> entry = read(key, tracker);
+    if(entry) ++_hitCount;
+    return entry;
+}
+
+bool TextureCache::contains(const std::string& key, FileTracker& tracker) {
+    return !!read(key, tracker);
+}
+
+Containers::Optional<TextureCache::Entry> TextureCache::read(const std::string& key, FileTracker& tracker) const {
+    const std::string filename = this->filename(key);
+    if(!Utility::Directory::exists(filename)) return {};
+
+    Entry entry;
+    entry.data = Utility::Directory::mapRead(filename);
+    Containers::ArrayView<const char> data = entry.data;
+
+    Header header;
+    if(!consume(data, header) || std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || !header.levelCount)
+        return {};
+    entry.hash = header.hash;
+
+    /* If any of the files the image came from changed, the entry is stale
+       and gets overwritten after the image is imported again */
+    for(UnsignedInt i = 0; i != header.fileCount; ++i) {
+        UnsignedInt size;
+        Utility::Sha1::Digest hash;
+        if(!consume(data, size) || data.size() < size) return {};
+        std::string file{data.data(), size};
+        data = data.suffix(size);
+        if(!consume(data, hash) || tracker.hash(file) != hash) return {};
+        entry.files.push_back(std::move(file));
+    }
+
+    for(UnsignedInt i = 0; i != header.levelCount; ++i) {
+        LevelHeader level;
+        if(!consume(data, level) || data.size() < level.dataSize) return {};
+        entry.levels.emplace_back(CompressedPixelFormat(header.format), level.size, data.prefix(level.dataSize));
+        data = data.suffix(level.dataSize);
+    }
+
+    return Containers::optional(std::move(entry));
+}
+
+bool TextureCache::save(const std::string& key, FileTracker& tracker, const std::vector<std::string>& files, const Utility::Sha1::Digest& hash, const Containers::ArrayView<const CompressedImageView2D> levels) {
+    CORRADE_INTERNAL_ASSERT(!levels.empty());
+
+    Header header;
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.format = UnsignedInt(levels[0].format());
+    header.fileCount = files.size();
+    header.levelCount = levels.size();
+    header.hash = hash;
+
+    Containers::Array<char> out;
+    append(out, header);
+    for(const std::string& file: files) {
+        append(out, UnsignedInt(file.size()));
+        arrayAppend(out, Containers::arrayView(file.data(), file.size()));
+        append(out, tracker.hash(file));
+    }
+    for(const CompressedImageView2D& level: levels) {
+        CORRADE_INTERNAL_ASSERT(level.format() == levels[0].format());
+        append(out, LevelHeader{level.size(), UnsignedInt(level.data().size())});
+        arrayAppend(out, level.data());
+    }
+
+    /* Write to a temporary file first so an interrupted write doesn't leave
+       a truncated entry behind, and the rename doesn't affect a copy that's
+       currently mapped */
+    const std::string filename = this->filename(key);
+    const std::string temporary = filename + ".tmp";
+    if(!Utility::Directory::write(temporary, out) || !Utility::Directory::move(temporary, filename)) {
+        Warning{} << "Cannot write a texture cache entry to" << filename;
+        return false;
+    }
+
+    ++_savedCount;
+    return true;
+}
+
+}}
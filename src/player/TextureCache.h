@@ -0,0 +1,93 @@
+#ifndef Magnum_Player_TextureCache_h
+#define Magnum_Player_TextureCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Sha1.h>
+#include <Magnum/ImageView.h>
+
+namespace Magnum { namespace Player {
+
+class FileTracker;
+
+/* On-disk cache of compressed textures, to avoid transcoding Basis images
+   again on every load. Each entry is a file named after a hash of the key
+   and of the importer configuration, such as the Basis target format. It
+   contains hashes of the files the image was imported from, a hash of the
+   imported data used for reload bookkeeping and the whole mip chain. A
+   found entry is memory-mapped and the levels point directly into the
+   mapped file, so the data can be uploaded without an extra copy. Not
+   available on Emscripten. */
+class TextureCache {
+    public:
+        struct Entry {
+            Utility::Sha1::Digest hash;
+            std::vector<std::string> files;
+            std::vector<CompressedImageView2D> levels;
+            Containers::Array<const char, Utility::Directory::MapDeleter> data;
+        };
+
+        /* Creates the directory if it doesn't exist. Entries saved with a
+           different configuration string are not used. */
+        explicit TextureCache(std::string directory, std::string configuration);
+
+        const std::string& directory() const { return _directory; }
+
+        /* Count of entries found and saved so far */
+        std::size_t hitCount() const { return _hitCount; }
+        std::size_t savedCount() const { return _savedCount; }
+
+        /* Looks up an entry for given key. Returns an empty optional if
+           there's none, if it can't be read or if any of the files it was
+           imported from changed since. The files are hashed through the
+           tracker, which also starts tracking them. */
+        Containers::Optional<Entry> find(const std::string& key, FileTracker& tracker);
+
+        /* Whether find() would return an entry for given key, without
+           counting it as a hit */
+        bool contains(const std::string& key, FileTracker& tracker);
+
+        /* Saves an entry for given key, with the files it was imported from
+           hashed through the tracker. All levels are expected to have the
+           same format. Prints a warning and returns false if the file
+           can't be written. */
+        bool save(const std::string& key, FileTracker& tracker, const std::vector<std::string>& files, const Utility::Sha1::Digest& hash, Containers::ArrayView<const CompressedImageView2D> levels);
+
+    private:
+        std::string filename(const std::string& key) const;
+        Containers::Optional<Entry> read(const std::string& key, FileTracker& tracker) const;
+
+        std::string _directory, _configuration;
+        std::size_t _hitCount{}, _savedCount{};
+};
+
+}}
+
+#endif
@@ -0,0 +1,204 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureDecoder.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/PluginManager/PluginMetadata.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
+#include <Magnum/FileCallback.h>
+#include <Magnum/Trade/AbstractImporter.h>
+
+#include "ImporterPool.h"
+
+namespace Magnum { namespace Player {
+
+struct TextureDecoder::Worker {
+    explicit Worker(const std::string& pluginDirectory): manager{pluginDirectory}, importers{manager} {}
+
+    /* Opens the file on first use, returns nullptr if it can't be opened */
+    Trade::AbstractImporter* open() {
+        if(!openAttempted) {
+            openAttempted = true;
+            importer->openFile(filename);
+        }
+        return importer->isOpened() ? importer : nullptr;
+    }
+
+    /* Same as FileTracker::fileCallback(), but with the data kept just for
+       this worker, so the workers don't need to synchronize */
+    static Containers::Optional<Containers::ArrayView<const char>> fileCallback(const std::string& filename, InputFileCallbackPolicy policy, Worker& worker) {
+        if(policy == InputFileCallbackPolicy::Close) return {};
+
+        worker.accessedFiles.push_back(filename);
+
+        auto found = worker.files.find(filename);
+        if(found == worker.files.end()) {
+            if(!Utility::Directory::exists(filename)) return {};
+            found = worker.files.emplace(filename, Utility::Directory::mapRead(filename)).first;
+        }
+
+        Containers::ArrayView<const char> data = found->second;
+        return data;
+    }
+
+    PluginManager::Manager<Trade::AbstractImporter> manager;
+    ImporterPool importers;
+
+    /* Set up on the main thread in decode(), the file is then opened by the
+       first job that gets to this worker */
+    Trade::AbstractImporter* importer{};
+    std::string filename;
+    bool openAttempted{};
+
+    std::unordered_map<std::string, Containers::Array<const char, Utility::Directory::MapDeleter>> files;
+    std::vector<std::string> accessedFiles;
+};
+
+TextureDecoder::TextureDecoder(PluginManager::Manager<Trade::AbstractImporter>& manager, const std::size_t threadCount, std::string importerOptions, const Trade::ImporterFlags flags): _importerOptions{std::move(importerOptions)}, _pool{threadCount} {
+    _workers.reserve(_pool.workerCount());
+    for(std::size_t i = 0; i != _pool.workerCount(); ++i) {
+        _workers.push_back(Containers::pointer<Worker>(manager.pluginDirectory()));
+        Worker& worker = *_workers.back();
+        worker.importers.setFlags(flags);
+
+        /* Use the same plugin defaults and preferences as the main manager,
+           such as the Basis target format */
+        for(const std::string& plugin: manager.pluginList()) {
+            PluginManager::PluginMetadata* const from = manager.metadata(plugin);
+            PluginManager::PluginMetadata* const to = worker.manager.metadata(plugin);
+            if(from && to) to->configuration() = from->configuration();
+        }
+        for(const std::string& alias: manager.aliasList()) {
+            const std::string& plugin = manager.metadata(alias)->name();
+            if(plugin != alias && worker.manager.loadState(plugin) != PluginManager::LoadState::NotFound)
+                worker.manager.setPreferredPlugins(alias, {plugin});
+        }
+    }
+}
+
+TextureDecoder::~TextureDecoder() = default;
+
+std::vector<DecodedImage> TextureDecoder::decode(const std::string& plugin, const std::string& filename, const Containers::ArrayView<const UnsignedInt> images) {
+    std::vector<DecodedImage> out(images.size());
+    if(images.empty()) return out;
+
+    /* Instantiate the importers here, as the managers can't be used from the
+       workers. The options are applied just once per plugin, silently, as
+       the main importer already warned about unrecognized ones. If any
+       worker fails, return empty images so the caller imports them on its
+       own. */
+    const bool configure = std::find(_configuredPlugins.begin(), _configuredPlugins.end(), plugin) == _configuredPlugins.end();
+    for(Containers::Pointer<Worker>& worker: _workers) {
+        worker->importer = worker->importers.get(plugin);
+        if(!worker->importer) return out;
+
+        if(configure) {
+            Warning silence{nullptr};
+            setImporterOptions(*worker->importer, _importerOptions);
+        }
+        worker->importer->setFileCallback(&Worker::fileCallback, *worker);
+        worker->filename = filename;
+        worker->openAttempted = false;
+    }
+    if(configure) _configuredPlugins.push_back(plugin);
+
+    /* Each level goes to its own slot, so the jobs don't need to
+       synchronize. The level count is known only after the first level is
+       imported. */
+    std::vector<std::vector<Containers::Optional<Trade::ImageData2D>>> levels(images.size());
+    const auto importLevel = [&](const std::size_t workerIndex, const std::size_t i, const UnsignedInt level) {
+        Worker& worker = *_workers[workerIndex];
+        Trade::AbstractImporter* const importer = worker.open();
+        if(!importer) return;
+
+        worker.accessedFiles.clear();
+        Containers::Optional<Trade::ImageData2D> image = importer->image2D(images[i], level);
+        if(!image) return;
+
+        /* Compressed images can't have mips generated, import all levels the
+           file has */
+        if(level == 0) {
+            out[i].files = worker.accessedFiles;
+            levels[i].resize(image->isCompressed() ? importer->image2DLevelCount(images[i]) : 1);
+        } else if(!image->isCompressed()) return;
+
+        levels[i][level] = std::move(image);
+    };
+
+    /* Import the first image alone, so the plugins it needs get loaded on
+       just one thread. The remaining workers then get them loaded here, as
+       plugin initializers aren't guaranteed to be thread-safe. */
+    std::size_t firstWorker{};
+    _pool.submit([&](const std::size_t worker) {
+        firstWorker = worker;
+        importLevel(worker, 0, 0);
+    });
+    _pool.wait();
+    PluginManager::Manager<Trade::AbstractImporter>& firstManager = _workers[firstWorker]->manager;
+    for(const std::string& name: firstManager.pluginList()) {
+        if(firstManager.loadState(name) != PluginManager::LoadState::Loaded) continue;
+        for(std::size_t i = 0; i != _workers.size(); ++i)
+            if(i != firstWorker) _workers[i]->manager.load(name);
+    }
+
+    /* Then the first level of all others and after that all remaining
+       levels of compressed images, with all workers busy in both passes */
+    for(std::size_t i = 1; i != images.size(); ++i)
+        _pool.submit([&importLevel, i](const std::size_t worker) {
+            importLevel(worker, i, 0);
+        });
+    _pool.wait();
+    for(std::size_t i = 0; i != images.size(); ++i)
+        for(UnsignedInt level = 1; level < levels[i].size(); ++level)
+            _pool.submit([&importLevel, i, level](const std::size_t worker) {
+                importLevel(worker, i, level);
+            });
+    _pool.wait();
+
+    /* A chain with a level that failed to import is cut at that level */
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        for(Containers::Optional<Trade::ImageData2D>& level: levels[i]) {
+            if(!level) break;
+            out[i].levels.push_back(std::move(*level));
+        }
+    }
+
+    /* Release the file data, keeping the importer instances warm */
+    for(Containers::Pointer<Worker>& worker: _workers) {
+        worker->importers.close();
+        worker->files.clear();
+        worker->accessedFiles.clear();
+    }
+
+    return out;
+}
+
+}}
@@ -0,0 +1,87 @@
+#ifndef Magnum_Player_TextureDecoder_h
+#define Magnum_Player_TextureDecoder_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/PluginManager.h>
+#include <Magnum/Trade/AbstractImporter.h>
+#include <Magnum/Trade/ImageData.h>
+
+#include "WorkerPool.h"
+
+namespace Magnum { namespace Player {
+
+struct DecodedImage {
+    /* Empty if the import failed. Compressed images have all levels the file
+       has, uncompressed only the first as the rest gets generated. */
+    std::vector<Trade::ImageData2D> levels;
+    /* Files the image was imported from */
+    std::vector<std::string> files;
+};
+
+/* Imports images of a scene on multiple threads, to not have Basis textures
+   transcoded one after another. As neither the plugin manager nor the
+   importer instances can be used from more threads at once, each worker has
+   its own manager with the same plugin configuration and preferences as the
+   one passed in the constructor, and opens the file in its own importer.
+   Not available on Emscripten, which is built without thread support. */
+class TextureDecoder {
+    public:
+        /* If threadCount is 0, a thread for each hardware thread is created.
+           The manager is expected to be fully set up already, its plugin
+           configuration and preferences are copied. */
+        explicit TextureDecoder(PluginManager::Manager<Trade::AbstractImporter>& manager, std::size_t threadCount, std::string importerOptions, Trade::ImporterFlags flags);
+
+        ~TextureDecoder();
+
+        std::size_t threadCount() const { return _pool.workerCount(); }
+
+        /* The thread pool, for other work done during load such as texture
+           compression. Shouldn't be used while decode() is running. */
+        WorkerPool& pool() { return _pool; }
+
+        /* Opens given file with given plugin on each worker and imports given
+           images together with all their levels in parallel. The output is
+           in the same order as the images, files opened by the importers are
+           closed again before returning. */
+        std::vector<DecodedImage> decode(const std::string& plugin, const std::string& filename, Containers::ArrayView<const UnsignedInt> images);
+
+    private:
+        struct Worker;
+
+        std::string _importerOptions;
+        std::vector<Containers::Pointer<Worker>> _workers;
+        std::vector<std::string> _configuredPlugins;
+        /* Declared last so the threads are gone before the workers */
+        WorkerPool _pool;
+};
+
+}}
+
+#endif
@@ -0,0 +1,209 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Tracer.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Format.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#ifndef MAGNUM_TARGET_GLES
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/OpenGL.h>
+#endif
+
+namespace Magnum { namespace Player {
+
+struct Tracer::Zone {
+    const char* name;
+    Double begin;
+    #ifndef MAGNUM_TARGET_GLES
+    GpuZone* gpu;
+    #endif
+};
+
+namespace {
+
+/* Zones are written on the first track, GPU zones on the second */
+constexpr UnsignedInt CpuTrack = 1;
+constexpr UnsignedInt GpuTrack = 2;
+
+/* Written to the file once there's this much, to not keep a whole long
+   session in memory and not touch the file every frame either */
+constexpr std::size_t WriteThreshold = 64*1024;
+
+}
+
+Tracer::Tracer(const std::string& filename, const bool gpu): _filename{filename}, _start{std::chrono::steady_clock::now()} {
+    _valid = Utility::Directory::writeString(filename, Utility::formatString(
+        "[\n"
+        R"({{"name":"process_name","ph":"M","pid":1,"tid":{0},"args":{{"name":"magnum-player"}}}},)" "\n"
+        R"({{"name":"thread_name","ph":"M","pid":1,"tid":{0},"args":{{"name":"CPU"}}}},)" "\n"
+        R"({{"name":"thread_name","ph":"M","pid":1,"tid":{1},"args":{{"name":"GPU"}}}},)" "\n",
+        CpuTrack, GpuTrack));
+    if(!_valid) return;
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* Query the current GPU time synchronously once to align the GPU
+       timestamps with the CPU timeline */
+    if(gpu) {
+        if(GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>()) {
+            GLint64 now;
+            glGetInteger64v(GL_TIMESTAMP, &now);
+            _gpuStartTime = time();
+            _gpuStart = now;
+            _gpu = true;
+        } else Debug{} << "ARB_timer_query not supported, the trace will contain only CPU zones";
+    }
+    #else
+    static_cast<void>(gpu);
+    #endif
+}
+
+Tracer::~Tracer() {
+    if(!_valid) return;
+
+    #ifndef MAGNUM_TARGET_GLES
+    writeGpuZones(true);
+    #endif
+
+    /* Last event without a trailing comma to make the file valid JSON */
+    _out += Utility::formatString(R"({{"name":"end","ph":"i","s":"g","pid":1,"tid":{},"ts":{:.3f}}})" "\n]\n", CpuTrack, time());
+    write();
+}
+
+Double Tracer::time() const {
+    return std::chrono::duration<Double, std::micro>{std::chrono::steady_clock::now() - _start}.count();
+}
+
+void Tracer::beginZone(const char* const name, const bool gpu) {
+    if(!_inFrame) {
+        _inFrame = true;
+        _frameBegin = time();
+        #ifndef MAGNUM_TARGET_GLES
+        if(_gpu) {
+            _gpuZones.push_back({"Frame", timestamp(), GL::TimeQuery{NoCreate}, false});
+            _gpuFrame = &_gpuZones.back();
+        }
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    GpuZone* gpuZone = nullptr;
+    if(gpu && _gpu) {
+        _gpuZones.push_back({name, timestamp(), GL::TimeQuery{NoCreate}, false});
+        gpuZone = &_gpuZones.back();
+    }
+    _zones.push_back({name, time(), gpuZone});
+    #else
+    static_cast<void>(gpu);
+    _zones.push_back({name, time()});
+    #endif
+}
+
+void Tracer::endZone() {
+    CORRADE_ASSERT(!_zones.empty(),
+        "Player::Tracer::endZone(): no zone open", );
+
+    const Zone zone = _zones.back();
+    _zones.pop_back();
+    writeZone(zone.name, CpuTrack, zone.begin, time());
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(zone.gpu) {
+        zone.gpu->end = timestamp();
+        zone.gpu->finished = true;
+    }
+    #endif
+}
+
+void Tracer::endFrame() {
+    CORRADE_ASSERT(_zones.empty(),
+        "Player::Tracer::endFrame():" << _zones.size() << "zones still open", );
+    if(!_inFrame) return;
+
+    _out += Utility::formatString(R"({{"name":"Frame","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f},"args":{{"frame":{}}}}},)" "\n", CpuTrack, _frameBegin, time() - _frameBegin, _frameCount);
+    _inFrame = false;
+    ++_frameCount;
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(_gpuFrame) {
+        _gpuFrame->end = timestamp();
+        _gpuFrame->finished = true;
+        _gpuFrame = nullptr;
+    }
+    writeGpuZones(false);
+    #endif
+
+    if(_out.size() >= WriteThreshold) write();
+}
+
+void Tracer::writeZone(const char* const name, const UnsignedInt track, const Double begin, const Double end) {
+    _out += Utility::formatString(R"({{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}},)" "\n", name, track, begin, end - begin);
+}
+
+void Tracer::write() {
+    if(!Utility::Directory::appendString(_filename, _out))
+        Warning{} << "Can't write the trace to" << _filename;
+    _out.clear();
+}
+
+#ifndef MAGNUM_TARGET_GLES
+GL::TimeQuery Tracer::timestamp() {
+    GL::TimeQuery query{NoCreate};
+    if(_queries.empty())
+        query = GL::TimeQuery{GL::TimeQuery::Target::Timestamp};
+    else {
+        query = std::move(_queries.back());
+        _queries.pop_back();
+    }
+
+    query.timestamp();
+    return query;
+}
+
+void Tracer::writeGpuZones(const bool wait) {
+    /* The queries finish in the order they were issued, so stop at the
+       first one that's not available yet. The end of a zone is always
+       issued after its begin. */
+    while(!_gpuZones.empty()) {
+        GpuZone& zone = _gpuZones.front();
+        if(!zone.finished || (!wait && !zone.end.resultAvailable())) break;
+
+        const Double begin = _gpuStartTime + Double(Long(zone.begin.result<UnsignedLong>()) - _gpuStart)/1000.0;
+        const Double end = _gpuStartTime + Double(Long(zone.end.result<UnsignedLong>()) - _gpuStart)/1000.0;
+        writeZone(zone.name, GpuTrack, begin, end);
+
+        _queries.push_back(std::move(zone.begin));
+        _queries.push_back(std::move(zone.end));
+        _gpuZones.pop_front();
+    }
+}
+#endif
+
+}}
@@ -0,0 +1,146 @@
+#ifndef Magnum_Player_Tracer_h
+#define Magnum_Player_Tracer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+#include <Magnum/Magnum.h>
+
+#ifndef MAGNUM_TARGET_GLES
+#include <Magnum/GL/TimeQuery.h>
+#endif
+
+namespace Magnum { namespace Player {
+
+/* Records nested zones of each frame with their CPU time and writes them to
+   a file in the Chrome trace event format, which can be opened in Perfetto
+   or chrome://tracing to see what a particular slow frame spent its time on.
+   If enabled and ARB_timer_query is supported, zones can be measured on the
+   GPU as well, using timestamp queries whose results are fetched a few
+   frames later. These are shown on a separate track, aligned to the CPU
+   timeline. The trailing bracket of the JSON array is optional in the
+   format, so events are appended to the file as the frames go and it stays
+   usable even if the application doesn't exit cleanly. */
+class Tracer {
+    public:
+        /* Truncates the file and writes the track names. GPU zones need a
+           current GL context. If the file can't be written, isValid()
+           returns false. */
+        explicit Tracer(const std::string& filename, bool gpu);
+
+        /* Not copyable as the open zones point into the GPU zone queue */
+        Tracer(const Tracer&) = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        /* Waits for the GPU zones that are still pending, writes them and
+           closes the JSON array */
+        ~Tracer();
+
+        bool isValid() const { return _valid; }
+
+        bool isGpuEnabled() const {
+            #ifndef MAGNUM_TARGET_GLES
+            return _gpu;
+            #else
+            return false;
+            #endif
+        }
+
+        /* Count of frames ended so far */
+        UnsignedLong frameCount() const { return _frameCount; }
+
+        /* Begins a zone, nested into the zone that's currently open. If gpu
+           is set and GPU zones are enabled, the zone is measured on the GPU
+           as well. The name has to stay valid until the zone ends. The first
+           zone after endFrame() begins a new frame. */
+        void beginZone(const char* name, bool gpu);
+
+        /* Ends the zone that was begun last */
+        void endZone();
+
+        /* Ends a frame, if any zone was begun since the last call, and
+           writes the zones finished so far. Expected to be called with no
+           zone open, right after the buffers got swapped. */
+        void endFrame();
+
+    private:
+        struct Zone;
+        #ifndef MAGNUM_TARGET_GLES
+        struct GpuZone {
+            const char* name;
+            GL::TimeQuery begin, end;
+            bool finished;
+        };
+
+        GL::TimeQuery timestamp();
+        void writeGpuZones(bool wait);
+        #endif
+
+        Double time() const;
+        void writeZone(const char* name, UnsignedInt track, Double begin, Double end);
+        void write();
+
+        std::string _filename;
+        std::string _out;
+        std::chrono::steady_clock::time_point _start;
+        std::vector<Zone> _zones;
+        Double _frameBegin{};
+        UnsignedLong _frameCount{};
+        bool _valid{}, _inFrame{};
+        #ifndef MAGNUM_TARGET_GLES
+        bool _gpu{};
+        Long _gpuStart{};
+        Double _gpuStartTime{};
+        std::deque<GpuZone> _gpuZones;
+        GpuZone* _gpuFrame{};
+        std::vector<GL::TimeQuery> _queries;
+        #endif
+};
+
+/* Traces a zone for the lifetime of the instance. Does nothing if the tracer
+   is null, so it can stay in the code when tracing is disabled. */
+class TraceZone {
+    public:
+        explicit TraceZone(Tracer* tracer, const char* name, bool gpu = false): _tracer{tracer} {
+            if(_tracer) _tracer->beginZone(name, gpu);
+        }
+
+        TraceZone(const TraceZone&) = delete;
+        TraceZone& operator=(const TraceZone&) = delete;
+
+        ~TraceZone() {
+            if(_tracer) _tracer->endZone();
+        }
+
+    private:
+        Tracer* _tracer;
+};
+
+}}
+
+#endif
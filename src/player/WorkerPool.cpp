@@ -0,0 +1,87 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "WorkerPool.h"
+
+#include <Magnum/Math/Functions.h>
+
+namespace Magnum { namespace Player {
+
+WorkerPool::WorkerPool(std::size_t workerCount) {
+    if(!workerCount) workerCount = Math::max(std::thread::hardware_concurrency(), 1u);
+
+    _threads.reserve(workerCount);
+    for(std::size_t i = 0; i != workerCount; ++i)
+        _threads.emplace_back(&WorkerPool::run, this, i);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping = true;
+    }
+    _jobAvailable.notify_all();
+    for(std::thread& thread: _threads) thread.join();
+}
+
+void WorkerPool::submit(std::function<void(std::size_t)> job) {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _jobs.push_back(std::move(job));
+    }
+    _jobAvailable.notify_one();
+}
+
+std::size_t WorkerPool::pendingCount() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _jobs.size() + _running;
+}
+
+void WorkerPool::wait(const std::size_t maxPending) {
+    std::unique_lock<std::mutex> lock{_mutex};
+    _jobDone.wait(lock, [this, maxPending] { return _jobs.size() + _running <= maxPending; });
+}
+
+void WorkerPool::run(const std::size_t worker) {
+    std::unique_lock<std::mutex> lock{_mutex};
+    for(;;) {
+        /* On destruction the remaining jobs are still done before exiting */
+        _jobAvailable.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+        if(_jobs.empty()) return;
+
+        std::function<void(std::size_t)> job = std::move(_jobs.front());
+        _jobs.pop_front();
+        ++_running;
+
+        lock.unlock();
+        job(worker);
+        lock.lock();
+
+        --_running;
+        _jobDone.notify_all();
+    }
+}
+
+}}
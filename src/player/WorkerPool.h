@@ -0,0 +1,85 @@
+#ifndef Magnum_Player_WorkerPool_h
+#define Magnum_Player_WorkerPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Magnum/Magnum.h>
+
+namespace Magnum { namespace Player {
+
+/* A fixed set of threads taking jobs from a shared queue in the order they
+   were submitted. Each job gets the index of the worker running it, so it can
+   use per-worker state such as a plugin instance, which can't be used from
+   more threads at once. Not available on Emscripten, which is built without
+   thread support. */
+class WorkerPool {
+    public:
+        /* If workerCount is 0, a worker for each hardware thread is
+           created */
+        explicit WorkerPool(std::size_t workerCount);
+
+        /* Not copyable or movable as the threads reference the instance */
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /* Waits until all submitted jobs are done */
+        ~WorkerPool();
+
+        std::size_t workerCount() const { return _threads.size(); }
+
+        /* Adds a job to the queue. Can be called from any thread, including
+           the workers. */
+        void submit(std::function<void(std::size_t)> job);
+
+        /* Count of jobs that are either queued or running. As the workers
+           finish the jobs concurrently, the value is only informative. */
+        std::size_t pendingCount();
+
+        /* Blocks until at most maxPending jobs are queued or running. With
+           the default of 0 waits until all submitted jobs are done, a
+           non-zero value can be used to limit how far the producer gets
+           ahead of the workers. */
+        void wait(std::size_t maxPending = 0);
+
+    private:
+        void run(std::size_t worker);
+
+        std::vector<std::thread> _threads;
+        std::mutex _mutex;
+        std::condition_variable _jobAvailable, _jobDone;
+        std::deque<std::function<void(std::size_t)>> _jobs;
+        std::size_t _running{};
+        bool _stopping{};
+};
+
+}}
+
+#endif